@@ -184,6 +184,11 @@ using BValFunc = void (*)(
     MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim, FaceField &b,
     Real time, Real dt,
     int is, int ie, int js, int je, int ks, int ke, int ngh);
+//! user boundary for one row (k,j) of ghost cells il<=i<=iu of the primitives, with ib
+//! the index of the last active cell normal to the face (i for x1, j for x2, k for x3)
+using BValPencilFunc = void (*)(
+    MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+    Real time, Real dt, int k, int j, int il, int iu, int ib);
 using AMRFlagFunc = int (*)(MeshBlock *pmb);
 using MeshGenFunc = Real (*)(Real x, RegionSize rs);
 using SrcTermFunc = void (*)(
@@ -327,7 +327,8 @@ void BoundaryValues::SetupPersistentMPI() {
 void BoundaryValues::CheckUserBoundaries() {
   for (int i=0; i<nface_; i++) {
     if (block_bcs[i] == BoundaryFlag::user) {
-      if (pmy_mesh_->BoundaryFunction_[i] == nullptr) {
+      if (pmy_mesh_->BoundaryFunction_[i] == nullptr
+          && pmy_mesh_->BoundaryPencilFunction_[i] == nullptr) {
         std::stringstream msg;
         msg << "### FATAL ERROR in BoundaryValues::CheckBoundary" << std::endl
             << "A user-defined boundary is specified but the actual boundary function "
@@ -362,11 +363,11 @@ void BoundaryValues::CheckUserBoundaries() {
 
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::StartReceivingSubset(BoundaryCommSubset phase,
-//!                                std::vector<BoundaryVariable *> bvars_subset)
+//!                                const std::vector<BoundaryVariable *> &bvars_subset)
 //! \brief initiate MPI_Irecv()
 
-void BoundaryValues::StartReceivingSubset(BoundaryCommSubset phase,
-                                          std::vector<BoundaryVariable *> bvars_subset) {
+void BoundaryValues::StartReceivingSubset(
+    BoundaryCommSubset phase, const std::vector<BoundaryVariable *> &bvars_subset) {
   for (auto bvars_it = bvars_subset.begin(); bvars_it != bvars_subset.end();
        ++bvars_it) {
     (*bvars_it)->StartReceiving(phase);
@@ -404,7 +405,7 @@ void BoundaryValues::StartReceivingSubset(BoundaryCommSubset phase,
 
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::ClearBoundary(BoundaryCommSubset phase,
-//!                                         std::vector<BoundaryVariable *> bvars_subset)
+//!                      const std::vector<BoundaryVariable *> &bvars_subset)
 //! \brief clean up the boundary flags after each loop
 //!
 //! \note
@@ -412,8 +413,8 @@ void BoundaryValues::StartReceivingSubset(BoundaryCommSubset phase,
 //! variables and magentic fields, while BoundaryCommSubset::gr_amr corresponds to fluid
 //! primitive variables sent only in the case of GR with refinement
 
-void BoundaryValues::ClearBoundarySubset(BoundaryCommSubset phase,
-                                         std::vector<BoundaryVariable *> bvars_subset) {
+void BoundaryValues::ClearBoundarySubset(
+    BoundaryCommSubset phase, const std::vector<BoundaryVariable *> &bvars_subset) {
   for (auto bvars_it = bvars_subset.begin(); bvars_it != bvars_subset.end();
        ++bvars_it) {
     (*bvars_it)->ClearBoundary(phase);
@@ -423,15 +424,15 @@ void BoundaryValues::ClearBoundarySubset(BoundaryCommSubset phase,
 
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::ApplyPhysicalBoundaries(const Real time, const Real dt,
-//!                                        std::vector<BoundaryVariable *> bvars_subset)
+//!                      const std::vector<BoundaryVariable *> &bvars_subset)
 //! \brief Apply all the physical boundary conditions for both hydro and field
 //!
 //! \note
 //! - temporarily hardcode Hydro and Field access for coupling in EOS U(W) + calc bcc
 //!   and when passed to user-defined boundary function stored in function pointer array
 
-void BoundaryValues::ApplyPhysicalBoundaries(const Real time, const Real dt,
-                                   std::vector<BoundaryVariable *> bvars_subset) {
+void BoundaryValues::ApplyPhysicalBoundaries(
+    const Real time, const Real dt, const std::vector<BoundaryVariable *> &bvars_subset) {
   MeshBlock *pmb = pmy_block_;
   Coordinates *pco = pmb->pcoord;
   int bis = pmb->is - NGHOST, bie = pmb->ie + NGHOST,
@@ -643,147 +644,231 @@ void BoundaryValues::ApplyPhysicalBoundaries(const Real time, const Real dt,
   return;
 }
 
-//! \brief
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::DispatchBoundaryFunctions(...)
+//! \brief Apply the physical boundary of one face to all variables of the subset
 //!
 //! \note
-//! - should "bvars_it" be fixed in this class member function? Or passed as argument?
+//! - the boundary flag and the face are resolved once, then the variables are swept
+//!   in turn with the same BoundaryPhysics function
+//! - nothing is constructed or allocated unless an invalid face or flag is passed
+
 void BoundaryValues::DispatchBoundaryFunctions(
     MeshBlock *pmb, Coordinates *pco, Real time, Real dt,
     int il, int iu, int jl, int ju, int kl, int ku, int ngh,
     AthenaArray<Real> &prim, FaceField &b, AthenaArray<Real> &ir,
     AthenaArray<Real> &u_cr,  BoundaryFace face,
-    std::vector<BoundaryVariable *> bvars_subset) {
-  if (block_bcs[face] ==  BoundaryFlag::user) {  // user-enrolled BCs
-    pmy_mesh_->BoundaryFunction_[face](pmb, pco, prim, b, time, dt,
-                                       il, iu, jl, ju, kl, ku, NGHOST);
-
-    // user-defined  boundary for radiation
-    if ((NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)) {
-      pmy_mesh_->RadBoundaryFunc_[face](pmb,pco,pmb->pnrrad,prim,b, ir,time,dt,
-                                             il,iu,jl,ju,kl,ku,NGHOST);
-    }
+    const std::vector<BoundaryVariable *> &bvars_subset) {
+  // KGF: the "undef" case only silences the compiler -Wswitch warnings about not
+  // handling all possible BoundaryFace enumerator values. If "undef" is actually passed
+  // to this function, it will likely die before, as it tries to access block_bcs[-1]
+  bool valid_face = true;
+  switch (block_bcs[face]) {
+    case BoundaryFlag::user: // user-enrolled BCs, not applied per BoundaryVariable
+      if (pmy_mesh_->BoundaryFunction_[face] != nullptr)
+        pmy_mesh_->BoundaryFunction_[face](pmb, pco, prim, b, time, dt,
+                                           il, iu, jl, ju, kl, ku, NGHOST);
+      if (pmy_mesh_->BoundaryPencilFunction_[face] != nullptr)
+        DispatchUserBoundaryPencils(pmb, pco, time, dt, il, iu, jl, ju, kl, ku,
+                                    prim, face);
+
+      // user-defined  boundary for radiation
+      if ((NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)) {
+        pmy_mesh_->RadBoundaryFunc_[face](pmb,pco,pmb->pnrrad,prim,b, ir,time,dt,
+                                          il,iu,jl,ju,kl,ku,NGHOST);
+      }
 
-    if (CR_ENABLED) {
-      pmy_mesh_->CRBoundaryFunc_[face](pmb,pco,pmb->pcr,prim, b, u_cr,time,dt,
-                                              il,iu,jl,ju,kl,ku,NGHOST);
-    }
+      if (CR_ENABLED) {
+        pmy_mesh_->CRBoundaryFunc_[face](pmb,pco,pmb->pcr,prim, b, u_cr,time,dt,
+                                         il,iu,jl,ju,kl,ku,NGHOST);
+      }
+      break;
+    case BoundaryFlag::reflect:
+      switch (face) {
+        case BoundaryFace::inner_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
+          break;
+        case BoundaryFace::outer_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->ReflectOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
+          break;
+        default:
+          valid_face = false;
+          break;
+      }
+      break;
+    case BoundaryFlag::outflow:
+      switch (face) {
+        case BoundaryFace::inner_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
+          break;
+        case BoundaryFace::outer_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->OutflowOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
+          break;
+        default:
+          valid_face = false;
+          break;
+      }
+      break;
+    case BoundaryFlag::vacuum: // special boundary condition type for radiation
+      switch (face) {
+        case BoundaryFace::inner_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x1:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::inner_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
+          break;
+        case BoundaryFace::outer_x3:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->VacuumOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
+          break;
+        default:
+          valid_face = false;
+          break;
+      }
+      break;
+    case BoundaryFlag::polar_wedge:
+      switch (face) {
+        case BoundaryFace::inner_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->PolarWedgeInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
+          break;
+        case BoundaryFace::outer_x2:
+          for (BoundaryVariable *pbvar : bvars_subset)
+            pbvar->PolarWedgeOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
+          break;
+        default:
+          std::stringstream msg_polar;
+          msg_polar << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
+                    << "Attempting to call polar wedge boundary function on \n"
+                    << "MeshBlock boundary other than inner x2 or outer x2"
+                    << std::endl;
+          ATHENA_ERROR(msg_polar);
+      }
+      break;
+    default:
+      // an empty subset has nothing to apply (as in the loop over the variables)
+      if (bvars_subset.empty()) break;
+      std::stringstream msg_flag;
+      msg_flag << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
+               << "No BoundaryPhysics function associated with provided\n"
+               << "block_bcs[" << face << "] = BoundaryFlag::"
+               << GetBoundaryString(block_bcs[face]) << std::endl;
+      ATHENA_ERROR(msg_flag);
+      break;
+  } // end switch (block_bcs[face])
+  if (!valid_face) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
+        << "face = BoundaryFace::undef passed to this function" << std::endl;
+    ATHENA_ERROR(msg);
   }
-  // KGF: this is only to silence the compiler -Wswitch warnings about not handling the
-  // "undef" case when considering all possible BoundaryFace enumerator values. If "undef"
-  // is actually passed to this function, it will likely die before that ATHENA_ERROR()
-  // call, as it tries to access block_bcs[-1]
-  std::stringstream msg;
-  msg << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
-      << "face = BoundaryFace::undef passed to this function" << std::endl;
-
-  // For any function in the BoundaryPhysics interface class, iterate over
-  // BoundaryVariable pointers "enrolled"
-  for (auto bvars_it = bvars_subset.begin(); bvars_it != bvars_subset.end();
-       ++bvars_it) {
-    switch (block_bcs[face]) {
-      case BoundaryFlag::user: // handled above, outside loop over BoundaryVariable objs
-        break;
-      case BoundaryFlag::reflect:
-        switch (face) {
-          case BoundaryFace::undef:
-            ATHENA_ERROR(msg);
-          case BoundaryFace::inner_x1:
-            (*bvars_it)->ReflectInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x1:
-            (*bvars_it)->ReflectOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x2:
-            (*bvars_it)->ReflectInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x2:
-            (*bvars_it)->ReflectOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x3:
-            (*bvars_it)->ReflectInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
-            break;
-          case BoundaryFace::outer_x3:
-            (*bvars_it)->ReflectOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
-            break;
-        }
-        break;
-      case BoundaryFlag::outflow:
-        switch (face) {
-          case BoundaryFace::undef:
-            ATHENA_ERROR(msg);
-          case BoundaryFace::inner_x1:
-            (*bvars_it)->OutflowInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x1:
-            (*bvars_it)->OutflowOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x2:
-            (*bvars_it)->OutflowInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x2:
-            (*bvars_it)->OutflowOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x3:
-            (*bvars_it)->OutflowInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
-            break;
-          case BoundaryFace::outer_x3:
-            (*bvars_it)->OutflowOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
-            break;
-        }
-        break;
-      case BoundaryFlag::vacuum: // special boundary condition type for radiation
-        switch (face) {
-          case BoundaryFace::undef:
-            ATHENA_ERROR(msg);
-          case BoundaryFace::inner_x1:
-            (*bvars_it)->VacuumInnerX1(time, dt, il, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x1:
-            (*bvars_it)->VacuumOuterX1(time, dt, iu, jl, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x2:
-            (*bvars_it)->VacuumInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x2:
-            (*bvars_it)->VacuumOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::inner_x3:
-            (*bvars_it)->VacuumInnerX3(time, dt, il, iu, jl, ju, kl, NGHOST);
-            break;
-          case BoundaryFace::outer_x3:
-            (*bvars_it)->VacuumOuterX3(time, dt, il, iu, jl, ju, ku, NGHOST);
-            break;
-        }
-        break;
-      case BoundaryFlag::polar_wedge:
-        switch (face) {
-          case BoundaryFace::undef:
-            ATHENA_ERROR(msg);
-          case BoundaryFace::inner_x2:
-            (*bvars_it)->PolarWedgeInnerX2(time, dt, il, iu, jl, kl, ku, NGHOST);
-            break;
-          case BoundaryFace::outer_x2:
-            (*bvars_it)->PolarWedgeOuterX2(time, dt, il, iu, ju, kl, ku, NGHOST);
-            break;
-          default:
-            std::stringstream msg_polar;
-            msg_polar << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
-                      << "Attempting to call polar wedge boundary function on \n"
-                      << "MeshBlock boundary other than inner x2 or outer x2"
-                      << std::endl;
-            ATHENA_ERROR(msg_polar);
-        }
-        break;
-      default:
-        std::stringstream msg_flag;
-        msg_flag << "### FATAL ERROR in DispatchBoundaryFunctions" << std::endl
-                 << "No BoundaryPhysics function associated with provided\n"
-                 << "block_bcs[" << face << "] = BoundaryFlag::"
-                 << GetBoundaryString(block_bcs[face]) << std::endl;
-        ATHENA_ERROR(msg);
-        break;
-    } // end switch (block_bcs[face])
-  } // end loop over BoundaryVariable *
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::DispatchUserBoundaryPencils(...)
+//! \brief Call the enrolled BValPencilFunc for each row (k,j) of the NGHOST ghost cells
+//!        of a face, also on the coarse buffers of ProlongateBoundaries()
+//!
+//! \note the rows always run along x1, so il..iu spans the NGHOST ghost cells on the x1
+//!       faces and the whole (transverse) range il..iu on the x2 and x3 faces
+
+void BoundaryValues::DispatchUserBoundaryPencils(
+    MeshBlock *pmb, Coordinates *pco, Real time, Real dt,
+    int il, int iu, int jl, int ju, int kl, int ku,
+    AthenaArray<Real> &prim, BoundaryFace face) {
+  BValPencilFunc UserPencil = pmy_mesh_->BoundaryPencilFunction_[face];
+  switch (face) {
+    case BoundaryFace::inner_x1:
+      for (int k=kl; k<=ku; ++k) {
+        for (int j=jl; j<=ju; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, il-NGHOST, il-1, il);
+      }
+      break;
+    case BoundaryFace::outer_x1:
+      for (int k=kl; k<=ku; ++k) {
+        for (int j=jl; j<=ju; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, iu+1, iu+NGHOST, iu);
+      }
+      break;
+    case BoundaryFace::inner_x2:
+      for (int k=kl; k<=ku; ++k) {
+        for (int j=jl-NGHOST; j<=jl-1; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, il, iu, jl);
+      }
+      break;
+    case BoundaryFace::outer_x2:
+      for (int k=kl; k<=ku; ++k) {
+        for (int j=ju+1; j<=ju+NGHOST; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, il, iu, ju);
+      }
+      break;
+    case BoundaryFace::inner_x3:
+      for (int k=kl-NGHOST; k<=kl-1; ++k) {
+        for (int j=jl; j<=ju; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, il, iu, kl);
+      }
+      break;
+    case BoundaryFace::outer_x3:
+      for (int k=ku+1; k<=ku+NGHOST; ++k) {
+        for (int j=jl; j<=ju; ++j)
+          UserPencil(pmb, pco, prim, time, dt, k, j, il, iu, ku);
+      }
+      break;
+    default:
+      break;
+  }
+  return;
 }
 
 
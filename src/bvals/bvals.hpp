@@ -141,14 +141,18 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
   // non-inhertied / unique functions (do not exist in BoundaryVariable objects):
   // (these typically involve a coupled interaction of boundary variable/quantities)
   // ------
+  // (the subsets are passed by reference: these run every stage on every MeshBlock)
   void StartReceivingSubset(BoundaryCommSubset phase,
-                            std::vector<BoundaryVariable *> bvars_subset);
+                            const std::vector<BoundaryVariable *> &bvars_subset);
   void ClearBoundarySubset(BoundaryCommSubset phase,
-                           std::vector<BoundaryVariable *> bvars_subset);
+                           const std::vector<BoundaryVariable *> &bvars_subset);
   void ApplyPhysicalBoundaries(const Real time, const Real dt,
-                               std::vector<BoundaryVariable *> bvars_subset);
+                               const std::vector<BoundaryVariable *> &bvars_subset);
   void ProlongateBoundaries(const Real time, const Real dt,
-                            std::vector<BoundaryVariable *> bvars_subset);
+                            const std::vector<BoundaryVariable *> &bvars_subset);
+
+  // hides BoundaryBase::SearchAndSetNeighbors() to refresh the prolongation regions
+  void SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist, int *nslist);
 
   // temporary workaround for self-gravity
   void ProlongateGravityBoundaries(const Real time, const Real dt);
@@ -202,13 +206,23 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
   ShearNeighborData<4> sb_data_[2];
   ShearNeighborData<3> sb_flux_data_[2];
 
-  // ProlongateBoundaries() wraps the following S/AMR-operations (within nneighbor loop):
-  // (the next function is also called within 3x nested loops over nk,nj,ni)
-  void RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int nk, int nj, int ni);
+  //! coarse-buffer regions of ProlongateBoundaries(), set with the neighbors: coarser
+  //! neighbors and their ghost-ghost zones, and the disjoint unions of the same-level
+  //! cells to restrict and of the cells to convert to primitives around all of them
+  std::vector<int> prol_neighbor_;
+  std::vector<CoarseIndexRange> prol_range_, prol_restrict_, prol_convert_;
+  //! bit (1 << face) set if the ghost-ghost zone of the coarser neighbor reaches the
+  //! physical boundary on that face, 0 if no physical boundary is applied on it
+  std::vector<int> prol_bndry_faces_;
+  void SetProlongationRegions();
+
+  // ProlongateBoundaries() wraps the following S/AMR-operations:
+  // (the first one over the cached prol_restrict_ boxes, the others per coarser neighbor)
+  void RestrictGhostCellsOnSameLevel(const CoarseIndexRange &r);
   void ApplyPhysicalBoundariesOnCoarseLevel(
-      const NeighborBlock& nb, const Real time, const Real dt,
+      const int faces, const Real time, const Real dt,
       int si, int ei, int sj, int ej, int sk, int ek,
-      std::vector<BoundaryVariable *> bvars_subset);
+      const std::vector<BoundaryVariable *> &bvars_subset);
   void ProlongateGhostCells(const NeighborBlock& nb,
                             int si, int ei, int sj, int ej, int sk, int ek);
 
@@ -222,7 +236,11 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
       int il, int iu, int jl, int ju, int kl, int ku, int ngh,
       AthenaArray<Real> &prim, FaceField &b, AthenaArray<Real> &ir,
       AthenaArray<Real> &u_cr, BoundaryFace face,
-      std::vector<BoundaryVariable *> bvars_subset);
+      const std::vector<BoundaryVariable *> &bvars_subset);
+  void DispatchUserBoundaryPencils(
+      MeshBlock *pmb, Coordinates *pco, Real time, Real dt,
+      int il, int iu, int jl, int ju, int kl, int ku,
+      AthenaArray<Real> &prim, BoundaryFace face);
 
   void CheckPolarBoundaries();  // called in BoundaryValues() ctor
 
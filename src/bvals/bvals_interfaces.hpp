@@ -190,6 +190,16 @@ struct ShearNeighborData {
   int jmin_recv[kMaxNeighbor], jmax_recv[kMaxNeighbor];
 };
 
+//----------------------------------------------------------------------------------------
+//! \struct CoarseIndexRange
+//! \brief box of coarse-buffer cells used at a level boundary, with the direction
+//!        (ni, nj, nk) of the ghost zone it lies in (restriction boxes only)
+
+struct CoarseIndexRange {
+  int si, ei, sj, ej, sk, ek;
+  int ni, nj, nk;
+};
+
 // Struct for describing blocks which touch the shearing-periodic boundaries
 // struct ShearingBoundaryBlock {
 //   int *igidlist, *ilidlist, *irnklist, *ilevlist;
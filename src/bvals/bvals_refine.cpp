@@ -33,8 +33,9 @@
 //! 2. MeshRefinement tuples of pointers: pvars_cc_
 //!   - Used in RestrictGhostCellsOnSameLevel() and ProlongateGhostCells()
 //! 3. Hardcoded pointers through MeshBlock members (pmb->phydro->w, e.g. )
-//!   - Used in ApplyPhysicalBoundariesOnCoarseLevel() and ProlongateGhostCells() where
-//!     physical quantities are coupled through EquationOfState
+//!   - Used in ProlongateBoundaries(), ApplyPhysicalBoundariesOnCoarseLevel() and
+//!     ProlongateGhostCells() where physical quantities are coupled through
+//!     EquationOfState
 //!
 //! SUMMARY OF BELOW PTR CHANGES:
 //! -----------
@@ -53,8 +54,9 @@
 // C headers
 
 // C++ headers
-#include <algorithm>  // min
+#include <algorithm>  // max, min
 #include <cmath>
+#include <cstdint>    // int64_t
 #include <iterator>
 #include <vector>
 
@@ -72,9 +74,48 @@
 #include "cc/hydro/bvals_hydro.hpp"
 #include "fc/bvals_fc.hpp"
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void AddDisjointRange(std::vector<CoarseIndexRange> &list,
+//!                            const CoarseIndexRange &box)
+//! \brief appends the parts of box not yet covered by the boxes in list, so that list
+//!        stays a set of disjoint boxes
+
+void AddDisjointRange(std::vector<CoarseIndexRange> &list, const CoarseIndexRange &box) {
+  std::vector<CoarseIndexRange> parts{box}, rest;
+  for (const CoarseIndexRange &c : list) {
+    rest.clear();
+    for (CoarseIndexRange q : parts) {
+      if (q.ei < c.si || q.si > c.ei || q.ej < c.sj || q.sj > c.ej
+          || q.ek < c.sk || q.sk > c.ek) {
+        rest.push_back(q);
+        continue;
+      }
+      // peel off the slabs of q outside c, one direction at a time
+      CoarseIndexRange slab = q;
+      if (q.si < c.si) { slab.ei = c.si - 1; rest.push_back(slab); q.si = c.si; }
+      slab = q;
+      if (q.ei > c.ei) { slab.si = c.ei + 1; rest.push_back(slab); q.ei = c.ei; }
+      slab = q;
+      if (q.sj < c.sj) { slab.ej = c.sj - 1; rest.push_back(slab); q.sj = c.sj; }
+      slab = q;
+      if (q.ej > c.ej) { slab.sj = c.ej + 1; rest.push_back(slab); q.ej = c.ej; }
+      slab = q;
+      if (q.sk < c.sk) { slab.ek = c.sk - 1; rest.push_back(slab); q.sk = c.sk; }
+      slab = q;
+      if (q.ek > c.ek) { slab.sk = c.ek + 1; rest.push_back(slab); q.ek = c.ek; }
+      // the rest of q lies inside c
+    }
+    parts.swap(rest);
+  }
+  list.insert(list.end(), parts.begin(), parts.end());
+  return;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
-//!                                       std::vector<BoundaryVariable *> bvars_subset)
+//!                      const std::vector<BoundaryVariable *> &bvars_subset)
 //! \brief Prolongate boundaries
 //!
 //! \note
@@ -82,9 +123,9 @@
 //!   around ApplyPhysicalBoundariesOnCoarseLevel()
 //! - This hardcoded technique is also used to manually specify the coupling between
 //!   physical variables in:
-//!   - step 2, ApplyPhysicalBoundariesOnCoarseLevel():
-//!     calls to W(U) and user BoundaryFunc
-//!   - step 3, ProlongateGhostCells(): calls to calculate bcc and U(W)
+//!   - step 2: calls to W(U)
+//!   - step 3, ApplyPhysicalBoundariesOnCoarseLevel(): calls to user BoundaryFunc
+//!   - step 4, ProlongateGhostCells(): calls to calculate bcc and U(W)
 //! - Additionally, pmr->SetHydroRefinement() is currently used in
 //!   RestrictGhostCellsOnSameLevel() (GR) and ProlongateGhostCells() (always) to switch
 //!   between conserved and primitive tuples in MeshRefinement::pvars_cc_, but this does
@@ -92,18 +133,18 @@
 //! - downcast BoundaryVariable pointers to known derived class pointer types:
 //!   RTTI via dynamic_case
 
-void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
-                                          std::vector<BoundaryVariable *> bvars_subset) {
+void BoundaryValues::ProlongateBoundaries(
+    const Real time, const Real dt, const std::vector<BoundaryVariable *> &bvars_subset) {
   MeshBlock *pmb = pmy_block_;
-  int &mylevel = loc.level;
 
   // TODO(KGF): temporarily hardcode Hydro and Field array access for the below switch
   // around ApplyPhysicalBoundariesOnCoarseLevel()
 
   // This hardcoded technique is also used to manually specify the coupling between
   // physical variables in:
-  // - step 2, ApplyPhysicalBoundariesOnCoarseLevel(): calls to W(U) and user BoundaryFunc
-  // - step 3, ProlongateGhostCells(): calls to calculate bcc and U(W)
+  // - step 2: calls to W(U)
+  // - step 3, ApplyPhysicalBoundariesOnCoarseLevel(): calls to user BoundaryFunc
+  // - step 4, ProlongateGhostCells(): calls to calculate bcc and U(W)
 
   // Additionally, pmr->SetHydroRefinement() is currently used in
   // RestrictGhostCellsOnSameLevel() (GR) and ProlongateGhostCells() (always) to switch
@@ -146,8 +187,119 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
     pcrbvar = &(pcr->cr_bvar);
   }
 
-  // For each finer neighbor, to prolongate a boundary we need to fill one more cell
-  // surrounding the boundary zone to calculate the slopes ("ghost-ghost zone"). 3x steps:
+  // For each coarser neighbor, to prolongate a boundary we need to fill one more cell
+  // surrounding the boundary zone to calculate the slopes ("ghost-ghost zone").
+  // The ghost-ghost zones of neighboring coarser blocks overlap, so the restriction and
+  // the conversion to primitives run once over the disjoint unions cached in
+  // SetProlongationRegions() before the per-neighbor steps. Both are pointwise and
+  // only read cells that the later steps do not write, so the result is unchanged.
+  if (prol_neighbor_.empty()) return;
+
+  // Step 1. Apply necessary variable restrictions when ghost-ghost zone is on same lvl
+  for (const CoarseIndexRange &r : prol_restrict_)
+    RestrictGhostCellsOnSameLevel(r);
+
+  // Step 2. Convert the ghost zones and ghost-ghost zones into primitive variables
+  // (this includes cell-centered field calculation)
+  //! \note (felker):
+  //! - passing nullptrs (pf) if no MHD.
+  //! - Might no longer be an issue to set pf=pmb->pfield even if no MHD.
+  //! - Originally was a problem when dereferencing in order
+  //!   to bind references to coarse_b_, coarse_bcc, since coarse_* are
+  //!   no longer members of MeshRefinement that always exist (even if not allocated).
+  MeshRefinement *pmr = pmb->pmr;
+  for (const CoarseIndexRange &r : prol_convert_) {
+    // KGF: COUPLING OF QUANTITIES (must be manually specified)
+    pmb->peos->ConservedToPrimitive(ph->coarse_cons_, ph->coarse_prim_,
+                                    pf->coarse_b_, ph->coarse_prim_,
+                                    pf->coarse_bcc_, pmr->pcoarsec,
+                                    r.si, r.ei, r.sj, r.ej, r.sk, r.ek);
+    if (NSCALARS > 0) {
+      pmb->peos->PassiveScalarConservedToPrimitive(ps->coarse_s_, ph->coarse_cons_,
+                                                   ps->coarse_r_, ps->coarse_r_,
+                                                   pmr->pcoarsec, r.si, r.ei,
+                                                   r.sj, r.ej, r.sk, r.ek);
+    }
+  }
+
+  for (std::size_t m=0; m<prol_neighbor_.size(); m++) {
+    NeighborBlock& nb = neighbor[prol_neighbor_[m]];
+    const CoarseIndexRange &r = prol_range_[m];
+    int si = r.si, ei = r.ei, sj = r.sj, ej = r.ej, sk = r.sk, ek = r.ek;
+
+    // (temp workaround) to automatically call all BoundaryFunction_[] on coarse_prim/b
+    // instead of previous targets var_cc=cons, var_fc=b
+    phbvar->var_cc = &(ph->coarse_prim_);
+    if (MAGNETIC_FIELDS_ENABLED)
+      pfbvar->var_fc = &(pf->coarse_b_);
+    if (NSCALARS > 0) {
+      ps = pmb->pscalars;
+      ps->sbvar.var_cc = &(ps->coarse_r_);
+    }
+
+    if ((NR_RADIATION_ENABLED|| IM_RADIATION_ENABLED))
+      pradbvar->var_cc = &(pnrrad->coarse_ir_);
+
+    if (CR_ENABLED)
+      pcrbvar->var_cc = &(pcr->coarse_cr_);
+
+    // Step 3. Re-apply physical boundaries on the coarse boundary, skipped if the
+    // ghost-ghost zone reaches no physical boundary:
+    if (prol_bndry_faces_[m] != 0)
+      ApplyPhysicalBoundariesOnCoarseLevel(prol_bndry_faces_[m], time, dt,
+                                           si, ei, sj, ej, sk, ek, bvars_subset);
+
+    // (temp workaround) swap BoundaryVariable var_cc/fc to standard primitive variable
+    // arrays (not coarse) from coarse primitive variables arrays
+    phbvar->var_cc = &(ph->w);
+    if (MAGNETIC_FIELDS_ENABLED)
+      pfbvar->var_fc = &(pf->b);
+    if (NSCALARS > 0) {
+      ps = pmb->pscalars;
+      ps->sbvar.var_cc = &(ps->r);
+    }
+
+    if ((NR_RADIATION_ENABLED|| IM_RADIATION_ENABLED))
+      pradbvar->var_cc = &(pnrrad->ir);
+
+    if (CR_ENABLED)
+      pcrbvar->var_cc = &(pcr->u_cr);
+
+    // Step 4. Finally, the ghost-ghost zones are ready for prolongation:
+    ProlongateGhostCells(nb, si, ei, sj, ej, sk, ek);
+  } // end loop over coarser neighbors
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
+//!                                                int *nslist)
+//! \brief Search and set all the neighbor blocks, and the prolongation regions
+
+void BoundaryValues::SearchAndSetNeighbors(MeshBlockTree &tree, int *ranklist,
+                                           int *nslist) {
+  BoundaryBase::SearchAndSetNeighbors(tree, ranklist, nslist);
+  SetProlongationRegions();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::SetProlongationRegions()
+//! \brief Caches the coarse-buffer index ranges used by ProlongateBoundaries(): the
+//!        ghost-ghost zone of each coarser neighbor, and the disjoint unions of the
+//!        same-level cells to restrict and of the cells to convert to primitives
+
+void BoundaryValues::SetProlongationRegions() {
+  MeshBlock *pmb = pmy_block_;
+  int &mylevel = loc.level;
+  prol_neighbor_.clear();
+  prol_range_.clear();
+  prol_restrict_.clear();
+  prol_convert_.clear();
+  prol_bndry_faces_.clear();
+  if (!pmy_mesh_->multilevel) return;
+
   for (int n=0; n<nneighbor; n++) {
     NeighborBlock& nb = neighbor[n];
     if (nb.snb.level >= mylevel) continue;
@@ -171,7 +323,7 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
       nke = std::min(nb.ni.ox3+1, 1);
     }
 
-    // Step 1. Apply necessary variable restrictions when ghost-ghost zone is on same lvl
+    // same-level parts of the ghost-ghost zone, restricted for prolongation
     for (int nk=nks; nk<=nke; nk++) {
       for (int nj=njs; nj<=nje; nj++) {
         for (int ni=nis; ni<=nie; ni++) {
@@ -179,9 +331,37 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
           // skip myself or coarse levels; only the same level must be restricted
           if (ntype == 0 || nblevel[nk+1][nj+1][ni+1] != mylevel) continue;
 
-          // this neighbor block is on the same level
-          // and needs to be restricted for prolongation
-          RestrictGhostCellsOnSameLevel(nb, nk, nj, ni);
+          CoarseIndexRange r;
+          r.ni = ni, r.nj = nj, r.nk = nk;
+          if (ni == 0) {
+            r.si = pmb->cis, r.ei = pmb->cie;
+            if (nb.ni.ox1 == 1)       r.si = pmb->cie;
+            else if (nb.ni.ox1 == -1) r.ei = pmb->cis;
+          } else if (ni == 1) {
+            r.si = pmb->cie + 1, r.ei = pmb->cie + 1;
+          } else { //(ni ==  - 1)
+            r.si = pmb->cis - 1, r.ei = pmb->cis - 1;
+          }
+          if (nj == 0) {
+            r.sj = pmb->cjs, r.ej = pmb->cje;
+            if (nb.ni.ox2 == 1)       r.sj = pmb->cje;
+            else if (nb.ni.ox2 == -1) r.ej = pmb->cjs;
+          } else if (nj == 1) {
+            r.sj = pmb->cje + 1, r.ej = pmb->cje + 1;
+          } else { //(nj == -1)
+            r.sj = pmb->cjs - 1, r.ej = pmb->cjs - 1;
+          }
+          if (nk == 0) {
+            r.sk = pmb->cks, r.ek = pmb->cke;
+            if (nb.ni.ox3 == 1)       r.sk = pmb->cke;
+            else if (nb.ni.ox3 == -1) r.ek = pmb->cks;
+          } else if (nk == 1) {
+            r.sk = pmb->cke + 1, r.ek = pmb->cke + 1;
+          } else { //(nk == -1)
+            r.sk = pmb->cks - 1, r.ek = pmb->cks - 1;
+          }
+          // boxes of different ghost zones never overlap
+          AddDisjointRange(prol_restrict_, r);
         }
       }
     }
@@ -214,87 +394,70 @@ void BoundaryValues::ProlongateBoundaries(const Real time, const Real dt,
       }
     } else if (nb.ni.ox3 > 0) { sk = pmb->cke + 1,  ek = pmb->cke + cn;}
     else              sk = pmb->cks-cn, ek = pmb->cks-1;
-
-    // (temp workaround) to automatically call all BoundaryFunction_[] on coarse_prim/b
-    // instead of previous targets var_cc=cons, var_fc=b
-    phbvar->var_cc = &(ph->coarse_prim_);
-    if (MAGNETIC_FIELDS_ENABLED)
-      pfbvar->var_fc = &(pf->coarse_b_);
-    if (NSCALARS > 0) {
-      ps = pmb->pscalars;
-      ps->sbvar.var_cc = &(ps->coarse_r_);
+    prol_neighbor_.push_back(n);
+    prol_range_.push_back({si, ei, sj, ej, sk, ek, 0, 0, 0});
+
+    // the physical boundaries reached by the ghost-ghost zone: those on the faces it
+    // spans, i.e. transverse to the direction of the neighbor, with either a boundary
+    // function or the rotation of the radiation intensities applied on them
+    int faces = 0;
+    for (int i=0; i<6; i++) {
+      BoundaryFace face = static_cast<BoundaryFace>(i);
+      int ox = (i < 2) ? nb.ni.ox1 : ((i < 4) ? nb.ni.ox2 : nb.ni.ox3);
+      if (ox != 0 || (i >= 2 && pmb->block_size.nx2 == 1)
+          || (i >= 4 && pmb->block_size.nx3 == 1)) continue;
+      bool rotate = false;
+      if ((NR_RADIATION_ENABLED|| IM_RADIATION_ENABLED) && i >= 2
+          && block_bcs[face] != BoundaryFlag::block)
+        rotate = (i < 4) ? (pmb->pnrrad->rotate_theta == 1)
+                         : (pmb->pnrrad->rotate_phi > 0);
+      if (apply_bndry_fn_[face] || rotate) faces |= 1 << face;
     }
+    prol_bndry_faces_.push_back(faces);
 
-    if ((NR_RADIATION_ENABLED|| IM_RADIATION_ENABLED))
-      pradbvar->var_cc = &(pnrrad->coarse_ir_);
-
-    if (CR_ENABLED)
-      pcrbvar->var_cc = &(pcr->coarse_cr_);
-
-    // Step 2. Re-apply physical boundaries on the coarse boundary:
-    ApplyPhysicalBoundariesOnCoarseLevel(nb, time, dt, si, ei, sj, ej, sk, ek,
-                                         bvars_subset);
-
-    // (temp workaround) swap BoundaryVariable var_cc/fc to standard primitive variable
-    // arrays (not coarse) from coarse primitive variables arrays
-    phbvar->var_cc = &(ph->w);
-    if (MAGNETIC_FIELDS_ENABLED)
-      pfbvar->var_fc = &(pf->b);
-    if (NSCALARS > 0) {
-      ps = pmb->pscalars;
-      ps->sbvar.var_cc = &(ps->r);
+    // the primitives are needed one cell further out for the slopes, except beyond
+    // physical boundaries, which are filled afterwards
+    int f1m = 0, f1p = 0, f2m = 0, f2p = 0, f3m = 0, f3p = 0;
+    if (nb.ni.ox1 == 0) {
+      if (nblevel[1][1][0] != -1) f1m = 1;
+      if (nblevel[1][1][2] != -1) f1p = 1;
+    } else {
+      f1m = 1;
+      f1p = 1;
     }
-
-    if ((NR_RADIATION_ENABLED|| IM_RADIATION_ENABLED))
-      pradbvar->var_cc = &(pnrrad->ir);
-
-    if (CR_ENABLED)
-      pcrbvar->var_cc = &(pcr->u_cr);
-
-    // Step 3. Finally, the ghost-ghost zones are ready for prolongation:
-    ProlongateGhostCells(nb, si, ei, sj, ej, sk, ek);
-  } // end loop over nneighbor
+    if (pmb->block_size.nx2 > 1) {
+      if (nb.ni.ox2 == 0) {
+        if (nblevel[1][0][1] != -1) f2m = 1;
+        if (nblevel[1][2][1] != -1) f2p = 1;
+      } else {
+        f2m = 1;
+        f2p = 1;
+      }
+    }
+    if (pmb->block_size.nx3 > 1) {
+      if (nb.ni.ox3 == 0) {
+        if (nblevel[0][1][1] != -1) f3m = 1;
+        if (nblevel[2][1][1] != -1) f3p = 1;
+      } else {
+        f3m = 1;
+        f3p = 1;
+      }
+    }
+    AddDisjointRange(prol_convert_, {si-f1m, ei+f1p, sj-f2m, ej+f2p, sk-f3m, ek+f3p,
+                                     0, 0, 0});
+  }
   return;
 }
 
-
 //----------------------------------------------------------------------------------------
-//! \fn void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb,
-//!                                                        int nk, int nj, int ni)
-//! \brief Restrict ghost cells on same level
-void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int nk,
-                                                   int nj, int ni) {
+//! \fn void BoundaryValues::RestrictGhostCellsOnSameLevel(const CoarseIndexRange &r)
+//! \brief Restrict ghost cells on same level in the box r of ghost zone (r.ni,r.nj,r.nk)
+
+void BoundaryValues::RestrictGhostCellsOnSameLevel(const CoarseIndexRange &r) {
   MeshBlock *pmb = pmy_block_;
   MeshRefinement *pmr = pmb->pmr;
-
-  int ris, rie, rjs, rje, rks, rke;
-  if (ni == 0) {
-    ris = pmb->cis, rie = pmb->cie;
-    if (nb.ni.ox1 == 1)       ris = pmb->cie;
-    else if (nb.ni.ox1 == -1) rie = pmb->cis;
-  } else if (ni == 1) {
-    ris = pmb->cie + 1, rie = pmb->cie + 1;
-  } else { //(ni ==  - 1)
-    ris = pmb->cis - 1, rie = pmb->cis - 1;
-  }
-  if (nj == 0) {
-    rjs = pmb->cjs, rje = pmb->cje;
-    if (nb.ni.ox2 == 1)       rjs = pmb->cje;
-    else if (nb.ni.ox2 == -1) rje = pmb->cjs;
-  } else if (nj == 1) {
-    rjs = pmb->cje + 1, rje = pmb->cje + 1;
-  } else { //(nj == -1)
-    rjs = pmb->cjs - 1, rje = pmb->cjs - 1;
-  }
-  if (nk == 0) {
-    rks = pmb->cks, rke = pmb->cke;
-    if (nb.ni.ox3 == 1)       rks = pmb->cke;
-    else if (nb.ni.ox3 == -1) rke = pmb->cks;
-  } else if (nk == 1) {
-    rks = pmb->cke + 1, rke = pmb->cke + 1;
-  } else { //(nk == -1)
-    rks = pmb->cks - 1, rke = pmb->cks - 1;
-  }
+  int ni = r.ni, nj = r.nj, nk = r.nk;
+  int ris = r.si, rie = r.ei, rjs = r.sj, rje = r.ej, rks = r.sk, rke = r.ek;
 
   for (auto cc_pair : pmr->pvars_cc_) {
     AthenaArray<Real> *var_cc = std::get<0>(cc_pair);
@@ -365,17 +528,18 @@ void BoundaryValues::RestrictGhostCellsOnSameLevel(const NeighborBlock& nb, int
 
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
-//!          const NeighborBlock& nb, const Real time, const Real dt,
+//!          const int faces, const Real time, const Real dt,
 //!          int si, int ei, int sj, int ej, int sk, int ek,
-//!          std::vector<BoundaryVariable *> bvars_subset)
-//! \brief physical boundaries
+//!          const std::vector<BoundaryVariable *> &bvars_subset)
+//! \brief physical boundaries on the faces set in the bitmask faces, as cached in
+//!        prol_bndry_faces_ for the coarser neighbor
 //!
 //! \note temporarily hardcode Hydro and Field array access
 
 void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
-    const NeighborBlock& nb, const Real time, const Real dt,
+    const int faces, const Real time, const Real dt,
     int si, int ei, int sj, int ej, int sk, int ek,
-    std::vector<BoundaryVariable *> bvars_subset) {
+    const std::vector<BoundaryVariable *> &bvars_subset) {
   MeshBlock *pmb = pmy_block_;
   MeshRefinement *pmr = pmb->pmr;
 
@@ -398,57 +562,10 @@ void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
     pcr = pmb->pcr;
 
 
-  // convert the ghost zone and ghost-ghost zones into primitive variables
-  // this includes cell-centered field calculation
-  int f1m = 0, f1p = 0, f2m = 0, f2p = 0, f3m = 0, f3p = 0;
-  if (nb.ni.ox1 == 0) {
-    if (nblevel[1][1][0] != -1) f1m = 1;
-    if (nblevel[1][1][2] != -1) f1p = 1;
-  } else {
-    f1m = 1;
-    f1p = 1;
-  }
-  if (pmb->block_size.nx2 > 1) {
-    if (nb.ni.ox2 == 0) {
-      if (nblevel[1][0][1] != -1) f2m = 1;
-      if (nblevel[1][2][1] != -1) f2p = 1;
-    } else {
-      f2m = 1;
-      f2p = 1;
-    }
-  }
-  if (pmb->block_size.nx3 > 1) {
-    if (nb.ni.ox3 == 0) {
-      if (nblevel[0][1][1] != -1) f3m = 1;
-      if (nblevel[2][1][1] != -1) f3p = 1;
-    } else {
-      f3m = 1;
-      f3p = 1;
-    }
-  }
-
-  //! \note (felker):
-  //! - passing nullptrs (pf) if no MHD.
-  //! - Might no longer be an issue to set pf=pmb->pfield even if no MHD.
-  //! - Originally was a problem when dereferencing in order
-  //!   to bind references to coarse_b_, coarse_bcc, since coarse_* are
-  //!   no longer members of MeshRefinement that always exist (even if not allocated).
-
-  // KGF: COUPLING OF QUANTITIES (must be manually specified)
-  pmb->peos->ConservedToPrimitive(ph->coarse_cons_, ph->coarse_prim_,
-                                  pf->coarse_b_, ph->coarse_prim_,
-                                  pf->coarse_bcc_, pmr->pcoarsec,
-                                  si-f1m, ei+f1p, sj-f2m, ej+f2p, sk-f3m, ek+f3p);
-  if (NSCALARS > 0) {
-    PassiveScalars *ps = pmb->pscalars;
-    pmb->peos->PassiveScalarConservedToPrimitive(ps->coarse_s_, ph->coarse_cons_,
-                                                 ps->coarse_r_, ps->coarse_r_,
-                                                 pmr->pcoarsec,
-                                                 si-f1m, ei+f1p, sj-f2m, ej+f2p,
-                                                 sk-f3m, ek+f3p);
-  }
-
-  if (nb.ni.ox1 == 0) {
+  constexpr int x1faces = (1 << BoundaryFace::inner_x1) | (1 << BoundaryFace::outer_x1);
+  constexpr int x2faces = (1 << BoundaryFace::inner_x2) | (1 << BoundaryFace::outer_x2);
+  constexpr int x3faces = (1 << BoundaryFace::inner_x3) | (1 << BoundaryFace::outer_x3);
+  if (faces & x1faces) {
     if (apply_bndry_fn_[BoundaryFace::inner_x1]) {
       DispatchBoundaryFunctions(pmb, pmr->pcoarsec, time, dt,
                                 pmb->cis, pmb->cie, sj, ej, sk, ek, 1,
@@ -466,7 +583,7 @@ void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
                                 bvars_subset);
     }
   }
-  if (nb.ni.ox2 == 0 && pmb->block_size.nx2 > 1) {
+  if (faces & x2faces) {
     if (apply_bndry_fn_[BoundaryFace::inner_x2]) {
       DispatchBoundaryFunctions(pmb, pmr->pcoarsec, time, dt,
                                 si, ei, pmb->cjs, pmb->cje, sk, ek, 1,
@@ -497,7 +614,7 @@ void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
       }
     }
   }
-  if (nb.ni.ox3 == 0 && pmb->block_size.nx3 > 1) {
+  if (faces & x3faces) {
     if (apply_bndry_fn_[BoundaryFace::inner_x3]) {
       DispatchBoundaryFunctions(pmb, pmr->pcoarsec, time, dt,
                                 si, ei, sj, ej, pmb->cks, pmb->cke, 1,
@@ -20,6 +20,7 @@
 #include "../athena_arrays.hpp"
 #include "../globals.hpp"
 #include "../mesh/mesh.hpp"
+#include "../utils/perf_counters.hpp"
 #include "bvals_interfaces.hpp"
 
 // MPI header
@@ -212,6 +213,7 @@ void BoundaryVariable::SetCompletedFlagSameProcess(NeighborBlock& nb) {
 void BoundaryVariable::SendBoundaryBuffers() {
   MeshBlock *pmb = pmy_block_;
   int mylevel = pmb->loc.level;
+  PerfCounters::Scope perf(PerfCounters::bval_pack, pmb->GetNumberOfMeshBlockCells());
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
     if (bd_var_.sflag[nb.bufid] == BoundaryStatus::completed) continue;
@@ -277,6 +279,7 @@ bool BoundaryVariable::ReceiveBoundaryBuffers() {
 void BoundaryVariable::SetBoundaries() {
   MeshBlock *pmb = pmy_block_;
   int mylevel = pmb->loc.level;
+  PerfCounters::Scope perf(PerfCounters::bval_unpack, pmb->GetNumberOfMeshBlockCells());
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
     if (nb.snb.level == mylevel)
@@ -646,7 +646,7 @@ void CellCenteredBoundaryVariable::SetupPersistentMPI() {
               *((nb.ni.ox2 == 0) ? ((pmb->block_size.nx2 + 1)/2) : NGHOST)
               *((nb.ni.ox3 == 0) ? ((pmb->block_size.nx3 + 1)/2) : NGHOST);
       }
-      ssize *= (nu_ + 1); rsize *= (nu_ + 1);
+      ssize = PackedBufferSize(ssize); rsize = PackedBufferSize(rsize);
       // specify the offsets in the view point of the target block: flip ox? signs
 
       // Initialize persistent communication requests attached to specific BoundaryData
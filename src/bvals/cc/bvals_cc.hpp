@@ -143,6 +143,9 @@ class CellCenteredBoundaryVariable : public BoundaryVariable {
   int nl_, nu_;
   const bool *flip_across_pole_;
 
+  //! number of Real words of a boundary message holding ncells cells of the variable
+  virtual int PackedBufferSize(int ncells) {return ncells*(nu_ + 1);}
+
   //! shearing box:
   //! working arrays of remapped quantities
   AthenaArray<Real>  shear_cc_[2];
@@ -27,7 +27,8 @@
 RadBoundaryVariable::RadBoundaryVariable(MeshBlock *pmb,
     AthenaArray<Real> *var_rad, AthenaArray<Real> *coarse_var,
     AthenaArray<Real> *var_flux) :
-    CellCenteredBoundaryVariable(pmb, var_rad, coarse_var, var_flux, true, 1) {
+    CellCenteredBoundaryVariable(pmb, var_rad, coarse_var, var_flux, true, 1),
+    format(IntensityFormat::real) {
     // the radiation array is (k,j,i,n)
     // the number of variables is GetDim1
     // All the other shared functions are initialized in CellCenteredBoundaryVariable
@@ -56,11 +57,8 @@ int RadBoundaryVariable::LoadBoundaryBufferSameLevel(Real *buf, const NeighborBl
   ej = (nb.ni.ox2 < 0) ? (pmb->js + NGHOST - 1) : pmb->je;
   sk = (nb.ni.ox3 > 0) ? (pmb->ke - NGHOST + 1) : pmb->ks;
   ek = (nb.ni.ox3 < 0) ? (pmb->ks + NGHOST - 1) : pmb->ke;
-  int p = 0;
   AthenaArray<Real> &var = *var_cc;
-  BufferUtility::PackData(var, buf, sk, ek, nl_, nu_, si, ei, sj, ej, p);
-
-  return p;
+  return PackIntensity(var, buf, si, ei, sj, ej, sk, ek);
 }
 
 //----------------------------------------------------------------------------------------
@@ -83,11 +81,9 @@ int RadBoundaryVariable::LoadBoundaryBufferToCoarser(Real *buf, const NeighborBl
   sk = (nb.ni.ox3 > 0) ? (pmb->cke - cn) : pmb->cks;
   ek = (nb.ni.ox3 < 0) ? (pmb->cks + cn) : pmb->cke;
 
-  int p = 0;
   // function overload to do restriction for radiation variabbles
   pmr->RestrictCellCenteredValues(var, coarse_var, -1, nl_, nu_, si, ei, sj, ej, sk, ek);
-  BufferUtility::PackData(coarse_var, buf, sk, ek, nl_, nu_, si, ei, sj, ej, p);
-  return p;
+  return PackIntensity(coarse_var, buf, si, ei, sj, ej, sk, ek);
 }
 
 
@@ -134,9 +130,78 @@ int RadBoundaryVariable::LoadBoundaryBufferToFiner(Real *buf, const NeighborBloc
     }
   }
 
+  return PackIntensity(var, buf, si, ei, sj, ej, sk, ek);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int RadBoundaryVariable::PackedBufferSize(int ncells)
+//  \brief number of Real words of a message holding ncells cells in the message format
+
+int RadBoundaryVariable::PackedBufferSize(int ncells) {
+  return IntensityFormatting::BufferSize(format, ncells, nu_ - nl_ + 1);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int RadBoundaryVariable::PackIntensity(AthenaArray<Real> &var, Real *buf,
+//                                  int si, int ei, int sj, int ej, int sk, int ek)
+//  \brief pack the intensities of the cells in (k,j,i) order into buf, and return the
+//  number of Real words used
+
+int RadBoundaryVariable::PackIntensity(AthenaArray<Real> &var, Real *buf,
+                                       int si, int ei, int sj, int ej, int sk, int ek) {
   int p = 0;
-  BufferUtility::PackData(var, buf, sk, ek, nl_, nu_, si, ei, sj, ej, p);
-  return p;
+  if (format == IntensityFormat::real) {
+    BufferUtility::PackData(var, buf, sk, ek, nl_, nu_, si, ei, sj, ej, p);
+    return p;
+  }
+  const int nvar = nu_ - nl_ + 1;
+  char *pbuf = reinterpret_cast<char *>(buf);
+  for (int k=sk; k<=ek; ++k) {
+    for (int j=sj; j<=ej; ++j) {
+      for (int i=si; i<=ei; ++i)
+        pbuf = IntensityFormatting::PackCell(format, &(var(k,j,i,nl_)), nvar, pbuf);
+    }
+  }
+  return PackedBufferSize((ek - sk + 1)*(ej - sj + 1)*(ei - si + 1));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RadBoundaryVariable::UnpackIntensity(Real *buf, AthenaArray<Real> &var,
+//                       int si, int ei, int sj, int ej, int sk, int ek, bool polar)
+//  \brief unpack a buffer written by PackIntensity(); across a pole the order of the
+//  cells in x2 is reversed
+
+void RadBoundaryVariable::UnpackIntensity(Real *buf, AthenaArray<Real> &var,
+                                          int si, int ei, int sj, int ej, int sk, int ek,
+                                          bool polar) {
+  int p = 0;
+  if (format == IntensityFormat::real) {
+    if (polar) {
+      for (int k=sk; k<=ek; ++k) {
+        for (int j=ej; j>=sj; --j) {
+          for (int i=si; i<=ei; ++i) {
+#pragma omp simd linear(p)
+            for (int n=nl_; n<=nu_; ++n) {
+              var(k,j,i,n) = buf[p++];
+            }
+          }
+        }
+      }
+    } else {
+      BufferUtility::UnpackData(buf, var, sk, ek, nl_, nu_, si, ei, sj, ej, p);
+    }
+    return;
+  }
+  const int nvar = nu_ - nl_ + 1;
+  const char *pbuf = reinterpret_cast<const char *>(buf);
+  for (int k=sk; k<=ek; ++k) {
+    for (int jj=sj; jj<=ej; ++jj) {
+      int j = polar ? (ej + sj - jj) : jj;
+      for (int i=si; i<=ei; ++i)
+        pbuf = IntensityFormatting::UnpackCell(format, pbuf, nvar, &(var(k,j,i,nl_)));
+    }
+  }
+  return;
 }
 
 //----------------------------------------------------------------------------------------
@@ -186,22 +251,8 @@ void RadBoundaryVariable::SetBoundarySameLevel(Real *buf,
   else if (nb.ni.ox3 > 0) sk = pmb->ke + 1,      ek = pmb->ke + NGHOST;
   else              sk = pmb->ks - NGHOST, ek = pmb->ks - 1;
 
-  int p = 0;
   // no need to flip for radiation
-  if (nb.polar) {
-    for (int k=sk; k<=ek; ++k) {
-      for (int j=ej; j>=sj; --j) {
-        for (int i=si; i<=ei; ++i) {
-#pragma omp simd linear(p)
-          for (int n=nl_; n<=nu_; ++n) {
-            var(k,j,i,n) = buf[p++];
-          }
-        }
-      }
-    }
-  } else {
-    BufferUtility::UnpackData(buf, var, sk, ek, nl_, nu_, si, ei, sj, ej, p);
-  }
+  UnpackIntensity(buf, var, si, ei, sj, ej, sk, ek, nb.polar);
   return;
 }
 
@@ -251,21 +302,7 @@ void RadBoundaryVariable::SetBoundaryFromCoarser(Real *buf,
     sk = pmb->cks - cng, ek = pmb->cks - 1;
   }
 
-  int p = 0;
-  if (nb.polar) {
-    for (int k=sk; k<=ek; ++k) {
-      for (int j=ej; j>=sj; --j) {
-        for (int i=si; i<=ei; ++i) {
-#pragma omp simd linear(p)
-          for (int n=nl_; n<=nu_; ++n) {
-            coarse_var(k,j,i,n) = buf[p++];
-          }
-        }
-      }
-    }
-  } else {
-    BufferUtility::UnpackData(buf, coarse_var, sk, ek, nl_, nu_, si, ei, sj, ej, p);
-  }
+  UnpackIntensity(buf, coarse_var, si, ei, sj, ej, sk, ek, nb.polar);
   return;
 }
 
@@ -323,23 +360,7 @@ void RadBoundaryVariable::SetBoundaryFromFiner(Real *buf, const NeighborBlock& n
     sk = pmb->ks - NGHOST, ek = pmb->ks - 1;
   }
 
-  int p = 0;
-  if (nb.polar) {
-//     Real sign=1.0;
-//      if (flip_across_pole_ != nullptr) sign = flip_across_pole_[n] ? -1.0 : 1.0;
-    for (int k=sk; k<=ek; ++k) {
-      for (int j=ej; j>=sj; --j) {
-        for (int i=si; i<=ei; ++i) {
-#pragma omp simd linear(p)
-          for (int n=nl_; n<=nu_; ++n) {
-            var(k,j,i,n) = buf[p++];
-          }
-        }
-      }
-    }
-  } else {
-    BufferUtility::UnpackData(buf, var,  sk, ek, nl_, nu_, si, ei, sj, ej, p);
-  }
+  UnpackIntensity(buf, var, si, ei, sj, ej, sk, ek, nb.polar);
   return;
 }
 
@@ -15,6 +15,7 @@
 // Athena++ headers
 #include "../../../athena.hpp"
 #include "../../../athena_arrays.hpp"
+#include "../../../nr_radiation/intensity_format.hpp"
 #include "../../../utils/buffer_utils.hpp"
 #include "../bvals_cc.hpp"
 
@@ -30,6 +31,9 @@ class RadBoundaryVariable : public CellCenteredBoundaryVariable {
                       AthenaArray<Real> *var_flux);
   virtual ~RadBoundaryVariable() = default;
 
+  // format of the intensities in the ghost-cell messages, set by NRRadiation
+  IntensityFormat format;
+
   // functions unique implementation to radiation class
   void SendFluxCorrection() override;
   bool ReceiveFluxCorrection() override;
@@ -115,9 +119,18 @@ class RadBoundaryVariable : public CellCenteredBoundaryVariable {
   void PolarWedgeOuterX2(Real time, Real dt,
                       int il, int iu, int jl, int ju, int ku, int ngh) override;
 
+ protected:
+  int PackedBufferSize(int ncells) override;
+
  private:
   AthenaArray<Real>  azimuthal_shift_rad_;
 
+  // pack/unpack the intensities of a range of cells in the message format
+  int PackIntensity(AthenaArray<Real> &var, Real *buf,
+                    int si, int ei, int sj, int ej, int sk, int ek);
+  void UnpackIntensity(Real *buf, AthenaArray<Real> &var,
+                       int si, int ei, int sj, int ej, int sk, int ek, bool polar);
+
   // override function for flux correction
   void SetFluxBoundaryFromFiner(Real *buf, const NeighborBlock& nb);
   void SetFluxBoundarySameLevel(Real *buf, const NeighborBlock& nb);
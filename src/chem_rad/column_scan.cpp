@@ -0,0 +1,212 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file column_scan.cpp
+//! \brief implementation of the parallel-prefix column density solver
+//!
+//! For each of the six ray directions, the blocks on a line of the root grid are ordered
+//! by their position p along the ray (p=0 is the block where the ray enters the
+//! domain). Each block contributes the total column through itself, T_p. The column
+//! entering block p is the exclusive prefix sum E_p = T_0 + ... + T_{p-1}, evaluated with
+//! the Hillis-Steele recursive doubling scan: at step s=1,2,4,... every block sends its
+//! running inclusive sum to the block s positions downstream and adds what it receives
+//! from s positions upstream. All six directions proceed in the same steps.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max
+#include <cstdint>    // int64_t
+#include <cstring>    // memcpy
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../globals.hpp"
+#include "../mesh/mesh.hpp"
+#include "chem_rad.hpp"
+#include "column_scan.hpp"
+#include "integrators/rad_integrators.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn ColumnDensityScan::ColumnDensityScan(Mesh *pm)
+//! \brief constructor, checks that the mesh is supported and sets up the communicator
+
+ColumnDensityScan::ColumnDensityScan(Mesh *pm) : pmy_mesh_(pm), nlen_(0), nbl_(0) {
+  if (pm->multilevel) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in ColumnDensityScan constructor" << std::endl
+        << "column_solver=scan only supports uniform meshes without refinement."
+        << std::endl << "Use column_solver=sweep instead." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  MeshBlock *pmb = pm->my_blocks(0);
+  const int nx1 = pmb->block_size.nx1;
+  const int nx2 = pmb->block_size.nx2;
+  const int nx3 = pmb->block_size.nx3;
+  nface_[BoundaryFace::inner_x1] = nface_[BoundaryFace::outer_x1] = nx2*nx3;
+  nface_[BoundaryFace::inner_x2] = nface_[BoundaryFace::outer_x2] = nx1*nx3;
+  nface_[BoundaryFace::inner_x3] = nface_[BoundaryFace::outer_x3] = nx1*nx2;
+  const int ncol = pmb->pchemrad->pchemradintegrator->ncol;
+  nlen_ = std::max(nx2*nx3, std::max(nx1*nx3, nx1*nx2))*ncol;
+#ifdef MPI_PARALLEL
+  MPI_Comm_dup(MPI_COMM_WORLD, &MPI_COMM_COLSCAN);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn ColumnDensityScan::~ColumnDensityScan()
+//! \brief destructor
+
+ColumnDensityScan::~ColumnDensityScan() {
+#ifdef MPI_PARALLEL
+  MPI_Comm_free(&MPI_COMM_COLSCAN);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ColumnDensityScan::AllocateBuffers()
+//! \brief rebuild the location->gid map and (re)allocate the face buffers if the number
+//!        of local blocks has changed, e.g. after load balancing
+
+void ColumnDensityScan::AllocateBuffers() {
+  Mesh *pm = pmy_mesh_;
+  const int nrb = pm->nrbx1*pm->nrbx2*pm->nrbx3;
+  gidmap_.assign(nrb, -1);
+  for (int gid=0; gid<pm->nbtotal; ++gid) {
+    const LogicalLocation &loc = pm->loclist[gid];
+    gidmap_[(loc.lx3*pm->nrbx2 + loc.lx2)*pm->nrbx1 + loc.lx1] = gid;
+  }
+  if (nbl_ != pm->nblocal) {
+    nbl_ = pm->nblocal;
+    excl_.NewAthenaArray(nbl_, 6, nlen_);
+    incl_.NewAthenaArray(nbl_, 6, nlen_);
+    recv_.NewAthenaArray(nbl_, 6, nlen_);
+#ifdef MPI_PARALLEL
+    req_.resize(12*nbl_);
+#endif
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int ColumnDensityScan::RayPosition(int dir, int gid) const
+//! \brief position of block gid along a ray travelling in direction dir
+
+int ColumnDensityScan::RayPosition(int dir, int gid) const {
+  const LogicalLocation &loc = pmy_mesh_->loclist[gid];
+  int lx, n;
+  if (dir/2 == 0) {
+    lx = static_cast<int>(loc.lx1); n = pmy_mesh_->nrbx1;
+  } else if (dir/2 == 1) {
+    lx = static_cast<int>(loc.lx2); n = pmy_mesh_->nrbx2;
+  } else {
+    lx = static_cast<int>(loc.lx3); n = pmy_mesh_->nrbx3;
+  }
+  return (dir%2 == 0) ? lx : n - 1 - lx;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int ColumnDensityScan::FindGid(int dir, int gid, int shift) const
+//! \brief gid of the block shift positions downstream (shift>0) or upstream (shift<0)
+//!        of block gid along direction dir
+
+int ColumnDensityScan::FindGid(int dir, int gid, int shift) const {
+  const LogicalLocation &loc = pmy_mesh_->loclist[gid];
+  std::int64_t lx[3] = {loc.lx1, loc.lx2, loc.lx3};
+  lx[dir/2] += (dir%2 == 0) ? shift : -shift;
+  return gidmap_[(lx[2]*pmy_mesh_->nrbx2 + lx[1])*pmy_mesh_->nrbx1 + lx[0]];
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ColumnDensityScan::Execute()
+//! \brief add the column entering each local block to its block-local partial columns.
+//!        ChemRadIntegrator::GetColMB must have been called for all directions first.
+
+void ColumnDensityScan::Execute() {
+  Mesh *pm = pmy_mesh_;
+  AllocateBuffers();
+  const int nb = pm->nblocal;
+  const int nrbx[3] = {pm->nrbx1, pm->nrbx2, pm->nrbx3};
+  const int nrbmax = std::max(nrbx[0], std::max(nrbx[1], nrbx[2]));
+  const int gids = pm->nslist[Globals::my_rank];
+
+  // total column through each block starts the inclusive sum
+  for (int b=0; b<nb; ++b) {
+    ChemRadIntegrator *pri = pm->my_blocks(b)->pchemrad->pchemradintegrator;
+    for (int dir=0; dir<6; ++dir) {
+      pri->GetColBlockTotal(static_cast<BoundaryFace>(dir), &incl_(b, dir, 0));
+      for (int n=0; n<nlen_; ++n)
+        excl_(b, dir, n) = 0.0;
+    }
+  }
+
+  for (int s=1; s<nrbmax; s*=2) {
+#ifdef MPI_PARALLEL
+    int nreq = 0;
+    // post receives from blocks s positions upstream
+    for (int b=0; b<nb; ++b) {
+      for (int dir=0; dir<6; ++dir) {
+        if (s >= nrbx[dir/2] || RayPosition(dir, gids+b) < s) continue;
+        int src = pm->ranklist[FindGid(dir, gids+b, -s)];
+        if (src == Globals::my_rank) continue;
+        MPI_Irecv(&recv_(b, dir, 0), nface_[dir]*pm->my_blocks(b)->pchemrad
+                  ->pchemradintegrator->ncol, MPI_ATHENA_REAL, src, b*6+dir,
+                  MPI_COMM_COLSCAN, &req_[nreq++]);
+      }
+    }
+#endif
+    // send the inclusive sums s positions downstream
+    for (int b=0; b<nb; ++b) {
+      const int ncol = pm->my_blocks(b)->pchemrad->pchemradintegrator->ncol;
+      for (int dir=0; dir<6; ++dir) {
+        if (s >= nrbx[dir/2] || RayPosition(dir, gids+b) + s >= nrbx[dir/2]) continue;
+        int dgid = FindGid(dir, gids+b, s);
+        int drank = pm->ranklist[dgid];
+        if (drank == Globals::my_rank) {
+          std::memcpy(&recv_(dgid-gids, dir, 0), &incl_(b, dir, 0),
+                      nface_[dir]*ncol*sizeof(Real));
+#ifdef MPI_PARALLEL
+        } else {
+          MPI_Isend(&incl_(b, dir, 0), nface_[dir]*ncol, MPI_ATHENA_REAL, drank,
+                    (dgid-pm->nslist[drank])*6+dir, MPI_COMM_COLSCAN, &req_[nreq++]);
+#endif
+        }
+      }
+    }
+#ifdef MPI_PARALLEL
+    MPI_Waitall(nreq, req_.data(), MPI_STATUSES_IGNORE);
+#endif
+    // accumulate what arrived from upstream
+    for (int b=0; b<nb; ++b) {
+      const int ncol = pm->my_blocks(b)->pchemrad->pchemradintegrator->ncol;
+      for (int dir=0; dir<6; ++dir) {
+        if (s >= nrbx[dir/2] || RayPosition(dir, gids+b) < s) continue;
+        const int len = nface_[dir]*ncol;
+#pragma omp simd
+        for (int n=0; n<len; ++n) {
+          excl_(b, dir, n) += recv_(b, dir, n);
+          incl_(b, dir, n) += recv_(b, dir, n);
+        }
+      }
+    }
+  }
+
+  // blocks at the start of a ray have nothing incoming
+  for (int b=0; b<nb; ++b) {
+    ChemRadIntegrator *pri = pm->my_blocks(b)->pchemrad->pchemradintegrator;
+    for (int dir=0; dir<6; ++dir) {
+      if (RayPosition(dir, gids+b) > 0)
+        pri->AddIncomingCol(static_cast<BoundaryFace>(dir), &excl_(b, dir, 0));
+    }
+  }
+  return;
+}
@@ -0,0 +1,62 @@
+#ifndef CHEM_RAD_COLUMN_SCAN_HPP_
+#define CHEM_RAD_COLUMN_SCAN_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file column_scan.hpp
+//! \brief definitions for ColumnDensityScan class, a parallel-prefix column density
+//!        solver for the six-ray radiation integrator
+
+// C headers
+
+// C++ headers
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+class Mesh;
+
+//! \class ColumnDensityScan
+//! \brief Combines the block-local partial column densities along each of the six ray
+//!        directions with an exclusive prefix scan over the MeshBlocks of a ray.
+//!
+//! Replaces the block-to-block sweep of SixRayBoundaryVariable: every block first
+//! computes its partial columns (ChemRadIntegrator::GetColMB), then the column entering
+//! each block is obtained in ceil(log2(nrbx)) recursive-doubling steps instead of nrbx
+//! serial boundary exchanges. Only uniform (single-level) meshes are supported.
+
+class ColumnDensityScan {
+ public:
+  explicit ColumnDensityScan(Mesh *pm);
+  ~ColumnDensityScan();
+
+  void Execute();
+
+ private:
+  Mesh *pmy_mesh_;
+  int nface_[6];             // number of face cells perpendicular to each direction
+  int nlen_;                 // length of a face buffer: max(nface_)*ncol
+  int nbl_;                  // number of local blocks the buffers were allocated for
+  AthenaArray<Real> excl_;   // exclusive prefix (incoming column) per block/direction
+  AthenaArray<Real> incl_;   // inclusive prefix sent downstream
+  AthenaArray<Real> recv_;   // receive buffer
+  std::vector<int> gidmap_;  // root-grid logical location -> gid
+#ifdef MPI_PARALLEL
+  MPI_Comm MPI_COMM_COLSCAN;
+  std::vector<MPI_Request> req_;
+#endif
+
+  void AllocateBuffers();
+  int FindGid(int dir, int gid, int shift) const;
+  int RayPosition(int dir, int gid) const;
+};
+
+#endif // CHEM_RAD_COLUMN_SCAN_HPP_
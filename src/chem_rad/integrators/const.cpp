@@ -70,3 +70,5 @@ void ChemRadIntegrator::UpdateRadiation() {}
 
 void ChemRadIntegrator::GetColMB(BoundaryFace direction) {}
 void ChemRadIntegrator::UpdateCol(BoundaryFace direction) {}
+void ChemRadIntegrator::GetColBlockTotal(BoundaryFace direction, Real *tot) {}
+void ChemRadIntegrator::AddIncomingCol(BoundaryFace direction, const Real *in) {}
@@ -43,7 +43,14 @@ class ChemRadIntegrator {
 
   void UpdateRadiation();
 
+  // block-local total columns and incoming columns, for the prefix-scan solver
+  void GetColBlockTotal(BoundaryFace direction, Real *tot);
+  void AddIncomingCol(BoundaryFace direction, const Real *in);
+
  private:
+  // scratch arrays for batched evaluation of the shielding functions
+  AthenaArray<Real> nh_, nh2_, nco_, nc_, fs_h2_, fs_co_, fs_c_;
+
   // calculate column densities within the meshblock, for six_ray
   void GetColMB(BoundaryFace direction);
   // update column density after boundary is received
@@ -75,6 +75,13 @@ ChemRadIntegrator::ChemRadIntegrator(ChemRadiation *pchemrad, ParameterInput *pi
       col_CO.NewAthenaArray(6, pmy_mb->ncells3, pmy_mb->ncells2, pmy_mb->ncells1);
       col_C.NewAthenaArray(6, pmy_mb->ncells3, pmy_mb->ncells2, pmy_mb->ncells1);
     }
+    nh_.NewAthenaArray(pmy_mb->ncells1);
+    nh2_.NewAthenaArray(pmy_mb->ncells1);
+    nco_.NewAthenaArray(pmy_mb->ncells1);
+    nc_.NewAthenaArray(pmy_mb->ncells1);
+    fs_h2_.NewAthenaArray(pmy_mb->ncells1);
+    fs_co_.NewAthenaArray(pmy_mb->ncells1);
+    fs_c_.NewAthenaArray(pmy_mb->ncells1);
   }
 }
 
@@ -159,32 +166,38 @@ void ChemRadIntegrator::UpdateRadiation() {
   const int iCR = pmy_chemnet->index_cr_;
   const Real sigmaPE = Thermo::sigmaPE_;
   const Real NH0_CR = 9.35e20;
-  Real NH, AV, NCO, NC, NH2, fs_CO, fs_H2, fs_CI;
+  const int is = pmy_mb->is, ie = pmy_mb->ie;
+  const int n = ie - is + 1;
+  Real NH, AV;
   for (int direction=0; direction < 6; direction++) {
     int iang = direction;
     for (int k=pmy_mb->ks; k<=pmy_mb->ke; ++k) {
       for (int j=pmy_mb->js; j<=pmy_mb->je; ++j) {
-        for (int i=pmy_mb->is; i<=pmy_mb->ie; ++i) {
-          NH = col(direction, k, j, i, pmy_chemnet->iNHtot_);
-          NH2 = col(direction, k, j, i,  pmy_chemnet->iNH2_);
-          NCO = col(direction, k, j, i,  pmy_chemnet->iNCO_);
-          NC = col(direction, k, j, i,  pmy_chemnet->iNC_);
+        // gather the columns of one pencil so the shielding functions run in a batch
+        for (int i=is; i<=ie; ++i) {
+          nh_(i) = col(direction, k, j, i, pmy_chemnet->iNHtot_);
+          nh2_(i) = col(direction, k, j, i,  pmy_chemnet->iNH2_);
+          nco_(i) = col(direction, k, j, i,  pmy_chemnet->iNCO_);
+          nc_(i) = col(direction, k, j, i,  pmy_chemnet->iNC_);
+        }
+        // H2, CO and CI self-shielding
+        Shielding::fShield_CO_V09_Batch(n, &nco_(is), &nh2_(is), &fs_co_(is));
+        Shielding::fShield_H2_Batch(n, &nh2_(is), bH2, &fs_h2_(is));
+        Shielding::fShield_C_Batch(n, &nc_(is), &nh2_(is), &fs_c_(is));
+        for (int i=is; i<=ie; ++i) {
+          NH = nh_(i);
           AV = NH * Zd / 1.87e21;
           // photo-reactions
           for (int ifreq=0; ifreq < pmy_rad->nfreq-2; ++ifreq) {
             pmy_rad->ir(k, j, i, ifreq * pmy_rad->nang+iang) = G0_iang(iang)
               * std::exp( -ChemNetwork::kph_avfac_[ifreq] * AV );
           }
-          // H2, CO and CI self-shielding
-          fs_CO = Shielding::fShield_CO_V09(NCO, NH2);
-          fs_H2 = Shielding::fShield_H2(NH2, bH2);
-          fs_CI = Shielding::fShield_C(NC, NH2);
           pmy_rad->ir(k, j, i, iph_H2 * pmy_rad->nang+iang) *=
-            fs_H2;
+            fs_h2_(i);
           pmy_rad->ir(k, j, i, iph_CO * pmy_rad->nang+iang) *=
-            fs_CO;
+            fs_co_(i);
           pmy_rad->ir(k, j, i, iph_C * pmy_rad->nang+iang) *=
-            fs_CI;
+            fs_c_(i);
           // GPE
           pmy_rad->ir(k, j, i, iPE * pmy_rad->nang+iang) = G0_iang(iang)
             *  std::exp(-NH * sigmaPE * Zd);
@@ -205,6 +218,105 @@ void ChemRadIntegrator::UpdateRadiation() {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void ChemRadIntegrator::GetColBlockTotal(BoundaryFace direction, Real *tot)
+//! \brief total column through the meshblock along direction for each face cell,
+//!        i.e. the column the next block downstream receives. GetColMB must be called
+//!        first. tot has ncol entries per face cell; untracked columns are set to zero.
+
+void ChemRadIntegrator::GetColBlockTotal(BoundaryFace direction, Real *tot) {
+  const int iH2 = pmy_chemnet->iH2_;
+  const int iCO = pmy_chemnet->iCO_;
+  const int iCplus = pmy_chemnet->iCplus_;
+  const int iHCOplus = pmy_chemnet->iHCOplus_;
+  const int iCHx = pmy_chemnet->iCHx_;
+  const Real xCtot =  pmy_chemnet->xC_;
+  const int is = pmy_mb->is, ie = pmy_mb->ie;
+  const int js = pmy_mb->js, je = pmy_mb->je;
+  const int ks = pmy_mb->ks, ke = pmy_mb->ke;
+  const int nx1 = ie - is + 1, nx2 = je - js + 1;
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie; ++i) {
+        // only the last cell along the ray contributes
+        int f, il = i, jl = j, kl = k;
+        Real dx;
+        if (direction == BoundaryFace::inner_x1 || direction == BoundaryFace::outer_x1) {
+          if (i != is) continue;
+          il = (direction == BoundaryFace::inner_x1) ? ie : is;
+          f = (k-ks)*nx2 + (j-js);
+          dx = pmy_mb->pcoord->dx1f(il);
+        } else if (direction == BoundaryFace::inner_x2
+                   || direction == BoundaryFace::outer_x2) {
+          if (j != js) continue;
+          jl = (direction == BoundaryFace::inner_x2) ? je : js;
+          f = (k-ks)*nx1 + (i-is);
+          dx = pmy_mb->pcoord->dx2f(jl);
+        } else {
+          if (k != ks) continue;
+          kl = (direction == BoundaryFace::inner_x3) ? ke : ks;
+          f = (j-js)*nx1 + (i-is);
+          dx = pmy_mb->pcoord->dx3f(kl);
+        }
+        Real *t = tot + f*ncol;
+        for (int icol=0; icol<ncol; ++icol) {
+          t[icol] = 0.;
+        }
+        const Real NH_last = lunit * pmy_mb->phydro->w(IDN, kl, jl, il) * dx * f_prev;
+        Real xCI = xCtot - pmy_mb->pscalars->r(iCO, kl, jl, il)
+                   - pmy_mb->pscalars->r(iCplus, kl, jl, il)
+                   - pmy_mb->pscalars->r(iHCOplus, kl, jl, il)
+                   - pmy_mb->pscalars->r(iCHx, kl, jl, il);
+        if (xCI < 0.0) {
+          xCI = 0.;
+        }
+        t[pmy_chemnet->iNHtot_] = col(direction, kl, jl, il, pmy_chemnet->iNHtot_)
+                                  + NH_last;
+        t[pmy_chemnet->iNH2_] = col(direction, kl, jl, il, pmy_chemnet->iNH2_)
+                                + pmy_mb->pscalars->r(iH2, kl, jl, il) * NH_last;
+        t[pmy_chemnet->iNCO_] = col(direction, kl, jl, il, pmy_chemnet->iNCO_)
+                                + pmy_mb->pscalars->r(iCO, kl, jl, il) * NH_last;
+        t[pmy_chemnet->iNC_] = col(direction, kl, jl, il, pmy_chemnet->iNC_)
+                               + xCI * NH_last;
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ChemRadIntegrator::AddIncomingCol(BoundaryFace direction, const Real *in)
+//! \brief add the column entering the meshblock (same layout as GetColBlockTotal) to
+//!        every cell along direction
+
+void ChemRadIntegrator::AddIncomingCol(BoundaryFace direction, const Real *in) {
+  const int is = pmy_mb->is, ie = pmy_mb->ie;
+  const int js = pmy_mb->js, je = pmy_mb->je;
+  const int ks = pmy_mb->ks, ke = pmy_mb->ke;
+  const int nx1 = ie - is + 1, nx2 = je - js + 1;
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie; ++i) {
+        int f;
+        if (direction == BoundaryFace::inner_x1 || direction == BoundaryFace::outer_x1) {
+          f = (k-ks)*nx2 + (j-js);
+        } else if (direction == BoundaryFace::inner_x2
+                   || direction == BoundaryFace::outer_x2) {
+          f = (k-ks)*nx1 + (i-is);
+        } else {
+          f = (j-js)*nx1 + (i-is);
+        }
+        const Real *c = in + f*ncol;
+        col(direction, k, j, i, pmy_chemnet->iNHtot_) += c[pmy_chemnet->iNHtot_];
+        col(direction, k, j, i, pmy_chemnet->iNH2_) += c[pmy_chemnet->iNH2_];
+        col(direction, k, j, i, pmy_chemnet->iNCO_) += c[pmy_chemnet->iNCO_];
+        col(direction, k, j, i, pmy_chemnet->iNC_) += c[pmy_chemnet->iNC_];
+      }
+    }
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void GetColMB(BoundaryFace direction)
 //! \brief calculate column densities within the meshblock
@@ -425,3 +425,52 @@ Real Shielding::fShield_CO_C(const Real NC) {
     return std::exp(-1.6e-17*NC);
   }
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void Shielding::fShield_CO_V09_Batch(const int n, const Real *NCO,
+//!                                           const Real *NH2, Real *fs)
+//! \brief fShield_CO_V09 for n cells. The table lookup does not vectorize, but batching
+//! keeps the table in cache across a pencil.
+void Shielding::fShield_CO_V09_Batch(const int n, const Real *NCO, const Real *NH2,
+                                     Real *fs) {
+  for (int i=0; i<n; ++i) {
+    fs[i] = fShield_CO_V09(NCO[i], NH2[i]);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Shielding::fShield_H2_Batch(const int n, const Real *NH2, const Real bH2,
+//!                                       Real *fs)
+//! \brief fShield_H2 for n cells, written without branches so the loop vectorizes
+void Shielding::fShield_H2_Batch(const int n, const Real *NH2, const Real bH2,
+                                 Real *fs) {
+  const Real N_small_ = 10.;
+  const Real b5 = bH2 / 1.0e5;
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    const Real x = NH2[i] / 5.0e14;
+    const Real p1 = 0.965 / ( (1.+x/b5) * (1.+x/b5) );
+    const Real term = std::sqrt(1. + x);
+    const Real p2 = 0.035/term * std::exp(-8.5e-4*term);
+    fs[i] = (NH2[i] < N_small_) ? 1. : p1 + p2;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Shielding::fShield_C_Batch(const int n, const Real *NC, const Real *NH2,
+//!                                      Real *fs)
+//! \brief fShield_C for n cells, written without branches so the loop vectorizes
+void Shielding::fShield_C_Batch(const int n, const Real *NC, const Real *NH2,
+                                Real *fs) {
+  const Real AH2 = 1.17e-8;
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    const Real NCi = (NC[i] < 0) ? 0. : NC[i];
+    const Real NH2i = (NH2[i] < 0) ? 0. : NH2[i];
+    const Real y = AH2 * 1.2e-14 * 2 * NH2i;
+    fs[i] = std::exp(-1.6e-17*NCi) * std::exp(-y) / (1. + y);
+  }
+  return;
+}
@@ -24,6 +24,11 @@ class Shielding {
   static Real fShield_H2(const Real NH2, const Real bH2);
   static Real fShield_C(const Real NC, const Real NH2);
   static Real fShield_CO_C(const Real NC);
+  // batched versions over n cells, used by the six-ray integrator
+  static void fShield_CO_V09_Batch(const int n, const Real *NCO, const Real *NH2,
+                                   Real *fs);
+  static void fShield_H2_Batch(const int n, const Real *NH2, const Real bH2, Real *fs);
+  static void fShield_C_Batch(const int n, const Real *NC, const Real *NH2, Real *fs);
 
  private:
   //CO column density for DB table
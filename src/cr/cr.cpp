@@ -242,9 +242,17 @@ CosmicRay::CosmicRay(MeshBlock *pmb, ParameterInput *pin):
     refinement_idx = pmy_block->pmr->AddToRefinement(&u_cr, &coarse_cr_);
   }
   cr_source_defined = false;
+  sum_diff = 0.0;
+  sum_full = 0.0;
   cr_bvar.bvar_index = pmb->pbval->bvars.size();
   pmb->pbval->bvars.push_back(&cr_bvar);
-  pmb->pbval->bvars_main_int.push_back(&cr_bvar);
+  // the implicit cosmic rays exchange their ghost zones during the iterations
+  if (pm->pimcr == nullptr) {
+    pmb->pbval->bvars_main_int.push_back(&cr_bvar);
+  } else {
+    u_cr2.NewAthenaArray(NCR,pmb->ncells3,pmb->ncells2,pmb->ncells1);
+    u_cr_old.NewAthenaArray(NCR,pmb->ncells3,pmb->ncells2,pmb->ncells1);
+  }
 
   vmax = pin->GetOrAddReal("cr", "vmax", 1.0);
   vlim = pin->GetOrAddReal("cr", "vlim", 0.9);
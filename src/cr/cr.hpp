@@ -29,12 +29,17 @@ enum {CRE=0, CRF1=1, CRF2=2, CRF3=3};
 class CosmicRay {
   friend class CRIntegrator;
   friend class BoundaryValues;
+  friend class IMCosmicRay;
  public:
   CosmicRay(MeshBlock *pmb, ParameterInput *pin);
   //  ~CosmicRay();
 
   MeshBlock* pmy_block;    // ptr to MeshBlock containing this Fluid
   AthenaArray<Real> u_cr, u_cr1, u_cr2; //cosmic ray energy density and flux
+  // implicit transport: u_cr2 is the right hand side of the stage and
+  // u_cr_old the previous iterate
+  AthenaArray<Real> u_cr_old;
+  Real sum_diff, sum_full; // residual of the last iteration
   AthenaArray<Real> coarse_cr_;
 
   //   diffusion coefficients for both normal diffusion term, and advection term
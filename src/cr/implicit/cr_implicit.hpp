@@ -0,0 +1,48 @@
+#ifndef CR_IMPLICIT_CR_IMPLICIT_HPP_
+#define CR_IMPLICIT_CR_IMPLICIT_HPP_
+//======================================================================================
+// Athena++ astrophysical MHD code
+// Copyright (C) 2014 James M. Stone  <jmstone@princeton.edu>
+// See LICENSE file for full public license information.
+//======================================================================================
+//! \file cr_implicit.hpp
+//  \brief implicit cosmic ray transport class definitions
+//======================================================================================
+
+// C++ headers
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../task_list/im_cr_task_list.hpp"
+
+class Mesh;
+class MeshBlock;
+class ParameterInput;
+class TimeIntegratorTaskList;
+
+//! \class IMCosmicRay
+//  \brief iterative implicit solve of the cosmic ray transport and source terms.
+//  Enabled with <cr> integrator = implicit, in which case the cosmic rays are removed
+//  from the main task list and the time step is no longer limited by vmax.
+
+class IMCosmicRay {
+ public:
+  IMCosmicRay(Mesh *pm, ParameterInput *pin);
+  ~IMCosmicRay();
+
+  void Iteration(Mesh *pm, TimeIntegratorTaskList *ptlist, int stage);
+  void CheckResidual(MeshBlock *pmb,
+        AthenaArray<Real> &ucr_old, AthenaArray<Real> &ucr_new);
+
+  IMCRITTaskList *pimcritlist;
+  IMCRHydroTaskList *pimcrhylist;
+
+ private:
+  Real sum_diff_;
+  Real sum_full_;
+  int nlimit_;       // threadhold for the number of iterations
+  Real error_limit_;
+};
+
+#endif // CR_IMPLICIT_CR_IMPLICIT_HPP_
@@ -0,0 +1,153 @@
+//======================================================================================
+// Athena++ astrophysical MHD code
+// Copyright (C) 2014 James M. Stone  <jmstone@princeton.edu>
+//
+// This program is free software: you can redistribute and/or modify it under the terms
+// of the GNU General Public License (GPL) as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+//
+// You should have received a copy of GNU GPL in the file LICENSE included in the code
+// distribution.  If not see <http://www.gnu.org/licenses/>.
+//======================================================================================
+//! \file cr_iteration.cpp
+//  \brief iterations to solve the cosmic ray transport implicitly
+//======================================================================================
+
+// C headers
+
+// C++ headers
+#include <cmath>      // abs
+#include <iostream>   // cout
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../field/field.hpp"
+#include "../../globals.hpp"
+#include "../../hydro/hydro.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../parameter_input.hpp"
+#include "../../task_list/task_list.hpp"
+#include "../cr.hpp"
+#include "../integrators/cr_integrators.hpp"
+#include "cr_implicit.hpp"
+
+// MPI header
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+IMCosmicRay::IMCosmicRay(Mesh *pm, ParameterInput *pin) {
+  nlimit_ = pin->GetOrAddInteger("cr","nlimit",100);
+  error_limit_ = pin->GetOrAddReal("cr","error_limit",1.e-6);
+  sum_diff_ = 0.0;
+  sum_full_ = 0.0;
+
+  if (pm->shear_periodic) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in IMCosmicRay constructor" << std::endl
+        << "integrator=implicit in <cr> does not work with shear periodic boundary."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  pimcritlist = new IMCRITTaskList(pm);
+  pimcrhylist = new IMCRHydroTaskList(pm);
+}
+
+IMCosmicRay::~IMCosmicRay() {
+  delete pimcritlist;
+  delete pimcrhylist;
+}
+
+//--------------------------------------------------------------------------------------
+// \!fn void Iteration()
+// \brief Jacobi iterations of the cosmic ray flux and source terms of one stage
+
+void IMCosmicRay::Iteration(Mesh *pm, TimeIntegratorTaskList *ptlist, int stage) {
+  if (stage > ptlist->nstages) return;
+  const Real wght = ptlist->stage_wghts[stage-1].beta*pm->dt;
+
+  // every stage advances the state at the beginning of the step by wght
+  for (int nb=0; nb<pm->nblocal; ++nb) {
+    MeshBlock *pmb = pm->my_blocks(nb);
+    CosmicRay *pcr = pmb->pcr;
+    Hydro *ph = pmb->phydro;
+    Field *pf = pmb->pfield;
+    if (stage == 1)
+      pcr->u_cr1 = pcr->u_cr;
+    // right hand side of the stage, with the user source terms applied explicitly
+    pcr->u_cr2 = pcr->u_cr1;
+    if (pcr->cr_source_defined)
+      pcr->UserSourceTerm_(pmb, pm->time, wght, ph->w, pf->b, pcr->u_cr2);
+
+    // diffusion speeds, streaming and the explicit source terms from the current state,
+    // which fix the coefficients of the iterations
+    pcr->pcrintegrator->CalculateFluxes(ph->w, pf->bcc, pcr->u_cr, 1);
+    pcr->pcrintegrator->FirstOrderFluxDivergenceCoef(ph->w);
+    pcr->u_cr_old = pcr->u_cr;
+  }
+
+  int niter = 0;
+  bool iteration = true;
+  while (iteration) {
+    sum_full_ = 0.0;
+    sum_diff_ = 0.0;
+    pimcritlist->DoTaskListOneStage(wght);
+
+    for (int nb=0; nb<pm->nblocal; ++nb) {
+      CosmicRay *pcr = pm->my_blocks(nb)->pcr;
+      pcr->u_cr_old = pcr->u_cr;
+      sum_full_ += pcr->sum_full;
+      sum_diff_ += pcr->sum_diff;
+    }
+
+#ifdef MPI_PARALLEL
+    Real global_sum = 0.0;
+    Real global_diff = 0.0;
+    MPI_Allreduce(&sum_full_, &global_sum, 1, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&sum_diff_, &global_diff, 1, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
+    sum_full_ = global_sum;
+    sum_diff_ = global_diff;
+#endif
+
+    niter++;
+    Real tot_res = sum_diff_/sum_full_;
+    if ((niter > nlimit_) || tot_res < error_limit_)
+      iteration = false;
+  }
+
+  if (Globals::my_rank == 0) {
+    if ((pm->ncycle_out != 0) && (pm->ncycle%pm->ncycle_out == 0))
+      std::cout << "CR iteration stops at niter: " << niter
+                << " relative error: " << sum_diff_/sum_full_ << std::endl;
+  }
+
+  // add the source terms to the gas, update the gas boundaries and the opacity
+  pimcrhylist->DoTaskListOneStage(wght);
+}
+
+void IMCosmicRay::CheckResidual(MeshBlock *pmb,
+                                AthenaArray<Real> &ucr_old, AthenaArray<Real> &ucr_new) {
+  CosmicRay *pcr = pmb->pcr;
+  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
+  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
+
+  pcr->sum_diff = 0.0;
+  pcr->sum_full = 0.0;
+  for (int n=0; n<NCR; ++n) {
+    for (int k=ks; k<=ke; ++k) {
+      for (int j=js; j<=je; ++j) {
+        for (int i=is; i<=ie; ++i) {
+          pcr->sum_diff += std::abs(ucr_old(n,k,j,i) - ucr_new(n,k,j,i));
+          pcr->sum_full += std::abs(ucr_new(n,k,j,i));
+        }
+      }
+    }
+  }
+}
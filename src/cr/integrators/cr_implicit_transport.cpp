@@ -0,0 +1,364 @@
+//======================================================================================
+// Athena++ astrophysical MHD code
+// Copyright (C) 2014 James M. Stone  <jmstone@princeton.edu>
+//
+// This program is free software: you can redistribute and/or modify it under the terms
+// of the GNU General Public License (GPL) as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+//
+// You should have received a copy of GNU GPL in the file LICENSE included in the code
+// distribution.  If not see <http://www.gnu.org/licenses/>.
+//======================================================================================
+//! \file cr_implicit_transport.cpp
+//  \brief Jacobi iteration of the implicit cosmic ray transport
+//
+//  Each stage solves U = U_ini - wght*div(F(U)) + wght*S(U) with the first order HLLE
+//  fluxes of CRFlux(), whose signal speeds are frozen at the beginning of the stage, and
+//  the source terms of AddSourceTerms(). For fixed signal speeds the flux is linear,
+//  F = a*F(U_L) + b*F(U_R), and the terms of a cell on itself keep the matrix of the
+//  local source solve: a multiple of the identity plus couplings of Ec with each Fc.
+//  Every iteration solves this local system with the neighbors from the last iterate.
+//
+//  The neighbor fluxes depend on the Ec of the cell itself through the neighbor Fc, so
+//  that plain Jacobi iterations only converge for D*dt/dx^2 < 1 in the diffusive limit.
+//  The update is therefore damped by omega = 1/(1+r), with r the local estimate of that
+//  ratio, which converges with a rate sqrt(r/(1+r)) for any time step.
+//======================================================================================
+
+// C headers
+
+// C++ headers
+#include <algorithm>   // min,max
+#include <cmath>       // sqrt
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../eos/eos.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../utils/utils.hpp"
+#include "../cr.hpp"
+
+// class header
+#include "cr_integrators.hpp"
+
+namespace {
+
+//! HLLE weights of the first order flux at one face, as in CRIntegrator::CRFlux()
+void HLLEWeights(const Real vmax, const Real vl, const Real vr,
+                 const Real vdiffl, const Real vdiffr, Real *coef) {
+  Real meanadv = 0.5*(vl + vr);
+  Real meandiffv = 0.5*(vdiffl + vdiffr);
+  Real al = std::min((meanadv - meandiffv),(vl - vdiffl));
+  Real ar = std::max((meanadv + meandiffv),(vr + vdiffr));
+  ar = std::min(ar,vmax*std::sqrt(1.0/3.0));
+  al = std::max(al,-vmax*std::sqrt(1.0/3.0));
+  Real bp = ar > 0.0 ? ar : 0.0;
+  Real bm = al < 0.0 ? al : 0.0;
+  Real tmp = 0.0;
+  if (std::abs(bm-bp) > TINY_NUMBER)
+    tmp = 0.5*(bp + bm)/(bp - bm);
+  coef[0] = 0.5 + tmp;
+  coef[1] = (0.5 + tmp)*bm;
+  coef[2] = 0.5 - tmp;
+  coef[3] = (0.5 - tmp)*bp;
+}
+
+//! terms of the two faces of one cell along direction d, with the weights cfp, cfm of
+//! the faces and the neighbor states up, um, multiplied with cp, cm = wght*area/vol
+void FaceTerms(const int d, const Real vmax, const Real cp, const Real cm,
+               const Real *cfp, const Real *cfm, const Real *up, const Real *um,
+               Real &diag, Real &coup, Real &wnb, Real *nb) {
+  const Real edd = 1.0/3.0;
+  diag += cm*cfm[3] - cp*cfp[1];
+  coup = cp*cfp[0] - cm*cfm[2];
+  wnb = cp*cfp[2] + cm*cfm[0];
+  for (int n=0; n<NCR; ++n)
+    nb[n] += cm*cfm[1]*um[n] - cp*cfp[3]*up[n];
+  nb[CRE] += vmax*(cp*cfp[2]*up[CRF1+d] - cm*cfm[0]*um[CRF1+d]);
+  nb[CRF1+d] += vmax*edd*(cp*cfp[2]*up[CRE] - cm*cfm[0]*um[CRE]);
+}
+
+//! matrix of the implicit source terms of one cell in the frame along B, as in
+//! CRIntegrator::AddSourceTerms(): a11 on Ec, a1n of Ec on Fc_n, an1 of Fc_n on Ec and
+//! the diagonal ann of Fc_n
+void SourceMatrix(CosmicRay *pcr, const Real dt, const Real rho_floor,
+                  AthenaArray<Real> &u, const int k, const int j, const int i,
+                  Real &a11, Real *a1n, Real *an1, Real *ann) {
+  Real vlim = pcr->vmax;
+  Real invlim = 1.0/vlim;
+  Real rho = std::max(u(IDN,k,j,i),rho_floor);
+  Real v1 = u(IM1,k,j,i)/rho;
+  Real v2 = u(IM2,k,j,i)/rho;
+  Real v3 = u(IM3,k,j,i)/rho;
+  Real vtot1 = v1;
+  Real vtot2 = v2;
+  Real vtot3 = v3;
+  if (pcr->stream_flag) {
+    vtot1 += pcr->v_adv(0,k,j,i);
+    vtot2 += pcr->v_adv(1,k,j,i);
+    vtot3 += pcr->v_adv(2,k,j,i);
+  }
+  if (MAGNETIC_FIELDS_ENABLED) {
+    Real sint_b = pcr->b_angle(0,k,j,i), cost_b = pcr->b_angle(1,k,j,i);
+    Real sinp_b = pcr->b_angle(2,k,j,i), cosp_b = pcr->b_angle(3,k,j,i);
+    RotateVec(sint_b,cost_b,sinp_b,cosp_b,v1,v2,v3);
+    RotateVec(sint_b,cost_b,sinp_b,cosp_b,vtot1,vtot2,vtot3);
+    vtot2 = 0.0;
+    vtot3 = 0.0;
+  }
+  Real sigma[3], v[3] = {v1, v2, v3}, vtot[3] = {vtot1, vtot2, vtot3};
+  for (int n=0; n<3; ++n) {
+    sigma[n] = pcr->sigma_diff(n,k,j,i);
+    if (pcr->stream_flag)
+      sigma[n] = 1.0/(1.0/pcr->sigma_diff(n,k,j,i) + 1.0/pcr->sigma_adv(n,k,j,i));
+  }
+  a11 = 1.0;
+  for (int n=0; n<3; ++n) {
+    a11 -= dt*sigma[n]*vtot[n]*v[n]*invlim*4.0/3.0;
+    a1n[n] = dt*sigma[n]*vtot[n];
+    an1[n] = -dt*v[n]*sigma[n]*4.0/3.0;
+    ann[n] = 1.0 + dt*vlim*sigma[n];
+  }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void CRIntegrator::FirstOrderFluxDivergenceCoef(AthenaArray<Real> &w)
+//  \brief HLLE weights of the faces from the v_diff of the last CalculateFluxes()
+
+void CRIntegrator::FirstOrderFluxDivergenceCoef(AthenaArray<Real> &w) {
+  CosmicRay *pcr=pmy_cr;
+  MeshBlock *pmb=pcr->pmy_block;
+  Real vmax = pcr->vmax;
+  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
+  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
+
+  Real coef[4];
+  AthenaArray<Real> &coef1 = imp_coef_[X1DIR];
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie+1; ++i) {
+        HLLEWeights(vmax, w(IVX,k,j,i-1), w(IVX,k,j,i), pcr->v_diff(0,k,j,i-1),
+                    pcr->v_diff(0,k,j,i), coef);
+        for (int n=0; n<4; ++n)
+          coef1(n,k,j,i) = coef[n];
+      }
+    }
+  }
+  if (pmb->pmy_mesh->f2) {
+    AthenaArray<Real> &coef2 = imp_coef_[X2DIR];
+    for (int k=ks; k<=ke; ++k) {
+      for (int j=js; j<=je+1; ++j) {
+        for (int i=is; i<=ie; ++i) {
+          HLLEWeights(vmax, w(IVY,k,j-1,i), w(IVY,k,j,i), pcr->v_diff(1,k,j-1,i),
+                      pcr->v_diff(1,k,j,i), coef);
+          for (int n=0; n<4; ++n)
+            coef2(n,k,j,i) = coef[n];
+        }
+      }
+    }
+  }
+  if (pmb->pmy_mesh->f3) {
+    AthenaArray<Real> &coef3 = imp_coef_[X3DIR];
+    for (int k=ks; k<=ke+1; ++k) {
+      for (int j=js; j<=je; ++j) {
+        for (int i=is; i<=ie; ++i) {
+          HLLEWeights(vmax, w(IVZ,k-1,j,i), w(IVZ,k,j,i), pcr->v_diff(2,k-1,j,i),
+                      pcr->v_diff(2,k,j,i), coef);
+          for (int n=0; n<4; ++n)
+            coef3(n,k,j,i) = coef[n];
+        }
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CRIntegrator::ImplicitFluxAndSource()
+//  \brief one damped Jacobi iteration of the implicit transport and source terms, from
+//  the previous iterate ucr_old to ucr
+
+void CRIntegrator::ImplicitFluxAndSource(const Real wght, AthenaArray<Real> &u,
+        AthenaArray<Real> &ucr_ini, AthenaArray<Real> &ucr_old, AthenaArray<Real> &ucr) {
+  CosmicRay *pcr=pmy_cr;
+  MeshBlock *pmb=pcr->pmy_block;
+  Real vmax = pcr->vmax;
+  Real rho_floor = pmb->peos->GetDensityFloor();
+  const Real edd = 1.0/3.0;
+  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
+  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
+  bool f2 = pmb->pmy_mesh->f2, f3 = pmb->pmy_mesh->f3;
+
+  AthenaArray<Real> &x1area = x1face_area_, &x2area = x2face_area_,
+                 &x2area_p1 = x2face_area_p1_, &x3area = x3face_area_,
+                 &x3area_p1 = x3face_area_p1_, &vol = cell_volume_;
+
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      pmb->pcoord->Face1Area(k,j,is,ie+1,x1area);
+      if (f2) {
+        pmb->pcoord->Face2Area(k,j  ,is,ie,x2area   );
+        pmb->pcoord->Face2Area(k,j+1,is,ie,x2area_p1);
+      }
+      if (f3) {
+        pmb->pcoord->Face3Area(k  ,j,is,ie,x3area   );
+        pmb->pcoord->Face3Area(k+1,j,is,ie,x3area_p1);
+      }
+      pmb->pcoord->CellVolume(k,j,is,ie,vol);
+      for (int i=is; i<=ie; ++i) {
+        Real diag = 0.0, coup[3] = {0.0, 0.0, 0.0}, wnb[3] = {0.0, 0.0, 0.0};
+        Real nb[4] = {0.0, 0.0, 0.0, 0.0};
+        Real up[4], um[4], cfp[4], cfm[4];
+
+        for (int n=0; n<NCR; ++n) {
+          up[n] = ucr_old(n,k,j,i+1);
+          um[n] = ucr_old(n,k,j,i-1);
+        }
+        for (int n=0; n<4; ++n) {
+          cfp[n] = imp_coef_[X1DIR](n,k,j,i+1);
+          cfm[n] = imp_coef_[X1DIR](n,k,j,i);
+        }
+        FaceTerms(0, vmax, wght*x1area(i+1)/vol(i), wght*x1area(i)/vol(i),
+                  cfp, cfm, up, um, diag, coup[0], wnb[0], nb);
+        if (f2) {
+          for (int n=0; n<NCR; ++n) {
+            up[n] = ucr_old(n,k,j+1,i);
+            um[n] = ucr_old(n,k,j-1,i);
+          }
+          for (int n=0; n<4; ++n) {
+            cfp[n] = imp_coef_[X2DIR](n,k,j+1,i);
+            cfm[n] = imp_coef_[X2DIR](n,k,j,i);
+          }
+          FaceTerms(1, vmax, wght*x2area_p1(i)/vol(i), wght*x2area(i)/vol(i),
+                    cfp, cfm, up, um, diag, coup[1], wnb[1], nb);
+        }
+        if (f3) {
+          for (int n=0; n<NCR; ++n) {
+            up[n] = ucr_old(n,k+1,j,i);
+            um[n] = ucr_old(n,k-1,j,i);
+          }
+          for (int n=0; n<4; ++n) {
+            cfp[n] = imp_coef_[X3DIR](n,k+1,j,i);
+            cfm[n] = imp_coef_[X3DIR](n,k,j,i);
+          }
+          FaceTerms(2, vmax, wght*x3area_p1(i)/vol(i), wght*x3area(i)/vol(i),
+                    cfp, cfm, up, um, diag, coup[2], wnb[2], nb);
+        }
+
+        // right hand side with the explicit coordinate and perpendicular source terms
+        Real rhs[4];
+        for (int n=0; n<NCR; ++n)
+          rhs[n] = ucr_ini(n,k,j,i) + wght*coord_source_(n,k,j,i) - nb[n];
+        if (MAGNETIC_FIELDS_ENABLED)
+          rhs[CRE] += wght*ec_source_(k,j,i);
+
+        Real a11, a1n[3], an1[3], ann[3];
+        SourceMatrix(pcr, wght, rho_floor, u, k, j, i, a11, a1n, an1, ann);
+
+        // couplings of Ec and Fc by the fluxes, in the frame of the source terms
+        Real ce[3] = {vmax*coup[0], vmax*coup[1], vmax*coup[2]};
+        Real cf[3] = {vmax*edd*coup[0], vmax*edd*coup[1], vmax*edd*coup[2]};
+        if (MAGNETIC_FIELDS_ENABLED) {
+          Real sint_b = pcr->b_angle(0,k,j,i), cost_b = pcr->b_angle(1,k,j,i);
+          Real sinp_b = pcr->b_angle(2,k,j,i), cosp_b = pcr->b_angle(3,k,j,i);
+          RotateVec(sint_b,cost_b,sinp_b,cosp_b,ce[0],ce[1],ce[2]);
+          RotateVec(sint_b,cost_b,sinp_b,cosp_b,cf[0],cf[1],cf[2]);
+          RotateVec(sint_b,cost_b,sinp_b,cosp_b,rhs[CRF1],rhs[CRF2],rhs[CRF3]);
+        }
+        a11 += diag;
+        Real e_coef = a11, new_ec = rhs[CRE];
+        Real fdiag_min = ann[0] + diag;
+        for (int n=0; n<3; ++n) {
+          a1n[n] += ce[n];
+          an1[n] += cf[n];
+          ann[n] += diag;
+          e_coef -= a1n[n]*an1[n]/ann[n];
+          new_ec -= a1n[n]*rhs[CRF1+n]/ann[n];
+          fdiag_min = std::min(fdiag_min, ann[n]);
+        }
+        new_ec /= e_coef;
+        Real newfr[3];
+        for (int n=0; n<3; ++n)
+          newfr[n] = (rhs[CRF1+n] - an1[n]*new_ec)/ann[n];
+        if (MAGNETIC_FIELDS_ENABLED) {
+          InvRotateVec(pcr->b_angle(0,k,j,i),pcr->b_angle(1,k,j,i),
+                       pcr->b_angle(2,k,j,i),pcr->b_angle(3,k,j,i),
+                       newfr[0],newfr[1],newfr[2]);
+        }
+
+        // damping by the ratio of the couplings through the neighbors to the diagonal
+        Real ratio = 0.0;
+        for (int n=0; n<3; ++n)
+          ratio += vmax*vmax*edd*wnb[n]*wnb[n];
+        ratio /= std::abs(a11*fdiag_min);
+        Real omega = 1.0/(1.0 + ratio);
+
+        ucr(CRE,k,j,i) = ucr_old(CRE,k,j,i) + omega*(new_ec - ucr_old(CRE,k,j,i));
+        for (int n=0; n<3; ++n)
+          ucr(CRF1+n,k,j,i) = ucr_old(CRF1+n,k,j,i)
+                              + omega*(newfr[n] - ucr_old(CRF1+n,k,j,i));
+        if (ucr(CRE,k,j,i) < TINY_NUMBER)
+          ucr(CRE,k,j,i) = TINY_NUMBER;
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CRIntegrator::AddImplicitSourceTerms()
+//  \brief add the energy and momentum exchanged by the converged implicit source terms
+//  to the gas, with the same sign conventions as AddSourceTerms()
+
+void CRIntegrator::AddImplicitSourceTerms(MeshBlock *pmb, const Real dt,
+        AthenaArray<Real> &u, AthenaArray<Real> &ucr) {
+  CosmicRay *pcr=pmb->pcr;
+  if (pcr->src_flag <= 0) return;
+  Real invlim = 1.0/pcr->vmax;
+  Real rho_floor = pmb->peos->GetDensityFloor();
+  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
+  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
+
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie; ++i) {
+        Real a11, a1n[3], an1[3], ann[3];
+        SourceMatrix(pcr, dt, rho_floor, u, k, j, i, a11, a1n, an1, ann);
+        Real ec = ucr(CRE,k,j,i);
+        Real fr[3] = {ucr(CRF1,k,j,i), ucr(CRF2,k,j,i), ucr(CRF3,k,j,i)};
+        if (MAGNETIC_FIELDS_ENABLED)
+          RotateVec(pcr->b_angle(0,k,j,i),pcr->b_angle(1,k,j,i),
+                    pcr->b_angle(2,k,j,i),pcr->b_angle(3,k,j,i),fr[0],fr[1],fr[2]);
+        // change of the cosmic rays by the source terms: (I - A) U
+        Real dec = (1.0 - a11)*ec;
+        Real dfr[3];
+        for (int n=0; n<3; ++n) {
+          dec -= a1n[n]*fr[n];
+          dfr[n] = -an1[n]*ec + (1.0 - ann[n])*fr[n];
+        }
+        if (MAGNETIC_FIELDS_ENABLED) {
+          InvRotateVec(pcr->b_angle(0,k,j,i),pcr->b_angle(1,k,j,i),
+                       pcr->b_angle(2,k,j,i),pcr->b_angle(3,k,j,i),
+                       dfr[0],dfr[1],dfr[2]);
+          dec += dt*ec_source_(k,j,i);
+        }
+        if (NON_BAROTROPIC_EOS) {
+          Real new_eg = u(IEN,k,j,i) - dec;
+          if (new_eg >= 0.0) u(IEN,k,j,i) = new_eg;
+        }
+        u(IM1,k,j,i) -= dfr[0]*invlim;
+        u(IM2,k,j,i) -= dfr[1]*invlim;
+        u(IM3,k,j,i) -= dfr[2]*invlim;
+      }
+    }
+  }
+  return;
+}
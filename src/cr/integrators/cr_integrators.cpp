@@ -90,6 +90,14 @@ CRIntegrator::CRIntegrator(CosmicRay *pcr, ParameterInput *pin) {
   grad_pc_.NewAthenaArray(3,ncells3,ncells2,ncells1);
   ec_source_.NewAthenaArray(ncells3,ncells2,ncells1);
   coord_source_.NewAthenaArray(NCR,ncells3,ncells2,ncells1);
+
+  if (pmb->pmy_mesh->pimcr != nullptr) {
+    imp_coef_[X1DIR].NewAthenaArray(4,ncells3,ncells2,ncells1+1);
+    if (pmb->pmy_mesh->f2)
+      imp_coef_[X2DIR].NewAthenaArray(4,ncells3,ncells2+1,ncells1);
+    if (pmb->pmy_mesh->f3)
+      imp_coef_[X3DIR].NewAthenaArray(4,ncells3+1,ncells2,ncells1);
+  }
 }
 
 // destructor
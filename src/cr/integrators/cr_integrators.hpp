@@ -39,6 +39,13 @@ class CRIntegrator {
               AthenaArray<Real> &flx);
   void AddSourceTerms(MeshBlock *pmb, const Real dt, AthenaArray<Real> &u,
         AthenaArray<Real> &w, AthenaArray<Real> &bcc, AthenaArray<Real> &ucr);
+
+  // implicit transport, using the v_diff of CalculateFluxes() with order 1
+  void FirstOrderFluxDivergenceCoef(AthenaArray<Real> &w);
+  void ImplicitFluxAndSource(const Real wght, AthenaArray<Real> &u,
+        AthenaArray<Real> &ucr_ini, AthenaArray<Real> &ucr_old, AthenaArray<Real> &ucr);
+  void AddImplicitSourceTerms(MeshBlock *pmb, const Real dt, AthenaArray<Real> &u,
+        AthenaArray<Real> &ucr);
   int cr_xorder;
 
  private:
@@ -55,6 +62,9 @@ class CRIntegrator {
   AthenaArray<Real> x1face_area_, x2face_area_, x3face_area_;
   AthenaArray<Real> x2face_area_p1_, x3face_area_p1_;
   AthenaArray<Real> cell_volume_, dflx_, cwidth2_, cwidth3_;
+  // HLLE weights a, a*bm, b, b*bp of the first order fluxes F = a*F_L + b*F_R
+  // at the faces along each direction, for the implicit transport
+  AthenaArray<Real> imp_coef_[3];
 };
 
 #endif // CR_INTEGRATORS_CR_INTEGRATORS_HPP_
@@ -248,12 +248,12 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, std::complex<Real> *data,
     plan->plan = fftw_plan_dft_1d(nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data),
-                                  FFTW_FORWARD, FFTW_ESTIMATE);
+                                  FFTW_FORWARD, pmy_driver_->planner_flags_);
   else
     plan->plan = fftw_plan_dft_1d(nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data),
-                                  FFTW_BACKWARD, FFTW_ESTIMATE);
+                                  FFTW_BACKWARD, pmy_driver_->planner_flags_);
 #endif
   return plan;
 }
@@ -282,7 +282,8 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nslow,
                                       f_out_->ie[f_in_->iloc[0]],
                                       f_out_->is[f_in_->iloc[1]],
                                       f_out_->ie[f_in_->iloc[1]],
-                                      0, permute1_, &nbuf);
+                                      0, permute1_, &nbuf,
+                                      pmy_driver_->planner_flags_);
   } else {
     plan->dir = FFTW_BACKWARD;
     plan->plan2d = fft_2d_create_plan(MPI_COMM_WORLD, nfast, nslow,
@@ -292,7 +293,8 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nslow,
                                       b_out_->ie[b_in_->iloc[0]],
                                       b_out_->is[b_in_->iloc[1]],
                                       b_out_->ie[b_in_->iloc[1]],
-                                      0, permute2_, &nbuf);
+                                      0, permute2_, &nbuf,
+                                      pmy_driver_->planner_flags_);
   }
   plan->plan3d = nullptr;
   plan->plan = nullptr;
@@ -301,12 +303,12 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nslow,
     plan->plan = fftw_plan_dft_2d(nslow, nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data),
-                                  FFTW_FORWARD, FFTW_MEASURE);
+                                  FFTW_FORWARD, pmy_driver_->planner_flags_);
   else
     plan->plan = fftw_plan_dft_2d(nslow, nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data),
-                                  FFTW_BACKWARD, FFTW_MEASURE);
+                                  FFTW_BACKWARD, pmy_driver_->planner_flags_);
 #endif
 #endif // FFT
 
@@ -343,7 +345,10 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
                                       ois[0], oie[0],
                                       ois[1], oie[1],
                                       ois[2], oie[2],
-                                      0, permute1_, &nbuf);
+                                      0, permute1_, &nbuf,
+                                      pmy_driver_->planner_flags_,
+                                      pmy_driver_->mid_decomp_,
+                                      pmy_driver_->nchunk_);
   } else {
     for (int l=0; l<dim_; l++) {
       ois[l] = b_out_->is[(l+(dim_-permute2_)) % dim_];
@@ -357,7 +362,10 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
                                       ois[0], oie[0],
                                       ois[1], oie[1],
                                       ois[2], oie[2],
-                                      0, permute2_, &nbuf);
+                                      0, permute2_, &nbuf,
+                                      pmy_driver_->planner_flags_,
+                                      pmy_driver_->mid_decomp_,
+                                      pmy_driver_->nchunk_);
   }
   plan->plan2d = nullptr;
   plan->plan = nullptr;
@@ -366,12 +374,12 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
     plan->plan = fftw_plan_dft_3d(nslow, nmid, nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data), FFTW_FORWARD,
-                                  FFTW_MEASURE);
+                                  pmy_driver_->planner_flags_);
   } else {
     plan->plan = fftw_plan_dft_3d(nslow, nmid, nfast,
                                   reinterpret_cast<fftw_complex *>(data),
                                   reinterpret_cast<fftw_complex *>(data), FFTW_BACKWARD,
-                                  FFTW_MEASURE);
+                                  pmy_driver_->planner_flags_);
   }
 #endif
 #endif // FFT
@@ -13,6 +13,7 @@
 // C++ headers
 #include <complex>
 #include <iostream>
+#include <string>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -60,6 +61,7 @@ class ParameterInput;
 class FFTBlock;
 class FFTDriver;
 class TurbulenceDriver;
+class SpectrumOutput;
 
 class AthenaFFTIndex{
  public:
@@ -146,6 +148,7 @@ class FFTBlock {
   friend class TurbulenceDriver;
   friend class FFTDriver;
   friend class Mesh;
+  friend class SpectrumOutput;
 
  protected:
   FFTDriver *pmy_driver_;
@@ -180,6 +183,9 @@ class FFTDriver {
 
   void QuickCreatePlan();
   void InitializeFFTBlock(bool set_norm);
+  void ImportWisdom();
+  void ExportWisdom();
+  std::string WisdomFileName();
   // small functions
   int GetNumFFTBlocks() { return nblist_[Globals::my_rank]; }
 
@@ -197,6 +203,12 @@ class FFTDriver {
   int decomp_, pdim_;
 #endif
   const int dim_;
+  // FFTW planner rigor, layout of the transposed data in parallel 3D FFTs,
+  // and number of chunks used to overlap the transposes with the 1D FFTs
+  unsigned int planner_flags_;
+  int mid_decomp_, nchunk_;
+  // FFTW wisdom is stored in a file per mesh size and decomposition
+  std::string wisdom_file_;
 #ifdef MPI_PARALLEL
   MPI_Comm MPI_COMM_FFT;
 #endif
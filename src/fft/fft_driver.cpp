@@ -10,6 +10,7 @@
 
 // C++ headers
 #include <cmath>
+#include <fstream>    // ifstream
 #include <iostream>   // endl
 #include <sstream>    // sstream
 #include <stdexcept>  // runtime_error
@@ -30,7 +31,9 @@
 // constructor, initializes data structures and parameters
 
 FFTDriver::FFTDriver(Mesh *pm, ParameterInput *pin) : nranks_(Globals::nranks),
-                                                      pmy_mesh_(pm), dim_(pm->ndim) {
+                                                      pmy_mesh_(pm), dim_(pm->ndim),
+                                                      planner_flags_(0),
+                                                      mid_decomp_(0), nchunk_(1) {
   if (!(pm->use_uniform_meshgen_fn_[X1DIR])
       || !(pm->use_uniform_meshgen_fn_[X2DIR])
       || !(pm->use_uniform_meshgen_fn_[X3DIR])) {
@@ -129,6 +132,53 @@ FFTDriver::FFTDriver(Mesh *pm, ParameterInput *pin) : nranks_(Globals::nranks),
 
   gcnt_ = fft_mesh_size_.nx1*fft_mesh_size_.nx2*fft_mesh_size_.nx3;
 
+  // FFTW planning options; MEASURE and above are only worth their planning time
+  // if the wisdom is saved and reused by subsequent runs
+#ifdef MPI_PARALLEL
+  std::string planner = pin->GetOrAddString("fft", "planner", "estimate");
+#else
+  std::string planner = pin->GetOrAddString("fft", "planner", "measure");
+#endif
+#ifdef FFT
+  if (planner == "estimate") {
+    planner_flags_ = FFTW_ESTIMATE;
+  } else if (planner == "measure") {
+    planner_flags_ = FFTW_MEASURE;
+  } else if (planner == "patient") {
+    planner_flags_ = FFTW_PATIENT;
+  } else if (planner == "exhaustive") {
+    planner_flags_ = FFTW_EXHAUSTIVE;
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in FFTDriver::FFTDriver" << std::endl
+        << "Unknown FFTW planner '" << planner << "' in <fft> block." << std::endl;
+    ATHENA_ERROR(msg);
+    return;
+  }
+#endif
+  wisdom_file_ = pin->GetOrAddString("fft", "wisdom_file", "");
+
+  // layout of the intermediate stages of the parallel 3D FFT:
+  // "slab" needs one all-to-all less than "pencil" but is limited to as many ranks
+  // as there are planes; "auto" picks slab whenever it fits
+  std::string decomp = pin->GetOrAddString("fft", "decomposition", "auto");
+  if (decomp == "auto") {
+    mid_decomp_ = 0;
+  } else if (decomp == "slab") {
+    mid_decomp_ = 1;
+  } else if (decomp == "pencil") {
+    mid_decomp_ = 2;
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in FFTDriver::FFTDriver" << std::endl
+        << "Unknown decomposition '" << decomp << "' in <fft> block." << std::endl;
+    ATHENA_ERROR(msg);
+    return;
+  }
+  // overlap the transposes with the 1D FFTs by splitting them into chunks
+  nchunk_ = pin->GetOrAddInteger("fft", "pipeline_chunks", 1);
+  if (nchunk_ < 1) nchunk_ = 1;
+
 #ifdef MPI_PARALLEL
   decomp_ = 0; pdim_ = 0;
   if (npx1 > 1) {
@@ -154,6 +204,9 @@ FFTDriver::~FFTDriver() {
   delete [] nblist_;
   delete [] fft_loclist_;
   delete pmy_fb;
+#ifdef MPI_PARALLEL
+  MPI_Comm_free(&MPI_COMM_FFT);
+#endif
 }
 
 void FFTDriver::InitializeFFTBlock(bool set_norm) {
@@ -163,10 +216,71 @@ void FFTDriver::InitializeFFTBlock(bool set_norm) {
 }
 
 void FFTDriver::QuickCreatePlan() {
+  ImportWisdom();
   pmy_fb->fplan_ = pmy_fb->QuickCreatePlan(
       pmy_fb->in_, FFTBlock::AthenaFFTDirection::forward);
   pmy_fb->bplan_ = pmy_fb->QuickCreatePlan(
       pmy_fb->in_, FFTBlock::AthenaFFTDirection::backward);
+  ExportWisdom();
 
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn std::string FFTDriver::WisdomFileName()
+//! \brief wisdom file name keyed by the FFT mesh size and the MPI decomposition
+
+std::string FFTDriver::WisdomFileName() {
+  std::stringstream fname;
+  fname << wisdom_file_ << "." << fft_mesh_size_.nx1 << "x" << fft_mesh_size_.nx2
+        << "x" << fft_mesh_size_.nx3 << "." << npx1 << "x" << npx2 << "x" << npx3
+        << ".wisdom";
+  return fname.str();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FFTDriver::ImportWisdom()
+//! \brief read FFTW wisdom saved by a previous run on rank 0 and share it with all ranks
+
+void FFTDriver::ImportWisdom() {
+#ifdef FFT
+  if (wisdom_file_.empty()) return;
+  std::string wisdom;
+  if (Globals::my_rank == 0) {
+    std::ifstream fin(WisdomFileName());
+    if (fin.good()) {
+      std::stringstream buf;
+      buf << fin.rdbuf();
+      wisdom = buf.str();
+    }
+  }
+#ifdef MPI_PARALLEL
+  int len = static_cast<int>(wisdom.size());
+  MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_FFT);
+  if (len == 0) return;
+  wisdom.resize(len);
+  MPI_Bcast(&wisdom[0], len, MPI_CHAR, 0, MPI_COMM_FFT);
+#endif
+  if (!wisdom.empty() && fftw_import_wisdom_from_string(wisdom.c_str()) == 0
+      && Globals::my_rank == 0) {
+    std::cout << "### Warning in FFTDriver::ImportWisdom" << std::endl
+              << "Failed to import FFTW wisdom from " << WisdomFileName() << std::endl;
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FFTDriver::ExportWisdom()
+//! \brief save the accumulated FFTW wisdom so later runs can skip the planning
+
+void FFTDriver::ExportWisdom() {
+#ifdef FFT
+  if (wisdom_file_.empty() || Globals::my_rank != 0) return;
+  if (fftw_export_wisdom_to_filename(WisdomFileName().c_str()) == 0) {
+    std::cout << "### Warning in FFTDriver::ExportWisdom" << std::endl
+              << "Failed to write FFTW wisdom to " << WisdomFileName() << std::endl;
+  }
+#endif
+  return;
+}
@@ -140,13 +140,14 @@ void fft_2d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_2d *plan)
                           0 = no permutation
 			  1 = permute = slow->fast, fast->slow
    nbuf                 returns size of internal storage buffers used by FFT
+   fftw_flags           FFTW planner flags for the 1d FFTs (e.g. FFTW_ESTIMATE)
 */
 
 struct fft_plan_2d *fft_2d_create_plan(
        MPI_Comm comm, int nfast, int nslow,
        int in_ilo, int in_ihi, int in_jlo, int in_jhi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
-       int scaled, int permute, int *nbuf)
+       int scaled, int permute, int *nbuf, unsigned int fftw_flags)
 
 {
   struct fft_plan_2d *plan;
@@ -315,11 +316,11 @@ struct fft_plan_2d *fft_2d_create_plan(
   plan->plan_fast_forward =
     fftw_plan_many_dft(1,&(plan->length1),plan->total1/plan->length1,
                        plan->scratch,NULL,1,plan->length1,plan->scratch,
-                       NULL,1,plan->length1,FFTW_FORWARD,FFTW_ESTIMATE);
+                       NULL,1,plan->length1,FFTW_FORWARD,fftw_flags);
   plan->plan_fast_backward =
     fftw_plan_many_dft(1,&(plan->length1),plan->total1/plan->length1,
                        plan->scratch,NULL,1,plan->length1,plan->scratch,
-                       NULL,1,plan->length1,FFTW_BACKWARD,FFTW_ESTIMATE);
+                       NULL,1,plan->length1,FFTW_BACKWARD,fftw_flags);
 
   if (plan->length2 == plan->length1) {
     plan->plan_slow_forward = plan->plan_fast_forward;
@@ -328,11 +329,11 @@ struct fft_plan_2d *fft_2d_create_plan(
     plan->plan_slow_forward =
       fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
                          plan->scratch,NULL,1,plan->length2,plan->scratch,
-                         NULL,1,plan->length2,FFTW_FORWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length2,FFTW_FORWARD,fftw_flags);
     plan->plan_slow_backward =
       fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
                          plan->scratch,NULL,1,plan->length2,plan->scratch,
-                         NULL,1,plan->length2,FFTW_BACKWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length2,FFTW_BACKWARD,fftw_flags);
   }
 
   if (scaled == 0)
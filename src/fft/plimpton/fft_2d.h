@@ -60,7 +60,7 @@ struct fft_plan_2d {
 void fft_2d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_2d *);
 struct fft_plan_2d *fft_2d_create_plan(MPI_Comm, int, int,
   int, int, int, int, int, int, int, int,
-  int, int, int *);
+  int, int, int *, unsigned int);
 void fft_2d_destroy_plan(struct fft_plan_2d *);
 void factor(int, int *, int *);
 
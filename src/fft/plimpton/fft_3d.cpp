@@ -64,7 +64,7 @@
 void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
 {
-  int i,offset,num;
+  int i,c,offset,num;
   double norm;
   FFT_DATA *data,*copy;
 
@@ -82,40 +82,65 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
   } else
     data = in;
 
-/* 1d FFTs along fast axis */
-
-  if (flag == -1)
-    fftw_execute_dft(plan->plan_fast_forward,data,data);
-  else
-    fftw_execute_dft(plan->plan_fast_backward,data,data);
-
-/* 1st mid-remap to prepare for 2nd FFTs
-   copy = loc for remap result */
+/* 1d FFTs along fast axis and 1st mid-remap to prepare for 2nd FFTs
+   copy = loc for remap result
+   if pipelined, each chunk is sent while FFTs on the next chunk proceed */
 
   if (plan->mid1_target == 0)
     copy = out;
   else
     copy = plan->copy;
-  remap_3d((double *) data, (double *) copy, (double *) plan->scratch,
-	   plan->mid1_plan);
-  data = copy;
-
-/* 1d FFTs along mid axis */
 
-  if (flag == -1)
-    fftw_execute_dft(plan->plan_mid_forward,data,data);
-  else
-    fftw_execute_dft(plan->plan_mid_backward,data,data);
+  if (plan->nchunk1 > 1) {
+    for (c = 0; c < plan->nchunk1; c++) {
+      offset = c*plan->chunk_size1;
+      if (flag == -1)
+        fftw_execute_dft(plan->plan_fast_forward_chunk,&data[offset],&data[offset]);
+      else
+        fftw_execute_dft(plan->plan_fast_backward_chunk,&data[offset],&data[offset]);
+      remap_3d_start((double *) &data[offset], (double *) copy, NULL,
+		     plan->mid1_chunk[c]);
+    }
+    for (c = 0; c < plan->nchunk1; c++)
+      remap_3d_finish((double *) copy, NULL, plan->mid1_chunk[c]);
+  } else {
+    if (flag == -1)
+      fftw_execute_dft(plan->plan_fast_forward,data,data);
+    else
+      fftw_execute_dft(plan->plan_fast_backward,data,data);
+    remap_3d((double *) data, (double *) copy, (double *) plan->scratch,
+	     plan->mid1_plan);
+  }
+  data = copy;
 
-/* 2nd mid-remap to prepare for 3rd FFTs
+/* 1d FFTs along mid axis and 2nd mid-remap to prepare for 3rd FFTs
    copy = loc for remap result */
 
   if (plan->mid2_target == 0)
     copy = out;
   else
     copy = plan->copy;
-  remap_3d((double *) data, (double *) copy, (double *) plan->scratch,
-	   plan->mid2_plan);
+
+  if (plan->nchunk2 > 1) {
+    for (c = 0; c < plan->nchunk2; c++) {
+      offset = c*plan->chunk_size2;
+      if (flag == -1)
+        fftw_execute_dft(plan->plan_mid_forward_chunk,&data[offset],&data[offset]);
+      else
+        fftw_execute_dft(plan->plan_mid_backward_chunk,&data[offset],&data[offset]);
+      remap_3d_start((double *) &data[offset], (double *) copy, NULL,
+		     plan->mid2_chunk[c]);
+    }
+    for (c = 0; c < plan->nchunk2; c++)
+      remap_3d_finish((double *) copy, NULL, plan->mid2_chunk[c]);
+  } else {
+    if (flag == -1)
+      fftw_execute_dft(plan->plan_mid_forward,data,data);
+    else
+      fftw_execute_dft(plan->plan_mid_backward,data,data);
+    remap_3d((double *) data, (double *) copy, (double *) plan->scratch,
+	     plan->mid2_plan);
+  }
   data = copy;
 
 /* 1d FFTs along slow axis */
@@ -164,20 +189,46 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 			  1 = permute once = mid->fast, slow->mid, fast->slow
 			  2 = permute twice = slow->fast, fast->mid, mid->slow
    nbuf                 returns size of internal storage buffers used by FFT
+   fftw_flags           FFTW planner flags for the 1d FFTs (e.g. FFTW_ESTIMATE)
+   decomp               layout of procs for the intermediate 1d FFTs
+                          FFT_3D_DECOMP_AUTO, _SLAB or _PENCIL
+   nchunk               max # of chunks to pipeline 1d FFTs with remaps
+                          1 = no pipelining
 */
 
+/* largest # of chunks <= nchunk that evenly divides n on every proc
+   flag = 0 on any proc disables pipelining for this stage */
+
+static int fft_3d_nchunk(MPI_Comm comm, int nchunk, int n, int flag)
+
+{
+  int nc,allnc,ok,allok;
+
+  nc = MIN(nchunk,n);
+  if (nc < 1 || flag == 0) nc = 1;
+  while (n % nc) nc--;
+
+  MPI_Allreduce(&nc,&allnc,1,MPI_INT,MPI_MIN,comm);
+  ok = (n > 0 && n % allnc == 0);
+  MPI_Allreduce(&ok,&allok,1,MPI_INT,MPI_MIN,comm);
+
+  if (allok == 0) return 1;
+  return allnc;
+}
+
 struct fft_plan_3d *fft_3d_create_plan(
        MPI_Comm comm, int nfast, int nmid, int nslow,
        int in_ilo, int in_ihi, int in_jlo, int in_jhi,
        int in_klo, int in_khi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
        int out_klo, int out_khi,
-       int scaled, int permute, int *nbuf)
+       int scaled, int permute, int *nbuf,
+       unsigned int fftw_flags, int decomp, int nchunk)
 
 {
   struct fft_plan_3d *plan;
   int me,nprocs;
-  int i,num,flag,remapflag,fftflag;
+  int i,num,flag,remapflag,fftflag,nsub,howmany;
   int first_ilo,first_ihi,first_jlo,first_jhi,first_klo,first_khi;
   int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
   int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
@@ -190,9 +241,21 @@ struct fft_plan_3d *fft_3d_create_plan(
   MPI_Comm_rank(comm,&me);
   MPI_Comm_size(comm,&nprocs);
 
-/* compute division of procs in 2 dimensions not on-processor */
+/* compute division of procs in 2 dimensions not on-processor
+   a slab layout (np2 = 1) needs a single transpose between the mid and
+   slow FFTs, so prefer it whenever every proc still gets a plane */
 
-  bifactor(nprocs,&np1,&np2);
+  if (decomp == FFT_3D_DECOMP_AUTO) {
+    if (nprocs <= nfast && nprocs <= nmid)
+      decomp = FFT_3D_DECOMP_SLAB;
+    else
+      decomp = FFT_3D_DECOMP_PENCIL;
+  }
+  if (decomp == FFT_3D_DECOMP_SLAB) {
+    np1 = nprocs;
+    np2 = 1;
+  } else
+    bifactor(nprocs,&np1,&np2);
   ip1 = me % np1;
   ip2 = me/np1;
 
@@ -309,6 +372,58 @@ struct fft_plan_3d *fft_3d_create_plan(
 			 FFT_PRECISION,1,0,2);
   if (plan->mid2_plan == NULL) return NULL;
 
+/* pipelined stages: split the slowest storage axis of the 1st (2nd) layout
+   into chunks, each with its own remap, so that sending one chunk overlaps
+   with the FFTs of the next
+   only possible if no proc changes its range along that axis in the remap,
+   i.e. data only moves between procs owning the same slab */
+
+  plan->nchunk1 = fft_3d_nchunk(comm,nchunk,first_khi-first_klo+1,
+				first_klo == second_klo &&
+				first_khi == second_khi);
+  plan->mid1_chunk = NULL;
+  plan->chunk_size1 = 0;
+  if (plan->nchunk1 > 1) {
+    nsub = (first_khi-first_klo+1)/plan->nchunk1;
+    plan->chunk_size1 = nfast * (first_jhi-first_jlo+1) * nsub;
+    plan->mid1_chunk = (struct remap_plan_3d **)
+      malloc(plan->nchunk1*sizeof(struct remap_plan_3d *));
+    if (plan->mid1_chunk == NULL) return NULL;
+    for (i = 0; i < plan->nchunk1; i++) {
+      plan->mid1_chunk[i] =
+	remap_3d_create_plan(comm,
+			     first_ilo,first_ihi,first_jlo,first_jhi,
+			     first_klo+i*nsub,first_klo+(i+1)*nsub-1,
+			     second_ilo,second_ihi,second_jlo,second_jhi,
+			     second_klo,second_khi,
+			     FFT_PRECISION,1,1,2);
+      if (plan->mid1_chunk[i] == NULL) return NULL;
+    }
+  }
+
+  plan->nchunk2 = fft_3d_nchunk(comm,nchunk,second_ihi-second_ilo+1,
+				second_ilo == third_ilo &&
+				second_ihi == third_ihi);
+  plan->mid2_chunk = NULL;
+  plan->chunk_size2 = 0;
+  if (plan->nchunk2 > 1) {
+    nsub = (second_ihi-second_ilo+1)/plan->nchunk2;
+    plan->chunk_size2 = nmid * (second_khi-second_klo+1) * nsub;
+    plan->mid2_chunk = (struct remap_plan_3d **)
+      malloc(plan->nchunk2*sizeof(struct remap_plan_3d *));
+    if (plan->mid2_chunk == NULL) return NULL;
+    for (i = 0; i < plan->nchunk2; i++) {
+      plan->mid2_chunk[i] =
+	remap_3d_create_plan(comm,
+			     second_jlo,second_jhi,second_klo,second_khi,
+			     second_ilo+i*nsub,second_ilo+(i+1)*nsub-1,
+			     third_jlo,third_jhi,third_klo,third_khi,
+			     third_ilo,third_ihi,
+			     FFT_PRECISION,1,1,2);
+      if (plan->mid2_chunk[i] == NULL) return NULL;
+    }
+  }
+
 /* 1d FFTs along slow axis */
 
   plan->length3 = nslow;
@@ -416,11 +531,11 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan->plan_fast_forward =
     fftw_plan_many_dft(1,&(plan->length1),plan->total1/plan->length1,
                        plan->scratch,NULL,1,plan->length1,plan->scratch,
-                       NULL,1,plan->length1,FFTW_FORWARD,FFTW_ESTIMATE);
+                       NULL,1,plan->length1,FFTW_FORWARD,fftw_flags);
   plan->plan_fast_backward =
     fftw_plan_many_dft(1,&(plan->length1),plan->total1/plan->length1,
                        plan->scratch,NULL,1,plan->length1,plan->scratch,
-                       NULL,1,plan->length1,FFTW_BACKWARD,FFTW_ESTIMATE);
+                       NULL,1,plan->length1,FFTW_BACKWARD,fftw_flags);
 
   if (plan->length2 == plan->length1) {
     plan->plan_mid_forward = plan->plan_fast_forward;
@@ -429,11 +544,11 @@ struct fft_plan_3d *fft_3d_create_plan(
     plan->plan_mid_forward =
       fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
                          plan->scratch,NULL,1,plan->length2,plan->scratch,
-                         NULL,1,plan->length2,FFTW_FORWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length2,FFTW_FORWARD,fftw_flags);
     plan->plan_mid_backward =
       fftw_plan_many_dft(1,&(plan->length2),plan->total2/plan->length2,
                          plan->scratch,NULL,1,plan->length2,plan->scratch,
-                         NULL,1,plan->length2,FFTW_BACKWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length2,FFTW_BACKWARD,fftw_flags);
   }
 
   if (plan->length3 == plan->length1) {
@@ -446,11 +561,46 @@ struct fft_plan_3d *fft_3d_create_plan(
     plan->plan_slow_forward =
       fftw_plan_many_dft(1,&(plan->length3),plan->total3/plan->length3,
                          plan->scratch,NULL,1,plan->length3,plan->scratch,
-                         NULL,1,plan->length3,FFTW_FORWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length3,FFTW_FORWARD,fftw_flags);
     plan->plan_slow_backward =
       fftw_plan_many_dft(1,&(plan->length3),plan->total3/plan->length3,
                          plan->scratch,NULL,1,plan->length3,plan->scratch,
-                         NULL,1,plan->length3,FFTW_BACKWARD,FFTW_ESTIMATE);
+                         NULL,1,plan->length3,FFTW_BACKWARD,fftw_flags);
+  }
+
+/* 1d FFTs over a single chunk of a pipelined stage
+   chunks start at arbitrary offsets, so alignment cannot be assumed */
+
+  plan->plan_fast_forward_chunk = NULL;
+  plan->plan_fast_backward_chunk = NULL;
+  if (plan->nchunk1 > 1) {
+    howmany = plan->chunk_size1/plan->length1;
+    plan->plan_fast_forward_chunk =
+      fftw_plan_many_dft(1,&(plan->length1),howmany,
+                         plan->scratch,NULL,1,plan->length1,plan->scratch,
+                         NULL,1,plan->length1,FFTW_FORWARD,
+                         fftw_flags | FFTW_UNALIGNED);
+    plan->plan_fast_backward_chunk =
+      fftw_plan_many_dft(1,&(plan->length1),howmany,
+                         plan->scratch,NULL,1,plan->length1,plan->scratch,
+                         NULL,1,plan->length1,FFTW_BACKWARD,
+                         fftw_flags | FFTW_UNALIGNED);
+  }
+
+  plan->plan_mid_forward_chunk = NULL;
+  plan->plan_mid_backward_chunk = NULL;
+  if (plan->nchunk2 > 1) {
+    howmany = plan->chunk_size2/plan->length2;
+    plan->plan_mid_forward_chunk =
+      fftw_plan_many_dft(1,&(plan->length2),howmany,
+                         plan->scratch,NULL,1,plan->length2,plan->scratch,
+                         NULL,1,plan->length2,FFTW_FORWARD,
+                         fftw_flags | FFTW_UNALIGNED);
+    plan->plan_mid_backward_chunk =
+      fftw_plan_many_dft(1,&(plan->length2),howmany,
+                         plan->scratch,NULL,1,plan->length2,plan->scratch,
+                         NULL,1,plan->length2,FFTW_BACKWARD,
+                         fftw_flags | FFTW_UNALIGNED);
   }
 
   if (scaled == 0)
@@ -471,11 +621,28 @@ struct fft_plan_3d *fft_3d_create_plan(
 void fft_3d_destroy_plan(struct fft_plan_3d *plan)
 
 {
+  int i;
+
   if (plan->pre_plan) remap_3d_destroy_plan(plan->pre_plan);
   if (plan->mid1_plan) remap_3d_destroy_plan(plan->mid1_plan);
   if (plan->mid2_plan) remap_3d_destroy_plan(plan->mid2_plan);
   if (plan->post_plan) remap_3d_destroy_plan(plan->post_plan);
 
+  if (plan->mid1_chunk) {
+    for (i = 0; i < plan->nchunk1; i++)
+      remap_3d_destroy_plan(plan->mid1_chunk[i]);
+    free(plan->mid1_chunk);
+    fftw_destroy_plan(plan->plan_fast_forward_chunk);
+    fftw_destroy_plan(plan->plan_fast_backward_chunk);
+  }
+  if (plan->mid2_chunk) {
+    for (i = 0; i < plan->nchunk2; i++)
+      remap_3d_destroy_plan(plan->mid2_chunk[i]);
+    free(plan->mid2_chunk);
+    fftw_destroy_plan(plan->plan_mid_forward_chunk);
+    fftw_destroy_plan(plan->plan_mid_backward_chunk);
+  }
+
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
 
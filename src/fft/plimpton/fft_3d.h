@@ -57,14 +57,29 @@ struct fft_plan_3d {
   fftw_plan plan_mid_backward;
   fftw_plan plan_slow_forward;
   fftw_plan plan_slow_backward;
+                                    /* pipelined FFT+remap stages */
+  int nchunk1,nchunk2;              /* # of chunks for 1st,2nd FFT stage */
+  int chunk_size1,chunk_size2;      /* # of values in each chunk */
+  struct remap_plan_3d **mid1_chunk; /* per-chunk 1st mid-remap */
+  struct remap_plan_3d **mid2_chunk; /* per-chunk 2nd mid-remap */
+  fftw_plan plan_fast_forward_chunk;
+  fftw_plan plan_fast_backward_chunk;
+  fftw_plan plan_mid_forward_chunk;
+  fftw_plan plan_mid_backward_chunk;
 };
 
+/* layout of the intermediate (transposed) data */
+
+#define FFT_3D_DECOMP_AUTO 0        /* slab if every proc gets a plane */
+#define FFT_3D_DECOMP_SLAB 1        /* split procs over one axis */
+#define FFT_3D_DECOMP_PENCIL 2      /* split procs over two axes */
+
 /* function prototypes */
 
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int,
   int, int, int, int, int, int, int, int, int, int, int, int,
-  int, int, int *);
+  int, int, int *, unsigned int, int, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
@@ -66,8 +66,26 @@ void remap_3d(double *in, double *out, double *buf,
 	      struct remap_plan_3d *plan)
 
 {
-  MPI_Status status;
-  int i,isend,irecv;
+  remap_3d_start(in,out,buf,plan);
+  remap_3d_finish(out,buf,plan);
+}
+
+/* ------------------------------------------------------------------- */
+/* Begin a 3d remap without waiting for messages to arrive */
+
+/* Arguments: same as remap_3d
+
+   all recvs are posted and all sends are packed and posted
+   nothing is written to out until remap_3d_finish is called,
+     so several remaps may be in flight at once and in may alias out
+   in may be modified again as soon as this function returns
+*/
+
+void remap_3d_start(double *in, double *out, double *buf,
+		    struct remap_plan_3d *plan)
+
+{
+  int isend,irecv;
   double *scratch;
 
   if (plan->memory == 0)
@@ -82,16 +100,17 @@ void remap_3d(double *in, double *out, double *buf,
 	      MPI_DOUBLE,plan->recv_proc[irecv],0,
 	      plan->comm,&plan->request[irecv]);
 
-/* send all messages to other procs */
+/* pack each message into its own slot and send it without blocking */
 
   for (isend = 0; isend < plan->nsend; isend++) {
     plan->pack(&in[plan->send_offset[isend]],
-	       plan->sendbuf,&plan->packplan[isend]);
-    MPI_Send(plan->sendbuf,plan->send_size[isend],MPI_DOUBLE,
-	     plan->send_proc[isend],0,plan->comm);
+	       &plan->sendbuf[plan->send_bufloc[isend]],&plan->packplan[isend]);
+    MPI_Isend(&plan->sendbuf[plan->send_bufloc[isend]],plan->send_size[isend],
+	      MPI_DOUBLE,plan->send_proc[isend],0,plan->comm,
+	      &plan->send_request[isend]);
   }
 
-/* copy in -> scratch -> out for self data */
+/* copy in -> scratch for self data, unpacked in remap_3d_finish */
 
   if (plan->self) {
     isend = plan->nsend;
@@ -99,6 +118,28 @@ void remap_3d(double *in, double *out, double *buf,
     plan->pack(&in[plan->send_offset[isend]],
 	       &scratch[plan->recv_bufloc[irecv]],
 	       &plan->packplan[isend]);
+  }
+}
+
+/* ------------------------------------------------------------------- */
+/* Complete a 3d remap started by remap_3d_start */
+
+void remap_3d_finish(double *out, double *buf, struct remap_plan_3d *plan)
+
+{
+  MPI_Status status;
+  int i,irecv;
+  double *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+/* copy scratch -> out for self data */
+
+  if (plan->self) {
+    irecv = plan->nrecv;
     plan->unpack(&scratch[plan->recv_bufloc[irecv]],
 		 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
   }
@@ -110,6 +151,11 @@ void remap_3d(double *in, double *out, double *buf,
     plan->unpack(&scratch[plan->recv_bufloc[irecv]],
 		 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
   }
+
+/* send buffers may be reused once all sends have completed */
+
+  if (plan->nsend)
+    MPI_Waitall(plan->nsend,plan->send_request,MPI_STATUSES_IGNORE);
 }
 
 /* ------------------------------------------------------------------- */
@@ -224,11 +270,14 @@ struct remap_plan_3d *remap_3d_create_plan(
     plan->send_offset = (int *) malloc(nsend*sizeof(int));
     plan->send_size = (int *) malloc(nsend*sizeof(int));
     plan->send_proc = (int *) malloc(nsend*sizeof(int));
+    plan->send_bufloc = (int *) malloc(nsend*sizeof(int));
+    plan->send_request = (MPI_Request *) malloc(nsend*sizeof(MPI_Request));
     plan->packplan = (struct pack_plan_3d *)
       malloc(nsend*sizeof(struct pack_plan_3d));
 
     if (plan->send_offset == NULL || plan->send_size == NULL ||
-	plan->send_proc == NULL || plan->packplan == NULL) return NULL;
+	plan->send_proc == NULL || plan->send_bufloc == NULL ||
+	plan->send_request == NULL || plan->packplan == NULL) return NULL;
   }
 
 /* store send info, with self as last entry */
@@ -401,13 +450,16 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   free(array);
 
-/* find biggest send message (not including self) and malloc space for it */
+/* give every send message (not including self) its own slot in sendbuf
+   so that all sends can be in flight at once */
 
   plan->sendbuf = NULL;
 
   size = 0;
-  for (nsend = 0; nsend < plan->nsend; nsend++)
-    size = MAX(size,plan->send_size[nsend]);
+  for (nsend = 0; nsend < plan->nsend; nsend++) {
+    plan->send_bufloc[nsend] = size;
+    size += plan->send_size[nsend];
+  }
 
   if (size) {
     if (precision == 1)
@@ -463,6 +515,8 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
     free(plan->send_offset);
     free(plan->send_size);
     free(plan->send_proc);
+    free(plan->send_bufloc);
+    free(plan->send_request);
     free(plan->packplan);
     if (plan->sendbuf) free(plan->sendbuf);
   }
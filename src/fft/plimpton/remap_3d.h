@@ -18,13 +18,15 @@
 /* details of how to do a 3d remap */
 
 struct remap_plan_3d {
-  double *sendbuf;                  /* buffer for MPI sends */
+  double *sendbuf;                  /* buffer for MPI sends (one slot per send) */
   double *scratch;                  /* scratch buffer for MPI recvs */
   void (*pack)(double *, double *, struct pack_plan_3d *);                   /* which pack function to use */
   void (*unpack)(double *, double *, struct pack_plan_3d *);                 /* which unpack function to use */
   int *send_offset;                 /* extraction loc for each send */
   int *send_size;                   /* size of each send message */
   int *send_proc;                   /* proc to send each message to */
+  int *send_bufloc;                 /* offset in sendbuf for each send */
+  MPI_Request *send_request;        /* MPI request for each posted send */
   struct pack_plan_3d *packplan;    /* pack plan for each send message */
   int *recv_offset;                 /* insertion loc for each recv */
   int *recv_size;                   /* size of each recv message */
@@ -50,6 +52,8 @@ struct extent_3d {
 /* function prototypes */
 
 void remap_3d(double *, double *, double *, struct remap_plan_3d *);
+void remap_3d_start(double *, double *, double *, struct remap_plan_3d *);
+void remap_3d_finish(double *, double *, struct remap_plan_3d *);
 struct remap_plan_3d *remap_3d_create_plan(MPI_Comm,
   int, int, int, int, int, int,	int, int, int, int, int, int,
   int, int, int, int);
@@ -27,11 +27,12 @@
 #include "../../parameter_input.hpp"
 #include "../field.hpp"
 #include "field_diffusion.hpp"
+#include "mg_ohmic.hpp"
 
 //! FieldDiffusion constructor
 
 FieldDiffusion::FieldDiffusion(MeshBlock *pmb, ParameterInput *pin) :
-    pmy_block(pmb), field_diffusion_defined(false) {
+    pmy_block(pmb), field_diffusion_defined(false), implicit_ohmic(false), pmg(nullptr) {
   int nc1 = pmb->ncells1, nc2 = pmb->ncells2, nc3 = pmb->ncells3;
 
   // Check if field diffusion
@@ -40,7 +41,12 @@ FieldDiffusion::FieldDiffusion(MeshBlock *pmb, ParameterInput *pin) :
   eta_ad = pin->GetOrAddReal("problem", "eta_ad", 0.0);
 
   if ((eta_ohm != 0.0) || (eta_hall != 0.0) || (eta_ad != 0.0)) {
-    field_diffusion_defined = true;
+    implicit_ohmic = (eta_ohm != 0.0) &&
+        (pin->GetOrAddString("resistivity", "integrator", "explicit") == "implicit");
+    // implicit Ohmic diffusion is advanced by the multigrid solver outside the explicit
+    // integrators, so it neither enters the STS subset nor limits the time step
+    if (!implicit_ohmic || (eta_hall != 0.0) || (eta_ad != 0.0))
+      field_diffusion_defined = true;
     // Allocate memory for scratch vectors
     etaB.NewAthenaArray(3, nc3, nc2, nc1);
     e_oa.x1e.NewAthenaArray(nc3+1, nc2+1, nc1);
@@ -78,9 +84,11 @@ FieldDiffusion::FieldDiffusion(MeshBlock *pmb, ParameterInput *pin) :
       CalcMagDiffCoeff_ = ConstDiffusivity;
     else
       CalcMagDiffCoeff_ = pmb->pmy_mesh->FieldDiffusivity_;
+    if (implicit_ohmic)
+      pmg = new MGOhmic(pmb->pmy_mesh->pmgohm, pmb);
   }
 
-  if (field_diffusion_defined && RELATIVISTIC_DYNAMICS) {
+  if ((field_diffusion_defined || implicit_ohmic) && RELATIVISTIC_DYNAMICS) {
     std::stringstream msg;
     msg << "### FATAL ERROR in FieldDiffusion" << std::endl
         << "Diffusion is incompatibile with relativistic dynamics" << std::endl;
@@ -88,6 +96,12 @@ FieldDiffusion::FieldDiffusion(MeshBlock *pmb, ParameterInput *pin) :
   }
 }
 
+//! FieldDiffusion destructor
+
+FieldDiffusion::~FieldDiffusion() {
+  delete pmg;
+}
+
 
 //----------------------------------------------------------------------------------------
 //! \fn void FieldDiffusion::CalcDiffusionEMF
@@ -99,13 +113,14 @@ void FieldDiffusion::CalcDiffusionEMF(FaceField &bi, const AthenaArray<Real> &bc
   Hydro *ph = pmy_block->phydro;
   // Mesh  *pm = pmy_block->pmy_mesh; // unused variable
 
-  if ((eta_ohm == 0.0) && (eta_ad == 0.0)) return;
+  const bool explicit_ohmic = (eta_ohm != 0.0) && !implicit_ohmic;
+  if (!explicit_ohmic && (eta_ad == 0.0)) return;
 
   SetDiffusivity(ph->w, pf->bcc);
 
   CalcCurrent(bi);
   ClearEMF(e_oa);
-  if (eta_ohm != 0.0) OhmicEMF(bi, bc, e_oa);
+  if (explicit_ohmic) OhmicEMF(bi, bc, e_oa);
   if (eta_ad != 0.0) AmbipolarEMF(bi, bc, e_oa);
 
   // calculate the Poynting flux pflux and add to energy flux in Hydro class
@@ -270,7 +285,7 @@ void FieldDiffusion::NewDiffusionDt(Real &dt_oa, Real &dt_h) {
       for (int i=is; i<=ie; ++i) {
         eta_t(i) = 0.0;
       }
-      if (eta_ohm > 0.0) {
+      if (eta_ohm > 0.0 && !implicit_ohmic) {
 #pragma omp simd
         for (int i=is; i<=ie; ++i) {
           eta_t(i) += etaB(ohmic,k,j,i);
@@ -290,7 +305,7 @@ void FieldDiffusion::NewDiffusionDt(Real &dt_oa, Real &dt_h) {
         len(i) = (f2) ? std::min(len(i), dx2(i)):len(i);
         len(i) = (f3) ? std::min(len(i), dx3(i)):len(i);
       }
-      if ((eta_ohm > 0.0) || (eta_ad > 0.0)) {
+      if ((eta_ohm > 0.0 && !implicit_ohmic) || (eta_ad > 0.0)) {
         for (int i=is; i<=ie; ++i)
           dt_oa = std::min(dt_oa, static_cast<Real>(
               fac_oa*SQR(len(i)) / (eta_t(i) + TINY_NUMBER)));
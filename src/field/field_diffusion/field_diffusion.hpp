@@ -21,6 +21,7 @@ class Field;
 class Hydro;
 class ParameterInput;
 class Coordinates;
+class MGOhmic;
 
 class FieldDiffusion;
 
@@ -36,10 +37,13 @@ void ConstDiffusivity(FieldDiffusion *pfdif, MeshBlock *pmb, const AthenaArray<R
 class FieldDiffusion {
  public:
   FieldDiffusion(MeshBlock *pmb, ParameterInput *pin);
+  ~FieldDiffusion();
 
   // data
   MeshBlock* pmy_block;
   bool field_diffusion_defined;
+  bool implicit_ohmic; // Ohmic diffusion integrated by the multigrid implicit solver
+  MGOhmic *pmg;        // per-block multigrid object for implicit Ohmic diffusion
   Real eta_ohm, eta_hall, eta_ad;
   AthenaArray<Real> etaB; // 4-dim array, covering O/H/A altogether
   EdgeField e_oa, e_h;     // edge-centered electric field from non-ideal MHD
@@ -0,0 +1,311 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_ohmic.cpp
+//! \brief implicit Ohmic diffusion using the Multigrid solver
+//!
+//! The induction equation is split off and advanced with the theta scheme
+//!   B^{n+1} = B^n - dt curl E,  E = eta curl(B^n + theta (B^{n+1} - B^n)).
+//! Eliminating B^{n+1} and using curl curl = -Laplacian for the divergence-free E of a
+//! uniform eta gives one elliptic equation per edge component,
+//!   E - theta dt div(eta grad E) = eta J^n,
+//! which is solved on the edge grid with the operator of MGConduction. The face fields
+//! are then updated by constrained transport with E, so div(B) is kept to round-off, and
+//! the total energy by the Poynting flux of E. With a spatially varying eta the face
+//! averages of eta make this a linearly implicit approximation of the same order.
+
+// C headers
+
+// C++ headers
+#include <iostream>
+#include <sstream>    // sstream
+#include <stdexcept>  // runtime_error
+#include <string>     // c_str()
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../bvals/bvals.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../hydro/hydro.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../multigrid/multigrid.hpp"
+#include "../../parameter_input.hpp"
+#include "../field.hpp"
+#include "field_diffusion.hpp"
+#include "mg_ohmic.hpp"
+
+namespace {
+//! \fn inline Real EdgeEta(const AthenaArray<Real> &eta, int ak, int aj, int ai,
+//!                         int bk, int bj, int bi, int k, int j, int i)
+//! \brief Ohmic diffusivity at edge (k,j,i), averaged over the four cells sharing it as
+//!        in FieldDiffusion::OhmicEMF; (ak,aj,ai) and (bk,bj,bi) point across the edge
+
+inline Real EdgeEta(const AthenaArray<Real> &eta, int ak, int aj, int ai,
+                    int bk, int bj, int bi, int k, int j, int i) {
+  return 0.25*(eta(FieldDiffusion::ohmic,k,j,i)
+             + eta(FieldDiffusion::ohmic,k-ak,j-aj,i-ai)
+             + eta(FieldDiffusion::ohmic,k-bk,j-bj,i-bi)
+             + eta(FieldDiffusion::ohmic,k-ak-bk,j-aj-bj,i-ai-bi));
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn MGOhmicDriver::MGOhmicDriver(Mesh *pm, ParameterInput *pin)
+//! \brief MGOhmicDriver constructor
+
+MGOhmicDriver::MGOhmicDriver(Mesh *pm, ParameterInput *pin)
+    : MGConductionDriver(pm, pin, "resistivity") {
+  if (pin->GetOrAddReal("problem", "eta_ohm", 0.0) <= 0.0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGOhmicDriver::MGOhmicDriver" << std::endl
+        << "Implicit Ohmic diffusion requires eta_ohm in the <problem> block."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  // the EMF lives on the edges, which are shared by the MeshBlocks only with periodic
+  // boundaries; the physical boundaries of an edge grid are not implemented
+  for (int f = 0; f < 6; ++f) {
+    if (pm->mesh_bcs[f] != BoundaryFlag::periodic) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in MGOhmicDriver::MGOhmicDriver" << std::endl
+          << "Implicit Ohmic diffusion currently supports only periodic boundaries."
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    mg_mesh_bcs_[f] = BoundaryFlag::periodic;
+  }
+  AllocateSolver();
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGOhmic::MGOhmic(MultigridDriver *pmd, MeshBlock *pmb)
+//! \brief MGOhmic constructor
+
+MGOhmic::MGOhmic(MultigridDriver *pmd, MeshBlock *pmb) : MGConduction(pmd, pmb) {
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmicDriver::Solve(int stage)
+//! \brief solve for the three EMF components in turn and update the field and energy
+
+void MGOhmicDriver::Solve(int stage) {
+  const Real dt = pmy_mesh_->dt;
+  // Construct the Multigrid array
+  vmg_.clear();
+  for (int i = 0; i < pmy_mesh_->nblocal; ++i)
+    vmg_.push_back(pmy_mesh_->my_blocks(i)->pfield->fdif.pmg);
+
+#pragma omp parallel for num_threads(nthreads_)
+  for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+    MGOhmic *pmg = static_cast<MGOhmic*>(*itr);
+    pmg->CalculateExplicitEMF();
+  }
+
+  for (int dir = X1DIR; dir <= X3DIR; ++dir) {
+#pragma omp parallel for num_threads(nthreads_)
+    for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+      MGOhmic *pmg = static_cast<MGOhmic*>(*itr);
+      pmg->LoadOhmicData(dir, dt, theta_);
+      pmg->RestrictCoefficients();
+    }
+
+    SetupMultigrid();
+    TransferCoefficientsToRoot();
+
+    if (mode_ == 0) {
+      SolveFMGCycle();
+    } else {
+      if (eps_ >= 0.0)
+        SolveIterative();
+      else
+        SolveIterativeFixedTimes();
+    }
+
+#pragma omp parallel for num_threads(nthreads_)
+    for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+      MGOhmic *pmg = static_cast<MGOhmic*>(*itr);
+      pmg->RetrieveOhmicEMF(dir);
+    }
+  }
+
+#pragma omp parallel for num_threads(nthreads_)
+  for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+    MGOhmic *pmg = static_cast<MGOhmic*>(*itr);
+    pmg->ApplyOhmicUpdate(dt);
+  }
+
+  ExchangeFieldBoundaries();
+  ExchangeHydroBoundaries();
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmicDriver::ExchangeFieldBoundaries()
+//! \brief refresh the ghost faces and the cell-centered field after the CT update
+
+void MGOhmicDriver::ExchangeFieldBoundaries() {
+  Mesh *pm = pmy_mesh_;
+  const int nblocal = pm->nblocal;
+
+  // mesh_init exchanges the face fields only, without the EMF flux correction
+#pragma omp parallel num_threads(nthreads_)
+  {
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b)
+      pm->my_blocks(b)->pfield->fbvar.StartReceiving(BoundaryCommSubset::mesh_init);
+
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b)
+      pm->my_blocks(b)->pfield->fbvar.SendBoundaryBuffers();
+
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b) {
+      MeshBlock *pmb = pm->my_blocks(b);
+      Field *pf = pmb->pfield;
+      pf->fbvar.ReceiveAndSetBoundariesWithWait();
+      pf->fbvar.ClearBoundary(BoundaryCommSubset::mesh_init);
+      pf->CalculateCellCenteredField(pf->b, pf->bcc, pmb->pcoord,
+                                     pmb->is - NGHOST, pmb->ie + NGHOST,
+                                     pmb->js - NGHOST, pmb->je + NGHOST,
+                                     pmb->ks - NGHOST, pmb->ke + NGHOST);
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmic::CalculateExplicitEMF()
+//! \brief store the explicit Ohmic EMF eta J^n of the MeshBlock in FieldDiffusion::e_oa
+
+void MGOhmic::CalculateExplicitEMF() {
+  MeshBlock *pmb = pmy_block_;
+  Field *pf = pmb->pfield;
+  FieldDiffusion &fd = pf->fdif;
+  fd.SetDiffusivity(pmb->phydro->w, pf->bcc);
+  fd.CalcCurrent(pf->b);
+  fd.ClearEMF(fd.e_oa);
+  fd.OhmicEMF(pf->b, pf->bcc, fd.e_oa);
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmic::LoadOhmicData(int dir, Real dt, Real theta)
+//! \brief load eta J^n of the EMF component along dir as the source, set the
+//!        coefficients on the finest level and clear the initial guess
+//!
+//! The Multigrid cell (mk,mj,mi) holds the edge (k,j,i) of the MeshBlock, i.e. the edge
+//! on the lower faces of cell (k,j,i) normal to the two directions other than dir.
+
+void MGOhmic::LoadOhmicData(int dir, Real dt, Real theta) {
+  MeshBlock *pmb = pmy_block_;
+  FieldDiffusion &fd = pmb->pfield->fdif;
+  const AthenaArray<Real> &eta = fd.etaB;
+  const AthenaArray<Real> &emf = (dir == X1DIR) ? fd.e_oa.x1e :
+                                 ((dir == X2DIR) ? fd.e_oa.x2e : fd.e_oa.x3e);
+  const int is = pmb->is, ie = pmb->ie, js = pmb->js, je = pmb->je,
+            ks = pmb->ks, ke = pmb->ke;
+  const int os = ngh_;
+  const Real dtheta = theta*dt;
+  // offsets to the cells sharing the edge
+  const int ak = 0, aj = (dir == X1DIR), ai = (dir != X1DIR);
+  const int bk = (dir != X3DIR), bj = (dir == X3DIR), bi = 0;
+
+  current_level_ = nlevel_-1;
+  AthenaArray<Real> &cf = coeff_[current_level_];
+  AthenaArray<Real> &src = src_[current_level_];
+  u_[current_level_].ZeroClear();
+
+  for (int k=ks; k<=ke+1; ++k) {
+    int mk = k - ks + os;
+    for (int j=js; j<=je+1; ++j) {
+      int mj = j - js + os;
+      for (int i=is; i<=ie+1; ++i) {
+        int mi = i - is + os;
+        Real etac = EdgeEta(eta, ak, aj, ai, bk, bj, bi, k, j, i);
+        if (k <= ke && j <= je && i <= ie) {
+          src(0,mk,mj,mi) = emf(k,j,i);
+          cf(ICC,mk,mj,mi) = 1.0;
+        }
+        if (k <= ke && j <= je)
+          cf(IK1,mk,mj,mi) = dtheta*0.5*(etac
+                           + EdgeEta(eta, ak, aj, ai, bk, bj, bi, k, j, i-1));
+        if (k <= ke && i <= ie)
+          cf(IK2,mk,mj,mi) = dtheta*0.5*(etac
+                           + EdgeEta(eta, ak, aj, ai, bk, bj, bi, k, j-1, i));
+        if (j <= je && i <= ie)
+          cf(IK3,mk,mj,mi) = dtheta*0.5*(etac
+                           + EdgeEta(eta, ak, aj, ai, bk, bj, bi, k-1, j, i));
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmic::RetrieveOhmicEMF(int dir)
+//! \brief copy the solved EMF component along dir into Field::e, including the edges
+//!        on the upper faces that are owned by the neighbors
+//!
+//! The last step of the Multigrid cycle exchanges the ghost cells of the finest level,
+//! so both MeshBlocks sharing an edge use the same EMF and the shared faces agree.
+
+void MGOhmic::RetrieveOhmicEMF(int dir) {
+  MeshBlock *pmb = pmy_block_;
+  EdgeField &e = pmb->pfield->e;
+  AthenaArray<Real> &emf = (dir == X1DIR) ? e.x1e : ((dir == X2DIR) ? e.x2e : e.x3e);
+  const AthenaArray<Real> &src = u_[nlevel_-1];
+  const int is = pmb->is, ie = pmb->ie, js = pmb->js, je = pmb->je,
+            ks = pmb->ks, ke = pmb->ke;
+  const int os = ngh_;
+  for (int k=ks-1; k<=ke+1; ++k) {
+    int mk = k - ks + os;
+    for (int j=js-1; j<=je+1; ++j) {
+      int mj = j - js + os;
+#pragma omp simd
+      for (int i=is-1; i<=ie+1; ++i) {
+        int mi = i - is + os;
+        emf(k,j,i) = src(0,mk,mj,mi);
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGOhmic::ApplyOhmicUpdate(Real dt)
+//! \brief update the total energy by the Poynting flux and the face fields by CT
+
+void MGOhmic::ApplyOhmicUpdate(Real dt) {
+  MeshBlock *pmb = pmy_block_;
+  Field *pf = pmb->pfield;
+  Coordinates *pco = pmb->pcoord;
+  if (NON_BAROTROPIC_EOS) {
+    FieldDiffusion &fd = pf->fdif;
+    fd.PoyntingFlux(pf->e, pf->bcc);
+    AthenaArray<Real> &u = pmb->phydro->u;
+    const AthenaArray<Real> &f1 = fd.pflux.x1f, &f2 = fd.pflux.x2f,
+                            &f3 = fd.pflux.x3f;
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp simd
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          u(IEN,k,j,i) -= dt*((f1(k,j,i+1) - f1(k,j,i))/pco->dx1f(i)
+                            + (f2(k,j+1,i) - f2(k,j,i))/pco->dx2f(j)
+                            + (f3(k+1,j,i) - f3(k,j,i))/pco->dx3f(k));
+        }
+      }
+    }
+  }
+  pf->CT(dt, pf->b);
+  return;
+}
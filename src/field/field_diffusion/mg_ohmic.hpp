@@ -0,0 +1,54 @@
+#ifndef FIELD_FIELD_DIFFUSION_MG_OHMIC_HPP_
+#define FIELD_FIELD_DIFFUSION_MG_OHMIC_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_ohmic.hpp
+//! \brief defines MGOhmic and MGOhmicDriver classes
+//!
+//! Implicit (backward Euler / Crank-Nicolson) Ohmic diffusion on the Multigrid solver
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../hydro/hydro_diffusion/mg_conduction.hpp"
+
+class MeshBlock;
+class ParameterInput;
+
+//! \class MGOhmic
+//! \brief Multigrid implicit Ohmic diffusion solver for each block
+//!
+//! Each component of the edge-centered EMF lives on a uniform grid shifted by half a
+//! cell, which is solved as the cell-centered operator of MGConduction with a unit cell
+//! coefficient and the face conductances theta dt eta_f.
+
+class MGOhmic : public MGConduction {
+ public:
+  MGOhmic(MultigridDriver *pmd, MeshBlock *pmb);
+
+  void CalculateExplicitEMF();
+  void LoadOhmicData(int dir, Real dt, Real theta);
+  void RetrieveOhmicEMF(int dir);
+  void ApplyOhmicUpdate(Real dt);
+};
+
+
+//! \class MGOhmicDriver
+//! \brief Multigrid implicit Ohmic diffusion solver
+
+class MGOhmicDriver : public MGConductionDriver {
+ public:
+  MGOhmicDriver(Mesh *pm, ParameterInput *pin);
+  void Solve(int stage) final;
+ private:
+  void ExchangeFieldBoundaries();
+};
+
+#endif // FIELD_FIELD_DIFFUSION_MG_OHMIC_HPP_
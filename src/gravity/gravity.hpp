@@ -25,6 +25,7 @@ class Coordinates;
 class GravityBoundaryValues;
 class MGGravity;
 class MGGravityDriver;
+class GravitySolveCadence;
 
 //! \class Gravity
 //! \brief gravitational potential data and functions
@@ -51,12 +52,17 @@ class Gravity {
   void ExpandPhysicalBoundaries();
 
   friend class MGGravityDriver;
+  friend class GravitySolveCadence;
 
  private:
   MGGravity *pmg;
   bool gravity_tensor_momentum_;
   bool gravity_tensor_energy_;
   AthenaArray<Real> fbuf_[6];
+  // last two solutions and the density of the last solve, for GravitySolveCadence
+  AthenaArray<Real> phi_old_[2], rho_solve_;
+  Real t_old_[2];
+  int nold_;
 };
 
 #endif // GRAVITY_GRAVITY_HPP_
@@ -0,0 +1,236 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file gravity_cadence.cpp
+//! \brief implementation of the self-gravity solve cadence control
+//!
+//! By default the Poisson equation is solved after every main integrator stage. With
+//! <gravity> solve_interval = N the solve is done only every N stages (or every N steps
+//! with solve_unit = step, in which case the solve is done at the end of the step), and
+//! with drho_threshold > 0 it is also done whenever the density has changed by more than
+//! that fraction anywhere since the last solve. In between, phi is extrapolated linearly
+//! in time from the last two solutions. The iterative multigrid solver (mgmode = MGI)
+//! starts from the extrapolated potential. At every solve the difference between the
+//! solution and the extrapolation is measured and reported in the history output.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max, min
+#include <cmath>      // abs
+#include <cstring>    // memcpy
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "fft_gravity.hpp"
+#include "gravity.hpp"
+#include "gravity_cadence.hpp"
+#include "mg_gravity.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn GravitySolveCadence::GravitySolveCadence(Mesh *pm, ParameterInput *pin)
+//! \brief GravitySolveCadence constructor
+
+GravitySolveCadence::GravitySolveCadence(Mesh *pm, ParameterInput *pin) :
+    nsolve(0), error(0.0), pmy_mesh_(pm),
+    interval_(pin->GetOrAddInteger("gravity", "solve_interval", 1)),
+    per_step_(pin->GetOrAddString("gravity", "solve_unit", "stage") == "step"),
+    drho_(pin->GetOrAddReal("gravity", "drho_threshold", -1.0)), ncall_(0) {
+  std::string unit = pin->GetString("gravity", "solve_unit");
+  if (interval_ < 1 || (unit != "stage" && unit != "step")) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in GravitySolveCadence::GravitySolveCadence" << std::endl
+        << "\"solve_interval\" in the <gravity> block must be >= 1 and "
+        << "\"solve_unit\" must be either \"stage\" or \"step\"." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn bool GravitySolveCadence::Enabled(ParameterInput *pin)
+//! \brief whether the input requests anything other than a solve after every stage
+
+bool GravitySolveCadence::Enabled(ParameterInput *pin) {
+  return (pin->GetOrAddInteger("gravity", "solve_interval", 1) != 1
+          || pin->GetOrAddString("gravity", "solve_unit", "stage") != "stage"
+          || pin->GetOrAddReal("gravity", "drho_threshold", -1.0) > 0.0);
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void GravitySolveCadence::Solve(int stage, bool end_of_step, Real time)
+//! \brief solve or extrapolate phi to the time at the end of the integrator stage
+
+void GravitySolveCadence::Solve(int stage, bool end_of_step, Real time) {
+  if (!SolveRequired(end_of_step)) {
+    Extrapolate(time);
+    return;
+  }
+
+  if (SELF_GRAVITY_ENABLED == 1) {
+    pmy_mesh_->pfgrd->Solve(stage, 0);
+  } else if (SELF_GRAVITY_ENABLED == 2) {
+    Extrapolate(time); // initial guess for the iterative multigrid
+    pmy_mesh_->pmgrd->Solve(stage);
+  }
+  StoreSolution(time);
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn bool GravitySolveCadence::SolveRequired(bool end_of_step)
+//! \brief decide whether the Poisson equation must be solved at this stage. The
+//!        decision is made identically on all ranks.
+
+bool GravitySolveCadence::SolveRequired(bool end_of_step) {
+  if (!per_step_ || end_of_step) ncall_++;
+  if ((!per_step_ || end_of_step) && ncall_ >= interval_) return true;
+
+  // blocks without a stored solution (new after AMR or load balancing, or restart)
+  int required = 0;
+  Mesh *pm = pmy_mesh_;
+  for (int b=0; b<pm->nblocal; ++b) {
+    if (pm->my_blocks(b)->pgrav->nold_ == 0) {
+      required = 1;
+      break;
+    }
+  }
+
+  if (required == 0 && drho_ > 0.0) {
+    Real drmax = 0.0;
+#pragma omp parallel for num_threads(pm->GetNumMeshThreads()) reduction(max: drmax)
+    for (int b=0; b<pm->nblocal; ++b) {
+      MeshBlock *pmb = pm->my_blocks(b);
+      const AthenaArray<Real> &u = pmb->phydro->u, &rs = pmb->pgrav->rho_solve_;
+      for (int k=pmb->ks; k<=pmb->ke; ++k) {
+        for (int j=pmb->js; j<=pmb->je; ++j) {
+          for (int i=pmb->is; i<=pmb->ie; ++i)
+            drmax = std::max(drmax, std::abs(u(IDN,k,j,i) - rs(k,j,i))/rs(k,j,i));
+        }
+      }
+    }
+    if (drmax > drho_) required = 1;
+  }
+
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &required, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  return (required != 0);
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void GravitySolveCadence::Extrapolate(Real time)
+//! \brief linear extrapolation of phi (including ghost cells) from the last two solutions
+
+void GravitySolveCadence::Extrapolate(Real time) {
+  Mesh *pm = pmy_mesh_;
+#pragma omp parallel for num_threads(pm->GetNumMeshThreads())
+  for (int b=0; b<pm->nblocal; ++b) {
+    Gravity *pgrav = pm->my_blocks(b)->pgrav;
+    if (pgrav->nold_ == 0) continue;
+    AthenaArray<Real> &phi = pgrav->phi;
+    const AthenaArray<Real> &p0 = pgrav->phi_old_[0], &p1 = pgrav->phi_old_[1];
+    if (pgrav->nold_ == 1) {
+      std::memcpy(phi.data(), p0.data(), phi.GetSizeInBytes());
+      continue;
+    }
+    Real w = (time - pgrav->t_old_[0])/(pgrav->t_old_[0] - pgrav->t_old_[1]);
+    Real *pp = phi.data();
+    const Real *pp0 = p0.data(), *pp1 = p1.data();
+    const int n = phi.GetSize();
+#pragma omp simd
+    for (int m=0; m<n; ++m)
+      pp[m] = pp0[m] + w*(pp0[m] - pp1[m]);
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void GravitySolveCadence::MeasureError(Real time)
+//! \brief max norm of the difference between the new solution and the extrapolation,
+//!        relative to the max norm of the solution
+
+void GravitySolveCadence::MeasureError(Real time) {
+  Mesh *pm = pmy_mesh_;
+  Real dmax = 0.0, pmax = 0.0;
+#pragma omp parallel for num_threads(pm->GetNumMeshThreads()) reduction(max: dmax, pmax)
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    Gravity *pgrav = pmb->pgrav;
+    if (pgrav->nold_ == 0) continue;
+    const AthenaArray<Real> &phi = pgrav->phi;
+    const AthenaArray<Real> &p0 = pgrav->phi_old_[0], &p1 = pgrav->phi_old_[1];
+    Real w = 0.0;
+    if (pgrav->nold_ == 2)
+      w = (time - pgrav->t_old_[0])/(pgrav->t_old_[0] - pgrav->t_old_[1]);
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real pe = p0(k,j,i);
+          if (pgrav->nold_ == 2) pe += w*(p0(k,j,i) - p1(k,j,i));
+          dmax = std::max(dmax, std::abs(phi(k,j,i) - pe));
+          pmax = std::max(pmax, std::abs(phi(k,j,i)));
+        }
+      }
+    }
+  }
+  Real norm[2] = {dmax, pmax};
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, norm, 2, MPI_ATHENA_REAL, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  if (norm[1] > 0.0)
+    error = norm[0]/norm[1];
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void GravitySolveCadence::StoreSolution(Real time)
+//! \brief store the new solution and density, and measure the extrapolation error
+
+void GravitySolveCadence::StoreSolution(Real time) {
+  MeasureError(time);
+  Mesh *pm = pmy_mesh_;
+#pragma omp parallel for num_threads(pm->GetNumMeshThreads())
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    Gravity *pgrav = pmb->pgrav;
+    if (pgrav->phi_old_[0].IsEmpty()) {
+      pgrav->phi_old_[0].NewAthenaArray(pmb->ncells3, pmb->ncells2, pmb->ncells1);
+      pgrav->phi_old_[1].NewAthenaArray(pmb->ncells3, pmb->ncells2, pmb->ncells1);
+      pgrav->rho_solve_.NewAthenaArray(pmb->ncells3, pmb->ncells2, pmb->ncells1);
+    }
+    // a repeated solve at the same time (e.g. during the initial refinement) replaces
+    // the last solution instead of producing a degenerate extrapolation
+    if (pgrav->nold_ == 0 || time != pgrav->t_old_[0]) {
+      pgrav->phi_old_[0].SwapAthenaArray(pgrav->phi_old_[1]);
+      pgrav->t_old_[1] = pgrav->t_old_[0];
+      pgrav->nold_ = std::min(pgrav->nold_ + 1, 2);
+    }
+    std::memcpy(pgrav->phi_old_[0].data(), pgrav->phi.data(),
+                pgrav->phi.GetSizeInBytes());
+    pgrav->t_old_[0] = time;
+    std::memcpy(pgrav->rho_solve_.data(), &(pmb->phydro->u(IDN,0,0,0)),
+                pgrav->rho_solve_.GetSizeInBytes());
+  }
+  nsolve++;
+  ncall_ = 0;
+  return;
+}
@@ -0,0 +1,49 @@
+#ifndef GRAVITY_GRAVITY_CADENCE_HPP_
+#define GRAVITY_GRAVITY_CADENCE_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file gravity_cadence.hpp
+//! \brief defines GravitySolveCadence class, which controls how often the self-gravity
+//!        solver is called and extrapolates the potential in time between the solves
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../athena.hpp"
+
+class Mesh;
+class ParameterInput;
+
+//! \class GravitySolveCadence
+//! \brief solves self-gravity every N stages or steps, or when the density has changed
+//!        by more than a threshold, and extrapolates phi linearly in time otherwise
+
+class GravitySolveCadence {
+ public:
+  GravitySolveCadence(Mesh *pm, ParameterInput *pin);
+
+  static bool Enabled(ParameterInput *pin);
+  void Solve(int stage, bool end_of_step, Real time);
+  void StoreSolution(Real time);
+
+  int nsolve;      // number of Poisson solves since the start of this run
+  Real error;      // relative error of the extrapolation measured at the last solve
+
+ private:
+  Mesh *pmy_mesh_;
+  int interval_;   // solve every interval_ stages (or steps, if per_step_)
+  bool per_step_;
+  Real drho_;      // solve when max |rho - rho_solve|/rho_solve exceeds this (if > 0)
+  int ncall_;      // stages (or steps) since the last solve
+
+  bool SolveRequired(bool end_of_step);
+  void Extrapolate(Real time);
+  void MeasureError(Real time);
+};
+
+#endif // GRAVITY_GRAVITY_CADENCE_HPP_
@@ -18,6 +18,7 @@
 #include "../athena_arrays.hpp"
 #include "../coordinates/coordinates.hpp"
 #include "../mesh/mesh.hpp"
+#include "../utils/perf_counters.hpp"
 #include "hydro.hpp"
 
 // OpenMP header
@@ -38,6 +39,8 @@
 // used)
 void Hydro::AddFluxDivergence(const Real wght, AthenaArray<Real> &u_out) {
   MeshBlock *pmb = pmy_block;
+  PerfCounters::Scope perf(PerfCounters::add_flux_divergence,
+                           pmb->GetNumberOfMeshBlockCells());
   AthenaArray<Real> &x1flux = flux[X1DIR];
   AthenaArray<Real> &x2flux = flux[X2DIR];
   AthenaArray<Real> &x3flux = flux[X3DIR];
@@ -21,6 +21,7 @@
 #include "../gravity/gravity.hpp"
 #include "../reconstruct/reconstruction.hpp"
 #include "../scalars/scalars.hpp"
+#include "../utils/perf_counters.hpp"
 #include "hydro.hpp"
 #include "hydro_diffusion/hydro_diffusion.hpp"
 
@@ -36,6 +37,8 @@
 void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
                             AthenaArray<Real> &bcc, const int order) {
   MeshBlock *pmb = pmy_block;
+  PerfCounters::Scope perf(PerfCounters::calculate_fluxes,
+                           pmb->GetNumberOfMeshBlockCells());
   int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
   int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
   int il, iu, jl, ju, kl, ku;
@@ -392,7 +395,8 @@ void Hydro::AddDiffusionFluxes() {
     if (hdif.nu_iso > 0.0 || hdif.nu_aniso > 0.0)
       hdif.AddDiffusionFlux(hdif.visflx,flux);
     if (NON_BAROTROPIC_EOS) {
-      if (hdif.kappa_iso > 0.0 || hdif.kappa_aniso > 0.0)
+      if ((hdif.kappa_iso > 0.0 || hdif.kappa_aniso > 0.0)
+          && !hdif.implicit_conduction)
         hdif.AddDiffusionEnergyFlux(hdif.cndflx,flux);
     }
   }
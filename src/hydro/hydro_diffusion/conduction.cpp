@@ -9,6 +9,8 @@
 // C headers
 
 // C++ headers
+#include <algorithm>  // min()
+#include <cmath>      // abs(), copysign()
 
 // Athena++ headers
 #include "../../athena.hpp"
@@ -19,6 +21,19 @@
 #include "../hydro.hpp"
 #include "hydro_diffusion.hpp"
 
+namespace {
+//! monotonized central limiter of two slopes
+inline Real MCLimiter(Real a, Real b) {
+  Real mc = std::min(0.5*std::abs(a + b), 2.0*std::min(std::abs(a), std::abs(b)));
+  return (a*b > 0.0) ? std::copysign(mc, a) : 0.0;
+}
+
+//! limited transverse gradient at a face from the four adjacent one-sided differences
+inline Real LimitedGradient(Real a, Real b, Real c, Real d) {
+  return MCLimiter(MCLimiter(a, b), MCLimiter(c, d));
+}
+} // namespace
+
 //---------------------------------------------------------------------------------------
 //! Calculate isotropic thermal conduction
 
@@ -107,10 +122,142 @@ void HydroDiffusion::ThermalFluxIso(
 
 
 //---------------------------------------------------------------------------------------
-//! Calculate anisotropic thermal conduction
+//! Calculate anisotropic (field-aligned) thermal conduction
+//!
+//! The heat flux is -kappa*rho*b(b.grad T). The temperature gradient normal to each face
+//! is centered; the transverse gradients are limited with the monotonized central
+//! limiter applied to the four adjacent one-sided differences, which keeps the scheme
+//! from creating new temperature extrema (Sharma & Hammett 2007, JCP, 227, 123).
 
 void HydroDiffusion::ThermalFluxAniso(
-     const AthenaArray<Real> &p, AthenaArray<Real> *flx) {
+     const AthenaArray<Real> &p, const AthenaArray<Real> &bc, AthenaArray<Real> *flx) {
+  const bool f2 = pmb_->pmy_mesh->f2;
+  const bool f3 = pmb_->pmy_mesh->f3;
+  AthenaArray<Real> &x1flux = flx[X1DIR];
+  AthenaArray<Real> &t = temp_;
+  int il, iu, jl, ju, kl, ku;
+  int is = pmb_->is; int js = pmb_->js; int ks = pmb_->ks;
+  int ie = pmb_->ie; int je = pmb_->je; int ke = pmb_->ke;
+
+  il = is - NGHOST, iu = ie + NGHOST, jl = js, ju = je, kl = ks, ku = ke;
+  if (f2) jl -= NGHOST, ju += NGHOST;
+  if (f3) kl -= NGHOST, ku += NGHOST;
+  for (int k=kl; k<=ku; ++k) {
+    for (int j=jl; j<=ju; ++j) {
+#pragma omp simd
+      for (int i=il; i<=iu; ++i)
+        t(k,j,i) = p(IPR,k,j,i)/p(IDN,k,j,i);
+    }
+  }
+
+  // i-direction
+  jl = js, ju = je, kl = ks, ku = ke;
+  if (f2) {
+    if (!f3) // 2D
+      jl = js - 1, ju = je + 1, kl = ks, ku = ke;
+    else // 3D
+      jl = js - 1, ju = je + 1, kl = ks - 1, ku = ke + 1;
+  }
+  for (int k=kl; k<=ku; ++k) {
+    for (int j=jl; j<=ju; ++j) {
+#pragma omp simd
+      for (int i=is; i<=ie+1; ++i) {
+        Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k,j,i-1));
+        Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k,j,i-1));
+        Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k,j,i-1));
+        Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+        Real ibsq = (bsq > TINY_NUMBER) ? 1.0/bsq : 0.0;
+        Real kappaf = 0.5*(kappa(DiffProcess::aniso,k,j,i)
+                           + kappa(DiffProcess::aniso,k,j,i-1));
+        Real denf = 0.5*(p(IDN,k,j,i) + p(IDN,k,j,i-1));
+        Real dTdx = (t(k,j,i) - t(k,j,i-1))/pco_->dx1v(i-1);
+        Real dTdy = 0.0, dTdz = 0.0;
+        if (f2)
+          dTdy = LimitedGradient((t(k,j+1,i) - t(k,j,i))/pco_->dx2v(j),
+                                 (t(k,j,i) - t(k,j-1,i))/pco_->dx2v(j-1),
+                                 (t(k,j+1,i-1) - t(k,j,i-1))/pco_->dx2v(j),
+                                 (t(k,j,i-1) - t(k,j-1,i-1))/pco_->dx2v(j-1))
+                 /pco_->h2f(i);
+        if (f3)
+          dTdz = LimitedGradient((t(k+1,j,i) - t(k,j,i))/pco_->dx3v(k),
+                                 (t(k,j,i) - t(k-1,j,i))/pco_->dx3v(k-1),
+                                 (t(k+1,j,i-1) - t(k,j,i-1))/pco_->dx3v(k),
+                                 (t(k,j,i-1) - t(k-1,j,i-1))/pco_->dx3v(k-1))
+                 /pco_->h31f(i)/pco_->h32v(j);
+        x1flux(k,j,i) -= kappaf*denf*bx*(bx*dTdx + by*dTdy + bz*dTdz)*ibsq;
+      }
+    }
+  }
+
+  // j-direction
+  if (!f3) // 2D
+    il = is - 1, iu = ie + 1, kl = ks, ku = ke;
+  else // 3D
+    il = is - 1, iu = ie + 1, kl = ks - 1, ku = ke + 1;
+  if (f2) { // 2D or 3D
+    AthenaArray<Real> &x2flux = flx[X2DIR];
+    for (int k=kl; k<=ku; ++k) {
+      for (int j=js; j<=je+1; ++j) {
+#pragma omp simd
+        for (int i=il; i<=iu; ++i) {
+          Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k,j-1,i));
+          Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k,j-1,i));
+          Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k,j-1,i));
+          Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+          Real ibsq = (bsq > TINY_NUMBER) ? 1.0/bsq : 0.0;
+          Real kappaf = 0.5*(kappa(DiffProcess::aniso,k,j,i)
+                             + kappa(DiffProcess::aniso,k,j-1,i));
+          Real denf = 0.5*(p(IDN,k,j,i) + p(IDN,k,j-1,i));
+          Real dTdx = LimitedGradient((t(k,j,i+1) - t(k,j,i))/pco_->dx1v(i),
+                                      (t(k,j,i) - t(k,j,i-1))/pco_->dx1v(i-1),
+                                      (t(k,j-1,i+1) - t(k,j-1,i))/pco_->dx1v(i),
+                                      (t(k,j-1,i) - t(k,j-1,i-1))/pco_->dx1v(i-1));
+          Real dTdy = (t(k,j,i) - t(k,j-1,i))/pco_->h2v(i)/pco_->dx2v(j-1);
+          Real dTdz = 0.0;
+          if (f3)
+            dTdz = LimitedGradient((t(k+1,j,i) - t(k,j,i))/pco_->dx3v(k),
+                                   (t(k,j,i) - t(k-1,j,i))/pco_->dx3v(k-1),
+                                   (t(k+1,j-1,i) - t(k,j-1,i))/pco_->dx3v(k),
+                                   (t(k,j-1,i) - t(k-1,j-1,i))/pco_->dx3v(k-1))
+                   /pco_->h31v(i)/pco_->h32f(j);
+          x2flux(k,j,i) -= kappaf*denf*by*(bx*dTdx + by*dTdy + bz*dTdz)*ibsq;
+        }
+      }
+    }
+  } // zero flux for 1D
+
+  // k-direction
+  il = is - 1, iu = ie + 1, jl = js - 1, ju = je + 1;
+  if (f3) { // 3D
+    AthenaArray<Real> &x3flux = flx[X3DIR];
+    for (int k=ks; k<=ke+1; ++k) {
+      for (int j=jl; j<=ju; ++j) {
+#pragma omp simd
+        for (int i=il; i<=iu; ++i) {
+          Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k-1,j,i));
+          Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k-1,j,i));
+          Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k-1,j,i));
+          Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+          Real ibsq = (bsq > TINY_NUMBER) ? 1.0/bsq : 0.0;
+          Real kappaf = 0.5*(kappa(DiffProcess::aniso,k,j,i)
+                             + kappa(DiffProcess::aniso,k-1,j,i));
+          Real denf = 0.5*(p(IDN,k,j,i) + p(IDN,k-1,j,i));
+          Real dTdx = LimitedGradient((t(k,j,i+1) - t(k,j,i))/pco_->dx1v(i),
+                                      (t(k,j,i) - t(k,j,i-1))/pco_->dx1v(i-1),
+                                      (t(k-1,j,i+1) - t(k-1,j,i))/pco_->dx1v(i),
+                                      (t(k-1,j,i) - t(k-1,j,i-1))/pco_->dx1v(i-1));
+          Real dTdy = LimitedGradient((t(k,j+1,i) - t(k,j,i))/pco_->dx2v(j),
+                                      (t(k,j,i) - t(k,j-1,i))/pco_->dx2v(j-1),
+                                      (t(k-1,j+1,i) - t(k-1,j,i))/pco_->dx2v(j),
+                                      (t(k-1,j,i) - t(k-1,j-1,i))/pco_->dx2v(j-1))
+                      /pco_->h2v(i);
+          Real dTdz = (t(k,j,i) - t(k-1,j,i))/pco_->dx3v(k-1)/pco_->h31v(i)
+                      /pco_->h32v(j);
+          x3flux(k,j,i) -= kappaf*denf*bz*(bx*dTdx + by*dTdy + bz*dTdz)*ibsq;
+        }
+      }
+    }
+  } // zero flux for 1D/2D
   return;
 }
 
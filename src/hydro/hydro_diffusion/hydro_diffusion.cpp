@@ -26,6 +26,7 @@
 #include "../../parameter_input.hpp"
 #include "../hydro.hpp"
 #include "hydro_diffusion.hpp"
+#include "mg_conduction.hpp"
 
 //! HydroDiffusion constructor
 
@@ -33,7 +34,7 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
     hydro_diffusion_defined(false),
     nu_iso{pin->GetOrAddReal("problem", "nu_iso", 0.0)},
     nu_aniso{pin->GetOrAddReal("problem", "nu_aniso", 0.0)},
-    kappa_iso{}, kappa_aniso{},
+    kappa_iso{}, kappa_aniso{}, implicit_conduction(false), pmg(nullptr),
     pmy_hydro_(phyd), pmb_(pmy_hydro_->pmy_block), pco_(pmb_->pcoord) {
   int nc1 = pmb_->ncells1, nc2 = pmb_->ncells2, nc3 = pmb_->ncells3;
 
@@ -67,7 +68,11 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
     kappa_iso  = pin->GetOrAddReal("problem", "kappa_iso", 0.0); // iso thermal conduction
     kappa_aniso  = pin->GetOrAddReal("problem", "kappa_aniso", 0.0); // aniso conduction
     if (kappa_iso > 0.0 || kappa_aniso > 0.0) {
-      hydro_diffusion_defined = true;
+      implicit_conduction =
+          (pin->GetOrAddString("conduction", "integrator", "explicit") == "implicit");
+      // implicit conduction is advanced by the multigrid solver outside the explicit
+      // integrators, so it neither enters the STS subset nor limits the time step
+      if (!implicit_conduction) hydro_diffusion_defined = true;
       cndflx[X1DIR].NewAthenaArray(nc3, nc2, nc1+1);
       cndflx[X2DIR].NewAthenaArray(nc3, nc2+1, nc1);
       cndflx[X3DIR].NewAthenaArray(nc3+1, nc2, nc1);
@@ -77,10 +82,21 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
         CalcCondCoeff_ = ConstConduction;
       else
         CalcCondCoeff_ = pmb_->pmy_mesh->ConductionCoeff_;
+      if (kappa_aniso > 0.0) {
+        if (!MAGNETIC_FIELDS_ENABLED) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in HydroDiffusion" << std::endl
+              << "Anisotropic thermal conduction requires magnetic fields" << std::endl;
+          ATHENA_ERROR(msg);
+        }
+        temp_.NewAthenaArray(nc3, nc2, nc1);
+      }
+      if (implicit_conduction)
+        pmg = new MGConduction(pmb_->pmy_mesh->pmgcnd, pmb_);
     }
   }
 
-  if (hydro_diffusion_defined && RELATIVISTIC_DYNAMICS) {
+  if ((hydro_diffusion_defined || implicit_conduction) && RELATIVISTIC_DYNAMICS) {
     std::stringstream msg;
     msg << "### FATAL ERROR in HydroDiffusion" << std::endl
         << "Diffusion is incompatibile with relativistic dynamics" << std::endl;
@@ -96,6 +112,11 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
   }
 }
 
+//! HydroDiffusion destructor
+
+HydroDiffusion::~HydroDiffusion() {
+  delete pmg;
+}
 
 //----------------------------------------------------------------------------------------
 //! \fn void HydroDiffusion::CalcDiffusionFlux
@@ -111,9 +132,11 @@ void HydroDiffusion::CalcDiffusionFlux(const AthenaArray<Real> &prim,
   if (nu_iso > 0.0) ViscousFluxIso(prim, iprim, visflx);
   if (nu_aniso > 0.0) ViscousFluxAniso(prim, iprim, visflx);
 
-  if (kappa_iso > 0.0 || kappa_aniso > 0.0) ClearFlux(cndflx);
-  if (kappa_iso > 0.0) ThermalFluxIso(prim, cndflx);
-  if (kappa_aniso > 0.0) ThermalFluxAniso(prim, cndflx);
+  if (!implicit_conduction) {
+    if (kappa_iso > 0.0 || kappa_aniso > 0.0) ClearFlux(cndflx);
+    if (kappa_iso > 0.0) ThermalFluxIso(prim, cndflx);
+    if (kappa_aniso > 0.0) ThermalFluxAniso(prim, bcc, cndflx);
+  }
 
   return;
 }
@@ -293,7 +316,7 @@ void HydroDiffusion::NewDiffusionDt(Real &dt_vis, Real &dt_cnd) {
           dt_vis = std::min(dt_vis, static_cast<Real>(
               SQR(len(i))*fac/(nu_t(i) + TINY_NUMBER)));
       }
-      if ((kappa_iso > 0.0) || (kappa_aniso > 0.0)) {
+      if (((kappa_iso > 0.0) || (kappa_aniso > 0.0)) && !implicit_conduction) {
         for (int i=il; i<=iu; ++i)
           dt_cnd = std::min(dt_cnd, static_cast<Real>(
               SQR(len(i))*fac/(kappa_t(i) + TINY_NUMBER)));
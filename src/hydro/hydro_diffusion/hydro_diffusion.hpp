@@ -23,6 +23,7 @@ class Hydro;
 class ParameterInput;
 class Coordinates;
 class HydroDiffusion;
+class MGConduction;
 
 // currently must be free functions for compatibility with user-defined fn via fn pointers
 void ConstViscosity(HydroDiffusion *phdif, MeshBlock *pmb, const AthenaArray<Real> &w,
@@ -39,6 +40,7 @@ void ConstConduction(HydroDiffusion *phdif, MeshBlock *pmb, const AthenaArray<Re
 class HydroDiffusion {
  public:
   HydroDiffusion(Hydro *phyd, ParameterInput *pin);
+  ~HydroDiffusion();
 
   // data
   bool hydro_diffusion_defined;
@@ -49,6 +51,8 @@ class HydroDiffusion {
   Real kappa_iso, kappa_aniso; // thermal conduction coeff
   AthenaArray<Real> cndflx[3]; // thermal stress tensor
   AthenaArray<Real> kappa; // conduction array
+  bool implicit_conduction; // conduction integrated by the multigrid implicit solver
+  MGConduction *pmg;        // per-block multigrid object for implicit conduction
 
   // array indices for hydro diffusion (conduction & viscosity) variants: directionality
   // should not be scoped (C++11) since enumerators are only used as "int" to index arrays
@@ -74,7 +78,8 @@ class HydroDiffusion {
 
   // thermal conduction
   void ThermalFluxIso(const AthenaArray<Real> &p, AthenaArray<Real> *flx);
-  void ThermalFluxAniso(const AthenaArray<Real> &p, AthenaArray<Real> *flx);
+  void ThermalFluxAniso(const AthenaArray<Real> &p, const AthenaArray<Real> &bc,
+                        AthenaArray<Real> *flx);
 
  private:
   Hydro *pmy_hydro_;  // ptr to Hydro containing this HydroDiffusion
@@ -86,6 +91,7 @@ class HydroDiffusion {
   AthenaArray<Real> fx_, fy_, fz_;
   AthenaArray<Real> dx1_, dx2_, dx3_;
   AthenaArray<Real> nu_tot_, kappa_tot_;
+  AthenaArray<Real> temp_; // temperature for anisotropic conduction
 
   // functions pointer to calculate spatial dependent coefficients
   ViscosityCoeffFunc CalcViscCoeff_;
@@ -0,0 +1,732 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_conduction.cpp
+//! \brief implicit thermal conduction using the Multigrid solver
+//!
+//! The energy equation is split off and advanced with the theta scheme
+//!   c (T^{n+1} - T^n) = dt div(K grad T^n) + theta dt div(K grad (T^{n+1} - T^n)),
+//! where c = rho/(gamma-1) and K = rho kappa. The right hand side uses the full explicit
+//! conduction flux of HydroDiffusion, so the transverse (cross) terms of the anisotropic
+//! flux are lagged. Its implicit part uses |b_n|(|b_1| + |b_2| + |b_3|)/b^2 on a face
+//! of normal n instead of b_n^2/b^2: by the Cauchy-Schwarz inequality this bounds
+//! (b.k)^2 from above for every wave vector, so the lagged cross terms cannot make the
+//! backward Euler step unstable, and a field along a grid axis is still exactly
+//! field-aligned.
+
+// C headers
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>    // strcmp()
+#include <iostream>
+#include <sstream>    // sstream
+#include <stdexcept>  // runtime_error
+#include <string>     // c_str()
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../bvals/bvals.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../eos/eos.hpp"
+#include "../../field/field.hpp"
+#include "../../globals.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../multigrid/multigrid.hpp"
+#include "../../parameter_input.hpp"
+#include "../../scalars/scalars.hpp"
+#include "../hydro.hpp"
+#include "hydro_diffusion.hpp"
+#include "mg_conduction.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+class MeshBlock;
+
+namespace {
+// no user-defined Multigrid boundary functions for conduction
+MGBoundaryFunc mg_no_user_bc[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+
+//! \fn inline Real ConductionOperator(const AthenaArray<Real> &cf,
+//!                      const AthenaArray<Real> &u, Real idx2, int k, int j, int i)
+//! \brief A(u) = c u + sum_f K_f (u - u_f)/dx^2 at cell (k,j,i)
+
+inline Real ConductionOperator(const AthenaArray<Real> &cf, const AthenaArray<Real> &u,
+                               Real idx2, int k, int j, int i) {
+  const Real uc = u(0,k,j,i);
+  return cf(MGConduction::ICC,k,j,i)*uc
+       + idx2*(cf(MGConduction::IK1,k,j,i)*(uc - u(0,k,j,i-1))
+             + cf(MGConduction::IK1,k,j,i+1)*(uc - u(0,k,j,i+1))
+             + cf(MGConduction::IK2,k,j,i)*(uc - u(0,k,j-1,i))
+             + cf(MGConduction::IK2,k,j+1,i)*(uc - u(0,k,j+1,i))
+             + cf(MGConduction::IK3,k,j,i)*(uc - u(0,k-1,j,i))
+             + cf(MGConduction::IK3,k+1,j,i)*(uc - u(0,k+1,j,i)));
+}
+
+//! \fn inline Real ConductionDiagonal(const AthenaArray<Real> &cf, Real idx2,
+//!                                    int k, int j, int i)
+//! \brief diagonal element of the conduction operator at cell (k,j,i)
+
+inline Real ConductionDiagonal(const AthenaArray<Real> &cf, Real idx2,
+                               int k, int j, int i) {
+  return cf(MGConduction::ICC,k,j,i)
+       + idx2*(cf(MGConduction::IK1,k,j,i) + cf(MGConduction::IK1,k,j,i+1)
+             + cf(MGConduction::IK2,k,j,i) + cf(MGConduction::IK2,k,j+1,i)
+             + cf(MGConduction::IK3,k,j,i) + cf(MGConduction::IK3,k+1,j,i));
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin)
+//! \brief MGConductionDriver constructor
+
+MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin)
+    : MGConductionDriver(pm, pin, "conduction") {
+  if (pin->GetOrAddReal("problem", "kappa_iso", 0.0) <= 0.0
+      && pin->GetOrAddReal("problem", "kappa_aniso", 0.0) <= 0.0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "Implicit conduction requires kappa_iso or kappa_aniso "
+        << "in the <problem> block." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  // the boundary conditions act on the temperature increment; default to the
+  // periodicity of the Mesh and to zero gradient (no implicit flux) elsewhere
+  const char *bcname[6] = {"ix1_bc", "ox1_bc", "ix2_bc", "ox2_bc", "ix3_bc", "ox3_bc"};
+  for (int f = 0; f < 6; ++f) {
+    std::string def = (pm->mesh_bcs[f] == BoundaryFlag::periodic) ? "periodic"
+                                                                   : "zerograd";
+    mg_mesh_bcs_[f] = GetMGBoundaryFlag(pin->GetOrAddString("conduction", bcname[f],
+                                                            def));
+    if (mg_mesh_bcs_[f] == BoundaryFlag::user
+        || mg_mesh_bcs_[f] == BoundaryFlag::mg_multipole) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+          << "Only periodic, zerograd and zerofixed are supported for \""
+          << bcname[f] << "\" in the <conduction> block." << std::endl;
+      ATHENA_ERROR(msg);
+    }
+  }
+  AllocateSolver();
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin,
+//!                                            const std::string &block)
+//! \brief set up the theta scheme and the Multigrid options from the input block
+//!
+//! Shared with the other implicit diffusion operators of the form c u - div(K grad u);
+//! the caller sets the boundary conditions and then calls AllocateSolver().
+
+MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin,
+                                       const std::string &block)
+    : MultigridDriver(pm, mg_no_user_bc, nullptr, 1) {
+  if (pm->multilevel || pm->shear_periodic) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "The implicit solver of the <" << block << "> block currently supports "
+        << "only a uniform mesh without shearing boundaries." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "The implicit solver of the <" << block << "> block currently supports "
+        << "only Cartesian coordinates." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  theta_ = pin->GetOrAddReal(block, "theta", 1.0);
+  eps_ = pin->GetOrAddReal(block, "threshold", 0.0);
+  niter_ = pin->GetOrAddInteger(block, "niteration", -1);
+  ffas_ = pin->GetOrAddBoolean(block, "fas", ffas_);
+  std::string m = pin->GetOrAddString(block, "mgmode", "fmg");
+  std::transform(m.begin(), m.end(), m.begin(), ::tolower);
+  if (m == "fmg") {
+    mode_ = 0;
+  } else if (m == "mgi") {
+    mode_ = 1; // Iterative
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "The \"mgmode\" parameter in the <" << block << "> block is invalid."
+        << std::endl
+        << "FMG: Full Multigrid + Multigrid iteration (default)" << std::endl
+        << "MGI: Multigrid Iteration" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (theta_ < 0.5 || theta_ > 1.0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "\"theta\" in the <" << block << "> block must be between 0.5 "
+        << "(Crank-Nicolson) and 1.0 (backward Euler)." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  // the operator contains the cell coefficient and is never singular
+  fsubtract_average_ = false;
+  coeffbuf_ = nullptr;
+  ncbuflist_ = nullptr;
+  ncbufslist_ = nullptr;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::AllocateSolver()
+//! \brief check the boundary conditions and allocate the buffers, the task list and
+//!        the root grid
+
+void MGConductionDriver::AllocateSolver() {
+  CheckBoundaryFunctions();
+
+  coeffbuf_ = new Real[nbtotal_*ncbuf_];
+  ncbuflist_ = new int[nranks_];
+  ncbufslist_ = new int[nranks_];
+
+  mgtlist_ = new MultigridTaskList(this);
+
+  // Allocate the root multigrid
+  mgroot_ = new MGConduction(this, nullptr);
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConductionDriver::~MGConductionDriver()
+//! \brief MGConductionDriver destructor
+
+MGConductionDriver::~MGConductionDriver() {
+  delete mgroot_;
+  delete mgtlist_;
+  delete [] coeffbuf_;
+  delete [] ncbuflist_;
+  delete [] ncbufslist_;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConduction::MGConduction(MultigridDriver *pmd, MeshBlock *pmb)
+//! \brief MGConduction constructor
+//!
+//! The boundary communication only packs the single cell-centered variable, so the
+//! gravity boundary buffers are reused.
+
+MGConduction::MGConduction(MultigridDriver *pmd, MeshBlock *pmb)
+    : Multigrid(pmd, pmb, 1, 1) {
+  btype = BoundaryQuantity::mggrav;
+  btypef = BoundaryQuantity::mggrav_f;
+  pmgbval = new MGGravityBoundaryValues(this, mg_block_bcs_);
+
+  coeff_ = new AthenaArray<Real>[nlevel_];
+  for (int l = 0; l < nlevel_; l++) {
+    int ll = nlevel_-1-l;
+    int ncx = (size_.nx1>>ll) + 2*ngh_;
+    int ncy = (size_.nx2>>ll) + 2*ngh_;
+    int ncz = (size_.nx3>>ll) + 2*ngh_;
+    coeff_[l].NewAthenaArray(NCOEFF, ncz, ncy, ncx);
+  }
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConduction::~MGConduction()
+//! \brief MGConduction deconstructor
+
+MGConduction::~MGConduction() {
+  delete pmgbval;
+  delete [] coeff_;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::Solve(int stage)
+//! \brief load the data, solve for the temperature increment and update the energy
+
+void MGConductionDriver::Solve(int stage) {
+  // Construct the Multigrid array
+  vmg_.clear();
+  for (int i = 0; i < pmy_mesh_->nblocal; ++i)
+    vmg_.push_back(pmy_mesh_->my_blocks(i)->phydro->hdif.pmg);
+
+  // load the explicit conduction source and the operator coefficients
+#pragma omp parallel for num_threads(nthreads_)
+  for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+    MGConduction *pmg = static_cast<MGConduction*>(*itr);
+    pmg->LoadConductionData(pmy_mesh_->dt, theta_);
+    pmg->RestrictCoefficients();
+  }
+
+  SetupMultigrid();
+  TransferCoefficientsToRoot();
+
+  if (mode_ == 0) {
+    SolveFMGCycle();
+  } else {
+    if (eps_ >= 0.0)
+      SolveIterative();
+    else
+      SolveIterativeFixedTimes();
+  }
+
+#pragma omp parallel for num_threads(nthreads_)
+  for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+    MGConduction *pmg = static_cast<MGConduction*>(*itr);
+    pmg->ApplyConductionUpdate();
+  }
+
+  ExchangeHydroBoundaries();
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::SolveCoarsestGrid()
+//! \brief Solve the coarsest root grid
+//!
+//! The conduction operator is never singular, but with a large time step the heat
+//! capacity is small compared with the conductances, so the coarsest level is smoothed
+//! until the defect has dropped by three orders of magnitude instead of a fixed number
+//! of sweeps. The root grid is replicated on all ranks, so no reduction is needed.
+
+void MGConductionDriver::SolveCoarsestGrid() {
+  constexpr int max_sweeps = 100;
+  mgroot_->pmgbval->ApplyPhysicalBoundaries();
+  if (ffas_) {
+    mgroot_->StoreOldData();
+    mgroot_->CalculateFASRHSBlock();
+  }
+  Real def0 = mgroot_->CalculateDefectNorm(MGNormType::max, 0);
+  for (int n = 0; n < max_sweeps; ++n) {
+    mgroot_->SmoothBlock(0);
+    mgroot_->pmgbval->ApplyPhysicalBoundaries();
+    mgroot_->SmoothBlock(1);
+    mgroot_->pmgbval->ApplyPhysicalBoundaries();
+    if (mgroot_->CalculateDefectNorm(MGNormType::max, 0) <= 1.0e-3*def0)
+      break;
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::TransferCoefficientsToRoot()
+//! \brief collect the coarsest coefficients of all MeshBlocks into the root grid
+
+void MGConductionDriver::TransferCoefficientsToRoot() {
+  MGConduction *proot = static_cast<MGConduction*>(mgroot_);
+  const int ngh = proot->ngh_;
+#pragma omp parallel for num_threads(nthreads_)
+  for (auto itr = vmg_.begin(); itr < vmg_.end(); itr++) {
+    MGConduction *pmg = static_cast<MGConduction*>(*itr);
+    const AthenaArray<Real> &cf = pmg->coeff_[0];
+    Real *buf = coeffbuf_ + pmg->pmy_block_->gid*ncbuf_;
+    buf[0] = cf(MGConduction::ICC, ngh, ngh, ngh);
+    buf[1] = cf(MGConduction::IK1, ngh, ngh, ngh);
+    buf[2] = cf(MGConduction::IK1, ngh, ngh, ngh+1);
+    buf[3] = cf(MGConduction::IK2, ngh, ngh, ngh);
+    buf[4] = cf(MGConduction::IK2, ngh, ngh+1, ngh);
+    buf[5] = cf(MGConduction::IK3, ngh, ngh, ngh);
+    buf[6] = cf(MGConduction::IK3, ngh+1, ngh, ngh);
+  }
+
+#ifdef MPI_PARALLEL
+  for (int n = 0; n < nranks_; ++n) {
+    ncbuflist_[n] = nblist_[n]*ncbuf_;
+    ncbufslist_[n] = nslist_[n]*ncbuf_;
+  }
+  MPI_Allgatherv(MPI_IN_PLACE, ncbuflist_[Globals::my_rank], MPI_ATHENA_REAL,
+                 coeffbuf_, ncbuflist_, ncbufslist_, MPI_ATHENA_REAL,
+                 MPI_COMM_MULTIGRID);
+#endif
+
+  // a face shared by two MeshBlocks receives the same value from both
+  AthenaArray<Real> &rc = proot->coeff_[proot->nlevel_-1];
+  for (int n = 0; n < nbtotal_; ++n) {
+    const LogicalLocation &loc = pmy_mesh_->loclist[n];
+    int i = static_cast<int>(loc.lx1) + ngh;
+    int j = static_cast<int>(loc.lx2) + ngh;
+    int k = static_cast<int>(loc.lx3) + ngh;
+    const Real *buf = coeffbuf_ + n*ncbuf_;
+    rc(MGConduction::ICC, k, j, i) = buf[0];
+    rc(MGConduction::IK1, k, j, i) = buf[1];
+    rc(MGConduction::IK1, k, j, i+1) = buf[2];
+    rc(MGConduction::IK2, k, j, i) = buf[3];
+    rc(MGConduction::IK2, k, j+1, i) = buf[4];
+    rc(MGConduction::IK3, k, j, i) = buf[5];
+    rc(MGConduction::IK3, k+1, j, i) = buf[6];
+  }
+  proot->RestrictCoefficients();
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::ExchangeHydroBoundaries()
+//! \brief refresh the ghost cells of the hydro variables after the energy update
+
+void MGConductionDriver::ExchangeHydroBoundaries() {
+  Mesh *pm = pmy_mesh_;
+  const int nblocal = pm->nblocal;
+  const Real time = pm->time + pm->dt;
+
+#pragma omp parallel num_threads(nthreads_)
+  {
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b) {
+      Hydro *ph = pm->my_blocks(b)->phydro;
+      ph->hbvar.SwapHydroQuantity(ph->u, HydroBoundaryQuantity::cons);
+      ph->hbvar.StartReceiving(BoundaryCommSubset::all);
+    }
+
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b)
+      pm->my_blocks(b)->phydro->hbvar.SendBoundaryBuffers();
+
+#pragma omp for
+    for (int b = 0; b < nblocal; ++b) {
+      MeshBlock *pmb = pm->my_blocks(b);
+      BoundaryValues *pbval = pmb->pbval;
+      Hydro *ph = pmb->phydro;
+      Field *pf = pmb->pfield;
+      ph->hbvar.ReceiveAndSetBoundariesWithWait();
+      ph->hbvar.ClearBoundary(BoundaryCommSubset::all);
+
+      int il = pmb->is - NGHOST, iu = pmb->ie + NGHOST,
+          jl = pmb->js - NGHOST, ju = pmb->je + NGHOST,
+          kl = pmb->ks - NGHOST, ku = pmb->ke + NGHOST;
+      pmb->peos->ConservedToPrimitive(ph->u, ph->w1, pf->b,
+                                      ph->w, pf->bcc, pmb->pcoord,
+                                      il, iu, jl, ju, kl, ku);
+
+      ph->hbvar.SwapHydroQuantity(ph->w, HydroBoundaryQuantity::prim);
+      if (NSCALARS > 0)
+        pmb->pscalars->sbvar.var_cc = &(pmb->pscalars->r);
+      pbval->ApplyPhysicalBoundaries(time, pm->dt, pbval->bvars_main_int);
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConduction::LoadConductionData(Real dt, Real theta)
+//! \brief compute the explicit conduction source and the coefficients on the finest
+//!        level, and clear the initial guess of the temperature increment
+
+void MGConduction::LoadConductionData(Real dt, Real theta) {
+  MeshBlock *pmb = pmy_block_;
+  Hydro *ph = pmb->phydro;
+  HydroDiffusion &hd = ph->hdif;
+  Coordinates *pco = pmb->pcoord;
+  const AthenaArray<Real> &w = ph->w;
+  const AthenaArray<Real> &bc = MAGNETIC_FIELDS_ENABLED ? pmb->pfield->bcc : ph->w;
+  const int is = pmb->is, ie = pmb->ie, js = pmb->js, je = pmb->je,
+            ks = pmb->ks, ke = pmb->ke;
+  const int os = ngh_;
+  const Real igm1 = 1.0/(pmb->peos->GetGamma() - 1.0);
+  const Real dtheta = theta*dt;
+  const bool fiso = (hd.kappa_iso > 0.0), faniso = (hd.kappa_aniso > 0.0);
+
+  // explicit conduction flux at t^n
+  hd.SetDiffusivity(w, bc);
+  hd.ClearFlux(hd.cndflx);
+  if (fiso) hd.ThermalFluxIso(w, hd.cndflx);
+  if (faniso) hd.ThermalFluxAniso(w, bc, hd.cndflx);
+  const AthenaArray<Real> &x1flux = hd.cndflx[X1DIR];
+  const AthenaArray<Real> &x2flux = hd.cndflx[X2DIR];
+  const AthenaArray<Real> &x3flux = hd.cndflx[X3DIR];
+  const AthenaArray<Real> &kappa = hd.kappa;
+
+  current_level_ = nlevel_-1;
+  AthenaArray<Real> &cf = coeff_[current_level_];
+  AthenaArray<Real> &src = src_[current_level_];
+  u_[current_level_].ZeroClear();
+
+  for (int k=ks; k<=ke; ++k) {
+    int mk = k - ks + os;
+    for (int j=js; j<=je; ++j) {
+      int mj = j - js + os;
+#pragma omp simd
+      for (int i=is; i<=ie; ++i) {
+        int mi = i - is + os;
+        src(0,mk,mj,mi) = -dt*((x1flux(k,j,i+1) - x1flux(k,j,i))/pco->dx1f(i)
+                             + (x2flux(k,j+1,i) - x2flux(k,j,i))/pco->dx2f(j)
+                             + (x3flux(k+1,j,i) - x3flux(k,j,i))/pco->dx3f(k));
+        cf(ICC,mk,mj,mi) = w(IDN,k,j,i)*igm1;
+      }
+    }
+  }
+
+  // face conductances theta*dt*rho_f*kappa_f, with the anisotropic part bounded as in
+  // the file header; face averages match HydroDiffusion::ThermalFluxIso/Aniso
+  for (int k=ks; k<=ke; ++k) {
+    int mk = k - ks + os;
+    for (int j=js; j<=je; ++j) {
+      int mj = j - js + os;
+      for (int i=is; i<=ie+1; ++i) {
+        int mi = i - is + os;
+        Real kf = 0.0;
+        if (fiso)
+          kf += 0.5*(kappa(HydroDiffusion::DiffProcess::iso,k,j,i)
+                     + kappa(HydroDiffusion::DiffProcess::iso,k,j,i-1));
+        if (faniso) {
+          Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k,j,i-1));
+          Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k,j,i-1));
+          Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k,j,i-1));
+          Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+          if (bsq > TINY_NUMBER)
+            kf += 0.5*(kappa(HydroDiffusion::DiffProcess::aniso,k,j,i)
+                       + kappa(HydroDiffusion::DiffProcess::aniso,k,j,i-1))
+                  *std::abs(bx)*(std::abs(bx) + std::abs(by) + std::abs(bz))/bsq;
+        }
+        cf(IK1,mk,mj,mi) = dtheta*0.5*(w(IDN,k,j,i) + w(IDN,k,j,i-1))*kf;
+      }
+    }
+  }
+  for (int k=ks; k<=ke; ++k) {
+    int mk = k - ks + os;
+    for (int j=js; j<=je+1; ++j) {
+      int mj = j - js + os;
+      for (int i=is; i<=ie; ++i) {
+        int mi = i - is + os;
+        Real kf = 0.0;
+        if (fiso)
+          kf += 0.5*(kappa(HydroDiffusion::DiffProcess::iso,k,j,i)
+                     + kappa(HydroDiffusion::DiffProcess::iso,k,j-1,i));
+        if (faniso) {
+          Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k,j-1,i));
+          Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k,j-1,i));
+          Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k,j-1,i));
+          Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+          if (bsq > TINY_NUMBER)
+            kf += 0.5*(kappa(HydroDiffusion::DiffProcess::aniso,k,j,i)
+                       + kappa(HydroDiffusion::DiffProcess::aniso,k,j-1,i))
+                  *std::abs(by)*(std::abs(bx) + std::abs(by) + std::abs(bz))/bsq;
+        }
+        cf(IK2,mk,mj,mi) = dtheta*0.5*(w(IDN,k,j,i) + w(IDN,k,j-1,i))*kf;
+      }
+    }
+  }
+  for (int k=ks; k<=ke+1; ++k) {
+    int mk = k - ks + os;
+    for (int j=js; j<=je; ++j) {
+      int mj = j - js + os;
+      for (int i=is; i<=ie; ++i) {
+        int mi = i - is + os;
+        Real kf = 0.0;
+        if (fiso)
+          kf += 0.5*(kappa(HydroDiffusion::DiffProcess::iso,k,j,i)
+                     + kappa(HydroDiffusion::DiffProcess::iso,k-1,j,i));
+        if (faniso) {
+          Real bx = 0.5*(bc(IB1,k,j,i) + bc(IB1,k-1,j,i));
+          Real by = 0.5*(bc(IB2,k,j,i) + bc(IB2,k-1,j,i));
+          Real bz = 0.5*(bc(IB3,k,j,i) + bc(IB3,k-1,j,i));
+          Real bsq = SQR(bx) + SQR(by) + SQR(bz);
+          if (bsq > TINY_NUMBER)
+            kf += 0.5*(kappa(HydroDiffusion::DiffProcess::aniso,k,j,i)
+                       + kappa(HydroDiffusion::DiffProcess::aniso,k-1,j,i))
+                  *std::abs(bz)*(std::abs(bx) + std::abs(by) + std::abs(bz))/bsq;
+        }
+        cf(IK3,mk,mj,mi) = dtheta*0.5*(w(IDN,k,j,i) + w(IDN,k-1,j,i))*kf;
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConduction::RestrictCoefficients()
+//! \brief restrict the coefficients through all the levels: the heat capacity is
+//!        averaged over the 8 fine cells and the conductances over the 4 fine faces
+
+void MGConduction::RestrictCoefficients() {
+  const int os = ngh_;
+  for (int lev=nlevel_-1; lev>0; lev--) {
+    int ll = nlevel_-lev;
+    int ie = os + (size_.nx1>>ll) - 1, je = os + (size_.nx2>>ll) - 1,
+        ke = os + (size_.nx3>>ll) - 1;
+    const AthenaArray<Real> &fc = coeff_[lev];
+    AthenaArray<Real> &cc = coeff_[lev-1];
+    for (int k=os; k<=ke+1; ++k) {
+      int fk = 2*k - os;
+      for (int j=os; j<=je+1; ++j) {
+        int fj = 2*j - os;
+        for (int i=os; i<=ie+1; ++i) {
+          int fi = 2*i - os;
+          if (k <= ke && j <= je && i <= ie)
+            cc(ICC,k,j,i) = 0.125*(fc(ICC,fk,  fj,  fi) + fc(ICC,fk,  fj,  fi+1)
+                                 + fc(ICC,fk,  fj+1,fi) + fc(ICC,fk,  fj+1,fi+1)
+                                 + fc(ICC,fk+1,fj,  fi) + fc(ICC,fk+1,fj,  fi+1)
+                                 + fc(ICC,fk+1,fj+1,fi) + fc(ICC,fk+1,fj+1,fi+1));
+          if (k <= ke && j <= je)
+            cc(IK1,k,j,i) = 0.25*(fc(IK1,fk,  fj,fi) + fc(IK1,fk,  fj+1,fi)
+                                + fc(IK1,fk+1,fj,fi) + fc(IK1,fk+1,fj+1,fi));
+          if (k <= ke && i <= ie)
+            cc(IK2,k,j,i) = 0.25*(fc(IK2,fk,  fj,fi) + fc(IK2,fk,  fj,fi+1)
+                                + fc(IK2,fk+1,fj,fi) + fc(IK2,fk+1,fj,fi+1));
+          if (j <= je && i <= ie)
+            cc(IK3,k,j,i) = 0.25*(fc(IK3,fk,fj,  fi) + fc(IK3,fk,fj,  fi+1)
+                                + fc(IK3,fk,fj+1,fi) + fc(IK3,fk,fj+1,fi+1));
+        }
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConduction::ApplyConductionUpdate()
+//! \brief add the energy change c dT to the total energy of the MeshBlock
+
+void MGConduction::ApplyConductionUpdate() {
+  MeshBlock *pmb = pmy_block_;
+  AthenaArray<Real> &u = pmb->phydro->u;
+  const AthenaArray<Real> &dtemp = u_[nlevel_-1];
+  const AthenaArray<Real> &cf = coeff_[nlevel_-1];
+  const int os = ngh_;
+  for (int k=pmb->ks; k<=pmb->ke; ++k) {
+    int mk = k - pmb->ks + os;
+    for (int j=pmb->js; j<=pmb->je; ++j) {
+      int mj = j - pmb->js + os;
+#pragma omp simd
+      for (int i=pmb->is; i<=pmb->ie; ++i) {
+        int mi = i - pmb->is + os;
+        u(IEN,k,j,i) += cf(ICC,mk,mj,mi)*dtemp(0,mk,mj,mi);
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::Smooth(AthenaArray<Real> &u, const AthenaArray<Real> &src,
+//!        int rlev, int il, int iu, int jl, int ju, int kl, int ku, int color, bool th)
+//! \brief Implementation of the Red-Black Gauss-Seidel Smoother
+//!        rlev = relative level from the finest level of this Multigrid block
+
+void MGConduction::Smooth(AthenaArray<Real> &u, const AthenaArray<Real> &src, int rlev,
+                int il, int iu, int jl, int ju, int kl, int ku, int color, bool th) {
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  const AthenaArray<Real> &cf = coeff_[current_level_];
+  color ^= pmy_driver_->coffset_;
+  if (th == true && (ku-kl) >=  minth_) {
+#pragma omp parallel for num_threads(pmy_driver_->nthreads_)
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+        int c = (color + k + j) & 1;
+#pragma ivdep
+        for (int i=il+c; i<=iu; i+=2)
+          u(0,k,j,i) += omega_*(src(0,k,j,i) - ConductionOperator(cf, u, idx2, k, j, i))
+                        /ConductionDiagonal(cf, idx2, k, j, i);
+      }
+    }
+  } else {
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+        int c = (color + k + j) & 1;
+#pragma ivdep
+        for (int i=il+c; i<=iu; i+=2)
+          u(0,k,j,i) += omega_*(src(0,k,j,i) - ConductionOperator(cf, u, idx2, k, j, i))
+                        /ConductionDiagonal(cf, idx2, k, j, i);
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::CalculateDefect(AthenaArray<Real> &def,
+//!           const AthenaArray<Real> &u, const AthenaArray<Real> &src, int rlev,
+//!           int il, int iu, int jl, int ju, int kl, int ku, bool th)
+//! \brief Implementation of the Defect calculation
+//!        rlev = relative level from the finest level of this Multigrid block
+
+void MGConduction::CalculateDefect(AthenaArray<Real> &def, const AthenaArray<Real> &u,
+                                   const AthenaArray<Real> &src, int rlev,
+                                   int il, int iu, int jl, int ju, int kl, int ku,
+                                   bool th) {
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  const AthenaArray<Real> &cf = coeff_[current_level_];
+  if (th == true && (ku-kl) >=  minth_) {
+#pragma omp parallel for num_threads(pmy_driver_->nthreads_)
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+#pragma omp simd
+        for (int i=il; i<=iu; i++)
+          def(0,k,j,i) = src(0,k,j,i) - ConductionOperator(cf, u, idx2, k, j, i);
+      }
+    }
+  } else {
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+#pragma omp simd
+        for (int i=il; i<=iu; i++)
+          def(0,k,j,i) = src(0,k,j,i) - ConductionOperator(cf, u, idx2, k, j, i);
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::CalculateFASRHS(AthenaArray<Real> &src,
+//!                      const AthenaArray<Real> &u, int rlev,
+//!                      int il, int iu, int jl, int ju, int kl, int ku, bool th)
+//! \brief Implementation of the RHS calculation for FAS
+//!        rlev = relative level from the finest level of this Multigrid block
+
+void MGConduction::CalculateFASRHS(AthenaArray<Real> &src, const AthenaArray<Real> &u,
+                int rlev, int il, int iu, int jl, int ju, int kl, int ku, bool th) {
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  const AthenaArray<Real> &cf = coeff_[current_level_];
+  if (th == true && (ku-kl) >=  minth_) {
+#pragma omp parallel for num_threads(pmy_driver_->nthreads_)
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+#pragma omp simd
+        for (int i=il; i<=iu; i++)
+          src(0,k,j,i) += ConductionOperator(cf, u, idx2, k, j, i);
+      }
+    }
+  } else {
+    for (int k=kl; k<=ku; k++) {
+      for (int j=jl; j<=ju; j++) {
+#pragma omp simd
+        for (int i=il; i<=iu; i++)
+          src(0,k,j,i) += ConductionOperator(cf, u, idx2, k, j, i);
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst,
+//!                           AthenaArray<Real> &cbuf, const AthenaArray<bool> &ncoarse)
+//! \brief octets exist only with mesh refinement, which is rejected in the constructor
+
+void MGConductionDriver::ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst,
+                         AthenaArray<Real> &cbuf, const AthenaArray<bool> &ncoarse) {
+  return;
+}
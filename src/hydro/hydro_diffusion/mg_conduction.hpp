@@ -0,0 +1,92 @@
+#ifndef HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
+#define HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_conduction.hpp
+//! \brief defines MGConduction and MGConductionDriver classes
+//!
+//! Implicit (backward Euler / Crank-Nicolson) thermal conduction on the Multigrid solver
+
+// C headers
+
+// C++ headers
+#include <string>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../multigrid/multigrid.hpp"
+
+class MeshBlock;
+class ParameterInput;
+class Multigrid;
+
+//! \class MGConduction
+//! \brief Multigrid implicit conduction solver for each block
+//!
+//! Solves c dT - theta dt div(rho kappa grad dT) = -dt div F(T^n) for the temperature
+//! increment dT. The cell coefficient c and the face conductances are stored per level.
+
+class MGConduction : public Multigrid {
+ public:
+  // coefficient indices: cell heat capacity and lower-face conductances in x1, x2, x3
+  enum CoeffIndex {ICC=0, IK1=1, IK2=2, IK3=3, NCOEFF=4};
+
+  MGConduction(MultigridDriver *pmd, MeshBlock *pmb);
+  ~MGConduction();
+
+  void LoadConductionData(Real dt, Real theta);
+  void RestrictCoefficients();
+  void ApplyConductionUpdate();
+
+  void Smooth(AthenaArray<Real> &dst, const AthenaArray<Real> &src, int rlev,
+              int il, int iu, int jl, int ju, int kl, int ku, int color, bool th) final;
+  void CalculateDefect(AthenaArray<Real> &def, const AthenaArray<Real> &u,
+                       const AthenaArray<Real> &src, int rlev,
+                       int il, int iu, int jl, int ju, int kl, int ku, bool th) final;
+  void CalculateFASRHS(AthenaArray<Real> &def, const AthenaArray<Real> &src,
+                int rlev, int il, int iu, int jl, int ju, int kl, int ku, bool th) final;
+
+  friend class MGConductionDriver;
+
+ protected:
+  AthenaArray<Real> *coeff_;
+
+ private:
+  static constexpr Real omega_ = 1.0;
+};
+
+
+//! \class MGConductionDriver
+//! \brief Multigrid implicit conduction solver
+//!
+//! The protected constructor and AllocateSolver() let other operators of the same form
+//! (MGOhmicDriver) reuse the coefficient transfer and the coarsest-grid solver.
+
+class MGConductionDriver : public MultigridDriver {
+ public:
+  MGConductionDriver(Mesh *pm, ParameterInput *pin);
+  ~MGConductionDriver();
+  void Solve(int stage) override;
+  void ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst,
+                 AthenaArray<Real> &cbuf, const AthenaArray<bool> &ncoarse) final;
+
+ protected:
+  MGConductionDriver(Mesh *pm, ParameterInput *pin, const std::string &block);
+  void AllocateSolver();
+  void SolveCoarsestGrid() final;
+  void TransferCoefficientsToRoot();
+  void ExchangeHydroBoundaries();
+
+  Real theta_;
+
+ private:
+  static constexpr int ncbuf_ = 7; // c and two conductances per direction
+  Real *coeffbuf_;
+  int *ncbuflist_, *ncbufslist_;
+};
+
+#endif // HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
@@ -22,6 +22,7 @@
 #include "../field/field.hpp"
 #include "../field/field_diffusion/field_diffusion.hpp"
 #include "../mesh/mesh.hpp"
+#include "../mesh/polar_coarsening.hpp"
 #include "../nr_radiation/implicit/radiation_implicit.hpp"
 #include "../nr_radiation/radiation.hpp"
 #include "../orbital_advection/orbital_advection.hpp"
@@ -65,7 +66,8 @@ void Hydro::NewBlockTimeStep() {
   Real cspeed = 0.0;
   if(NR_RADIATION_ENABLED)
     cspeed = pmb->pnrrad->reduced_c;
-  if(CR_ENABLED)
+  // the implicit cosmic ray transport is not limited by vmax
+  if(CR_ENABLED && (pmb->pmy_mesh->pimcr == nullptr))
     cspeed = std::max(cspeed,pmb->pcr->vmax);
 
   // TODO(felker): skip this next loop if pm->fluid_setup == FluidFormulation::disabled
@@ -76,6 +78,12 @@ void Hydro::NewBlockTimeStep() {
       pmb->pcoord->CenterWidth1(k, j, is, ie, dt1);
       pmb->pcoord->CenterWidth2(k, j, is, ie, dt2);
       pmb->pcoord->CenterWidth3(k, j, is, ie, dt3);
+      // merged azimuthal width of the cells near the poles
+      if (pmb->ppolar->polar_coarsening_defined) {
+        int nfac = pmb->ppolar->Factor(j);
+        for (int i=is; i<=ie; ++i)
+          dt3(i) *= nfac;
+      }
 
       // Newtonian case: divide cell widths by maximum characteristic speed
       if (!RELATIVISTIC_DYNAMICS) {
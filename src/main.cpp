@@ -35,10 +35,14 @@
 // Athena++ headers
 #include "athena.hpp"
 #include "chem_rad/chem_rad.hpp"
+#include "cr/implicit/cr_implicit.hpp"
 #include "fft/turbulence.hpp"
+#include "field/field_diffusion/mg_ohmic.hpp"
 #include "globals.hpp"
 #include "gravity/fft_gravity.hpp"
+#include "gravity/gravity_cadence.hpp"
 #include "gravity/mg_gravity.hpp"
+#include "hydro/hydro_diffusion/mg_conduction.hpp"
 #include "mesh/mesh.hpp"
 #include "nr_radiation/implicit/radiation_implicit.hpp"
 #include "nr_radiation/radiation.hpp"
@@ -46,6 +50,9 @@
 #include "outputs/outputs.hpp"
 #include "parameter_input.hpp"
 #include "task_list/chem_rad_task_list.hpp"
+#include "utils/autotune.hpp"
+#include "utils/perf_counters.hpp"
+#include "utils/task_trace.hpp"
 #include "utils/utils.hpp"
 
 // MPI/OpenMP headers
@@ -234,6 +241,14 @@ int main(int argc, char *argv[]) {
       // the output next_time, dt, etc.
       // This needs to be corrected on the restart file because we need the old dt.
       pinput->RollbackNextTime();
+      // keep the MeshBlock size of the restart file, since the -i input file or cmdline
+      // args may change it; the Mesh then splits or merges the MeshBlocks of the file
+      for (std::string nx : {"nx1", "nx2", "nx3"}) {
+        int mesh_nx = pinput->DoesParameterExist("mesh", nx)
+                      ? pinput->GetInteger("mesh", nx) : 1;
+        pinput->SetInteger("meshblock", "restart_" + nx,
+                           pinput->GetOrAddInteger("meshblock", nx, mesh_nx));
+      }
       // leave the restart file open for later use
     }
     if (iarg_flag == 1) {
@@ -272,6 +287,8 @@ int main(int argc, char *argv[]) {
 #ifdef ENABLE_EXCEPTIONS
   try {
 #endif
+    // choose the MeshBlock size and number of threads by trial runs if requested
+    if (res_flag == 0 && mesh_flag == 0 && narg_flag == 0) Autotune::Run(pinput);
     if (res_flag == 0) {
       pmesh = new Mesh(pinput, mesh_flag);
     } else {
@@ -448,6 +465,9 @@ int main(int argc, char *argv[]) {
     std::cout << "\nSetup complete, entering main loop...\n" << std::endl;
   }
 
+  TaskTrace::Initialize(pinput, pmesh->GetNumMeshThreads());
+  PerfCounters::Initialize(pinput, pmesh->GetNumMeshThreads());
+
   clock_t tstart = clock();
 #ifdef OPENMP_PARALLEL
   double omp_start_time = omp_get_wtime();
@@ -487,7 +507,7 @@ int main(int argc, char *argv[]) {
       clock_t tstart_rad, tstop_rad;
       tstart_rad = std::clock();
 
-      pchemradlist->DoTaskListOneStage(pmesh, 1);
+      pchemradlist->DoIntegration(pmesh);
 
       // radiation tasklist timing output
       if (pmesh->my_blocks(0)->pchemrad->output_zone_sec) {
@@ -507,7 +527,10 @@ int main(int argc, char *argv[]) {
     for (int stage=1; stage<=ptlist->nstages; ++stage) {
       ptlist->DoTaskListOneStage(pmesh, stage);
       if (ptlist->CheckNextMainStage(stage)) {
-        if (SELF_GRAVITY_ENABLED == 1) // fft (0: discrete kernel, 1: continuous kernel)
+        if (pmesh->pgcad != nullptr) // solve cadence control with phi extrapolation
+          pmesh->pgcad->Solve(stage, stage == ptlist->nstages,
+                              pmesh->time + ptlist->StageEndTime(stage)*pmesh->dt);
+        else if (SELF_GRAVITY_ENABLED == 1) // fft (0: discrete, 1: continuous kernel)
           pmesh->pfgrd->Solve(stage, 0);
         else if (SELF_GRAVITY_ENABLED == 2) // multigrid
           pmesh->pmgrd->Solve(stage);
@@ -515,6 +538,8 @@ int main(int argc, char *argv[]) {
       if (IM_RADIATION_ENABLED) {
         pmesh->pimrad->Iteration(pmesh,ptlist,stage);
       }
+      if (pmesh->pimcr != nullptr)
+        pmesh->pimcr->Iteration(pmesh,ptlist,stage);
     }
 
     if (STS_ENABLED && pmesh->sts_integrator == "rkl2") {
@@ -524,6 +549,12 @@ int main(int argc, char *argv[]) {
         pststlist->DoTaskListOneStage(pmesh, stage);
     }
 
+    if (pmesh->pmgohm != nullptr) // implicit Ohmic diffusion (operator split)
+      pmesh->pmgohm->Solve(1);
+
+    if (pmesh->pmgcnd != nullptr) // implicit thermal conduction (operator split)
+      pmesh->pmgcnd->Solve(1);
+
     pmesh->UserWorkInLoop();
 
     pmesh->ncycle++;
@@ -531,7 +562,10 @@ int main(int argc, char *argv[]) {
     mbcnt += pmesh->nbtotal;
     pmesh->step_since_lb++;
 
+    double tt0 = TaskTrace::enabled ? TaskTrace::Now() : 0.0;
     pmesh->LoadBalancingAndAdaptiveMeshRefinement(pinput);
+    if (TaskTrace::enabled)
+      TaskTrace::Record("regrid", -1, 0, tt0, TaskTrace::Now(), false);
 
     pmesh->NewTimeStep();
 
@@ -558,6 +592,7 @@ int main(int argc, char *argv[]) {
       return(0);
     }
 #endif // ENABLE_EXCEPTIONS
+    TaskTrace::Dump(pmesh->ncycle);
 
     // check for signals
     if (SignalHandler::CheckSignalFlags() != 0) {
@@ -600,6 +635,8 @@ int main(int argc, char *argv[]) {
     return(0);
   }
 #endif // ENABLE_EXCEPTIONS
+  TaskTrace::Finalize();
+  PerfCounters::Finalize();
 
   //--- Step 10. -------------------------------------------------------------------------
   // Print diagnostic messages related to the end of the simulation
@@ -640,6 +677,11 @@ int main(int argc, char *argv[]) {
     std::cout << std::endl << "zone-cycles = " << zonecycles << std::endl;
     std::cout << "cpu time used  = " << cpu_time << std::endl;
     std::cout << "zone-cycles/cpu_second = " << zc_cpus << std::endl;
+    if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) {
+      // each zone-cycle updates every angle and frequency group of the intensities
+      double zau_cpus = zc_cpus*pmesh->my_blocks(0)->pnrrad->n_fre_ang;
+      std::cout << "zone-angle-updates/cpu_second = " << zau_cpus << std::endl;
+    }
 #ifdef OPENMP_PARALLEL
     double zc_omps = static_cast<double> (zonecycles) / omp_time;
     std::cout << std::endl << "omp wtime used = " << omp_time << std::endl;
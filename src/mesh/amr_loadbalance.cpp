@@ -11,9 +11,11 @@
 // C++ headers
 #include <algorithm>  // std::sort()
 #include <cstdint>
+#include <ctime>      // clock_gettime()
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -32,6 +34,44 @@
 #include <mpi.h>
 #endif
 
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace {
+//! wall clock time in seconds, for timing the regrids
+double RegridWallTime() {
+#ifdef MPI_PARALLEL
+  return MPI_Wtime();
+#elif defined(OPENMP_PARALLEL)
+  return omp_get_wtime();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec);
+#endif
+}
+
+#ifdef MPI_PARALLEL
+//! grow a migration buffer to hold need Reals. The memory is not initialized since
+//! every buffer is packed before it is sent or filled by the receive. The peak size
+//! is kept unless it has been more than four times too large for eight consecutive
+//! redistributions (including ones without traffic), e.g. after a large derefinement.
+void ReserveMigrationPool(MigrationPool *pool, std::size_t need) {
+  if (pool->size >= need && pool->size <= 4*need) {
+    pool->noversized = 0;
+    return;
+  }
+  if (pool->size > need && ++(pool->noversized) < 8) return;
+  delete [] pool->data;
+  pool->data = (need > 0) ? new Real[need] : nullptr;
+  pool->size = need;
+  pool->noversized = 0;
+  return;
+}
+#endif
+} // namespace
+
 
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin)
@@ -40,6 +80,7 @@
 void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin) {
   int nnew = 0, ndel = 0;
   amr_updated = false;
+  double tstart = RegridWallTime();
 
   if (adaptive) {
     UpdateMeshBlockTree(nnew, ndel);
@@ -52,15 +93,29 @@ void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin) {
 
   if (nnew != 0 || ndel != 0) { // at least one (de)refinement happened
     amr_updated = true;
-    GatherCostListAndCheckBalance();
+    GatherCostList();
     RedistributeAndRefineMeshBlocks(pin, nbtotal + nnew - ndel);
   } else if (lb_flag_ && step_since_lb >= lb_interval_) {
-    if (!GatherCostListAndCheckBalance()) { // load imbalance detected
+    if (!CheckLoadBalance()) { // load imbalance detected
       amr_updated = true;
+      GatherCostList();
       RedistributeAndRefineMeshBlocks(pin, nbtotal);
     }
     lb_flag_ = false;
   }
+
+  // report the wall time of this regrid, the maximum over all ranks
+  if (amr_updated && lb_verbose_) {
+    double wtime = RegridWallTime() - tstart;
+#ifdef MPI_PARALLEL
+    MPI_Allreduce(MPI_IN_PLACE, &wtime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+    if (Globals::my_rank == 0) {
+      std::cout << "Regrid at cycle=" << ncycle << ": " << nbtotal << " MeshBlocks ("
+                << nnew << " created, " << ndel << " destroyed) in " << wtime
+                << " s" << std::endl;
+    }
+  }
   return;
 }
 
@@ -164,9 +219,67 @@ void Mesh::UpdateCostList() {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int Mesh::MergeDerefinedSiblings(LogicalLocation *lderef, int nderef,
+//!                                      LogicalLocation *clderef, int *merged)
+//! \brief find complete groups of sibling MeshBlocks in a Z-ordered list of blocks
+//!        flagged for derefinement, store their parents in clderef and mark the
+//!        merged blocks. Returns the number of parents found.
+
+int Mesh::MergeDerefinedSiblings(LogicalLocation *lderef, int nderef,
+                                 LogicalLocation *clderef, int *merged) {
+  int nleaf = 2, lk = 0, lj = 0;
+  if (mesh_size.nx2 > 1) {
+    nleaf = 4;
+    lj = 1;
+  }
+  if (mesh_size.nx3 > 1) {
+    nleaf = 8;
+    lk = 1;
+  }
+  int ctnd = 0;
+  for (int n=0; n<nderef; n++) {
+    if ((lderef[n].lx1 & 1LL) == 0LL &&
+        (lderef[n].lx2 & 1LL) == 0LL &&
+        (lderef[n].lx3 & 1LL) == 0LL) {
+      int r = n, rr = 0;
+      for (std::int64_t k=0; k<=lk; k++) {
+        for (std::int64_t j=0; j<=lj; j++) {
+          for (std::int64_t i=0; i<=1; i++) {
+            if (r < nderef) {
+              if ((lderef[n].lx1+i) == lderef[r].lx1
+                  && (lderef[n].lx2+j) == lderef[r].lx2
+                  && (lderef[n].lx3+k) == lderef[r].lx3
+                  &&  lderef[n].level  == lderef[r].level)
+                rr++;
+              r++;
+            }
+          }
+        }
+      }
+      if (rr == nleaf) {
+        clderef[ctnd].lx1   = lderef[n].lx1>>1;
+        clderef[ctnd].lx2   = lderef[n].lx2>>1;
+        clderef[ctnd].lx3   = lderef[n].lx3>>1;
+        clderef[ctnd].level = lderef[n].level-1;
+        ctnd++;
+        if (merged != nullptr) {
+          for (int m=n; m<n+nleaf; m++)
+            merged[m] = 1;
+        }
+      }
+    }
+  }
+  return ctnd;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel)
 //! \brief collect refinement flags and manipulate the MeshBlockTree
+//!
+//! Sibling groups that are completely owned by one rank are merged into their parent
+//! locally, so only the parents and the few flagged blocks of groups split between
+//! neighboring ranks are exchanged instead of every flagged MeshBlock.
 
 void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   // compute nleaf= number of leaf MeshBlocks per refined block
@@ -174,27 +287,44 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   if (mesh_size.nx2 > 1) nleaf = 4;
   if (mesh_size.nx3 > 1) nleaf = 8;
 
-  // collect refinement flags from all the meshblocks
-  // count the number of the blocks to be (de)refined
-  nref[Globals::my_rank] = 0;
-  nderef[Globals::my_rank] = 0;
+  // collect the local refinement flags; blocks of this rank are in Z-order
+  std::vector<LogicalLocation> mylref, mylderef;
   for (int i=0; i<nblocal; ++i) {
     MeshBlock *pmb = my_blocks(i);
-    if (pmb->pmr->refine_flag_ ==  1) nref[Globals::my_rank]++;
-    if (pmb->pmr->refine_flag_ == -1) nderef[Globals::my_rank]++;
+    if (pmb->pmr->refine_flag_ ==  1) mylref.push_back(pmb->loc);
+    if (pmb->pmr->refine_flag_ == -1) mylderef.push_back(pmb->loc);
   }
+  // merge the local complete sibling groups, the rest may pair with other ranks
+  int mynderef = static_cast<int>(mylderef.size());
+  std::vector<LogicalLocation> mylcderef(mynderef/nleaf + 1);
+  std::vector<int> merged(mynderef + 1, 0);
+  int myncderef = MergeDerefinedSiblings(mylderef.data(), mynderef, mylcderef.data(),
+                                         merged.data());
+  std::vector<LogicalLocation> myrest;
+  for (int n=0; n<mynderef; n++) {
+    if (!merged[n]) myrest.push_back(mylderef[n]);
+  }
+
+  // count the number of the blocks to be refined, the merged parents and the rest
+  std::vector<int> counts(3*Globals::nranks);
+  counts[3*Globals::my_rank]   = static_cast<int>(mylref.size());
+  counts[3*Globals::my_rank+1] = myncderef;
+  counts[3*Globals::my_rank+2] = static_cast<int>(myrest.size());
 #ifdef MPI_PARALLEL
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nref,   1, MPI_INT, MPI_COMM_WORLD);
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nderef, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Allgather(MPI_IN_PLACE, 3, MPI_INT, counts.data(), 3, MPI_INT, MPI_COMM_WORLD);
 #endif
 
   // count the number of the blocks to be (de)refined and displacement
-  int tnref = 0, tnderef = 0;
+  // nref holds the refined blocks followed by the merged parents of each rank
+  int tnref = 0, tncderef = 0, tnderef = 0;
   for (int n=0; n<Globals::nranks; n++) {
-    tnref  += nref[n];
-    tnderef += nderef[n];
+    tnref    += counts[3*n];
+    tncderef += counts[3*n+1];
+    tnderef  += counts[3*n+2];
+    nref[n]   = counts[3*n] + counts[3*n+1];
+    nderef[n] = counts[3*n+2];
   }
-  if (tnref == 0 && tnderef < nleaf) // nothing to do
+  if (tnref == 0 && tncderef == 0 && tnderef < nleaf) // nothing to do
     return;
 
   int rd = 0, dd = 0;
@@ -214,27 +344,29 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   }
 
   // allocate memory for the location arrays
-  LogicalLocation *lref{}, *lderef{}, *clderef{};
+  LogicalLocation *lrefcd{}, *lref{}, *lderef{}, *clderef{};
+  if (tnref + tncderef > 0)
+    lrefcd = new LogicalLocation[tnref + tncderef];
   if (tnref > 0)
     lref = new LogicalLocation[tnref];
-  if (tnderef >= nleaf) {
+  if (tnderef >= nleaf)
     lderef = new LogicalLocation[tnderef];
-    clderef = new LogicalLocation[tnderef/nleaf];
-  }
+  clderef = new LogicalLocation[tncderef + tnderef/nleaf + 1];
 
-  // collect the locations and costs
+  // collect the locations
   int iref = rdisp[Globals::my_rank], ideref = ddisp[Globals::my_rank];
-  for (int i=0; i<nblocal; ++i) {
-    MeshBlock *pmb = my_blocks(i);
-    if (pmb->pmr->refine_flag_ ==  1)
-      lref[iref++] = pmb->loc;
-    if (pmb->pmr->refine_flag_ == -1 && tnderef >= nleaf)
-      lderef[ideref++] = pmb->loc;
+  for (const LogicalLocation &loc : mylref)
+    lrefcd[iref++] = loc;
+  for (int n=0; n<myncderef; n++)
+    lrefcd[iref++] = mylcderef[n];
+  if (tnderef >= nleaf) {
+    for (const LogicalLocation &loc : myrest)
+      lderef[ideref++] = loc;
   }
 #ifdef MPI_PARALLEL
-  if (tnref > 0) {
+  if (tnref + tncderef > 0) {
     MPI_Allgatherv(MPI_IN_PLACE, bnref[Globals::my_rank],   MPI_BYTE,
-                   lref,   bnref,   brdisp, MPI_BYTE, MPI_COMM_WORLD);
+                   lrefcd, bnref,   brdisp, MPI_BYTE, MPI_COMM_WORLD);
   }
   if (tnderef >= nleaf) {
     MPI_Allgatherv(MPI_IN_PLACE, bnderef[Globals::my_rank], MPI_BYTE,
@@ -242,47 +374,27 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   }
 #endif
 
-  // calculate the list of the newly derefined blocks
-  int ctnd = 0;
-  if (tnderef >= nleaf) {
-    int lk = 0, lj = 0;
-    if (mesh_size.nx2 > 1) lj = 1;
-    if (mesh_size.nx3 > 1) lk = 1;
-    for (int n=0; n<tnderef; n++) {
-      if ((lderef[n].lx1 & 1LL) == 0LL &&
-          (lderef[n].lx2 & 1LL) == 0LL &&
-          (lderef[n].lx3 & 1LL) == 0LL) {
-        int r = n, rr = 0;
-        for (std::int64_t k=0; k<=lk; k++) {
-          for (std::int64_t j=0; j<=lj; j++) {
-            for (std::int64_t i=0; i<=1; i++) {
-              if (r < tnderef) {
-                if ((lderef[n].lx1+i) == lderef[r].lx1
-                    && (lderef[n].lx2+j) == lderef[r].lx2
-                    && (lderef[n].lx3+k) == lderef[r].lx3
-                    &&  lderef[n].level  == lderef[r].level)
-                  rr++;
-                r++;
-              }
-            }
-          }
-        }
-        if (rr == nleaf) {
-          clderef[ctnd].lx1   = lderef[n].lx1>>1;
-          clderef[ctnd].lx2   = lderef[n].lx2>>1;
-          clderef[ctnd].lx3   = lderef[n].lx3>>1;
-          clderef[ctnd].level = lderef[n].level-1;
-          ctnd++;
-        }
-      }
-    }
+  // split the gathered lists into the refined blocks and the derefined parents
+  int nr = 0, ctnd = 0;
+  for (int n=0; n<Globals::nranks; n++) {
+    for (int m=0; m<counts[3*n]; m++)
+      lref[nr++] = lrefcd[rdisp[n]+m];
+    for (int m=0; m<counts[3*n+1]; m++)
+      clderef[ctnd++] = lrefcd[rdisp[n]+counts[3*n]+m];
   }
-  // sort the lists by level
-  if (ctnd > 1)
-    std::sort(clderef, &(clderef[ctnd-1]), LogicalLocation::Greater);
+  if (tnref + tncderef > 0)
+    delete [] lrefcd;
 
-  if (tnderef >= nleaf)
+  // calculate the list of the newly derefined blocks split between ranks
+  if (tnderef >= nleaf) {
+    ctnd += MergeDerefinedSiblings(lderef, tnderef, &(clderef[ctnd]), nullptr);
     delete [] lderef;
+  }
+  // sort the whole list by level, finest first, since the parents merged locally and
+  // across ranks are appended in an order that depends on the rank layout.
+  // The order within a level does not change the result of Derefine().
+  if (ctnd > 1)
+    std::sort(clderef, clderef + ctnd, LogicalLocation::Greater);
 
   // Now the lists of the blocks to be refined and derefined are completed
   // Start tree manipulation
@@ -299,32 +411,30 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
     MeshBlockTree *bt = tree.FindMeshBlock(clderef[n]);
     bt->Derefine(ndel);
   }
-  if (tnderef >= nleaf)
-    delete [] clderef;
+  delete [] clderef;
 
   return;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn bool Mesh::GatherCostListAndCheckBalance()
-//! \brief collect the cost from MeshBlocks and check the load balance
+//! \fn bool Mesh::CheckLoadBalance()
+//! \brief check the load balance from the total cost of every rank
+//!
+//! Only the per-rank sums are reduced here; the full cost list is gathered by
+//! GatherCostList() when the MeshBlocks are actually redistributed.
 
-bool Mesh::GatherCostListAndCheckBalance() {
+bool Mesh::CheckLoadBalance() {
   if (lb_manual_ || lb_automatic_) {
+    double mycost = 0.0;
+    int ns = nslist[Globals::my_rank];
+    int ne = ns + nblist[Globals::my_rank];
+    for (int n=ns; n<ne; ++n)
+      mycost += costlist[n];
+    double maxcost = mycost, avecost = mycost;
 #ifdef MPI_PARALLEL
-    MPI_Allgatherv(MPI_IN_PLACE, nblist[Globals::my_rank], MPI_DOUBLE, costlist, nblist,
-                   nslist, MPI_DOUBLE, MPI_COMM_WORLD);
+    MPI_Allreduce(&mycost, &maxcost, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&mycost, &avecost, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
 #endif
-    double maxcost = 0.0, avecost = 0.0;
-    for (int rank=0; rank<Globals::nranks; rank++) {
-      double rcost = 0.0;
-      int ns = nslist[rank];
-      int ne = ns + nblist[rank];
-      for (int n=ns; n<ne; ++n)
-        rcost += costlist[n];
-      maxcost = std::max(maxcost,rcost);
-      avecost += rcost;
-    }
     avecost /= Globals::nranks;
 
     if (adaptive) lb_tolerance_ = 2.0*static_cast<double>(Globals::nranks)
@@ -336,6 +446,24 @@ bool Mesh::GatherCostListAndCheckBalance() {
   return true;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::GatherCostList()
+//! \brief collect the cost from MeshBlocks of all ranks
+//!
+//! Called only when the MeshBlocks are redistributed, i.e. after a regrid or when
+//! CheckLoadBalance() finds an imbalance, since CalculateLoadBalance() partitions the
+//! full list on every rank. Like loclist and ranklist, costlist is replicated.
+
+void Mesh::GatherCostList() {
+  if (lb_manual_ || lb_automatic_) {
+#ifdef MPI_PARALLEL
+    MPI_Allgatherv(MPI_IN_PLACE, nblist[Globals::my_rank], MPI_DOUBLE, costlist, nblist,
+                   nslist, MPI_DOUBLE, MPI_COMM_WORLD);
+#endif
+  }
+  return;
+}
+
 
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot)
@@ -399,34 +527,7 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   int bnx3 = my_blocks(0)->block_size.nx3;
 
 #ifdef MPI_PARALLEL
-  // Step 3. count the number of the blocks to be sent / received
-  int nsend = 0, nrecv = 0;
-  for (int n=nbs; n<=nbe; n++) {
-    int on = newtoold[n];
-    if (loclist[on].level > newloc[n].level) { // f2c
-      for (int k=0; k<nleaf; k++) {
-        if (ranklist[on+k] != Globals::my_rank)
-          nrecv++;
-      }
-    } else {
-      if (ranklist[on] != Globals::my_rank)
-        nrecv++;
-    }
-  }
-  for (int n=gids_; n<=gide_; n++) {
-    int nn = oldtonew[n];
-    if (loclist[n].level < newloc[nn].level) { // c2f
-      for (int k=0; k<nleaf; k++) {
-        if (newrank[nn+k] != Globals::my_rank)
-          nsend++;
-      }
-    } else {
-      if (newrank[nn] != Globals::my_rank)
-        nsend++;
-    }
-  }
-
-  // Step 4. calculate buffer sizes
+  // Step 3. calculate buffer sizes
   Real **sendbuf, **recvbuf;
   // use the first MeshBlock in the linked list of blocks belonging to this MPI rank as a
   // representative of all MeshBlocks for counting the "load-balancing registered" and
@@ -463,12 +564,54 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   // add one more element to buffer size for storing the derefinement counter
   bssame++;
 
+  // Step 4. count the number of the blocks and the buffer volume to be sent / received
+  int nsend = 0, nrecv = 0;
+  std::size_t sendsize = 0, recvsize = 0;
+  for (int n=nbs; n<=nbe; n++) {
+    int on = newtoold[n];
+    if (loclist[on].level > newloc[n].level) { // f2c
+      for (int k=0; k<nleaf; k++) {
+        if (ranklist[on+k] != Globals::my_rank) {
+          nrecv++;
+          recvsize += bsf2c;
+        }
+      }
+    } else {
+      if (ranklist[on] != Globals::my_rank) {
+        nrecv++;
+        recvsize += (loclist[on].level == newloc[n].level) ? bssame : bsc2f;
+      }
+    }
+  }
+  for (int n=gids_; n<=gide_; n++) {
+    int nn = oldtonew[n];
+    if (loclist[n].level < newloc[nn].level) { // c2f
+      for (int k=0; k<nleaf; k++) {
+        if (newrank[nn+k] != Globals::my_rank) {
+          nsend++;
+          sendsize += bsc2f;
+        }
+      }
+    } else {
+      if (newrank[nn] != Globals::my_rank) {
+        nsend++;
+        sendsize += (loclist[n].level == newloc[nn].level) ? bssame : bsf2c;
+      }
+    }
+  }
+
+  ReserveMigrationPool(&lb_sendpool_, sendsize);
+  ReserveMigrationPool(&lb_recvpool_, recvsize);
+
   MPI_Request *req_send, *req_recv;
-  // Step 5. allocate and start receiving buffers
+  // new gid and index of the fine block (f2c only) of every receive buffer
+  std::vector<int> recv_gid(nrecv), recv_leaf(nrecv);
+  // Step 5. take receiving buffers from the pool and start receiving
   if (nrecv != 0) {
     recvbuf = new Real*[nrecv];
     req_recv = new MPI_Request[nrecv];
     int rb_idx = 0;     // recv buffer index
+    std::size_t offset = 0;
     for (int n=nbs; n<=nbe; n++) {
       int on = newtoold[n];
       LogicalLocation const &oloc = loclist[on];
@@ -479,7 +622,10 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
           LogicalLocation &lloc = loclist[on+l];
           int ox1 = ((lloc.lx1 & 1LL) == 1LL), ox2 = ((lloc.lx2 & 1LL) == 1LL),
               ox3 = ((lloc.lx3 & 1LL) == 1LL);
-          recvbuf[rb_idx] = new Real[bsf2c];
+          recvbuf[rb_idx] = lb_recvpool_.data + offset;
+          offset += bsf2c;
+          recv_gid[rb_idx] = n;
+          recv_leaf[rb_idx] = l;
           int tag = CreateAMRMPITag(n-nbs, ox1, ox2, ox3);
           MPI_Irecv(recvbuf[rb_idx], bsf2c, MPI_ATHENA_REAL, ranklist[on+l],
                     tag, MPI_COMM_WORLD, &(req_recv[rb_idx]));
@@ -493,7 +639,10 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
         } else {
           size = bsc2f;
         }
-        recvbuf[rb_idx] = new Real[size];
+        recvbuf[rb_idx] = lb_recvpool_.data + offset;
+        offset += size;
+        recv_gid[rb_idx] = n;
+        recv_leaf[rb_idx] = 0;
         int tag = CreateAMRMPITag(n-nbs, 0, 0, 0);
         MPI_Irecv(recvbuf[rb_idx], size, MPI_ATHENA_REAL, ranklist[on],
                   tag, MPI_COMM_WORLD, &(req_recv[rb_idx]));
@@ -501,11 +650,12 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       }
     }
   }
-  // Step 6. allocate, pack and start sending buffers
+  // Step 6. take sending buffers from the pool, pack and start sending
   if (nsend != 0) {
     sendbuf = new Real*[nsend];
     req_send = new MPI_Request[nsend];
     int sb_idx = 0;      // send buffer index
+    std::size_t offset = 0;
     for (int n=gids_; n<=gide_; n++) {
       int nn = oldtonew[n];
       LogicalLocation &oloc = loclist[n];
@@ -513,7 +663,8 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
       MeshBlock* pb = FindMeshBlock(n);
       if (nloc.level == oloc.level) { // same level
         if (newrank[nn] == Globals::my_rank) continue;
-        sendbuf[sb_idx] = new Real[bssame];
+        sendbuf[sb_idx] = lb_sendpool_.data + offset;
+        offset += bssame;
         PrepareSendSameLevel(pb, sendbuf[sb_idx]);
         int tag = CreateAMRMPITag(nn-nslist[newrank[nn]], 0, 0, 0);
         MPI_Isend(sendbuf[sb_idx], bssame, MPI_ATHENA_REAL, newrank[nn],
@@ -523,7 +674,8 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
         // c2f must communicate to multiple leaf blocks (unlike f2c, same2same)
         for (int l=0; l<nleaf; l++) {
           if (newrank[nn+l] == Globals::my_rank) continue;
-          sendbuf[sb_idx] = new Real[bsc2f];
+          sendbuf[sb_idx] = lb_sendpool_.data + offset;
+          offset += bsc2f;
           PrepareSendCoarseToFineAMR(pb, sendbuf[sb_idx], newloc[nn+l]);
           int tag = CreateAMRMPITag(nn+l-nslist[newrank[nn+l]], 0, 0, 0);
           MPI_Isend(sendbuf[sb_idx], bsc2f, MPI_ATHENA_REAL, newrank[nn+l],
@@ -532,7 +684,8 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
         } // end loop over nleaf (unique to c2f branch in this step 6)
       } else { // f2c: restrict + pack + send
         if (newrank[nn] == Globals::my_rank) continue;
-        sendbuf[sb_idx] = new Real[bsf2c];
+        sendbuf[sb_idx] = lb_sendpool_.data + offset;
+        offset += bsf2c;
         PrepareSendFineToCoarseAMR(pb, sendbuf[sb_idx]);
         int ox1 = ((oloc.lx1 & 1LL) == 1LL), ox2 = ((oloc.lx2 & 1LL) == 1LL),
             ox3 = ((oloc.lx3 & 1LL) == 1LL);
@@ -595,34 +748,22 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
   gids_ = nbs;
   gide_ = nbe;
 
-  // Step 8. Receive the data and load into MeshBlocks
-  // This is a test: try MPI_Waitall later.
+  // Step 8. Receive the data and load into MeshBlocks in the order of arrival
 #ifdef MPI_PARALLEL
-  if (nrecv != 0) {
-    int rb_idx = 0;     // recv buffer index
-    for (int n=nbs; n<=nbe; n++) {
-      int on = newtoold[n];
-      LogicalLocation const &oloc = loclist[on];
-      LogicalLocation const &nloc = newloc[n];
-      MeshBlock *pb = FindMeshBlock(n);
-      if (oloc.level == nloc.level) { // same
-        if (ranklist[on] == Globals::my_rank) continue;
-        MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
-        FinishRecvSameLevel(pb, recvbuf[rb_idx]);
-        rb_idx++;
-      } else if (oloc.level > nloc.level) { // f2c
-        for (int l=0; l<nleaf; l++) {
-          if (ranklist[on+l] == Globals::my_rank) continue;
-          MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
-          FinishRecvFineToCoarseAMR(pb, recvbuf[rb_idx], loclist[on+l]);
-          rb_idx++;
-        }
-      } else { // c2f
-        if (ranklist[on] == Globals::my_rank) continue;
-        MPI_Wait(&(req_recv[rb_idx]), MPI_STATUS_IGNORE);
-        FinishRecvCoarseToFineAMR(pb, recvbuf[rb_idx]);
-        rb_idx++;
-      }
+  for (int m=0; m<nrecv; m++) {
+    int rb_idx;     // recv buffer index
+    MPI_Waitany(nrecv, req_recv, &rb_idx, MPI_STATUS_IGNORE);
+    int n = recv_gid[rb_idx];
+    int on = newtoold[n];
+    LogicalLocation const &oloc = loclist[on];
+    LogicalLocation const &nloc = newloc[n];
+    MeshBlock *pb = FindMeshBlock(n);
+    if (oloc.level == nloc.level) { // same
+      FinishRecvSameLevel(pb, recvbuf[rb_idx]);
+    } else if (oloc.level > nloc.level) { // f2c
+      FinishRecvFineToCoarseAMR(pb, recvbuf[rb_idx], loclist[on+recv_leaf[rb_idx]]);
+    } else { // c2f
+      FinishRecvCoarseToFineAMR(pb, recvbuf[rb_idx]);
     }
   }
 #endif
@@ -636,14 +777,10 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot) {
 #ifdef MPI_PARALLEL
   if (nsend != 0) {
     MPI_Waitall(nsend, req_send, MPI_STATUSES_IGNORE);
-    for (int n=0; n<nsend; n++)
-      delete [] sendbuf[n];
     delete [] sendbuf;
     delete [] req_send;
   }
   if (nrecv != 0) {
-    for (int n=0; n<nrecv; n++)
-      delete [] recvbuf[n];
     delete [] recvbuf;
     delete [] req_recv;
   }
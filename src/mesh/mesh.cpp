@@ -34,17 +34,21 @@
 #include "../chem_rad/integrators/rad_integrators.hpp"
 #include "../coordinates/coordinates.hpp"
 #include "../cr/cr.hpp"
+#include "../cr/implicit/cr_implicit.hpp"
 #include "../eos/eos.hpp"
 #include "../fft/athena_fft.hpp"
 #include "../fft/turbulence.hpp"
 #include "../field/field.hpp"
 #include "../field/field_diffusion/field_diffusion.hpp"
+#include "../field/field_diffusion/mg_ohmic.hpp"
 #include "../globals.hpp"
 #include "../gravity/fft_gravity.hpp"
 #include "../gravity/gravity.hpp"
+#include "../gravity/gravity_cadence.hpp"
 #include "../gravity/mg_gravity.hpp"
 #include "../hydro/hydro.hpp"
 #include "../hydro/hydro_diffusion/hydro_diffusion.hpp"
+#include "../hydro/hydro_diffusion/mg_conduction.hpp"
 #include "../multigrid/multigrid.hpp"
 #include "../nr_radiation/implicit/radiation_implicit.hpp"
 #include "../nr_radiation/radiation.hpp"
@@ -107,6 +111,7 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     muj(), nuj(), muj_tilde(), gammaj_tilde(),
     nbnew(), nbdel(),
     step_since_lb(), turb_flag(), amr_updated(multilevel),
+    pmgcnd(), pmgohm(), pgcad(), pimcr(),
     // private members:
     next_phys_id_(), num_mesh_threads_(pin->GetOrAddInteger("mesh", "num_threads", 1)),
     gids_(), gide_(),
@@ -114,10 +119,11 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     use_uniform_meshgen_fn_{true, true, true},
     nreal_user_mesh_data_(), nint_user_mesh_data_(), nuser_history_output_(),
     four_pi_G_(-1.0),
-    lb_flag_(true), lb_automatic_(), lb_manual_(),
+    lb_flag_(true), lb_automatic_(), lb_manual_(), lb_verbose_(),
     MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
                    UniformMeshGeneratorX3},
     BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
+    BoundaryPencilFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
     AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, ViscosityCoeff_{},
     ConductionCoeff_{}, FieldDiffusivity_{},
     OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
@@ -309,6 +315,7 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
   lb_tolerance_ = pin->GetOrAddReal("loadbalancing","tolerance",0.5);
   lb_interval_ = pin->GetOrAddReal("loadbalancing","interval",10);
 #endif
+  lb_verbose_ = pin->GetOrAddBoolean("loadbalancing","verbose",false);
 
   // SMR / AMR:
   if (adaptive) {
@@ -322,6 +329,7 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
   } else {
     max_level = 63;
   }
+  ReadRefinementCriteria(pin);
 
   // initialize units
   punit = new Units(pin);
@@ -534,10 +542,20 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     // MGDriver must be initialzied before MeshBlocks
     pmgrd = new MGGravityDriver(this, pin);
   }
+  if (SELF_GRAVITY_ENABLED && GravitySolveCadence::Enabled(pin))
+    pgcad = new GravitySolveCadence(this, pin);
+  if (NON_BAROTROPIC_EOS
+      && pin->GetOrAddString("conduction", "integrator", "explicit") == "implicit")
+    pmgcnd = new MGConductionDriver(this, pin);
+  if (MAGNETIC_FIELDS_ENABLED
+      && pin->GetOrAddString("resistivity", "integrator", "explicit") == "implicit")
+    pmgohm = new MGOhmicDriver(this, pin);
 
   if (IM_RADIATION_ENABLED) {
     pimrad = new IMRadiation(this, pin);
   }
+  if (CR_ENABLED && pin->GetOrAddString("cr", "integrator", "explicit") == "implicit")
+    pimcr = new IMCosmicRay(this, pin);
 
   // create MeshBlock list for this process
   gids_ = nslist[Globals::my_rank];
@@ -602,6 +620,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     muj(), nuj(), muj_tilde(), gammaj_tilde(),
     nbnew(), nbdel(),
     step_since_lb(), turb_flag(), amr_updated(multilevel),
+    pmgcnd(), pmgohm(), pgcad(), pimcr(),
     // private members:
     next_phys_id_(), num_mesh_threads_(pin->GetOrAddInteger("mesh", "num_threads", 1)),
     gids_(), gide_(),
@@ -609,10 +628,11 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     use_uniform_meshgen_fn_{true, true, true},
     nreal_user_mesh_data_(), nint_user_mesh_data_(), nuser_history_output_(),
     four_pi_G_(-1.0),
-    lb_flag_(true), lb_automatic_(), lb_manual_(),
+    lb_flag_(true), lb_automatic_(), lb_manual_(), lb_verbose_(),
     MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
                    UniformMeshGeneratorX3},
     BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
+    BoundaryPencilFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
     AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, ViscosityCoeff_{},
     ConductionCoeff_{}, FieldDiffusivity_{},
     OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
@@ -694,6 +714,45 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   nrbx2 = mesh_size.nx2/block_size.nx2;
   nrbx3 = mesh_size.nx3/block_size.nx3;
 
+  // MeshBlock size of the restart file (set in main()); the MeshBlocks are split or
+  // merged if it differs from the current one, see mesh_reblock.cpp
+  RegionSize restart_block = block_size;
+  restart_block.nx1 = pin->GetOrAddInteger("meshblock", "restart_nx1", block_size.nx1);
+  restart_block.nx2 = pin->GetOrAddInteger("meshblock", "restart_nx2", block_size.nx2);
+  restart_block.nx3 = pin->GetOrAddInteger("meshblock", "restart_nx3", block_size.nx3);
+  int restart_root_level = root_level;
+  bool reblock = (restart_block.nx1 != block_size.nx1
+                  || restart_block.nx2 != block_size.nx2
+                  || restart_block.nx3 != block_size.nx3);
+  if (reblock) {
+    const int oldnx[3] = {restart_block.nx1, restart_block.nx2, restart_block.nx3};
+    const int newnx[3] = {block_size.nx1, block_size.nx2, block_size.nx3};
+    const int meshnx[3] = {mesh_size.nx1, mesh_size.nx2, mesh_size.nx3};
+    const bool active[3] = {true, f2, f3};
+    for (int d=0; d<3; ++d) {
+      int big = std::max(oldnx[d], newnx[d]), small = std::min(oldnx[d], newnx[d]);
+      if ((active[d] && newnx[d] < NGHOST) || meshnx[d] % newnx[d] != 0
+          || big % small != 0 || ((big/small) & (big/small - 1)) != 0) {
+        msg << "### FATAL ERROR in Mesh constructor" << std::endl
+            << "Cannot change the MeshBlock size from " << oldnx[d] << " to "
+            << newnx[d] << " cells in x" << d+1 << " on restart: the new size must "
+            << "be >= NGHOST, divide the Mesh and differ from the old one by a power "
+            << "of two."
+            << std::endl;
+        ATHENA_ERROR(msg);
+      }
+    }
+    if (multilevel && (block_size.nx1 % 2 == 1 || (block_size.nx2 % 2 == 1 && f2)
+                       || (block_size.nx3 % 2 == 1 && f3))) {
+      msg << "### FATAL ERROR in Mesh constructor" << std::endl
+          << "The size of MeshBlock must be divisible by 2 in order to use SMR or AMR."
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    int nbmax = std::max(nrbx1, std::max(nrbx2, nrbx3));
+    for (root_level=0; (1<<root_level) < nbmax; root_level++) {}
+  }
+
   // initialize user-enrollable functions
   if (mesh_size.x1rat != 1.0) {
     use_uniform_meshgen_fn_[X1DIR] = false;
@@ -717,6 +776,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   lb_tolerance_ = pin->GetOrAddReal("loadbalancing", "tolerance", 0.5);
   lb_interval_ = pin->GetOrAddReal("loadbalancing", "interval", 10);
 #endif
+  lb_verbose_ = pin->GetOrAddBoolean("loadbalancing", "verbose", false);
 
   // SMR / AMR
   if (adaptive) {
@@ -730,6 +790,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   } else {
     max_level = 63;
   }
+  ReadRefinementCriteria(pin);
 
   // initialize units
   punit = new Units(pin);
@@ -797,10 +858,14 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   }
   delete [] idlist;
 
+  int restart_nbtotal = nbtotal;
+  std::vector<ReblockSource> reblock_list;
+  if (reblock) ReblockRestartList(restart_block, restart_root_level, reblock_list);
+
   if (!adaptive) max_level = current_level;
 
   // calculate the header offset and seek
-  headeroffset += headersize + udsize + listsize*nbtotal;
+  headeroffset += headersize + udsize + listsize*restart_nbtotal;
   if (Globals::my_rank != 0)
     resfile.Seek(headeroffset);
 
@@ -817,6 +882,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
         << nbtotal << " != " << nnb << ")" << std::endl;
     ATHENA_ERROR(msg);
   }
+  if (reblock) SortReblockSources(reblock_list);
 
 #ifdef MPI_PARALLEL
   if (nbtotal < Globals::nranks) {
@@ -861,10 +927,20 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     // MGDriver must be initialzied before MeshBlocks
     pmgrd = new MGGravityDriver(this, pin);
   }
+  if (SELF_GRAVITY_ENABLED && GravitySolveCadence::Enabled(pin))
+    pgcad = new GravitySolveCadence(this, pin);
+  if (NON_BAROTROPIC_EOS
+      && pin->GetOrAddString("conduction", "integrator", "explicit") == "implicit")
+    pmgcnd = new MGConductionDriver(this, pin);
+  if (MAGNETIC_FIELDS_ENABLED
+      && pin->GetOrAddString("resistivity", "integrator", "explicit") == "implicit")
+    pmgohm = new MGOhmicDriver(this, pin);
 
   if (IM_RADIATION_ENABLED) {
     pimrad = new IMRadiation(this, pin);
   }
+  if (CR_ENABLED && pin->GetOrAddString("cr", "integrator", "explicit") == "implicit")
+    pimcr = new IMCosmicRay(this, pin);
 
 
   // allocate data buffer
@@ -879,6 +955,16 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   char *mbdata = new char[datasize];
   my_blocks.NewAthenaArray(nblocal);
   for (int i=gids_; i<=gide_; i++) {
+    if (reblock) {
+      // create the MeshBlock and copy its cells from the blocks of the file
+      SetBlockSizeAndBoundaries(loclist[i], block_size, block_bcs);
+      my_blocks(i-gids_) = new MeshBlock(i, i-gids_, loclist[i], block_size, block_bcs,
+                                         this, pin);
+      LoadReblockedMeshBlock(my_blocks(i-gids_), reblock_list[i], restart_block,
+                             resfile, headeroffset, datasize);
+      my_blocks(i-gids_)->pbval->SearchAndSetNeighbors(tree, ranklist, nslist);
+      continue;
+    }
     if (i - gids_ < nbmin) {
       // load MeshBlock (parallel)
       if (resfile.Read_at_all(mbdata, datasize, 1, headeroffset+i*datasize) != 1) {
@@ -903,8 +989,10 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     my_blocks(i-gids_)->pbval->SearchAndSetNeighbors(tree, ranklist, nslist);
   }
   delete [] mbdata;
-  // check consistency
-  if ( (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) &&
+  // check consistency (done in LoadReblockedMeshBlock() for re-blocked restarts)
+  if (reblock) {
+    // nothing to do
+  } else if ( (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) &&
                     my_blocks(0)->pnrrad->restart_from_gray > 0) {
     if (datasize != my_blocks(0)->GetBlockSizeInBytesGray()) {
         msg << "### FATAL ERROR in Mesh constructor" << std::endl
@@ -942,9 +1030,15 @@ Mesh::~Mesh() {
   delete [] ranklist;
   delete [] costlist;
   delete [] loclist;
+  delete [] lb_sendpool_.data;
+  delete [] lb_recvpool_.data;
   if (SELF_GRAVITY_ENABLED == 1) delete pfgrd;
   else if (SELF_GRAVITY_ENABLED == 2) delete pmgrd;
+  delete pmgcnd;
+  delete pmgohm;
+  delete pgcad;
   if (IM_RADIATION_ENABLED) delete pimrad;
+  delete pimcr;
   if (turb_flag > 0) delete ptrbd;
   if (adaptive) { // deallocate arrays for AMR
     delete [] nref;
@@ -1196,6 +1290,34 @@ void Mesh::EnrollUserBoundaryFunction(int dir, BValFunc my_bc) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::EnrollUserBoundaryPencilFunction(BoundaryFace dir,
+//!                                                  BValPencilFunc my_bc)
+//! \brief Enroll a user-defined boundary function called for each row of ghost cells
+//!
+//! \note
+//! - the rows run along x1: i over the ghost cells for the x1 faces, and over the
+//!   whole transverse range for the x2 and x3 faces, so the loop over i can vectorize
+//! - if a BValFunc is enrolled on the same face (e.g. for the magnetic field), it is
+//!   called first
+
+void Mesh::EnrollUserBoundaryPencilFunction(BoundaryFace dir, BValPencilFunc my_bc) {
+  std::stringstream msg;
+  if (dir < 0 || dir > 5) {
+    msg << "### FATAL ERROR in EnrollUserBoundaryPencilFunction" << std::endl
+        << "dirName = " << dir << " not valid" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (mesh_bcs[dir] != BoundaryFlag::user) {
+    msg << "### FATAL ERROR in EnrollUserBoundaryPencilFunction" << std::endl
+        << "The boundary condition flag must be set to the string 'user' in the "
+        << " <mesh> block in the input file to use user-enrolled BCs" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  BoundaryPencilFunction_[static_cast<int>(dir)]=my_bc;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::EnrollUserMGGravityBoundaryFunction(BoundaryFace dir,
 //!                                                    MGBoundaryFunc my_bc)
@@ -1516,6 +1638,8 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
       pfgrd->Solve(1, 0);
     else if (SELF_GRAVITY_ENABLED == 2)
       pmgrd->Solve(1);
+    if (pgcad != nullptr)
+      pgcad->StoreSolution(time);
 
 #pragma omp parallel num_threads(nthreads)
     {
@@ -1533,6 +1657,8 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
                                     pbval->bvars_main_int);
         if (IM_RADIATION_ENABLED)
           pmb->pnrrad->rad_bvar.StartReceiving(BoundaryCommSubset::radiation);
+        if (pimcr != nullptr)
+          pmb->pcr->cr_bvar.StartReceiving(BoundaryCommSubset::radiation);
       }
 
       // send conserved variables
@@ -1555,6 +1681,7 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
 
 
         if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) {
+          pmb->pnrrad->QuantizeIntensity(pmb->pnrrad->ir);
           pmb->pnrrad->rad_bvar.SendBoundaryBuffers();
         }
         if (CR_ENABLED) {
@@ -1586,6 +1713,8 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
                                    pbval->bvars_main_int);
         if (IM_RADIATION_ENABLED)
           pmb->pnrrad->rad_bvar.ClearBoundary(BoundaryCommSubset::radiation);
+        if (pimcr != nullptr)
+          pmb->pcr->cr_bvar.ClearBoundary(BoundaryCommSubset::radiation);
       }
 
       // With AMR/SMR GR send primitives to enable cons->prim before prolongation
@@ -1989,6 +2118,8 @@ void Mesh::CorrectMidpointInitialCondition() {
 
     if (IM_RADIATION_ENABLED)
       pmb->pnrrad->rad_bvar.StartReceiving(BoundaryCommSubset::radiation);
+    if (pimcr != nullptr)
+      pmb->pcr->cr_bvar.StartReceiving(BoundaryCommSubset::radiation);
   }
 
 #pragma omp for private(pmb,pbval)
@@ -2049,6 +2180,8 @@ void Mesh::CorrectMidpointInitialCondition() {
     if (IM_RADIATION_ENABLED) {
       pmb->pnrrad->rad_bvar.ClearBoundary(BoundaryCommSubset::radiation);
     }
+    if (pimcr != nullptr)
+      pmb->pcr->cr_bvar.ClearBoundary(BoundaryCommSubset::radiation);
   } // end second exchange of ghost cells
   return;
 }
@@ -49,17 +49,22 @@ class Hydro;
 class NRRadiation;
 class IMRadiation;
 class CosmicRay;
+class IMCosmicRay;
 class Field;
 class Particles;
 class PassiveScalars;
 class Gravity;
 class MGGravityDriver;
+class MGConductionDriver;
+class MGOhmicDriver;
+class GravitySolveCadence;
 class EquationOfState;
 class FFTDriver;
 class FFTGravityDriver;
 class TurbulenceDriver;
 class ChemRadiation;
 class OrbitalAdvection;
+class PolarCoarsening;
 
 FluidFormulation GetFluidFormulation(const std::string& input_string);
 
@@ -130,6 +135,7 @@ class MeshBlock {
   EquationOfState *peos;
   ChemRadiation *pchemrad;
   OrbitalAdvection *porb;
+  PolarCoarsening *ppolar;
 
 
   // functions
@@ -193,6 +199,16 @@ class MeshBlock {
   void StopTimeMeasurement();
 };
 
+//----------------------------------------------------------------------------------------
+//! \struct MigrationPool
+//! \brief MPI buffer for migrating MeshBlocks, reused across redistributions
+
+struct MigrationPool {
+  Real *data = nullptr;
+  std::size_t size = 0;  // number of Reals allocated
+  int noversized = 0;    // consecutive redistributions that needed less than size/4
+};
+
 //----------------------------------------------------------------------------------------
 //! \class Mesh
 //! \brief data/functions associated with the overall mesh
@@ -200,6 +216,7 @@ class MeshBlock {
 class Mesh {
   friend class RestartOutput;
   friend class HistoryOutput;
+  friend class SpectrumOutput;
   friend class MeshBlock;
   friend class MeshBlockTree;
   friend class BoundaryBase;
@@ -220,11 +237,14 @@ class Mesh {
   friend class TurbulenceDriver;
   friend class MultigridDriver;
   friend class MGGravityDriver;
+  friend class MGConductionDriver;
+  friend class MGOhmicDriver;
   friend class Gravity;
   friend class HydroDiffusion;
   friend class FieldDiffusion;
   friend class OrbitalAdvection;
   friend class Particles;
+  friend class ColumnDensityScan;
 #ifdef HDF5OUTPUT
   friend class ATHDF5Output;
 #endif
@@ -267,10 +287,15 @@ class Mesh {
   TurbulenceDriver *ptrbd;
   FFTGravityDriver *pfgrd;
   MGGravityDriver *pmgrd;
+  MGConductionDriver *pmgcnd;
+  MGOhmicDriver *pmgohm;
+  GravitySolveCadence *pgcad;
   Units *punit;
 
   // implicit radiation iteration
   IMRadiation *pimrad;
+  // implicit cosmic ray iteration, nullptr with the explicit cosmic ray transport
+  IMCosmicRay *pimcr;
 
   AthenaArray<Real> *ruser_mesh_data;
   AthenaArray<int> *iuser_mesh_data;
@@ -330,13 +355,21 @@ class Mesh {
   Real four_pi_G_;
 
   // variables for load balancing control
-  bool lb_flag_, lb_automatic_, lb_manual_;
+  bool lb_flag_, lb_automatic_, lb_manual_, lb_verbose_;
   double lb_tolerance_;
   int lb_interval_;
+  // built-in refinement criteria of the <amr_criterionN> blocks, cycles between their
+  // evaluations and cells checked outside the MeshBlocks; used by all MeshRefinement
+  std::vector<RefinementCriterion> amr_criteria_;
+  int amr_check_interval_, amr_check_buffer_;
+
+  // MPI buffers for migrating MeshBlocks, reused across redistributions
+  MigrationPool lb_sendpool_, lb_recvpool_;
 
   // functions
   MeshGenFunc MeshGenerator_[3];
   BValFunc BoundaryFunction_[6];
+  BValPencilFunc BoundaryPencilFunction_[6];
   // radiation boundaries
   RadBoundaryFunc RadBoundaryFunc_[6];
   CRBoundaryFunc CRBoundaryFunc_[6];
@@ -359,13 +392,33 @@ class Mesh {
   void CalculateLoadBalance(double *clist, int *rlist, int *slist, int *nlist, int nb);
   void ResetLoadBalanceVariables();
 
+  //! a MeshBlock of a restart with a changed MeshBlock size and its source blocks
+  struct ReblockSource {
+    LogicalLocation loc;
+    double cost;
+    std::vector<int> ids;               // indices of the source blocks in the file
+    std::vector<LogicalLocation> locs;  // their locations in the old decomposition
+  };
+  // restart with a different MeshBlock size, defined in mesh_reblock.cpp
+  void ReblockRestartList(const RegionSize &rblock, int rroot_level,
+                          std::vector<ReblockSource> &blist);
+  void SortReblockSources(std::vector<ReblockSource> &blist);
+  void LoadReblockedMeshBlock(MeshBlock *pmb, const ReblockSource &src,
+                              const RegionSize &rblock, IOWrapper &resfile,
+                              IOWrapperSizeT offset, IOWrapperSizeT datasize);
+
   void CorrectMidpointInitialCondition();
   void ReserveMeshBlockPhysIDs();
+  // built-in refinement criteria, defined in refinement_criteria.cpp
+  void ReadRefinementCriteria(ParameterInput *pin);
 
   // Mesh::LoadBalancingAndAdaptiveMeshRefinement() helper functions:
   void UpdateCostList();
+  int MergeDerefinedSiblings(LogicalLocation *lderef, int nderef,
+                             LogicalLocation *clderef, int *merged);
   void UpdateMeshBlockTree(int &nnew, int &ndel);
-  bool GatherCostListAndCheckBalance();
+  bool CheckLoadBalance();
+  void GatherCostList();
   void RedistributeAndRefineMeshBlocks(ParameterInput *pin, int ntot);
 
   // Mesh::RedistributeAndRefineMeshBlocks() helper functions:
@@ -388,6 +441,7 @@ class Mesh {
 
   // often used (not defined) in prob file in ../pgen/
   void EnrollUserBoundaryFunction(BoundaryFace face, BValFunc my_func);
+  void EnrollUserBoundaryPencilFunction(BoundaryFace face, BValPencilFunc my_func);
   void EnrollUserMGGravityBoundaryFunction(BoundaryFace dir, MGBoundaryFunc my_bc);
   void EnrollUserMGGravitySourceMaskFunction(MGSourceMaskFunc srcmask);
 
@@ -0,0 +1,319 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mesh_reblock.cpp
+//! \brief restarting from a restart file written with a different MeshBlock size
+//!
+//! The <meshblock> nx1/nx2/nx3 of the restart file are kept as restart_nx1/2/3 by main()
+//! before the -i file and the command line are applied. If they differ from the new
+//! values, every MeshBlock of the file is split into or merged with blocks of the new
+//! size at the same physical refinement level, and the active cells of the new blocks
+//! are copied from the file; ghost cells are filled by the boundary communication in
+//! Mesh::Initialize(). The ratio of the old and new sizes must be a power of two in
+//! every direction, and merged blocks must be complete in the file.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max(), min()
+#include <cstdint>    // int64_t
+#include <cstring>    // memcpy()
+#include <iostream>   // endl
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <unordered_map>
+#include <utility>    // move()
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../chem_rad/chem_rad.hpp"
+#include "../cr/cr.hpp"
+#include "../field/field.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../nr_radiation/radiation.hpp"
+#include "../outputs/io_wrapper.hpp"
+#include "../scalars/scalars.hpp"
+#include "mesh.hpp"
+#include "meshblock_tree.hpp"
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \struct RestartArray
+//! \brief an array of the restart data with nvar variables stored outside (n,k,j,i) or
+//!        inside (k,j,i,n) the spatial indices; face = 1,2,3 for face-centered arrays
+
+struct RestartArray {
+  AthenaArray<Real> *parr;
+  int nvar;
+  bool var_inner;
+  int face;
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn std::vector<RestartArray> RestartArrays(MeshBlock *pmb)
+//! \brief the physics arrays of a MeshBlock in the order written by RestartOutput
+
+std::vector<RestartArray> RestartArrays(MeshBlock *pmb) {
+  std::vector<RestartArray> arrays;
+  arrays.push_back({&pmb->phydro->u, pmb->phydro->u.GetDim4(), false, 0});
+  if (GENERAL_RELATIVITY) {
+    arrays.push_back({&pmb->phydro->w, pmb->phydro->w.GetDim4(), false, 0});
+    arrays.push_back({&pmb->phydro->w1, pmb->phydro->w1.GetDim4(), false, 0});
+  }
+  if (MAGNETIC_FIELDS_ENABLED) {
+    arrays.push_back({&pmb->pfield->b.x1f, 1, false, 1});
+    arrays.push_back({&pmb->pfield->b.x2f, 1, false, 2});
+    arrays.push_back({&pmb->pfield->b.x3f, 1, false, 3});
+  }
+  if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)
+    arrays.push_back({&pmb->pnrrad->ir, pmb->pnrrad->ir.GetDim1(), true, 0});
+  if (CR_ENABLED)
+    arrays.push_back({&pmb->pcr->u_cr, pmb->pcr->u_cr.GetDim4(), false, 0});
+  if (NSCALARS > 0) {
+    arrays.push_back({&pmb->pscalars->s, NSCALARS, false, 0});
+    if (CHEMISTRY_ENABLED)
+      arrays.push_back({&pmb->pscalars->h, 1, false, 0});
+  }
+  if (CHEMRADIATION_ENABLED)
+    arrays.push_back({&pmb->pchemrad->ir, pmb->pchemrad->ir.GetDim1(), true, 0});
+  return arrays;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::ReblockRestartList(const RegionSize &rblock, int rroot_level,
+//!                                   std::vector<ReblockSource> &blist)
+//! \brief replaces loclist and costlist read from the restart file, whose MeshBlocks
+//!        have the size rblock and the root level rroot_level, by the list of blocks of
+//!        the current block_size, and stores the source blocks of each in blist
+
+void Mesh::ReblockRestartList(const RegionSize &rblock, int rroot_level,
+                              std::vector<ReblockSource> &blist) {
+  std::stringstream msg;
+  // refinement (>1) or coarsening (<1) ratios of the new blocks in each direction
+  const int oldnx[3] = {rblock.nx1, rblock.nx2, rblock.nx3};
+  const int newnx[3] = {block_size.nx1, block_size.nx2, block_size.nx3};
+  int nsplit = 1, nmerge = 1;
+  for (int d=0; d<3; ++d) {
+    if (oldnx[d] > newnx[d])
+      nsplit *= oldnx[d]/newnx[d];
+    else
+      nmerge *= newnx[d]/oldnx[d];
+  }
+
+  std::unordered_map<LogicalLocation, int, MortonKeyHash> index;
+  blist.clear();
+  current_level = root_level;
+  for (int n=0; n<nbtotal; ++n) {
+    const LogicalLocation &oloc = loclist[n];
+    std::int64_t olx[3] = {oloc.lx1, oloc.lx2, oloc.lx3};
+    std::int64_t lxs[3], lxe[3];
+    for (int d=0; d<3; ++d) {
+      if (oldnx[d] > newnx[d]) {
+        int r = oldnx[d]/newnx[d];
+        lxs[d] = olx[d]*r, lxe[d] = olx[d]*r + r - 1;
+      } else {
+        lxs[d] = lxe[d] = olx[d]/(newnx[d]/oldnx[d]);
+      }
+    }
+    LogicalLocation nloc;
+    nloc.level = oloc.level - rroot_level + root_level;
+    current_level = std::max(current_level, nloc.level);
+    for (nloc.lx3=lxs[2]; nloc.lx3<=lxe[2]; ++nloc.lx3) {
+      for (nloc.lx2=lxs[1]; nloc.lx2<=lxe[1]; ++nloc.lx2) {
+        for (nloc.lx1=lxs[0]; nloc.lx1<=lxe[0]; ++nloc.lx1) {
+          auto it = index.find(nloc);
+          if (it == index.end()) {
+            it = index.emplace(nloc, static_cast<int>(blist.size())).first;
+            blist.push_back({nloc, 0.0, {}, {}});
+          }
+          ReblockSource &b = blist[it->second];
+          b.cost += costlist[n]/nsplit;
+          b.ids.push_back(n);
+          b.locs.push_back(oloc);
+        }
+      }
+    }
+  }
+
+  for (const ReblockSource &b : blist) {
+    if (static_cast<int>(b.ids.size()) != nmerge) {
+      msg << "### FATAL ERROR in Mesh constructor" << std::endl
+          << "Cannot merge the MeshBlocks of the restart file into MeshBlocks of "
+          << block_size.nx1 << "x" << block_size.nx2 << "x" << block_size.nx3
+          << " cells: a new MeshBlock at level " << b.loc.level - root_level
+          << " covers " << b.ids.size() << " instead of " << nmerge
+          << " MeshBlocks of the same level in the file." << std::endl;
+      ATHENA_ERROR(msg);
+    }
+  }
+
+  nbtotal = static_cast<int>(blist.size());
+  delete [] loclist;
+  delete [] costlist;
+  delete [] ranklist;
+  loclist = new LogicalLocation[nbtotal];
+  costlist = new double[nbtotal];
+  ranklist = new int[nbtotal];
+  for (int n=0; n<nbtotal; ++n)
+    loclist[n] = blist[n].loc;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::SortReblockSources(std::vector<ReblockSource> &blist)
+//! \brief reorders blist by the gid assigned by MeshBlockTree::GetMeshBlockList() and
+//!        fills costlist
+
+void Mesh::SortReblockSources(std::vector<ReblockSource> &blist) {
+  std::vector<ReblockSource> sorted(blist.size());
+  for (ReblockSource &b : blist) {
+    int gid = tree.FindMeshBlock(b.loc)->GetGid();
+    costlist[gid] = b.cost;
+    sorted[gid] = std::move(b);
+  }
+  blist.swap(sorted);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::LoadReblockedMeshBlock(MeshBlock *pmb, const ReblockSource &src,
+//!       const RegionSize &rblock, IOWrapper &resfile, IOWrapperSizeT offset,
+//!       IOWrapperSizeT datasize)
+//! \brief copies the active cells of the restart file blocks src (of the size rblock,
+//!        datasize bytes each, starting at offset) that overlap pmb into pmb
+
+void Mesh::LoadReblockedMeshBlock(MeshBlock *pmb, const ReblockSource &src,
+                                  const RegionSize &rblock, IOWrapper &resfile,
+                                  IOWrapperSizeT offset, IOWrapperSizeT datasize) {
+  std::stringstream msg;
+  if ((NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)
+      && pmb->pnrrad->restart_from_gray > 0) {
+    msg << "### FATAL ERROR in Mesh constructor" << std::endl
+        << "Restarting from a gray radiation restart file is not supported when the "
+        << "MeshBlock size is changed." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if ((NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)
+      && pmb->pnrrad->ir_storage != IntensityFormat::real) {
+    msg << "### FATAL ERROR in Mesh constructor" << std::endl
+        << "Changing the MeshBlock size on restart requires "
+        << "<radiation> intensity_storage = double." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  // cells of the old and new blocks in each direction, and the first active cell
+  const int newnx[3] = {block_size.nx1, block_size.nx2, block_size.nx3};
+  const int oldnx[3] = {rblock.nx1, rblock.nx2, rblock.nx3};
+  const bool active[3] = {true, f2, f3};
+  int oncells[3], nncells[3], ghost[3];
+  for (int d=0; d<3; ++d) {
+    ghost[d] = active[d] ? NGHOST : 0;
+    oncells[d] = oldnx[d] + 2*ghost[d];
+    nncells[d] = newnx[d] + 2*ghost[d];
+  }
+
+  std::vector<RestartArray> arrays = RestartArrays(pmb);
+  IOWrapperSizeT osize = 0;
+  for (const RestartArray &a : arrays) {
+    std::size_t ocnt = a.nvar, ncnt = a.nvar;
+    for (int d=0; d<3; ++d) {
+      ocnt *= oncells[d] + (a.face == d+1);
+      ncnt *= nncells[d] + (a.face == d+1);
+    }
+    if (ncnt*sizeof(Real) != a.parr->GetSizeInBytes()) {
+      msg << "### FATAL ERROR in Mesh constructor" << std::endl
+          << "Unexpected array layout while changing the MeshBlock size." << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    osize += ocnt*sizeof(Real);
+  }
+  IOWrapperSizeT usize = 0;
+  for (int n=0; n<pmb->nint_user_meshblock_data_; n++)
+    usize += pmb->iuser_meshblock_data[n].GetSizeInBytes();
+  for (int n=0; n<pmb->nreal_user_meshblock_data_; n++)
+    usize += pmb->ruser_meshblock_data[n].GetSizeInBytes();
+  if (osize + usize != datasize) {
+    msg << "### FATAL ERROR in Mesh constructor" << std::endl
+        << "The restart file is broken or input parameters are inconsistent."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  const std::int64_t nlx[3] = {pmb->loc.lx1, pmb->loc.lx2, pmb->loc.lx3};
+  std::vector<char> buf(datasize);
+  for (std::size_t s=0; s<src.ids.size(); ++s) {
+    if (resfile.Read_at(buf.data(), datasize, 1, offset + src.ids[s]*datasize) != 1) {
+      msg << "### FATAL ERROR in Mesh constructor" << std::endl
+          << "The restart file is broken or input parameters are inconsistent."
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    // overlapping global cells at the common physical level, and the local index of
+    // the global cell 0 in the old (oo) and new (no) blocks
+    const std::int64_t olx[3] = {src.locs[s].lx1, src.locs[s].lx2, src.locs[s].lx3};
+    std::int64_t gs[3], ge[3], oo[3], no[3];
+    for (int d=0; d<3; ++d) {
+      gs[d] = std::max(olx[d]*oldnx[d], nlx[d]*newnx[d]);
+      ge[d] = std::min((olx[d]+1)*oldnx[d], (nlx[d]+1)*newnx[d]) - 1;
+      oo[d] = ghost[d] - olx[d]*oldnx[d];
+      no[d] = ghost[d] - nlx[d]*newnx[d];
+    }
+
+    const Real *pold = reinterpret_cast<const Real *>(buf.data());
+    for (const RestartArray &a : arrays) {
+      Real *pnew = a.parr->data();
+      std::int64_t oe[3], ne[3], ke[3];
+      for (int d=0; d<3; ++d) {
+        oe[d] = oncells[d] + (a.face == d+1);
+        ne[d] = nncells[d] + (a.face == d+1);
+        ke[d] = ge[d] + (a.face == d+1);   // faces include the upper boundary
+      }
+      for (int n=0; n<a.nvar; ++n) {
+        for (std::int64_t k=gs[2]; k<=ke[2]; ++k) {
+          for (std::int64_t j=gs[1]; j<=ke[1]; ++j) {
+            for (std::int64_t i=gs[0]; i<=ke[0]; ++i) {
+              std::int64_t op = ((k+oo[2])*oe[1] + j+oo[1])*oe[0] + i+oo[0];
+              std::int64_t np = ((k+no[2])*ne[1] + j+no[1])*ne[0] + i+no[0];
+              if (a.var_inner) {
+                op = op*a.nvar + n, np = np*a.nvar + n;
+              } else {
+                op += n*oe[2]*oe[1]*oe[0], np += n*ne[2]*ne[1]*ne[0];
+              }
+              pnew[np] = pold[op];
+            }
+          }
+        }
+      }
+      pold += a.nvar*oe[2]*oe[1]*oe[0];
+    }
+
+    // user MeshBlock data have no known spatial layout; take them from the first block
+    if (s == 0) {
+      const char *pdata = buf.data() + osize;
+      for (int n=0; n<pmb->nint_user_meshblock_data_; n++) {
+        std::memcpy(pmb->iuser_meshblock_data[n].data(), pdata,
+                    pmb->iuser_meshblock_data[n].GetSizeInBytes());
+        pdata += pmb->iuser_meshblock_data[n].GetSizeInBytes();
+      }
+      for (int n=0; n<pmb->nreal_user_meshblock_data_; n++) {
+        std::memcpy(pmb->ruser_meshblock_data[n].data(), pdata,
+                    pmb->ruser_meshblock_data[n].GetSizeInBytes());
+        pdata += pmb->ruser_meshblock_data[n].GetSizeInBytes();
+      }
+    }
+  }
+
+  // as in the MeshBlock constructor for restarts
+  if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)
+    pmb->pnrrad->ir1 = pmb->pnrrad->ir;
+  if (CR_ENABLED)
+    pmb->pcr->u_cr1 = pmb->pcr->u_cr;
+  pmb->cost_ = src.cost;
+  return;
+}
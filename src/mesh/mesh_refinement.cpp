@@ -35,6 +35,9 @@
 MeshRefinement::MeshRefinement(MeshBlock *pmb, ParameterInput *pin) :
     pmy_block_(pmb), deref_count_(0),
     deref_threshold_(pin->GetOrAddInteger("mesh", "derefine_count", 10)),
+    criteria_(pmb->pmy_mesh->amr_criteria_),
+    check_interval_(pmb->pmy_mesh->amr_check_interval_),
+    check_buffer_(pmb->pmy_mesh->amr_check_buffer_),
     AMRFlag_(pmb->pmy_mesh->AMRFlag_) {
   // Create coarse mesh object for parent grid
   if (std::strcmp(COORDINATE_SYSTEM, "cartesian") == 0) {
@@ -83,6 +86,21 @@ MeshRefinement::MeshRefinement(MeshBlock *pmb, ParameterInput *pin) :
   sarea_x3_[2][0].NewAthenaArray(nc1);
   sarea_x3_[2][1].NewAthenaArray(nc1);
 
+  // the x1-spacings only depend on the coordinates, so they are computed once here for
+  // all coarse cells whose fine cells lie inside the MeshBlock
+  dx1m_.NewAthenaArray(pmb->ncc1);
+  dx1p_.NewAthenaArray(pmb->ncc1);
+  dx1fm_.NewAthenaArray(pmb->ncc1);
+  dx1fp_.NewAthenaArray(pmb->ncc1);
+  Coordinates *pco = pmb->pcoord;
+  for (int i=pmb->cis-pmb->cnghost+1; i<=pmb->cie+pmb->cnghost-1; i++) {
+    int fi = (i - pmb->cis)*2 + pmb->is;
+    dx1m_(i) = pcoarsec->x1v(i) - pcoarsec->x1v(i-1);
+    dx1p_(i) = pcoarsec->x1v(i+1) - pcoarsec->x1v(i);
+    dx1fm_(i) = pcoarsec->x1v(i) - pco->x1v(fi);
+    dx1fp_(i) = pco->x1v(fi+1) - pcoarsec->x1v(i);
+  }
+
   // KGF: probably don't need to preallocate space for pointers in these vectors
   pvars_cc_.reserve(3);
   pvars_fc_.reserve(3);
@@ -480,17 +498,11 @@ void MeshRefinement::ProlongateCellCenteredValues(
           const Real& fx2p = pco->x2v(fj+1);
           Real dx2fm = x2c - fx2m;
           Real dx2fp = fx2p - x2c;
+#pragma omp simd
           for (int i=si; i<=ei; i++) {
             int fi = (i - pmb->cis)*2 + pmb->is;
-            const Real& x1m = pcoarsec->x1v(i-1);
-            const Real& x1c = pcoarsec->x1v(i);
-            const Real& x1p = pcoarsec->x1v(i+1);
-            Real dx1m = x1c - x1m;
-            Real dx1p = x1p - x1c;
-            const Real& fx1m = pco->x1v(fi);
-            const Real& fx1p = pco->x1v(fi+1);
-            Real dx1fm = x1c - fx1m;
-            Real dx1fp = fx1p - x1c;
+            Real dx1m = dx1m_(i), dx1p = dx1p_(i);
+            Real dx1fm = dx1fm_(i), dx1fp = dx1fp_(i);
             Real ccval = coarse(n,k,j,i);
 
             // calculate 3D gradients using the minmod limiter
@@ -535,17 +547,11 @@ void MeshRefinement::ProlongateCellCenteredValues(
         const Real& fx2p = pco->x2v(fj+1);
         Real dx2fm = x2c - fx2m;
         Real dx2fp = fx2p - x2c;
+#pragma omp simd
         for (int i=si; i<=ei; i++) {
           int fi = (i - pmb->cis)*2 + pmb->is;
-          const Real& x1m = pcoarsec->x1v(i-1);
-          const Real& x1c = pcoarsec->x1v(i);
-          const Real& x1p = pcoarsec->x1v(i+1);
-          Real dx1m = x1c - x1m;
-          Real dx1p = x1p - x1c;
-          const Real& fx1m = pco->x1v(fi);
-          const Real& fx1p = pco->x1v(fi+1);
-          Real dx1fm = x1c - fx1m;
-          Real dx1fp = fx1p - x1c;
+          Real dx1m = dx1m_(i), dx1p = dx1p_(i);
+          Real dx1fm = dx1fm_(i), dx1fp = dx1fp_(i);
           Real ccval = coarse(n,k,j,i);
 
           // calculate 2D gradients using the minmod limiter
@@ -570,17 +576,11 @@ void MeshRefinement::ProlongateCellCenteredValues(
   } else { // 1D
     int k = pmb->cks, fk = pmb->ks, j = pmb->cjs, fj = pmb->js;
     for (int n=sn; n<=en; n++) {
+#pragma omp simd
       for (int i=si; i<=ei; i++) {
         int fi = (i - pmb->cis)*2 + pmb->is;
-        const Real& x1m = pcoarsec->x1v(i-1);
-        const Real& x1c = pcoarsec->x1v(i);
-        const Real& x1p = pcoarsec->x1v(i+1);
-        Real dx1m = x1c - x1m;
-        Real dx1p = x1p - x1c;
-        const Real& fx1m = pco->x1v(fi);
-        const Real& fx1p = pco->x1v(fi+1);
-        Real dx1fm = x1c - fx1m;
-        Real dx1fp = fx1p - x1c;
+        Real dx1m = dx1m_(i), dx1p = dx1p_(i);
+        Real dx1fm = dx1fm_(i), dx1fp = dx1fp_(i);
         Real ccval = coarse(n,k,j,i);
 
         // calculate 1D gradient using the min-mod limiter
@@ -787,6 +787,7 @@ void MeshRefinement::ProlongateSharedFieldX1(
         Real dx2p = x2p - x2c;
         const Real& fx2m = pco->x2s1(fj);
         const Real& fx2p = pco->x2s1(fj+1);
+#pragma omp simd
         for (int i=si; i<=ei; i++) {
           int fi = (i - pmb->cis)*2 + pmb->is;
           Real ccval = coarse(k,j,i);
@@ -818,6 +819,7 @@ void MeshRefinement::ProlongateSharedFieldX1(
       Real dx2p = x2p - x2c;
       const Real& fx2m = pco->x2s1(fj);
       const Real& fx2p = pco->x2s1(fj+1);
+#pragma omp simd
       for (int i=si; i<=ei; i++) {
         int fi = (i - pmb->cis)*2 + pmb->is;
         Real ccval = coarse(k,j,i);
@@ -832,6 +834,7 @@ void MeshRefinement::ProlongateSharedFieldX1(
       }
     }
   } else { // 1D
+#pragma omp simd
     for (int i=si; i<=ei; i++) {
       int fi = (i - pmb->cis)*2 + pmb->is;
       fine(0,0,fi) = coarse(0,0,i);
@@ -862,6 +865,7 @@ void MeshRefinement::ProlongateSharedFieldX2(
       const Real& fx3p = pco->x3s2(fk+1);
       for (int j=sj; j<=ej; j++) {
         int fj = (j - pmb->cjs)*2 + pmb->js;
+#pragma omp simd
         for (int i=si; i<=ei; i++) {
           int fi = (i - pmb->cis)*2 + pmb->is;
           const Real& x1m = pcoarsec->x1s2(i-1);
@@ -893,6 +897,7 @@ void MeshRefinement::ProlongateSharedFieldX2(
     int k = pmb->cks, fk = pmb->ks;
     for (int j=sj; j<=ej; j++) {
       int fj = (j - pmb->cjs)*2 + pmb->js;
+#pragma omp simd
       for (int i=si; i<=ei; i++) {
         int fi = (i - pmb->cis)*2 + pmb->is;
         const Real& x1m = pcoarsec->x1s2(i-1);
@@ -912,6 +917,7 @@ void MeshRefinement::ProlongateSharedFieldX2(
       }
     }
   } else {
+#pragma omp simd
     for (int i=si; i<=ei; i++) {
       int fi = (i - pmb->cis)*2 + pmb->is;
       Real gxm = (coarse(0,0,i) - coarse(0,0,i-1))
@@ -951,6 +957,7 @@ void MeshRefinement::ProlongateSharedFieldX3(
         Real dx2p = x2p - x2c;
         const Real& fx2m = pco->x2s3(fj);
         const Real& fx2p = pco->x2s3(fj+1);
+#pragma omp simd
         for (int i=si; i<=ei; i++) {
           int fi = (i - pmb->cis)*2 + pmb->is;
           const Real& x1m = pcoarsec->x1s3(i-1);
@@ -991,6 +998,7 @@ void MeshRefinement::ProlongateSharedFieldX3(
       const Real& fx2p = pco->x2s3(fj+1);
       Real dx2fm = x2c - fx2m;
       Real dx2fp = fx2p - x2c;
+#pragma omp simd
       for (int i=si; i<=ei; i++) {
         int fi = (i - pmb->cis)*2 + pmb->is;
         const Real& x1m = pcoarsec->x1s3(i-1);
@@ -1022,6 +1030,7 @@ void MeshRefinement::ProlongateSharedFieldX3(
       }
     }
   } else {
+#pragma omp simd
     for (int i=si; i<=ei; i++) {
       int fi = (i - pmb->cis)*2 + pmb->is;
       Real gxm = (coarse(0,0,i)   - coarse(0,0,i-1))
@@ -1216,14 +1225,22 @@ void MeshRefinement::ProlongateInternalField(
 
 void MeshRefinement::CheckRefinementCondition() {
   MeshBlock *pmb = pmy_block_;
-  int ret = 0, aret = -1;
+  int aret = -1;
   refine_flag_ = 0;
 
-  //! \todo **should be implemented later:**
-  //! loop-over refinement criteria
+  // the criteria are only evaluated every check_interval_ cycles
+  if (check_interval_ > 1 && pmb->pmy_mesh->ncycle % check_interval_ != 0)
+    return;
+
+  // refine if any criterion asks for it, derefine only if all of them allow it
   if (AMRFlag_ != nullptr)
-    ret = AMRFlag_(pmb);
-  aret = std::max(aret,ret);
+    aret = std::max(aret, AMRFlag_(pmb));
+  else if (criteria_.empty())
+    aret = 0;
+  for (const RefinementCriterion &crit : criteria_) {
+    if (aret > 0) break;
+    aret = std::max(aret, CheckCriterion(crit));
+  }
 
   if (aret >= 0)
     deref_count_ = 0;
@@ -32,6 +32,18 @@ class FaceCenteredBoundaryVariable;
 class HydroBoundaryVariable;
 class OrbitalAdvection;
 
+//----------------------------------------------------------------------------------------
+//! \struct RefinementCriterion
+//! \brief built-in refinement criterion read from an <amr_criterionN> input block
+
+struct RefinementCriterion {
+  enum class Method {density, gradient, loehner, jeans, vorticity};
+  Method method;
+  int ivar;                      // primitive variable for density, gradient, loehner
+  Real refine_tol, derefine_tol; // refine above refine_tol, derefine below derefine_tol
+  Real filter;                   // noise filter of the Loehner estimator
+};
+
 //----------------------------------------------------------------------------------------
 //! \class MeshRefinement
 //! \brief
@@ -97,10 +109,18 @@ class MeshRefinement {
   Coordinates *pcoarsec;
 
   AthenaArray<Real> fvol_[2][2], sarea_x1_[2][2], sarea_x2_[2][3], sarea_x3_[3][2];
+  // x1-spacings of the cell-centered prolongation stencil, per coarse cell: to the
+  // neighboring coarse centers (m, p) and to the two fine centers inside (fm, fp)
+  AthenaArray<Real> dx1m_, dx1p_, dx1fm_, dx1fp_;
   int refine_flag_, neighbor_rflag_, deref_count_, deref_threshold_;
+  // built-in criteria, cycles between evaluations and cells checked outside the block,
+  // parsed once by Mesh::ReadRefinementCriteria()
+  const std::vector<RefinementCriterion> &criteria_;
+  const int check_interval_, check_buffer_;
 
   // functions
   AMRFlagFunc AMRFlag_; // duplicate of Mesh class member
+  int CheckCriterion(const RefinementCriterion &crit);
 
   // tuples of references to AMR-enrolled arrays (quantity, coarse_quantity)
   std::vector<std::tuple<AthenaArray<Real> *, AthenaArray<Real> *>> pvars_cc_;
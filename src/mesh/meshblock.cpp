@@ -45,6 +45,7 @@
 #include "mesh.hpp"
 #include "mesh_refinement.hpp"
 #include "meshblock_tree.hpp"
+#include "polar_coarsening.hpp"
 
 //----------------------------------------------------------------------------------------
 //! MeshBlock constructor: constructs coordinate, boundary condition, hydro, field
@@ -260,6 +261,8 @@ MeshBlock::MeshBlock(int igid, int ilid, LogicalLocation iloc, RegionSize input_
   // OrbitalAdvection: constructor depends on Coordinates, Hydro, Field, PassiveScalars.
   porb = new OrbitalAdvection(this, pin);
 
+  ppolar = new PolarCoarsening(this, pin);
+
   // Create user mesh data
   InitUserMeshBlockData(pin);
 
@@ -455,6 +458,8 @@ MeshBlock::MeshBlock(int igid, int ilid, Mesh *pm, ParameterInput *pin,
   // OrbitalAdvection: constructor depends on Coordinates, Hydro, Field, PassiveScalars.
   porb = new OrbitalAdvection(this, pin);
 
+  ppolar = new PolarCoarsening(this, pin);
+
   InitUserMeshBlockData(pin);
 
   std::size_t os = 0;
@@ -514,8 +519,7 @@ MeshBlock::MeshBlock(int igid, int ilid, Mesh *pm, ParameterInput *pin,
       fre_ratio.DeleteAthenaArray();
       os += pnrrad->ir_gray.GetSizeInBytes();
     } else {
-      std::memcpy(pnrrad->ir.data(), &(mbdata[os]), pnrrad->ir.GetSizeInBytes());
-      os += pnrrad->ir.GetSizeInBytes();
+      os += pnrrad->LoadRestartData(&(mbdata[os]));
     }
     //    std::memcpy(prad->ir1.data(), &(mbdata[os]), prad->ir1.GetSizeInBytes());
     // copy the data
@@ -567,6 +571,7 @@ MeshBlock::~MeshBlock() {
   if (MAGNETIC_FIELDS_ENABLED) delete pfield;
   delete peos;
   delete porb;
+  delete ppolar;
   if (SELF_GRAVITY_ENABLED) delete pgrav;
   if (NSCALARS > 0) delete pscalars;
   if (CHEMRADIATION_ENABLED) {
@@ -682,7 +687,7 @@ std::size_t MeshBlock::GetBlockSizeInBytes() {
   }
 
   if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED)
-    size += pnrrad->ir.GetSizeInBytes();
+    size += pnrrad->GetRestartSizeInBytes();
   if (CR_ENABLED)
     size += pcr->u_cr.GetSizeInBytes();
 
@@ -715,7 +720,7 @@ std::size_t MeshBlock::GetBlockSizeInBytesGray() {
     if (pnrrad->restart_from_gray > 0)
       size += pnrrad->ir_gray.GetSizeInBytes();
     else
-      size += pnrrad->ir.GetSizeInBytes();
+      size += pnrrad->GetRestartSizeInBytes();
   }
   if (CR_ENABLED)
     size += pcr->u_cr.GetSizeInBytes();
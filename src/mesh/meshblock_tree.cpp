@@ -11,6 +11,10 @@
 //! logical root (single block) level is 0.  Note the logical level of the physical root
 //! grid (user-specified root grid) will be greater than zero if it contains more than
 //! one MeshBlock
+//!
+//! In addition to the pointer tree, every node is registered in a hash map keyed by
+//! the Morton (Z-order) key of its LogicalLocation, so that FindMeshBlock() and
+//! FindNeighbor() are O(1) lookups instead of walks from the root.
 
 // C headers
 
@@ -26,11 +30,6 @@
 #include "../mesh/mesh.hpp"
 #include "meshblock_tree.hpp"
 
-// Define static member variables
-Mesh* MeshBlockTree::pmesh_;
-MeshBlockTree* MeshBlockTree::proot_;
-int MeshBlockTree::nleaf_;
-
 
 //----------------------------------------------------------------------------------------
 //! \fn bool operator==(const LogicalLocation &l1, const LogicalLocation &l2)
@@ -45,13 +44,14 @@ bool operator==(const LogicalLocation &l1, const LogicalLocation &l2) {
 //! \fn MeshBlockTree::MeshBlockTree(Mesh* pmesh)
 //! \brief constructor for the logical root
 
-MeshBlockTree::MeshBlockTree(Mesh* pmesh) : pleaf_(nullptr), gid_(-1) {
-  pmesh_ = pmesh;
-  proot_ = this;
+MeshBlockTree::MeshBlockTree(Mesh* pmesh) : pleaf_(nullptr), gid_(-1), proot_(this),
+    pnodes_(new std::unordered_map<LogicalLocation, MeshBlockTree*, MortonKeyHash>),
+    pmesh_(pmesh), nleaf_(0) {
   loc_.lx1 = 0;
   loc_.lx2 = 0;
   loc_.lx3 = 0;
   loc_.level = 0;
+  (*pnodes_)[loc_] = this;
 }
 
 //----------------------------------------------------------------------------------------
@@ -59,11 +59,13 @@ MeshBlockTree::MeshBlockTree(Mesh* pmesh) : pleaf_(nullptr), gid_(-1) {
 //! \brief constructor for a leaf
 
 MeshBlockTree::MeshBlockTree(MeshBlockTree *parent, int ox1, int ox2, int ox3)
-                           : pleaf_(nullptr), gid_(parent->gid_) {
+    : pleaf_(nullptr), gid_(parent->gid_), proot_(parent->proot_), pnodes_(nullptr),
+      pmesh_(nullptr), nleaf_(0) {
   loc_.lx1 = (parent->loc_.lx1<<1)+ox1;
   loc_.lx2 = (parent->loc_.lx2<<1)+ox2;
   loc_.lx3 = (parent->loc_.lx3<<1)+ox3;
   loc_.level = parent->loc_.level+1;
+  (*proot_->pnodes_)[loc_] = this;
 }
 
 
@@ -72,11 +74,19 @@ MeshBlockTree::MeshBlockTree(MeshBlockTree *parent, int ox1, int ox2, int ox3)
 //! \brief destructor (for both root and leaves)
 
 MeshBlockTree::~MeshBlockTree() {
+  const int nleaf = proot_->nleaf_;
   if (pleaf_ != nullptr) {
-    for (int i=0; i<nleaf_; i++)
+    for (int i=0; i<nleaf; i++)
       delete pleaf_[i];
     delete [] pleaf_;
   }
+  if (this == proot_) {
+    delete pnodes_;
+  } else {
+    auto it = proot_->pnodes_->find(loc_);
+    if (it != proot_->pnodes_->end() && it->second == this)
+      proot_->pnodes_->erase(it);
+  }
 }
 
 
@@ -85,23 +95,25 @@ MeshBlockTree::~MeshBlockTree() {
 //! \brief create the root grid; the root grid can be incomplete (less than 8 leaves)
 
 void MeshBlockTree::CreateRootGrid() {
+  Mesh *pmesh = proot_->pmesh_;
   if (loc_.level == 0) {
     nleaf_ = 2;
-    if (pmesh_->f2) nleaf_ = 4;
-    if (pmesh_->f3) nleaf_ = 8;
+    if (pmesh->f2) nleaf_ = 4;
+    if (pmesh->f3) nleaf_ = 8;
   }
-  if (loc_.level == pmesh_->root_level) return;
+  if (loc_.level == pmesh->root_level) return;
+  const int nleaf = proot_->nleaf_;
 
-  pleaf_ = new MeshBlockTree*[nleaf_];
-  for (int n=0; n<nleaf_; n++)
+  pleaf_ = new MeshBlockTree*[nleaf];
+  for (int n=0; n<nleaf; n++)
     pleaf_[n] = nullptr;
 
-  std::int64_t levfac = 1LL<<(pmesh_->root_level - loc_.level-1);
-  for (int n=0; n<nleaf_; n++) {
+  std::int64_t levfac = 1LL<<(pmesh->root_level - loc_.level-1);
+  for (int n=0; n<nleaf; n++) {
     int i = n&1, j = (n>>1)&1, k = (n>>2)&1;
-    if ((loc_.lx3*2 + k)*levfac < pmesh_->nrbx3
-     && (loc_.lx2*2 + j)*levfac < pmesh_->nrbx2
-     && (loc_.lx1*2 + i)*levfac < pmesh_->nrbx1) {
+    if ((loc_.lx3*2 + k)*levfac < pmesh->nrbx3
+     && (loc_.lx2*2 + j)*levfac < pmesh->nrbx2
+     && (loc_.lx1*2 + i)*levfac < pmesh->nrbx1) {
       pleaf_[n] = new MeshBlockTree(this, i, j, k);
       pleaf_[n]->CreateRootGrid();
     }
@@ -136,12 +148,13 @@ void MeshBlockTree::AddMeshBlock(LogicalLocation rloc, int &nnew) {
 //! \brief add a MeshBlock to the tree without refinement, used in restarting.
 //!        MeshBlockTree::CreateRootGrid must be called before this method
 void MeshBlockTree::AddMeshBlockWithoutRefine(LogicalLocation rloc) {
+  const int nleaf = proot_->nleaf_;
   if (loc_.level == rloc.level) // done
     return;
 
   if (pleaf_ == nullptr) {
-    pleaf_ = new MeshBlockTree*[nleaf_];
-    for (int n=0; n<nleaf_; n++)
+    pleaf_ = new MeshBlockTree*[nleaf];
+    for (int n=0; n<nleaf; n++)
       pleaf_[n] = nullptr;
   }
 
@@ -164,13 +177,15 @@ void MeshBlockTree::AddMeshBlockWithoutRefine(LogicalLocation rloc) {
 //! \brief make finer leaves
 
 void MeshBlockTree::Refine(int &nnew) {
+  Mesh *pmesh = proot_->pmesh_;
+  const int nleaf = proot_->nleaf_;
   if (pleaf_ != nullptr) return;
 
-  pleaf_ = new MeshBlockTree*[nleaf_];
-  for (int n=0; n<nleaf_; n++)
+  pleaf_ = new MeshBlockTree*[nleaf];
+  for (int n=0; n<nleaf; n++)
     pleaf_[n] = nullptr;
 
-  for (int n=0; n<nleaf_; n++) {
+  for (int n=0; n<nleaf; n++) {
     int i = n&1, j = (n>>1)&1, k = (n>>2)&1;
     pleaf_[n] = new MeshBlockTree(this, i, j, k);
   }
@@ -180,26 +195,26 @@ void MeshBlockTree::Refine(int &nnew) {
   LogicalLocation nloc;
   nloc.level=loc_.level;
 
-  oxmin=-1, oxmax=1, nxmax=(pmesh_->nrbx1<<(loc_.level-pmesh_->root_level));
-  if (pmesh_->f2)
-    oymin=-1, oymax=1, nymax=(pmesh_->nrbx2<<(loc_.level-pmesh_->root_level));
+  oxmin=-1, oxmax=1, nxmax=(pmesh->nrbx1<<(loc_.level-pmesh->root_level));
+  if (pmesh->f2)
+    oymin=-1, oymax=1, nymax=(pmesh->nrbx2<<(loc_.level-pmesh->root_level));
   else
     oymin=0,  oymax=0, nymax=1;
-  if (pmesh_->f3) // 3D
-    ozmin=-1, ozmax=1, nzmax=(pmesh_->nrbx3<<(loc_.level-pmesh_->root_level));
+  if (pmesh->f3) // 3D
+    ozmin=-1, ozmax=1, nzmax=(pmesh->nrbx3<<(loc_.level-pmesh->root_level));
   else
     ozmin=0,  ozmax=0, nzmax=1;
 
   for (oz=ozmin; oz<=ozmax; oz++) {
     nloc.lx3=loc_.lx3+oz;
     if (nloc.lx3<0) {
-      if (pmesh_->mesh_bcs[BoundaryFace::inner_x3]!=BoundaryFlag::periodic)
+      if (pmesh->mesh_bcs[BoundaryFace::inner_x3]!=BoundaryFlag::periodic)
         continue;
       else
         nloc.lx3=nzmax-1;
     }
     if (nloc.lx3>=nzmax) {
-      if (pmesh_->mesh_bcs[BoundaryFace::outer_x3]!=BoundaryFlag::periodic)
+      if (pmesh->mesh_bcs[BoundaryFace::outer_x3]!=BoundaryFlag::periodic)
         continue;
       else
         nloc.lx3=0;
@@ -208,9 +223,9 @@ void MeshBlockTree::Refine(int &nnew) {
       nloc.lx2=loc_.lx2+oy;
       bool polar=false;
       if (nloc.lx2<0) {
-        if (pmesh_->mesh_bcs[BoundaryFace::inner_x2]==BoundaryFlag::periodic) {
+        if (pmesh->mesh_bcs[BoundaryFace::inner_x2]==BoundaryFlag::periodic) {
           nloc.lx2=nymax-1;
-        } else if (pmesh_->mesh_bcs[BoundaryFace::inner_x2]==BoundaryFlag::polar) {
+        } else if (pmesh->mesh_bcs[BoundaryFace::inner_x2]==BoundaryFlag::polar) {
           nloc.lx2=0;
           polar=true;
         } else {
@@ -218,9 +233,9 @@ void MeshBlockTree::Refine(int &nnew) {
         }
       }
       if (nloc.lx2>=nymax) {
-        if (pmesh_->mesh_bcs[BoundaryFace::outer_x2]==BoundaryFlag::periodic) {
+        if (pmesh->mesh_bcs[BoundaryFace::outer_x2]==BoundaryFlag::periodic) {
           nloc.lx2=0;
-        } else if (pmesh_->mesh_bcs[BoundaryFace::outer_x2]==BoundaryFlag::polar) {
+        } else if (pmesh->mesh_bcs[BoundaryFace::outer_x2]==BoundaryFlag::polar) {
           nloc.lx2=nymax-1;
           polar=true;
         } else {
@@ -232,13 +247,13 @@ void MeshBlockTree::Refine(int &nnew) {
         if (ox==0 && oy==0 && oz==0) continue;
         nloc.lx1=loc_.lx1+ox;
         if (nloc.lx1<0) {
-          if (pmesh_->mesh_bcs[BoundaryFace::inner_x1]!=BoundaryFlag::periodic)
+          if (pmesh->mesh_bcs[BoundaryFace::inner_x1]!=BoundaryFlag::periodic)
             continue;
           else
             nloc.lx1=nxmax-1;
         }
         if (nloc.lx1>=nxmax) {
-          if (pmesh_->mesh_bcs[BoundaryFace::outer_x1]!=BoundaryFlag::periodic)
+          if (pmesh->mesh_bcs[BoundaryFace::outer_x1]!=BoundaryFlag::periodic)
             continue;
           else
             nloc.lx1=0;
@@ -250,7 +265,7 @@ void MeshBlockTree::Refine(int &nnew) {
   // this block is not a leaf anymore
   gid_=-1;
 
-  nnew+=nleaf_-1;
+  nnew+=nleaf-1;
   return;
 }
 
@@ -259,28 +274,30 @@ void MeshBlockTree::Refine(int &nnew) {
 //! \brief destroy leaves and make this block a leaf
 
 void MeshBlockTree::Derefine(int &ndel) {
+  Mesh *pmesh = proot_->pmesh_;
+  const int nleaf = proot_->nleaf_;
   int s2=0, e2=0, s3=0, e3=0;
-  if (pmesh_->f2) s2=-1, e2=1;
-  if (pmesh_->f3) s3=-1, e3=1;
+  if (pmesh->f2) s2=-1, e2=1;
+  if (pmesh->f3) s3=-1, e3=1;
   for (int ox3=s3; ox3<=e3; ox3++) {
     for (int ox2=s2; ox2<=e2; ox2++) {
       for (int ox1=-1; ox1<=1; ox1++) {
         MeshBlockTree *bt = proot_->FindNeighbor(loc_, ox1, ox2, ox3,
-                                                 pmesh_->mesh_bcs, true);
+                                                 pmesh->mesh_bcs, true);
         if (bt != nullptr) {
           if (bt->pleaf_ != nullptr) {
             int lis, lie, ljs, lje, lks, lke;
             if (ox1==-1)       lis=lie=1;
             else if (ox1==1)   lis=lie=0;
             else              lis=0, lie=1;
-            if (pmesh_->f2) {
+            if (pmesh->f2) {
               if (ox2==-1)     ljs=lje=1;
               else if (ox2==1) ljs=lje=0;
               else            ljs=0, lje=1;
             } else {
               ljs=lje=0;
             }
-            if (pmesh_->f3) {
+            if (pmesh->f3) {
               if (ox3==-1)     lks=lke=1;
               else if (ox3==1) lks=lke=0;
               else            lks=0, lke=1;
@@ -302,11 +319,11 @@ void MeshBlockTree::Derefine(int &ndel) {
   }
 
   gid_ = pleaf_[0]->gid_; // now this is a leaf; inherit the first leaf's GID
-  for (int n=0; n<nleaf_; n++)
+  for (int n=0; n<nleaf; n++)
     delete pleaf_[n];
   delete [] pleaf_;
   pleaf_ = nullptr;
-  ndel+=nleaf_-1;
+  ndel+=nleaf-1;
   return;
 }
 
@@ -315,12 +332,13 @@ void MeshBlockTree::Derefine(int &ndel) {
 //! \brief creates the Location list sorted by Z-ordering
 
 void MeshBlockTree::CountMeshBlock(int& count) {
+  const int nleaf = proot_->nleaf_;
   if (loc_.level == 0) count=0;
 
   if (pleaf_ == nullptr) {
     count++;
   } else {
-    for (int n=0; n<nleaf_; n++) {
+    for (int n=0; n<nleaf; n++) {
       if (pleaf_[n] != nullptr)
         pleaf_[n]->CountMeshBlock(count);
     }
@@ -334,6 +352,7 @@ void MeshBlockTree::CountMeshBlock(int& count) {
 //! \brief creates the Location list sorted by Z-ordering
 
 void MeshBlockTree::GetMeshBlockList(LogicalLocation *list, int *pglist, int& count) {
+  const int nleaf = proot_->nleaf_;
   if (loc_.level == 0) count=0;
 
   if (pleaf_ == nullptr) {
@@ -343,7 +362,7 @@ void MeshBlockTree::GetMeshBlockList(LogicalLocation *list, int *pglist, int& co
     gid_=count;
     count++;
   } else {
-    for (int n=0; n<nleaf_; n++) {
+    for (int n=0; n<nleaf; n++) {
       if (pleaf_[n] != nullptr)
         pleaf_[n]->GetMeshBlockList(list, pglist, count);
     }
@@ -361,6 +380,7 @@ void MeshBlockTree::GetMeshBlockList(LogicalLocation *list, int *pglist, int& co
 
 MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
                int ox1, int ox2, int ox3, BoundaryFlag *bcs, bool amrflag) {
+  Mesh *pmesh = proot_->pmesh_;
   std::stringstream msg;
   std::int64_t lx, ly, lz;
   int ll;
@@ -373,11 +393,11 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
   if (lx<0) {
     if (bcs[BoundaryFace::inner_x1] == BoundaryFlag::periodic
         || bcs[BoundaryFace::inner_x1] == BoundaryFlag::shear_periodic)
-      lx=(pmesh_->nrbx1<<(ll-pmesh_->root_level))-1;
+      lx=(pmesh->nrbx1<<(ll-pmesh->root_level))-1;
     else
       return nullptr;
   }
-  if (lx>=pmesh_->nrbx1<<(ll-pmesh_->root_level)) {
+  if (lx>=pmesh->nrbx1<<(ll-pmesh->root_level)) {
     if (bcs[BoundaryFace::outer_x1] == BoundaryFlag::periodic
         || bcs[BoundaryFace::outer_x1] == BoundaryFlag::shear_periodic)
       lx=0;
@@ -387,7 +407,7 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
   bool polar = false;
   if (ly<0) {
     if (bcs[BoundaryFace::inner_x2] == BoundaryFlag::periodic) {
-      ly=(pmesh_->nrbx2<<(ll-pmesh_->root_level))-1;
+      ly=(pmesh->nrbx2<<(ll-pmesh->root_level))-1;
     } else if (bcs[BoundaryFace::inner_x2] == BoundaryFlag::polar) {
       ly=0;
       polar=true;
@@ -395,17 +415,17 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
       return nullptr;
     }
   }
-  if (ly>=pmesh_->nrbx2<<(ll-pmesh_->root_level)) {
+  if (ly>=pmesh->nrbx2<<(ll-pmesh->root_level)) {
     if (bcs[BoundaryFace::outer_x2] == BoundaryFlag::periodic) {
       ly=0;
     } else if (bcs[BoundaryFace::outer_x2] == BoundaryFlag::polar) {
-      ly=(pmesh_->nrbx2<<(ll-pmesh_->root_level))-1;
+      ly=(pmesh->nrbx2<<(ll-pmesh->root_level))-1;
       polar=true;
     } else {
       return nullptr;
     }
   }
-  std::int64_t num_x3 = pmesh_->nrbx3<<(ll-pmesh_->root_level);
+  std::int64_t num_x3 = pmesh->nrbx3<<(ll-pmesh->root_level);
   if (lz<0) {
     if (bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic)
       lz=num_x3-1;
@@ -421,30 +441,23 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
   if (ll<1) return proot_; // single grid; return root
   if (polar) lz=(lz+num_x3/2)%num_x3;
 
-  for (int level=0; level<ll; level++) {
-    if (bt->pleaf_ == nullptr) { // leaf
-      if (level == ll-1) {
-        return bt;
-      } else {
-        msg << "### FATAL ERROR in FindNeighbor" << std::endl
-            << "Neighbor search failed. The Block Tree is broken." << std::endl;
-        ATHENA_ERROR(msg);
-        return nullptr;
-      }
-    }
-    // find a leaf in the next level
-    int sh=ll-level-1;
-    ox = ((lx>>sh) & 1LL) == 1LL;
-    oy = ((ly>>sh) & 1LL) == 1LL;
-    oz = ((lz>>sh) & 1LL) == 1LL;
-    bt=bt->GetLeaf(ox, oy, oz);
-    if (bt == nullptr) {
+  // look up the block on the same level, or its parent if the neighbor is coarser
+  LogicalLocation nloc;
+  nloc.lx1 = lx, nloc.lx2 = ly, nloc.lx3 = lz, nloc.level = ll;
+  const auto &nodes = *proot_->pnodes_;
+  auto it = nodes.find(nloc);
+  if (it == nodes.end()) {
+    nloc.lx1 = lx>>1, nloc.lx2 = ly>>1, nloc.lx3 = lz>>1, nloc.level = ll-1;
+    it = nodes.find(nloc);
+    if (it == nodes.end() || it->second->pleaf_ != nullptr) {
       msg << "### FATAL ERROR in FindNeighbor" << std::endl
           << "Neighbor search failed. The Block Tree is broken." << std::endl;
       ATHENA_ERROR(msg);
       return nullptr;
     }
+    return it->second;
   }
+  bt = it->second;
   if (bt->pleaf_ == nullptr) // leaf on the same level
     return bt;
   // one level finer: check if it is a leaf
@@ -468,6 +481,10 @@ MeshBlockTree* MeshBlockTree::FindNeighbor(LogicalLocation myloc,
 //! \brief find MeshBlock with LogicalLocation tloc and return a pointer
 
 MeshBlockTree* MeshBlockTree::FindMeshBlock(LogicalLocation tloc) {
+  if (this == proot_) {
+    auto it = pnodes_->find(tloc);
+    return (it == pnodes_->end()) ? nullptr : it->second;
+  }
   if (tloc.level == loc_.level) return this;
   if (pleaf_ == nullptr) return nullptr;
   // get leaf index
@@ -487,12 +504,14 @@ MeshBlockTree* MeshBlockTree::FindMeshBlock(LogicalLocation tloc) {
 //! \brief count the number of octets for Multigrid with mesh refinement
 
 void MeshBlockTree::CountMGOctets(int *noct) {
+  Mesh *pmesh = proot_->pmesh_;
+  const int nleaf = proot_->nleaf_;
   if (pleaf_ == nullptr) return;
 
-  int lev = loc_.level - pmesh_->root_level;
+  int lev = loc_.level - pmesh->root_level;
   if (lev >= 0)
     noct[lev]++;
-  for (int n=0; n<nleaf_; n++) {
+  for (int n=0; n<nleaf; n++) {
     if (pleaf_[n] != nullptr)
       pleaf_[n]->CountMGOctets(noct);
   }
@@ -507,9 +526,11 @@ void MeshBlockTree::CountMGOctets(int *noct) {
 
 void MeshBlockTree::GetMGOctetList(std::vector<MGOctet> *oct,
      std::unordered_map<LogicalLocation, int, LogicalLocationHash> *octmap, int *noct) {
+  Mesh *pmesh = proot_->pmesh_;
+  const int nleaf = proot_->nleaf_;
   if (pleaf_ == nullptr) return;
 
-  int lev = loc_.level - pmesh_->root_level;
+  int lev = loc_.level - pmesh->root_level;
   int oid = 0;
   if (lev >= 0) {
     oid = noct[lev];
@@ -518,7 +539,7 @@ void MeshBlockTree::GetMGOctetList(std::vector<MGOctet> *oct,
     oct[lev][oid].fleaf = true;
     noct[lev]++;
   }
-  for (int n=0; n<nleaf_; n++) {
+  for (int n=0; n<nleaf; n++) {
     if (pleaf_[n] != nullptr) {
       if (pleaf_[n]->pleaf_ != nullptr) {
         if (lev >= 0) oct[lev][oid].fleaf = false;
@@ -12,6 +12,7 @@
 // C headers
 
 // C++ headers
+#include <cstdint>    // uint64_t
 #include <unordered_map>
 #include <vector>
 
@@ -26,6 +27,30 @@ class Mesh;
 struct MGOctet;
 struct LogicalLocationHash;
 
+//----------------------------------------------------------------------------------------
+//! \fn inline std::uint64_t MortonKey(const LogicalLocation &loc)
+//! \brief interleaves the lowest 21 bits of the logical coordinates (Z-order) and
+//!        appends the level; unique for up to 2^21 MeshBlocks per direction and level
+
+inline std::uint64_t MortonKey(const LogicalLocation &loc) {
+  std::uint64_t key = 0;
+  for (int b=0; b<21; b++) {
+    key |= ((static_cast<std::uint64_t>(loc.lx1)>>b) & 1ULL)<<(3*b);
+    key |= ((static_cast<std::uint64_t>(loc.lx2)>>b) & 1ULL)<<(3*b+1);
+    key |= ((static_cast<std::uint64_t>(loc.lx3)>>b) & 1ULL)<<(3*b+2);
+  }
+  return key ^ (static_cast<std::uint64_t>(loc.level)<<58);
+}
+
+//! \struct MortonKeyHash
+//! \brief Hash function object for LogicalLocation on all levels
+
+struct MortonKeyHash {
+  std::size_t operator()(const LogicalLocation &l) const {
+    return static_cast<std::size_t>(MortonKey(l));
+  }
+};
+
 //--------------------------------------------------------------------------------------
 //! \class MeshBlockTree
 //! \brief Objects are nodes in an AMR MeshBlock tree structure
@@ -65,9 +90,14 @@ class MeshBlockTree {
   int gid_;
   LogicalLocation loc_;
 
-  static Mesh* pmesh_;
-  static MeshBlockTree* proot_;
-  static int nleaf_;
+  // the root of the tree of this node, so that the trees of several Meshes can coexist
+  MeshBlockTree* proot_;
+  // per-tree state, only set in the root and reached through proot_ from the other
+  // nodes: all nodes (leaves and internal) indexed by their location, the Mesh, and
+  // the number of leaves of a refined node
+  std::unordered_map<LogicalLocation, MeshBlockTree*, MortonKeyHash> *pnodes_;
+  Mesh* pmesh_;
+  int nleaf_;
 };
 
 #endif // MESH_MESHBLOCK_TREE_HPP_
@@ -0,0 +1,154 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file polar_coarsening.cpp
+//! \brief implementation of the azimuthal coarsening near the poles
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max(), min()
+#include <cmath>      // abs(), sin()
+#include <cstring>    // strcmp()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../parameter_input.hpp"
+#include "mesh.hpp"
+#include "polar_coarsening.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn PolarCoarsening::PolarCoarsening(MeshBlock *pmb, ParameterInput *pin)
+//! \brief reads <polar_coarsening> and sets the number of merged cells of each ring
+
+PolarCoarsening::PolarCoarsening(MeshBlock *pmb, ParameterInput *pin) : pmb_(pmb) {
+  polar_coarsening_defined = pin->GetOrAddBoolean("polar_coarsening", "enable", false);
+  nfac_.NewAthenaArray(pmb->ncells2);
+  for (int j=0; j<pmb->ncells2; ++j)
+    nfac_(j) = 1;
+  if (!polar_coarsening_defined) return;
+
+  std::stringstream msg;
+  Mesh *pm = pmb->pmy_mesh;
+  if (std::strcmp(COORDINATE_SYSTEM, "spherical_polar") != 0 || !pm->f3) {
+    msg << "### FATAL ERROR in PolarCoarsening constructor" << std::endl
+        << "Polar coarsening requires 3D spherical_polar coordinates." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (MAGNETIC_FIELDS_ENABLED && pm->multilevel) {
+    msg << "### FATAL ERROR in PolarCoarsening constructor" << std::endl
+        << "Polar coarsening with magnetic fields is not supported with SMR/AMR."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (pm->orbital_advection != 0) {
+    msg << "### FATAL ERROR in PolarCoarsening constructor" << std::endl
+        << "Polar coarsening cannot be combined with orbital advection." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  // the chunks must tile the MeshBlock: limit nfac to a power of two dividing nx3
+  int nx3 = pmb->block_size.nx3;
+  int limit = 1;
+  while (nx3 % (2*limit) == 0) limit *= 2;
+  limit = std::min(limit, pin->GetOrAddInteger("polar_coarsening", "max_factor", nx3));
+  Real width_ratio = pin->GetOrAddReal("polar_coarsening", "width_ratio", 1.0);
+
+  Coordinates *pco = pmb->pcoord;
+  Real dphi = (pco->x3f(pmb->ke+1) - pco->x3f(pmb->ks))/nx3;
+  for (int j=pmb->js-1; j<=pmb->je+1; ++j) {
+    Real width = std::abs(std::sin(pco->x2v(j)))*dphi;
+    int m = 1;
+    while (2*m <= limit && 2*m*width <= width_ratio*pco->dx2f(j)) m *= 2;
+    nfac_(j) = m;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PolarCoarsening::AverageCellCentered(AthenaArray<Real> &u, int nvar)
+//! \brief replaces the nvar cell-centered variables u in the active cells of each chunk
+//!        by their volume-weighted average
+
+void PolarCoarsening::AverageCellCentered(AthenaArray<Real> &u, int nvar) {
+  MeshBlock *pmb = pmb_;
+  Coordinates *pco = pmb->pcoord;
+  for (int j=pmb->js; j<=pmb->je; ++j) {
+    int m = nfac_(j);
+    if (m == 1) continue;
+    for (int k0=pmb->ks; k0<=pmb->ke; k0+=m) {
+      // at fixed (i,j) the cell volume is proportional to dx3f
+      Real vol = 0.0;
+      for (int k=k0; k<k0+m; ++k)
+        vol += pco->dx3f(k);
+      for (int n=0; n<nvar; ++n) {
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real sum = 0.0;
+          for (int k=k0; k<k0+m; ++k)
+            sum += u(n,k,j,i)*pco->dx3f(k);
+          Real ave = sum/vol;
+          for (int k=k0; k<k0+m; ++k)
+            u(n,k,j,i) = ave;
+        }
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PolarCoarsening::CoarsenEMF(EdgeField &e)
+//! \brief makes the EMFs uniform (E3 on x2-faces) or linear (E1, E2 on x3-faces) within
+//!        the chunks; an x2-face uses the chunks of the coarser of its two rings
+
+void PolarCoarsening::CoarsenEMF(EdgeField &e) {
+  MeshBlock *pmb = pmb_;
+  Coordinates *pco = pmb->pcoord;
+  AthenaArray<Real> &e1 = e.x1e, &e2 = e.x2e, &e3 = e.x3e;
+
+  for (int j=pmb->js; j<=pmb->je+1; ++j) {
+    int m = std::max(nfac_(j-1), nfac_(j));
+    // the EMFs on the polar axis are set by the polar boundary
+    if (m == 1 || pco->IsPole(j)) continue;
+    for (int k0=pmb->ks; k0<=pmb->ke; k0+=m) {
+      // E3 along the x2-face, edge lengths proportional to dx3f
+      Real len = 0.0;
+      for (int k=k0; k<k0+m; ++k)
+        len += pco->dx3f(k);
+      for (int i=pmb->is; i<=pmb->ie+1; ++i) {
+        Real sum = 0.0;
+        for (int k=k0; k<k0+m; ++k)
+          sum += e3(k,j,i)*pco->dx3f(k);
+        Real ave = sum/len;
+        for (int k=k0; k<k0+m; ++k)
+          e3(k,j,i) = ave;
+      }
+      // E1 on the interior x3-faces of the chunk
+      for (int k=k0+1; k<k0+m; ++k) {
+        Real frac = (pco->x3f(k) - pco->x3f(k0))/len;
+        for (int i=pmb->is; i<=pmb->ie; ++i)
+          e1(k,j,i) = (1.0 - frac)*e1(k0,j,i) + frac*e1(k0+m,j,i);
+      }
+    }
+  }
+
+  // E2 on the interior x3-faces of the chunks of each ring
+  for (int j=pmb->js; j<=pmb->je; ++j) {
+    int m = nfac_(j);
+    if (m == 1) continue;
+    for (int k0=pmb->ks; k0<=pmb->ke; k0+=m) {
+      Real len = pco->x3f(k0+m) - pco->x3f(k0);
+      for (int k=k0+1; k<k0+m; ++k) {
+        Real frac = (pco->x3f(k) - pco->x3f(k0))/len;
+        for (int i=pmb->is; i<=pmb->ie+1; ++i)
+          e2(k,j,i) = (1.0 - frac)*e2(k0,j,i) + frac*e2(k0+m,j,i);
+      }
+    }
+  }
+  return;
+}
@@ -0,0 +1,55 @@
+#ifndef MESH_POLAR_COARSENING_HPP_
+#define MESH_POLAR_COARSENING_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file polar_coarsening.hpp
+//! \brief defines PolarCoarsening class, which merges cells in x3 (azimuth) near the
+//!        poles of spherical_polar grids for the hydro/MHD update
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../athena.hpp"         // Real
+#include "../athena_arrays.hpp"  // AthenaArray
+
+class MeshBlock;
+class ParameterInput;
+struct EdgeField;
+
+//----------------------------------------------------------------------------------------
+//! \class PolarCoarsening
+//! \brief azimuthal coarsening of the rings of cells close to the poles
+//!
+//! The cells of ring j are grouped in chunks of nfac(j) cells in x3, where nfac(j) is
+//! the largest power of two for which the merged azimuthal width does not exceed
+//! width_ratio times the polar width of the cell. After every stage the conserved
+//! variables are replaced by their chunk averages (a restriction in x3 followed by a
+//! piecewise-constant prolongation), so that only the fluxes through the chunk faces
+//! change them and the CFL condition in x3 uses the merged width. The same fine fluxes
+//! enter both sides of a face between rings of different nfac, which keeps the update
+//! conservative. For MHD, the EMFs are made consistent with the chunks before CT: E3
+//! on x2-faces is averaged and E1 and E2 on interior x3-faces are interpolated linearly,
+//! so that the face fields in each chunk change uniformly while CT keeps div(B) = 0.
+
+class PolarCoarsening {
+ public:
+  PolarCoarsening(MeshBlock *pmb, ParameterInput *pin);
+
+  // data
+  bool polar_coarsening_defined;  //!> flag for the azimuthal coarsening near the poles
+
+  // functions
+  int Factor(int j) const { return nfac_(j); }
+  void AverageCellCentered(AthenaArray<Real> &u, int nvar);
+  void CoarsenEMF(EdgeField &e);
+
+ private:
+  MeshBlock *pmb_;
+  AthenaArray<int> nfac_;  // number of merged cells in each ring js-1:je+1
+};
+#endif // MESH_POLAR_COARSENING_HPP_
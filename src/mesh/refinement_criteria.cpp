@@ -0,0 +1,245 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file refinement_criteria.cpp
+//! \brief built-in adaptive mesh refinement criteria selected in the input file
+//!
+//! Every <amr_criterionN> block adds one criterion, evaluated in addition to the user
+//! function enrolled with EnrollUserRefinementCondition(). A MeshBlock is refined if
+//! any criterion asks for it and derefined only if all of them allow it.
+//!   method = density   : refine if max(q) > refine_tol, derefine if below derefine_tol
+//!   method = gradient  : relative gradient |dq|/q, with centered differences
+//!   method = loehner   : Loehner (1987) normalized second derivative estimator
+//!   method = jeans     : number of cells per Jeans length; refine if fewer than
+//!                        refine_tol, derefine if more than derefine_tol everywhere
+//!   method = vorticity : |curl v| dx/c_s, the velocity shear across a cell relative to
+//!                        the sound speed
+//! q is selected by variable = rho, press, vel1, vel2 or vel3. The criteria are checked
+//! on the active cells plus refine_buffer (<mesh>) ghost cells on every side, so that
+//! features are caught before they enter the block; together with refine_interval the
+//! refinement can then be checked less frequently. Indicators are compared as squares
+//! to avoid a square root per cell, and a block stops checking as soon as it is flagged.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max()
+#include <cmath>      // abs()
+#include <cstring>    // strcmp()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../eos/eos.hpp"
+#include "../hydro/hydro.hpp"
+#include "../parameter_input.hpp"
+#include "mesh.hpp"
+#include "mesh_refinement.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::ReadRefinementCriteria(ParameterInput *pin)
+//! \brief read the <amr_criterionN> blocks of the input file once per Mesh; the
+//!        MeshRefinement of every MeshBlock refers to them
+
+void Mesh::ReadRefinementCriteria(ParameterInput *pin) {
+  std::stringstream msg;
+  amr_check_interval_ = pin->GetOrAddInteger("mesh", "refine_interval", 1);
+  amr_check_buffer_ = pin->GetOrAddInteger("mesh", "refine_buffer", 1);
+  amr_criteria_.clear();
+  if (!adaptive) return;
+  if (amr_check_interval_ < 1 || amr_check_buffer_ < 0
+      || amr_check_buffer_ > NGHOST - 1) {
+    msg << "### FATAL ERROR in Mesh::ReadRefinementCriteria" << std::endl
+        << "refine_interval must be positive and refine_buffer between 0 and "
+        << NGHOST - 1 << " (NGHOST-1)" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  for (InputBlock *pib = pin->pfirst_block; pib != nullptr; pib = pib->pnext) {
+    if (pib->block_name.compare(0, 13, "amr_criterion") != 0) continue;
+    RefinementCriterion crit;
+    std::string method = pin->GetString(pib->block_name, "method");
+    if (method == "density") {
+      crit.method = RefinementCriterion::Method::density;
+    } else if (method == "gradient") {
+      crit.method = RefinementCriterion::Method::gradient;
+    } else if (method == "loehner") {
+      crit.method = RefinementCriterion::Method::loehner;
+    } else if (method == "jeans") {
+      crit.method = RefinementCriterion::Method::jeans;
+    } else if (method == "vorticity") {
+      crit.method = RefinementCriterion::Method::vorticity;
+    } else {
+      msg << "### FATAL ERROR in Mesh::ReadRefinementCriteria" << std::endl
+          << "Unknown method '" << method << "' in <" << pib->block_name << ">"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    if ((crit.method == RefinementCriterion::Method::jeans
+         || crit.method == RefinementCriterion::Method::vorticity)
+        && std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0) {
+      msg << "### FATAL ERROR in Mesh::ReadRefinementCriteria" << std::endl
+          << "The " << method << " criterion requires cartesian coordinates"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+
+    std::string var = pin->GetOrAddString(pib->block_name, "variable", "rho");
+    if (var == "rho") {
+      crit.ivar = IDN;
+    } else if (var == "press" && NON_BAROTROPIC_EOS) {
+      crit.ivar = IPR;
+    } else if (var == "vel1") {
+      crit.ivar = IVX;
+    } else if (var == "vel2") {
+      crit.ivar = IVY;
+    } else if (var == "vel3") {
+      crit.ivar = IVZ;
+    } else {
+      msg << "### FATAL ERROR in Mesh::ReadRefinementCriteria" << std::endl
+          << "Variable '" << var << "' in <" << pib->block_name << "> is not "
+          << "available; use rho, press, vel1, vel2 or vel3" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+
+    // defaults: Loehner as in FLASH, 16 cells per Jeans length as in Truelove+ (1997)
+    Real rdef = 0.5, ddef = 0.125;
+    if (crit.method == RefinementCriterion::Method::loehner) {
+      rdef = 0.8, ddef = 0.2;
+    } else if (crit.method == RefinementCriterion::Method::jeans) {
+      rdef = 16.0, ddef = 32.0;
+    }
+    crit.refine_tol = pin->GetOrAddReal(pib->block_name, "refine_tol", rdef);
+    crit.derefine_tol = pin->GetOrAddReal(pib->block_name, "derefine_tol", ddef);
+    crit.filter = pin->GetOrAddReal(pib->block_name, "filter", 0.01);
+    amr_criteria_.push_back(crit);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int MeshRefinement::CheckCriterion(const RefinementCriterion &crit)
+//! \brief evaluate one built-in criterion on this MeshBlock; returns 1 (refine),
+//!        0 (keep) or -1 (derefinement allowed)
+
+int MeshRefinement::CheckCriterion(const RefinementCriterion &crit) {
+  MeshBlock *pmb = pmy_block_;
+  Mesh *pm = pmb->pmy_mesh;
+  Coordinates *pco = pmb->pcoord;
+  const AthenaArray<Real> &w = pmb->phydro->w;
+  const int n = crit.ivar;
+  // offsets of the neighbors in x2 and x3, zero in collapsed dimensions
+  const int dj = pm->f2 ? 1 : 0, dk = pm->f3 ? 1 : 0;
+  const int il = pmb->is - check_buffer_, iu = pmb->ie + check_buffer_;
+  const int jl = pmb->js - dj*check_buffer_, ju = pmb->je + dj*check_buffer_;
+  const int kl = pmb->ks - dk*check_buffer_, ku = pmb->ke + dk*check_buffer_;
+
+  // all indicators grow with the need for refinement; the Jeans and vorticity
+  // indicators need the square of the sound speed
+  Real rtol, dtol;
+  Real gamma = 0.0, cs2 = 0.0, jfac = 0.0;
+  switch (crit.method) {
+    case RefinementCriterion::Method::density:
+      rtol = crit.refine_tol, dtol = crit.derefine_tol;
+      break;
+    case RefinementCriterion::Method::jeans:
+      if (pm->four_pi_G_ <= 0.0) {
+        std::stringstream msg;
+        msg << "### FATAL ERROR in MeshRefinement::CheckCriterion" << std::endl
+            << "The jeans criterion requires the gravitational constant set by "
+            << "SetFourPiG() or SetGravitationalConstant()" << std::endl;
+        ATHENA_ERROR(msg);
+      }
+      // (dx/lambda_J)^2 = 4 pi G rho dx^2/(4 pi^2 c_s^2)
+      jfac = pm->four_pi_G_/(4.0*SQR(PI));
+      rtol = 1.0/SQR(crit.refine_tol), dtol = 1.0/SQR(crit.derefine_tol);
+      break;
+    default:
+      rtol = SQR(crit.refine_tol), dtol = SQR(crit.derefine_tol);
+      break;
+  }
+  if (NON_BAROTROPIC_EOS)
+    gamma = pmb->peos->GetGamma();
+  else
+    cs2 = SQR(pmb->peos->GetIsoSoundSpeed());
+
+  Real maxind = 0.0;
+  for (int k=kl; k<=ku; ++k) {
+    for (int j=jl; j<=ju; ++j) {
+      switch (crit.method) {
+        case RefinementCriterion::Method::density:
+#pragma omp simd reduction(max: maxind)
+          for (int i=il; i<=iu; ++i)
+            maxind = std::max(maxind, w(n,k,j,i));
+          break;
+        case RefinementCriterion::Method::gradient:
+#pragma omp simd reduction(max: maxind)
+          for (int i=il; i<=iu; ++i) {
+            Real g2 = SQR(0.5*(w(n,k,j,i+1) - w(n,k,j,i-1)))
+                      + SQR(0.5*(w(n,k,j+dj,i) - w(n,k,j-dj,i)))
+                      + SQR(0.5*(w(n,k+dk,j,i) - w(n,k-dk,j,i)));
+            maxind = std::max(maxind, g2/SQR(w(n,k,j,i)));
+          }
+          break;
+        case RefinementCriterion::Method::loehner:
+#pragma omp simd reduction(max: maxind)
+          for (int i=il; i<=iu; ++i) {
+            const Real q = w(n,k,j,i);
+            Real num = 0.0, den = 0.0;
+            Real qm = w(n,k,j,i-1), qp = w(n,k,j,i+1);
+            num += SQR(qp - 2.0*q + qm);
+            den += SQR(std::abs(qp - q) + std::abs(q - qm)
+                       + crit.filter*(std::abs(qp) + 2.0*std::abs(q) + std::abs(qm)));
+            qm = w(n,k,j-dj,i), qp = w(n,k,j+dj,i);
+            num += SQR(qp - 2.0*q + qm);
+            den += dj*SQR(std::abs(qp - q) + std::abs(q - qm)
+                          + crit.filter*(std::abs(qp) + 2.0*std::abs(q) + std::abs(qm)));
+            qm = w(n,k-dk,j,i), qp = w(n,k+dk,j,i);
+            num += SQR(qp - 2.0*q + qm);
+            den += dk*SQR(std::abs(qp - q) + std::abs(q - qm)
+                          + crit.filter*(std::abs(qp) + 2.0*std::abs(q) + std::abs(qm)));
+            maxind = std::max(maxind, num/std::max(den, TINY_NUMBER));
+          }
+          break;
+        case RefinementCriterion::Method::jeans: {
+          const Real dxjk = std::max(dj*pco->dx2f(j), dk*pco->dx3f(k));
+#pragma omp simd reduction(max: maxind)
+          for (int i=il; i<=iu; ++i) {
+            const Real dx = std::max(pco->dx1f(i), dxjk);
+            const Real c2 = NON_BAROTROPIC_EOS ? gamma*w(IPR,k,j,i)/w(IDN,k,j,i) : cs2;
+            maxind = std::max(maxind, jfac*w(IDN,k,j,i)*SQR(dx)/c2);
+          }
+          break;
+        }
+        case RefinementCriterion::Method::vorticity: {
+          const Real dxjk = std::max(dj*pco->dx2f(j), dk*pco->dx3f(k));
+          const Real idy = dj/(pco->x2v(j+dj) - pco->x2v(j-dj) + (1 - dj));
+          const Real idz = dk/(pco->x3v(k+dk) - pco->x3v(k-dk) + (1 - dk));
+#pragma omp simd reduction(max: maxind)
+          for (int i=il; i<=iu; ++i) {
+            const Real idx = 1.0/(pco->x1v(i+1) - pco->x1v(i-1));
+            const Real wx = (w(IVZ,k,j+dj,i) - w(IVZ,k,j-dj,i))*idy
+                            - (w(IVY,k+dk,j,i) - w(IVY,k-dk,j,i))*idz;
+            const Real wy = (w(IVX,k+dk,j,i) - w(IVX,k-dk,j,i))*idz
+                            - (w(IVZ,k,j,i+1) - w(IVZ,k,j,i-1))*idx;
+            const Real wz = (w(IVY,k,j,i+1) - w(IVY,k,j,i-1))*idx
+                            - (w(IVX,k,j+dj,i) - w(IVX,k,j-dj,i))*idy;
+            const Real dx = std::max(pco->dx1f(i), dxjk);
+            const Real c2 = NON_BAROTROPIC_EOS ? gamma*w(IPR,k,j,i)/w(IDN,k,j,i) : cs2;
+            maxind = std::max(maxind, (SQR(wx) + SQR(wy) + SQR(wz))*SQR(dx)/c2);
+          }
+          break;
+        }
+      }
+      // early exit: the block is refined regardless of the remaining cells
+      if (maxind > rtol) return 1;
+    }
+  }
+  if (maxind < dtol) return -1;
+  return 0;
+}
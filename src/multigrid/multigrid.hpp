@@ -131,6 +131,8 @@ class Multigrid {
   friend class MGBoundaryValues;
   friend class MGGravityBoundaryValues;
   friend class MGGravityDriver;
+  friend class MGConductionDriver;
+  friend class MGOhmicDriver;
 
  protected:
   MultigridDriver *pmy_driver_;
@@ -164,6 +166,7 @@ class MultigridDriver {
   friend class Multigrid;
   friend class MultigridTaskList;
   friend class MGGravity;
+  friend class MGConduction;
   friend class MGBoundaryValues;
   friend class MGGravityBoundaryValues;
 
@@ -259,11 +262,14 @@ class MultigridDriver {
   AthenaArray<Real> mpo_;
   bool autompo_, nodipole_;
 
+#ifdef MPI_PARALLEL
+  MPI_Comm MPI_COMM_MULTIGRID;
+#endif
+
  private:
   Real *rootbuf_;
   int nb_rank_;
 #ifdef MPI_PARALLEL
-  MPI_Comm MPI_COMM_MULTIGRID;
   int mg_phys_id_;
 #endif
 };
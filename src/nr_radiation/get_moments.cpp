@@ -144,8 +144,6 @@ void NRRadiation::CalculateComMoment() {
   AthenaArray<Real> &cosy_cm = cosy_cm_;
   AthenaArray<Real> &cosz_cm = cosz_cm_;
 
-  AthenaArray<Real> split_ratio;
-  AthenaArray<int> map_start, map_end;
 
   // reset the moment arrays to be zero
   // There are 4 3D arrays
@@ -219,25 +217,7 @@ void NRRadiation::CalculateComMoment() {
           // shift intensity from shifted frequency bins
 
           // map frequency grid
-          for (int n=0; n<nang; ++n) {
-            for (int ifr=0; ifr<nfreq; ++ifr) {
-              pradintegrator->ir_ori_(ifr) = ir_cm(ifr*nang+n);
-            }
-            split_ratio.InitWithShallowSlice(pradintegrator->split_ratio_,
-                                                                    3,n,1);
-            map_start.InitWithShallowSlice(pradintegrator->map_bin_start_,
-                                                                    2,n,1);
-            map_end.InitWithShallowSlice(pradintegrator->map_bin_end_,
-                                                                    2,n,1);
-
-
-            pradintegrator->MapLabToCmFrequency(tran_coef(n), split_ratio,
-                      map_start, map_end,
-                      pradintegrator->ir_ori_, pradintegrator->ir_done_);
-
-            for (int ifr=0; ifr<nfreq; ++ifr)
-              ir_cm(ifr*nang+n) = pradintegrator->ir_done_(ifr);
-          }
+          pradintegrator->MapLabToCmAngles(tran_coef, ir_cm);
         }
 
         Real *cm_weight = &(wmu_cm(0));
@@ -103,8 +103,10 @@ void RadIntegrator::ComToLabMultiGroup(const Real vx, const Real vy, const Real
   Real invcrat = 1.0/pmy_rad->crat;
   int& nang=pmy_rad->nang;
   int& nfreq=pmy_rad->nfreq;
-  AthenaArray<Real> split_ratio;
+  AthenaArray<Real> split_ratio, ir_ori, ir_done;
   AthenaArray<int> map_start, map_end;
+  ir_ori.InitWithShallowSlice(ir_ori_,2,0,1);
+  ir_done.InitWithShallowSlice(ir_done_,2,0,1);
 
   // square of Lorentz factor
   Real lorz = std::sqrt(1.0/(1.0 - (vx * vx + vy * vy + vz * vz) * invcrat * invcrat));
@@ -117,16 +119,16 @@ void RadIntegrator::ComToLabMultiGroup(const Real vx, const Real vy, const Real
     Real cm_nu = vnc * lorz;
 
     for (int ifr=0; ifr<nfreq; ++ifr)
-      ir_ori_(ifr) = ir_cm(ifr*nang+n);
+      ir_ori(ifr) = ir_cm(ifr*nang+n);
 
     split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
     map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
     map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
 
-    MapCmToLabFrequency(cm_nu,split_ratio,map_start,map_end,ir_ori_,ir_done_);
+    MapCmToLabFrequency(cm_nu,split_ratio,map_start,map_end,ir_ori,ir_done,0);
 
     for (int ifr=0; ifr<nfreq; ++ifr) {
-      ir_lab[ifr*nang+n] = ir_done_(ifr)/(cm_nu*cm_nu*cm_nu*cm_nu);
+      ir_lab[ifr*nang+n] = ir_done(ifr)/(cm_nu*cm_nu*cm_nu*cm_nu);
     }
   }
   return;
@@ -20,6 +20,8 @@
 // C headers
 
 // C++ headers
+#include <algorithm>  // min, max
+#include <cmath>      // atanh, exp, log
 #include <sstream>  // msg
 #include <stdexcept>  // runtime_error
 
@@ -34,6 +36,11 @@
 // this class header
 #include "./rad_integrators.hpp"
 
+// OpenMP header
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
 
 //--------------------------------------------------------------------------------------
 //The function calculate the amount of shift for each I we need
@@ -55,17 +62,20 @@
 void RadIntegrator::MapLabToCmFrequency(Real &tran_coef,
                    AthenaArray<Real> &split_ratio,
                    AthenaArray<int> &map_start, AthenaArray<int> &map_end,
-                   AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_shift) {
+                   AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_shift, int tid) {
   int &nfreq=pmy_rad->nfreq;
+  AthenaArray<Real> delta_nu_n, ir_face;
+  delta_nu_n.InitWithShallowSlice(delta_nu_n_,2,tid,1);
+  ir_face.InitWithShallowSlice(ir_face_,2,tid,1);
 
   // prepare the frequency bin width
   for (int ifr=0; ifr<nfreq-1; ++ifr) {
-    delta_nu_n_(ifr) = pmy_rad->delta_nu(ifr) * tran_coef;
+    delta_nu_n(ifr) = pmy_rad->delta_nu(ifr) * tran_coef;
   }
 
-  GetCmMCIntensity(ir_cm, delta_nu_n_, ir_face_);
+  GetCmMCIntensity(ir_cm, delta_nu_n, ir_face);
   // calculate the shift ratio
-  ForwardSplitting(tran_coef, ir_cm, ir_face_, split_ratio, map_start, map_end);
+  ForwardSplitting(tran_coef, ir_cm, ir_face, split_ratio, map_start, map_end);
   MapIrcmFrequency(split_ratio, map_start, map_end, ir_cm,ir_shift);
   return;
 }
@@ -104,55 +114,61 @@ void RadIntegrator::ForwardSplitting(
   }
   // map intensity to the desired bin
   // This is a generic function to shift any array
+  bool tabulated = TabulatedSplitting(tran_coef, ir_face, split_ratio, map_start,
+                                      map_end);
   if (tran_coef >= 1) {
-    for (int ifr=0; ifr<nfreq-1; ++ifr) {
-      Real nu_l = nu_lab[ifr] * tran_coef;
-      Real nu_r = nu_lab[ifr+1] * tran_coef;
-      int l_bd = ifr;
-      int r_bd = ifr;
-
-      while((nu_l > nu_lab[l_bd+1]) && (l_bd < nfreq-1))   l_bd++;
-      r_bd = l_bd; // r_bd always > l_bd
-      while((nu_r > nu_lab[r_bd+1]) && (r_bd < nfreq-1))   r_bd++;
-
-      if (r_bd-l_bd+1 > nmax_map_) {
-        std::stringstream msg;
-        msg << "### FATAL ERROR in function [ForwardSplitting]"
-          << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
-          "' larger than maximum allowed " << nmax_map_;
-        ATHENA_ERROR(msg);
+    if (!tabulated) {
+      for (int ifr=0; ifr<nfreq-1; ++ifr) {
+        Real nu_l = nu_lab[ifr] * tran_coef;
+        Real nu_r = nu_lab[ifr+1] * tran_coef;
+        int l_bd = ifr;
+        int r_bd = ifr;
+
+        while((nu_l > nu_lab[l_bd+1]) && (l_bd < nfreq-1))   l_bd++;
+        r_bd = l_bd; // r_bd always > l_bd
+        while((nu_r > nu_lab[r_bd+1]) && (r_bd < nfreq-1))   r_bd++;
+
+        if (r_bd-l_bd+1 > nmax_map_) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in function [ForwardSplitting]"
+            << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
+            "' larger than maximum allowed " << nmax_map_;
+          ATHENA_ERROR(msg);
+        }
+        map_start(ifr) = l_bd;
+        map_end(ifr) = r_bd;
+        SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, ir_face(ifr),
+                                      ir_face(ifr+1), &(split_ratio(ifr,0)));
       }
-      map_start(ifr) = l_bd;
-      map_end(ifr) = r_bd;
-      SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, ir_face(ifr),
-                                    ir_face(ifr+1), &(split_ratio(ifr,0)));
     }
     // the last frequency bin
     map_start(nfreq-1) = nfreq-1;
     map_end(nfreq-1) = nfreq-1;
     split_ratio(nfreq-1,0) = 1.0;
   } else {
-    for (int ifr=0; ifr<nfreq-1; ++ifr) {
-      Real nu_l = nu_lab[ifr] * tran_coef;
-      Real nu_r = nu_lab[ifr+1] * tran_coef;
-      int l_bd = ifr;
-      int r_bd = ifr;
-
-      while((nu_r < nu_lab[r_bd]) && (r_bd > 0))   r_bd--;
-      l_bd = r_bd; // r_bd always > l_bd
-      while((nu_l < nu_lab[l_bd]) && (l_bd > 0))   l_bd--;
-
-      if (r_bd-l_bd+1 > nmax_map_) {
-        std::stringstream msg;
-        msg << "### FATAL ERROR in function [ForwardSplitting]"
-            << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
-          "' larger than maximum allowed " << nmax_map_;
-        ATHENA_ERROR(msg);
+    if (!tabulated) {
+      for (int ifr=0; ifr<nfreq-1; ++ifr) {
+        Real nu_l = nu_lab[ifr] * tran_coef;
+        Real nu_r = nu_lab[ifr+1] * tran_coef;
+        int l_bd = ifr;
+        int r_bd = ifr;
+
+        while((nu_r < nu_lab[r_bd]) && (r_bd > 0))   r_bd--;
+        l_bd = r_bd; // r_bd always > l_bd
+        while((nu_l < nu_lab[l_bd]) && (l_bd > 0))   l_bd--;
+
+        if (r_bd-l_bd+1 > nmax_map_) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in function [ForwardSplitting]"
+              << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
+            "' larger than maximum allowed " << nmax_map_;
+          ATHENA_ERROR(msg);
+        }
+        map_start(ifr) = l_bd;
+        map_end(ifr) = r_bd;
+        SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, ir_face(ifr),
+                                      ir_face(ifr+1), &(split_ratio(ifr,0)));
       }
-      map_start(ifr) = l_bd;
-      map_end(ifr) = r_bd;
-      SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, ir_face(ifr),
-                                    ir_face(ifr+1), &(split_ratio(ifr,0)));
     }
     Real nu_l = nu_lab[nfreq-1] * tran_coef;
     int r_bd = nfreq-1;
@@ -376,14 +392,16 @@ void RadIntegrator::SplitFrequencyBinLinear(
 void RadIntegrator::MapCmToLabFrequency(Real &tran_coef,
                     AthenaArray<Real> &split_ratio,
                     AthenaArray<int> &map_start, AthenaArray<int> &map_end,
-                    AthenaArray<Real> &ir_shift, AthenaArray<Real> &ir_cm) {
+                    AthenaArray<Real> &ir_shift, AthenaArray<Real> &ir_cm, int tid) {
   //Real *nu_fixed = &(pmy_rad->nu_grid(0));
   AthenaArray<Real> &delta_nu = pmy_rad->delta_nu;
+  AthenaArray<Real> ir_face;
+  ir_face.InitWithShallowSlice(ir_face_,2,tid,1);
   // now call the function to get value at frequency face
-  GetCmMCIntensity(ir_shift, delta_nu, ir_face_);
+  GetCmMCIntensity(ir_shift, delta_nu, ir_face);
 
-  BackwardSplitting(tran_coef, ir_shift, ir_face_, split_ratio,
-                                     map_start,map_end);
+  BackwardSplitting(tran_coef, ir_shift, ir_face, split_ratio,
+                                     map_start,map_end,tid);
   MapIrcmFrequency(split_ratio, map_start, map_end, ir_shift, ir_cm);
   return;
 }
@@ -397,10 +415,11 @@ void RadIntegrator::MapCmToLabFrequency(Real &tran_coef,
 void RadIntegrator::BackwardSplitting(Real &tran_coef,
                       AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_face,
                       AthenaArray<Real> &split_ratio,
-                      AthenaArray<int> &map_start,AthenaArray<int> &map_end) {
+                      AthenaArray<int> &map_start,AthenaArray<int> &map_end,
+                      int tid) {
   int &nfreq = pmy_rad->nfreq;
   Real *nu_lab = &(pmy_rad->nu_grid(0));
-  Real *nu_shift = &(nu_shift_(0));
+  Real *nu_shift = &(nu_shift_(tid,0));
   // check to make sure nfreq > 2
   if (nfreq < 2) {
     std::stringstream msg;
@@ -411,60 +430,67 @@ void RadIntegrator::BackwardSplitting(Real &tran_coef,
   }
 
   for (int ifr=0; ifr<nfreq; ++ifr)
-    nu_shift_(ifr) = nu_lab[ifr] * tran_coef;
+    nu_shift[ifr] = nu_lab[ifr] * tran_coef;
 
   // map intensity to the desired bin
   // This is a generic function to shift any array
+  // the shift of nu_f onto [Gamma nu_f] is the shift of [nu_f/Gamma] onto nu_f
+  bool tabulated = TabulatedSplitting(1.0/tran_coef, ir_face, split_ratio,
+                                      map_start, map_end);
   if (tran_coef < 1) {
-    for (int ifr=0; ifr<nfreq-1; ++ifr) {
-      Real nu_l = nu_lab[ifr];
-      Real nu_r = nu_lab[ifr+1];
-      int l_bd = ifr;
-      int r_bd = ifr;
-
-      while((nu_l > nu_shift[l_bd+1]) && (l_bd < nfreq-1))   l_bd++;
-      r_bd = l_bd; // r_bd always > l_bd
-      while((nu_r > nu_shift[r_bd+1]) && (r_bd < nfreq-1))   r_bd++;
-
-      if (r_bd-l_bd+1 > nmax_map_) {
-        std::stringstream msg;
-        msg << "### FATAL ERROR in function [ForwardSplitting]"
-          << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
-          "' larger than maximum allowed " << nmax_map_;
-        ATHENA_ERROR(msg);
+    if (!tabulated) {
+      for (int ifr=0; ifr<nfreq-1; ++ifr) {
+        Real nu_l = nu_lab[ifr];
+        Real nu_r = nu_lab[ifr+1];
+        int l_bd = ifr;
+        int r_bd = ifr;
+
+        while((nu_l > nu_shift[l_bd+1]) && (l_bd < nfreq-1))   l_bd++;
+        r_bd = l_bd; // r_bd always > l_bd
+        while((nu_r > nu_shift[r_bd+1]) && (r_bd < nfreq-1))   r_bd++;
+
+        if (r_bd-l_bd+1 > nmax_map_) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in function [ForwardSplitting]"
+            << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
+            "' larger than maximum allowed " << nmax_map_;
+          ATHENA_ERROR(msg);
+        }
+        map_start(ifr) = l_bd;
+        map_end(ifr) = r_bd;
+        SplitFrequencyBinLinear(l_bd, r_bd, nu_shift, nu_l, nu_r, ir_face(ifr),
+                                      ir_face(ifr+1), &(split_ratio(ifr,0)));
       }
-      map_start(ifr) = l_bd;
-      map_end(ifr) = r_bd;
-      SplitFrequencyBinLinear(l_bd, r_bd, nu_shift, nu_l, nu_r, ir_face(ifr),
-                                    ir_face(ifr+1), &(split_ratio(ifr,0)));
     }
     // the last frequency bin
     map_start(nfreq-1) = nfreq-1;
     map_end(nfreq-1) = nfreq-1;
     split_ratio(nfreq-1,0) = 1.0;
   } else {
-    for (int ifr=0; ifr<nfreq-1; ++ifr) {
-      Real nu_l = nu_lab[ifr];
-      Real nu_r = nu_lab[ifr+1];
-      int l_bd = ifr;
-      int r_bd = ifr;
-
-      while((nu_r < nu_shift[r_bd]) && (r_bd > 0))   r_bd--;
-      l_bd = r_bd; // r_bd always > l_bd
-      while((nu_l < nu_shift[l_bd]) && (l_bd > 0))   l_bd--;
-
-      if (r_bd-l_bd+1 > nmax_map_) {
-        std::stringstream msg;
-        msg << "### FATAL ERROR in function [ForwardSplitting]"
-            << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
-          "' larger than maximum allowed " << nmax_map_;
-        ATHENA_ERROR(msg);
+    if (!tabulated) {
+      for (int ifr=0; ifr<nfreq-1; ++ifr) {
+        Real nu_l = nu_lab[ifr];
+        Real nu_r = nu_lab[ifr+1];
+        int l_bd = ifr;
+        int r_bd = ifr;
+
+        while((nu_r < nu_shift[r_bd]) && (r_bd > 0))   r_bd--;
+        l_bd = r_bd; // r_bd always > l_bd
+        while((nu_l < nu_shift[l_bd]) && (l_bd > 0))   l_bd--;
+
+        if (r_bd-l_bd+1 > nmax_map_) {
+          std::stringstream msg;
+          msg << "### FATAL ERROR in function [ForwardSplitting]"
+              << std::endl << "Frequency shift '" << r_bd-l_bd+1 <<
+            "' larger than maximum allowed " << nmax_map_;
+          ATHENA_ERROR(msg);
+        }
+        map_start(ifr) = l_bd;
+        map_end(ifr) = r_bd;
+
+        SplitFrequencyBinLinear(l_bd, r_bd, nu_shift, nu_l, nu_r, ir_face(ifr),
+                                      ir_face(ifr+1), &(split_ratio(ifr,0)));
       }
-      map_start(ifr) = l_bd;
-      map_end(ifr) = r_bd;
-
-      SplitFrequencyBinLinear(l_bd, r_bd, nu_shift, nu_l, nu_r, ir_face(ifr),
-                                    ir_face(ifr+1), &(split_ratio(ifr,0)));
     }
 
     //-------------------------------------
@@ -504,3 +530,217 @@ void RadIntegrator::BackwardSplitting(Real &tran_coef,
   }
   return;
 }
+
+//--------------------------------------------------------------------------------------
+// Tabulated frequency shift
+// The split of the bin [Gamma nu_f, Gamma nu_f+1] onto the default frequency grid is
+// linear in the intensities at the two bin faces,
+// split_ratio(m) = (ir_l*wl(m) + ir_r*wr(m))/(ir_l + ir_r),
+// where the weights wl, wr and the range of bins only depend on Gamma = tran_coef.
+// They are calculated on nodes uniform in ln(Gamma), which cover all the angles for
+// |v| <= vmax*c as Gamma = gamma(1-v.n/c) is in [exp(-atanh(vmax)), exp(atanh(vmax))].
+// For each interval between two nodes, the table stores the union of the bin ranges
+// of the two nodes, and the weights and their differences on that range, so that the
+// weights are interpolated linearly in ln(Gamma). The last bin is not tabulated as it
+// depends on the effective blackbody spectrum.
+
+void RadIntegrator::InitDopplerTable(Real vmax) {
+  int &nfreq = pmy_rad->nfreq;
+  Real *nu_lab = &(pmy_rad->nu_grid(0));
+  int nnode = 2*doppler_table_ + 1;
+  dop_lnt_max_ = std::atanh(vmax);
+  dop_dlnt_ = dop_lnt_max_/doppler_table_;
+
+  // weights at the nodes, with the same bins as ForwardSplitting
+  AthenaArray<int> node_start, node_end;
+  AthenaArray<Real> node_wl, node_wr;
+  node_start.NewAthenaArray(nnode,nfreq);
+  node_end.NewAthenaArray(nnode,nfreq);
+  node_wl.NewAthenaArray(nnode,nfreq,nmax_map_);
+  node_wr.NewAthenaArray(nnode,nfreq,nmax_map_);
+
+  Real one = 1.0, zero = 0.0;
+  for (int k=0; k<nnode; ++k) {
+    Real tran_coef = std::exp((k - doppler_table_)*dop_dlnt_);
+    for (int ifr=0; ifr<nfreq-1; ++ifr) {
+      Real nu_l = nu_lab[ifr] * tran_coef;
+      Real nu_r = nu_lab[ifr+1] * tran_coef;
+      int l_bd = ifr;
+      int r_bd = ifr;
+      if (tran_coef >= 1) {
+        while((l_bd < nfreq-1) && (nu_l > nu_lab[l_bd+1]))   l_bd++;
+        r_bd = l_bd;
+        while((r_bd < nfreq-1) && (nu_r > nu_lab[r_bd+1]))   r_bd++;
+      } else {
+        while((nu_r < nu_lab[r_bd]) && (r_bd > 0))   r_bd--;
+        l_bd = r_bd;
+        while((nu_l < nu_lab[l_bd]) && (l_bd > 0))   l_bd--;
+      }
+      node_start(k,ifr) = l_bd;
+      node_end(k,ifr) = r_bd;
+      if (r_bd-l_bd+1 > nmax_map_) continue;
+      SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, one, zero,
+                              &(node_wl(k,ifr,0)));
+      SplitFrequencyBinLinear(l_bd, r_bd, nu_lab, nu_l, nu_r, zero, one,
+                              &(node_wr(k,ifr,0)));
+    }
+  }
+
+  // range of the intervals, those that shift too far are never used
+  dop_start_.NewAthenaArray(2*doppler_table_,nfreq);
+  dop_end_.NewAthenaArray(2*doppler_table_,nfreq);
+  dop_nw_ = 1;
+  for (int k=0; k<2*doppler_table_; ++k) {
+    for (int ifr=0; ifr<nfreq-1; ++ifr) {
+      int l_bd = std::min(node_start(k,ifr), node_start(k+1,ifr));
+      int r_bd = std::max(node_end(k,ifr), node_end(k+1,ifr));
+      if (r_bd-l_bd+1 > nmax_map_) {
+        dop_start_(k,ifr) = -1;
+      } else {
+        dop_start_(k,ifr) = l_bd;
+        dop_end_(k,ifr) = r_bd;
+        dop_nw_ = std::max(dop_nw_, r_bd-l_bd+1);
+      }
+    }
+  }
+
+  // wl, wl(k+1)-wl(k), wr, wr(k+1)-wr(k) on the range of each interval
+  dop_coef_.NewAthenaArray(2*doppler_table_,nfreq,dop_nw_,4);
+  for (int k=0; k<2*doppler_table_; ++k) {
+    for (int ifr=0; ifr<nfreq-1; ++ifr) {
+      if (dop_start_(k,ifr) < 0) continue;
+      for (int m=dop_start_(k,ifr); m<=dop_end_(k,ifr); ++m) {
+        Real wl[2] = {0.0, 0.0}, wr[2] = {0.0, 0.0};
+        for (int l=0; l<2; ++l) {
+          if ((m >= node_start(k+l,ifr)) && (m <= node_end(k+l,ifr))) {
+            wl[l] = node_wl(k+l,ifr,m-node_start(k+l,ifr));
+            wr[l] = node_wr(k+l,ifr,m-node_start(k+l,ifr));
+          }
+        }
+        Real *coef = &(dop_coef_(k,ifr,m-dop_start_(k,ifr),0));
+        coef[0] = wl[0];
+        coef[1] = wl[1] - wl[0];
+        coef[2] = wr[0];
+        coef[3] = wr[1] - wr[0];
+      }
+    }
+  }
+  return;
+}
+
+// split all but the last frequency bin with the table, same as ForwardSplitting
+// return false if tran_coef is not covered by the table, so that the caller
+// calculates the shift directly
+bool RadIntegrator::TabulatedSplitting(Real tran_coef, AthenaArray<Real> &ir_face,
+                      AthenaArray<Real> &split_ratio,
+                      AthenaArray<int> &map_start, AthenaArray<int> &map_end) {
+  if (doppler_table_ == 0) return false;
+  Real lnt = std::log(tran_coef);
+  if (std::abs(lnt) >= dop_lnt_max_) return false;
+
+  int &nfreq = pmy_rad->nfreq;
+  Real x = lnt/dop_dlnt_ + doppler_table_;
+  int k = std::min(static_cast<int>(x), 2*doppler_table_-1);
+  Real frac = x - k;
+
+  for (int ifr=0; ifr<nfreq-1; ++ifr) {
+    int l_bd = dop_start_(k,ifr);
+    if (l_bd < 0) return false;
+    int r_bd = dop_end_(k,ifr);
+    map_start(ifr) = l_bd;
+    map_end(ifr) = r_bd;
+
+    // weights of the face intensities, frequency grid only if the bin is empty
+    Real ir_sum = ir_face(ifr) + ir_face(ifr+1);
+    Real coef_l = 0.5, coef_r = 0.5;
+    if (ir_sum >= TINY_NUMBER) {
+      Real inv_sum = 1.0/ir_sum;
+      coef_l = ir_face(ifr)*inv_sum;
+      coef_r = ir_face(ifr+1)*inv_sum;
+    }
+    Real *coef = &(dop_coef_(k,ifr,0,0));
+    Real *ratio = &(split_ratio(ifr,0));
+    Real sum = 0.0;
+    for (int m=0; m<r_bd-l_bd; ++m) {
+      ratio[m] = coef_l*(coef[4*m] + frac*coef[4*m+1])
+                 + coef_r*(coef[4*m+2] + frac*coef[4*m+3]);
+      sum += ratio[m];
+    }
+    // make sure the sum is always 1
+    ratio[r_bd-l_bd] = 1.0 - sum;
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------------------
+// Doppler mapping of all the angles of one cell
+// The frequency shift of each angle only depends on its own groups, so the angles are
+// split among group_threads_ threads, each using its own slice of the scratch arrays.
+// A nested team is only created if the enclosing MeshBlock loop leaves cores free.
+
+// shift ir_cm(ifr*nang+n) from the frequency grid [Gamma nu_f] of each angle onto the
+// default grid [nu_f]
+void RadIntegrator::MapLabToCmAngles(AthenaArray<Real> &tran_coef,
+                                     AthenaArray<Real> &ir_cm) {
+  int &nang = pmy_rad->nang;
+  int &nfreq = pmy_rad->nfreq;
+#pragma omp parallel for num_threads(group_threads_) if (group_threads_ > 1)
+  for (int n=0; n<nang; ++n) {
+    int tid = 0;
+#ifdef OPENMP_PARALLEL
+    tid = omp_get_thread_num();
+#endif
+    AthenaArray<Real> split_ratio, ir_ori, ir_done;
+    AthenaArray<int> map_start, map_end;
+    split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
+    map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
+    map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
+    ir_ori.InitWithShallowSlice(ir_ori_,2,tid,1);
+    ir_done.InitWithShallowSlice(ir_done_,2,tid,1);
+
+    for (int ifr=0; ifr<nfreq; ++ifr)
+      ir_ori(ifr) = ir_cm(ifr*nang+n);
+    MapLabToCmFrequency(tran_coef(n), split_ratio, map_start, map_end, ir_ori,
+                        ir_done, tid);
+    for (int ifr=0; ifr<nfreq; ++ifr)
+      ir_cm(ifr*nang+n) = ir_done(ifr);
+  }
+  return;
+}
+
+// shift ir_cm(ifr*nang+n) back from the default grid onto the grid of each angle,
+// inverting the forward map if possible and splitting the bins otherwise
+void RadIntegrator::MapCmToLabAngles(AthenaArray<Real> &tran_coef,
+                                     AthenaArray<Real> &ir_cm) {
+  int &nang = pmy_rad->nang;
+  int &nfreq = pmy_rad->nfreq;
+#pragma omp parallel for num_threads(group_threads_) if (group_threads_ > 1)
+  for (int n=0; n<nang; ++n) {
+    int tid = 0;
+#ifdef OPENMP_PARALLEL
+    tid = omp_get_thread_num();
+#endif
+    AthenaArray<Real> split_ratio, ir_ori, ir_done, map_matrix;
+    AthenaArray<int> map_start, map_end, map_count;
+    split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
+    map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
+    map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
+    ir_ori.InitWithShallowSlice(ir_ori_,2,tid,1);
+    ir_done.InitWithShallowSlice(ir_done_,2,tid,1);
+    map_matrix.InitWithShallowSlice(fre_map_matrix_,3,tid,1);
+    map_count.InitWithShallowSlice(map_count_,2,tid,1);
+
+    for (int ifr=0; ifr<nfreq; ++ifr)
+      ir_ori(ifr) = ir_cm(ifr*nang+n);
+    bool invertible = FreMapMatrix(split_ratio, tran_coef(n), map_start, map_end,
+                                   map_count, map_matrix);
+    bool success = invertible && InverseMapFrequency(tran_coef(n), map_count,
+                                                     map_matrix, ir_ori, ir_done);
+    if (!success)
+      MapCmToLabFrequency(tran_coef(n), split_ratio, map_start, map_end, ir_ori,
+                          ir_done, tid);
+    for (int ifr=0; ifr<nfreq; ++ifr)
+      ir_cm(ifr*nang+n) = ir_done(ifr);
+  }
+  return;
+}
@@ -72,6 +72,18 @@ RadIntegrator::RadIntegrator(NRRadiation *prad, ParameterInput *pin) {
   flux_correct_flag_ = pin->GetOrAddInteger("radiation","CorrectFlux",0);
   imp_ang_flx_ = pin->GetOrAddInteger("radiation","implicit_ang_flux",0);
 
+  // The explicit flux divergence is done in tiles of ang_blk_ angles times a pencil of
+  // cells. The default keeps the ~8 rows of angles used per cell (fluxes on both faces
+  // in each direction, ir_in and ir_out) within half of a 32 kB L1 cache.
+  // The angular fluxes couple all the angles of a frequency group, so that the tiles
+  // then hold whole groups
+  ang_blk_ = pin->GetOrAddInteger("radiation","angle_block",0);
+  if (ang_blk_ <= 0)
+    ang_blk_ = std::max(256/SIMD_WIDTH, 1)*SIMD_WIDTH;
+  if ((prad->angle_flag == 1) && (imp_ang_flx_ == 0))
+    ang_blk_ = std::max(ang_blk_/nang, 1)*nang;
+  ang_blk_ = std::min(ang_blk_, prad->n_fre_ang);
+
   doppler_flag_ = pin->GetOrAddInteger("radiation","doppler_flag",1);
 
   // multi-group iteration
@@ -82,6 +94,20 @@ RadIntegrator::RadIntegrator(NRRadiation *prad, ParameterInput *pin) {
   compton_error_ =   pin->GetOrAddReal("radiation","gas_error",1.e-6);
   // maximum number of bins each frequency bin will map to, default is nfreq/2
   nmax_map_ = pin->GetOrAddInteger("radiation","max_map_bin",0);
+  // number of intervals on each side of Gamma=1 of the table of frequency shifts,
+  // 0 to calculate the shifts in every cell
+  doppler_table_ = pin->GetOrAddInteger("radiation","doppler_table",0);
+  // threads sharing the angles and groups of one cell in the multi-group source terms
+  group_threads_ = pin->GetOrAddInteger("radiation","group_threads",1);
+#ifndef OPENMP_PARALLEL
+  group_threads_ = 1;
+#endif
+  if (group_threads_ < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in RadIntegrator constructor" << std::endl
+        << "group_threads=" << group_threads_ << " must be at least 1" << std::endl;
+    ATHENA_ERROR(msg);
+  }
 
   int ncells1 = pmb->ncells1, ncells2 = pmb->ncells2,
       ncells3 = pmb->ncells3;
@@ -202,15 +228,26 @@ RadIntegrator::RadIntegrator(NRRadiation *prad, ParameterInput *pin) {
     if (nmax_map_ == 0)  nmax_map_ = nfreq/2+1;
     split_ratio_.NewAthenaArray(nang,nfreq,nmax_map_);
     // this needs to be done for each angle, all frequency groups
-    fre_map_matrix_.NewAthenaArray(nfreq,nmax_map_);
-    delta_nu_n_.NewAthenaArray(nfreq);
+    fre_map_matrix_.NewAthenaArray(group_threads_,nfreq,nmax_map_);
+    delta_nu_n_.NewAthenaArray(group_threads_,nfreq);
     map_bin_start_.NewAthenaArray(nang,nfreq);
     map_bin_end_.NewAthenaArray(nang,nfreq);
-    map_count_.NewAthenaArray(nfreq);
-    nu_shift_.NewAthenaArray(nfreq);
-    ir_face_.NewAthenaArray(nfreq);
-    ir_ori_.NewAthenaArray(nfreq);
-    ir_done_.NewAthenaArray(nfreq);
+    map_count_.NewAthenaArray(group_threads_,nfreq);
+    nu_shift_.NewAthenaArray(group_threads_,nfreq);
+    ir_face_.NewAthenaArray(group_threads_,nfreq);
+    ir_ori_.NewAthenaArray(group_threads_,nfreq);
+    ir_done_.NewAthenaArray(group_threads_,nfreq);
+
+    if (doppler_table_ > 0) {
+      Real vmax = pin->GetOrAddReal("radiation","doppler_table_vmax",0.1);
+      if ((vmax <= 0.0) || (vmax >= 1.0)) {
+        std::stringstream msg;
+        msg << "### FATAL ERROR in RadIntegrator constructor" << std::endl
+            << "doppler_table_vmax=" << vmax << " must be in (0, 1)" << std::endl;
+        ATHENA_ERROR(msg);
+      }
+      InitDopplerTable(vmax);
+    }
 
     com_b_face_coef_.NewAthenaArray(nfreq);
     com_d_face_coef_.NewAthenaArray(nfreq);
@@ -520,6 +557,11 @@ RadIntegrator::~RadIntegrator() {
     nu_shift_.DeleteAthenaArray();
     ir_ori_.DeleteAthenaArray();
     ir_done_.DeleteAthenaArray();
+    if (doppler_table_ > 0) {
+      dop_start_.DeleteAthenaArray();
+      dop_end_.DeleteAthenaArray();
+      dop_coef_.DeleteAthenaArray();
+    }
 
     com_b_face_coef_.DeleteAthenaArray();
     com_d_face_coef_.DeleteAthenaArray();
@@ -773,8 +815,6 @@ void RadIntegrator::SplitVelocity(Real *vel_l, Real *vel_r, const Real advl,
 }
 
 void RadIntegrator::GetTaufactor(const Real tau, Real &factor1, int dir) {
-  std::stringstream msg;
-
   if (dir > 0) {
     if (tau_flag_ == 1) {
       Real tausq = tau * tau;
@@ -791,6 +831,7 @@ void RadIntegrator::GetTaufactor(const Real tau, Real &factor1, int dir) {
         factor1 = 1.0;
 
     } else {
+      std::stringstream msg;
       msg << "### FATAL ERROR in function [GetTaufactor]"
           << std::endl << "tau_flag_ '" << tau_flag_ << "' not allowed!";
       ATHENA_ERROR(msg);
@@ -810,6 +851,7 @@ void RadIntegrator::GetTaufactor(const Real tau, Real &factor1, int dir) {
       else
         factor1 = tausq;
     } else {
+      std::stringstream msg;
       msg << "### FATAL ERROR in function [GetTaufactor]"
           << std::endl << "tau_flag_ '" << tau_flag_ << "' not allowed!";
       ATHENA_ERROR(msg);
@@ -40,6 +40,8 @@ class RadIntegrator {
                                  AthenaArray<Real> &ir);
 
 
+  void AngularFluxDivergence(const int k, const int j, const int i, const int ifr,
+                             const Real wght, AthenaArray<Real> &ir_out);
   void ImplicitAngularFluxesCoef(const Real wght);
   void ImplicitAngularFluxes(const int k, const int j, const int i,
                              AthenaArray<Real> &ir);
@@ -94,10 +96,12 @@ class RadIntegrator {
 
   void MapLabToCmFrequency(Real &tran_coef, AthenaArray<Real> &split_ratio,
                    AthenaArray<int> &map_start, AthenaArray<int> &map_end,
-                   AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_shift);
+                   AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_shift, int tid);
   void MapCmToLabFrequency(Real &tran_coef, AthenaArray<Real> &split_ratio,
                    AthenaArray<int> &map_start, AthenaArray<int> &map_end,
-                      AthenaArray<Real> &ir_shift, AthenaArray<Real> &ir_cm);
+                   AthenaArray<Real> &ir_shift, AthenaArray<Real> &ir_cm, int tid);
+  void MapLabToCmAngles(AthenaArray<Real> &tran_coef, AthenaArray<Real> &ir_cm);
+  void MapCmToLabAngles(AthenaArray<Real> &tran_coef, AthenaArray<Real> &ir_cm);
 
   void GetCmMCIntensity(AthenaArray<Real> &ir_cm, AthenaArray<Real> &delta_nu_n,
                                                     AthenaArray<Real> &ir_face);
@@ -110,7 +114,7 @@ class RadIntegrator {
   void BackwardSplitting(Real &tran_coef,
                       AthenaArray<Real> &ir_cm, AthenaArray<Real> &ir_face,
                       AthenaArray<Real> &split_ratio,
-                      AthenaArray<int> &map_start,AthenaArray<int> &map_end);
+                      AthenaArray<int> &map_start,AthenaArray<int> &map_end, int tid);
 
 
   void MapIrcmFrequency(AthenaArray<Real> &split_ratio,
@@ -131,6 +135,12 @@ class RadIntegrator {
                   Real *nu_lab, Real &nu_l, Real &nu_r, Real &ir_l,
                                       Real &ir_r, Real *split_ratio);
 
+  // table of the frequency shifts as a function of tran_coef
+  void InitDopplerTable(Real vmax);
+  bool TabulatedSplitting(Real tran_coef, AthenaArray<Real> &ir_face,
+                      AthenaArray<Real> &split_ratio,
+                      AthenaArray<int> &map_start, AthenaArray<int> &map_end);
+
 
 
   void ComToLabMultiGroup(const Real vx, const Real vy, const Real vz,
@@ -199,6 +209,9 @@ class RadIntegrator {
   int adv_flag_; // flag used to indicate whether separate
                  // advection flux from diffustion flux or not.
   int imp_ang_flx_;
+  // number of angles in each tile of the explicit flux divergence, a multiple of
+  // nang when the explicit angular fluxes are included
+  int ang_blk_;
 
   int doppler_flag_;
 
@@ -237,9 +250,18 @@ class RadIntegrator {
   AthenaArray<int> map_bin_start_, map_bin_end_;
   AthenaArray<int> map_count_;
   AthenaArray<Real> nu_shift_;
+  // threads over the angles and groups of one cell; fre_map_matrix_, delta_nu_n_,
+  // ir_face_, ir_ori_, ir_done_, map_count_ and nu_shift_ have one slice per thread
+  int group_threads_;
   int iteration_tgas_, iteration_compton_;
   Real tgas_error_, compton_error_;
   int nmax_map_; //maximum number of frequency bins that each bin will map to
+  // frequency shift table: intervals uniform in ln(tran_coef), with the range of bins
+  // and the interpolation coefficients of the weights of the face intensities
+  int doppler_table_, dop_nw_;
+  Real dop_lnt_max_, dop_dlnt_;
+  AthenaArray<int> dop_start_, dop_end_;
+  AthenaArray<Real> dop_coef_;
 };
 
 #endif // NR_RADIATION_INTEGRATORS_RAD_INTEGRATORS_HPP_
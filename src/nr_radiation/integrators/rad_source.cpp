@@ -70,8 +70,6 @@ void RadIntegrator::CalSourceTerms(MeshBlock *pmb, const Real dt,
   AthenaArray<Real> &ir_cm = ir_cm_;
   AthenaArray<Real> &cm_to_lab = cm_to_lab_;
 
-  AthenaArray<Real> split_ratio;
-  AthenaArray<int> map_start, map_end;
 
   // for implicit update, using the quantities from the partially
   // updated u, not from w
@@ -157,21 +155,7 @@ void RadIntegrator::CalSourceTerms(MeshBlock *pmb, const Real dt,
   } else {
     // map frequency grid
     if (doppler_flag_ > 0) {
-      for (int n=0; n<nang; ++n) {
-        for (int ifr=0; ifr<nfreq; ++ifr) {
-          ir_ori_(ifr) = ir_cm(ifr*nang+n);
-        }
-        split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
-        map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
-        map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
-
-        MapLabToCmFrequency(tran_coef(n), split_ratio, map_start, map_end,
-                                                     ir_ori_, ir_done_);
-
-        for (int ifr=0; ifr<nfreq; ++ifr) {
-          ir_cm(ifr*nang+n) = ir_done_(ifr);
-        }
-      }
+      MapLabToCmAngles(tran_coef, ir_cm);
     }
     // calculate the source term
     tgas_new_(k,j,i) = MultiGroupAbsScat(wmu_cm,tran_coef, sigma_at, sigma_p,
@@ -197,33 +181,7 @@ void RadIntegrator::CalSourceTerms(MeshBlock *pmb, const Real dt,
     }
     // map frequency grid
     if (doppler_flag_ > 0) {
-      for (int n=0; n<nang; ++n) {
-        for (int ifr=0; ifr<nfreq; ++ifr) {
-          ir_ori_(ifr) = ir_cm(ifr*nang+n);
-        }
-        split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
-        map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
-        map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
-
-        bool invertible = FreMapMatrix(split_ratio, tran_coef(n), map_start,
-                                        map_end, map_count_, fre_map_matrix_);
-        if (invertible) {
-          bool success = InverseMapFrequency(tran_coef(n), map_count_,
-                                          fre_map_matrix_, ir_ori_, ir_done_);
-
-          if (!success)
-            MapCmToLabFrequency(tran_coef(n),split_ratio, map_start, map_end,
-                                                        ir_ori_,ir_done_);
-
-        } else {
-          MapCmToLabFrequency(tran_coef(n),split_ratio, map_start, map_end,
-                                                        ir_ori_,ir_done_);
-        }
-
-        for (int ifr=0; ifr<nfreq; ++ifr) {
-          ir_cm(ifr*nang+n) = ir_done_(ifr);
-        }
-      }
+      MapCmToLabAngles(tran_coef, ir_cm);
     }
   }
 
@@ -268,8 +226,6 @@ void RadIntegrator::AddMultiGroupCompt(MeshBlock *pmb, const Real dt,
   Real invcrat = 1.0/prad->crat;
   Real invredfactor = prad->crat/prad->reduced_c;
 
-  AthenaArray<Real> split_ratio;
-  AthenaArray<int> map_start, map_end;
 
   Real *lab_ir;
 
@@ -331,22 +287,7 @@ void RadIntegrator::AddMultiGroupCompt(MeshBlock *pmb, const Real dt,
             delta_source(0,ifr) = er_fr;
           }
           // map frequency grid
-          for (int n=0; n<nang; ++n) {
-            for (int ifr=0; ifr<nfreq; ++ifr)
-              ir_ori_(ifr) = ir_cm(ifr*nang+n);
-
-            split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
-            map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
-            map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
-
-            MapLabToCmFrequency(tran_coef(n), split_ratio, map_start, map_end,
-                                                            ir_ori_, ir_done_);
-
-
-            for (int ifr=0; ifr<nfreq; ++ifr) {
-              ir_cm(ifr*nang+n) = ir_done_(ifr);
-            }
-          }
+          MapLabToCmAngles(tran_coef, ir_cm);
 
           // Add compton scattering
           Real t_ini = tgas_new_(k,j,i);
@@ -364,33 +305,7 @@ void RadIntegrator::AddMultiGroupCompt(MeshBlock *pmb, const Real dt,
           ir_cm = ir_buff_;
 
           // map frequency grid
-          for (int n=0; n<nang; ++n) {
-            for (int ifr=0; ifr<nfreq; ++ifr) {
-              ir_ori_(ifr) = ir_cm(ifr*nang+n);
-            }
-
-            split_ratio.InitWithShallowSlice(split_ratio_,3,n,1);
-            map_start.InitWithShallowSlice(map_bin_start_,2,n,1);
-            map_end.InitWithShallowSlice(map_bin_end_,2,n,1);
-
-            bool invertible = FreMapMatrix(split_ratio, tran_coef(n), map_start,
-                                            map_end, map_count_, fre_map_matrix_);
-            if (invertible) {
-              bool success = InverseMapFrequency(tran_coef(n), map_count_,
-                                          fre_map_matrix_, ir_ori_, ir_done_);
-              if (!success) {
-                  MapCmToLabFrequency(tran_coef(n),split_ratio, map_start, map_end,
-                                                        ir_ori_,ir_done_);
-              }
-            } else {
-              MapCmToLabFrequency(tran_coef(n),split_ratio, map_start, map_end,
-                                                             ir_ori_,ir_done_);
-            }
-
-            for (int ifr=0; ifr<nfreq; ++ifr) {
-              ir_cm(ifr*nang+n) = ir_done_(ifr);
-            }
-          }
+          MapCmToLabAngles(tran_coef, ir_cm);
           for (int ifr=0; ifr<nfreq; ++ifr) {
             lab_ir = &(ir(k,j,i,nang*ifr));
             for (int n=0; n<nang; ++n) {
@@ -20,6 +20,7 @@
 // C headers
 
 // C++ headers
+#include <algorithm>  // max, min
 #include <sstream>    // stringstream
 
 // Athena++ headers
@@ -29,6 +30,7 @@
 #include "../../mesh/mesh.hpp"
 #include "../../parameter_input.hpp"
 #include "../../reconstruct/reconstruction.hpp"
+#include "../../utils/perf_counters.hpp"
 #include "../radiation.hpp"
 
 // class header
@@ -39,12 +41,31 @@
 #include <omp.h>
 #endif
 
+namespace {
+//! HLLE flux of all the angles at one face, plus the upwinded advective flux.
+//! 1/(smax-smin), the diffusive flux and the advective flux are done in one pass
+inline void HLLEFaceFlux(const int n_fre_ang, const Real adv, const Real *vel,
+                         const Real *smax, const Real *smin, const Real *irln,
+                         const Real *irrn, Real *flx) {
+  const Real *irup = (adv > 0) ? irln : irrn;
+#pragma omp simd
+  for (int n=0; n<n_fre_ang; ++n) {
+    Real diff = smax[n] - smin[n];
+    Real sm_diff = (std::abs(diff) < TINY_NUMBER) ? 0.0 : 1.0/diff;
+    Real vl = vel[n] - adv;
+    flx[n] = smax[n] * (vl - smin[n]) * irln[n] * sm_diff
+             + smin[n] * (smax[n] - vl) * irrn[n] * sm_diff + adv * irup[n];
+  }
+}
+} // namespace
+
 // calculate the transport flux as
 // (v- vel)I + vel*I
 void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
                                     AthenaArray<Real> &ir, const int order) {
   NRRadiation *prad=pmy_rad;
   MeshBlock *pmb=prad->pmy_block;
+  PerfCounters::Scope perf(PerfCounters::rad_fluxes, pmb->GetNumberOfMeshBlockCells());
   Coordinates *pco=pmb->pcoord;
 
   int nang=prad->nang;
@@ -117,31 +138,8 @@ void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
         if (adv_flag_ > 0) {
           adv = adv_vel(0,k,j,i);
         }
-        Real *sm_diff = &(sm_diff1_(0));
-        for (int n=0; n<prad->n_fre_ang; ++n) {
-          Real diff = smax[n] - smin[n];
-          if (std::abs(diff) < TINY_NUMBER)
-            sm_diff[n] = 0.0;
-          else
-            sm_diff[n] = 1.0/diff;
-        }
-        for (int n=0; n<prad->n_fre_ang; ++n) {
-          Real vl = vel[n] - adv;
-          x1flux(k,j,i,n) = smax[n] * (vl - smin[n]) * irln[n] * sm_diff[n]
-                            + smin[n] * (smax[n] - vl) * irrn[n] * sm_diff[n];
-        }
-        if (adv_flag_ > 0) {
-          Real &advv = adv_vel(0,k,j,i);
-          if (advv >0) {
-            for (int n=0; n<prad->n_fre_ang; ++n) {
-              x1flux(k,j,i,n) += advv * irln[n];
-            }
-          } else {
-            for (int n=0; n<prad->n_fre_ang; ++n) {
-              x1flux(k,j,i,n) += advv * irrn[n];
-            }
-          }
-        }
+        HLLEFaceFlux(prad->n_fre_ang, adv, vel, smax, smin, irln, irrn,
+                     &(x1flux(k,j,i,0)));
       }
     }
   }
@@ -208,34 +206,8 @@ void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
           if (adv_flag_ > 0) {
             adv = adv_vel(1,k,j,i);
           }
-          Real *sm_diff = &(sm_diff1_(0));
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            Real diff = smax[n] - smin[n];
-            if (std::abs(diff) < TINY_NUMBER)
-              sm_diff[n] = 0.0;
-            else
-              sm_diff[n] = 1.0/diff;
-          }
-
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            Real vl = vel[n] - adv;
-            x2flux(k,j,i,n) = smax[n] * (vl - smin[n]) * irln[n] * sm_diff[n]
-                              + smin[n] * (smax[n] - vl) * irrn[n] * sm_diff[n];
-            // x2flux(k,j,i,n) = (smax[n] * vl * irln[n] - smin[n] * vl * irrn[n]
-            // + smax[n] * smin[n] * (irrn[n] - irln[n]))/(smax[n] - smin[n]);
-          }
-          if (adv_flag_ > 0) {
-            Real &advv = adv_vel(1,k,j,i);
-            if (advv >0) {
-              for (int n=0; n<prad->n_fre_ang; ++n) {
-                x2flux(k,j,i,n) += advv * irln[n];
-              }
-            } else {
-              for (int n=0; n<prad->n_fre_ang; ++n) {
-                x2flux(k,j,i,n) += advv * irrn[n];
-              }
-            }
-          }
+          HLLEFaceFlux(prad->n_fre_ang, adv, vel, smax, smin, irln, irrn,
+                       &(x2flux(k,j,i,0)));
         }
         il_.SwapAthenaArray(ilb_);
       }
@@ -307,33 +279,8 @@ void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
           if (adv_flag_ > 0) {
             adv = adv_vel(2,k,j,i);
           }
-          Real *sm_diff = &(sm_diff1_(0));
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            Real diff = smax[n] - smin[n];
-            if (std::abs(diff) < TINY_NUMBER)
-              sm_diff[n] = 0.0;
-            else
-              sm_diff[n] = 1.0/diff;
-          }
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            Real vl = vel[n] - adv;
-            x3flux(k,j,i,n) = smax[n] * (vl - smin[n]) * irln[n] * sm_diff[n]
-                              + smin[n] * (smax[n] - vl) * irrn[n] * sm_diff[n];
-            // x3flux(k,j,i,n) = (smax[n] * vl * irln[n] - smin[n] * vl * irrn[n]
-            // + smax[n] * smin[n] * (irrn[n] - irln[n]))/(smax[n] - smin[n]);
-          }// end n
-          if (adv_flag_ > 0) {
-            Real &advv = adv_vel(2,k,j,i);
-            if (advv >0) {
-              for (int n=0; n<prad->n_fre_ang; ++n) {
-                x3flux(k,j,i,n) += advv * irln[n];
-              }
-            } else {
-              for (int n=0; n<prad->n_fre_ang; ++n) {
-                x3flux(k,j,i,n) += advv * irrn[n];
-              }
-            }
-          }
+          HLLEFaceFlux(prad->n_fre_ang, adv, vel, smax, smin, irln, irrn,
+                       &(x3flux(k,j,i,0)));
         }
         // swap the arrays for the next step
         il_.SwapAthenaArray(ilb_);
@@ -342,115 +289,111 @@ void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
   }
 
   // calculate flux along angular direction
-  if ((prad->angle_flag == 1) && (prad->nzeta > 0) && (imp_ang_flx_ == 0)) {
+  // zeta and psi fluxes are done in the same pass over the cells, while the
+  // intensities of each cell are in cache
+  if ((prad->angle_flag == 1) && (imp_ang_flx_ == 0)
+      && ((prad->nzeta > 0) || (prad->npsi > 0))) {
+    int &nzeta = prad->nzeta;
+    int &npsi = prad->npsi;
+    int psi_limit=2*npsi;
+    if (npsi == 0) psi_limit=1;
+    int zeta_limit=2*nzeta;
+    if (nzeta == 0) zeta_limit=1;
+
     for (int k=ks; k<=ke; ++k) {
       for (int j=js; j<=je; ++j) {
         for (int i=is; i<=ie; ++i) {
+          // the zeta geometry factors are the same for all groups
+          if (nzeta > 0)
+            pco->GetGeometryZeta(prad,k,j,i,g_zeta_);
           // going through all frequency groups
           for (int ifr=0; ifr<nfreq; ++ifr) {
-            int &nzeta = prad->nzeta;
-            int &npsi = prad->npsi;
-            int psi_limit=2*npsi;
-            if (npsi == 0) psi_limit=1;
-
-            for (int m=0; m<psi_limit; ++m) {
-              // TODO(KGF): forced to comment out 4x pragmas here and 2x in
-              // ../get_moments.cpp to stop link-time segfault with icpx 2023.0.0
-              // and other problems on 2022.2.0
+            if (nzeta > 0) {
+              for (int m=0; m<psi_limit; ++m) {
+                // TODO(KGF): forced to comment out 4x pragmas here and 2x in
+                // ../get_moments.cpp to stop link-time segfault with icpx 2023.0.0
+                // and other problems on 2022.2.0
 //#pragma omp simd
-              for (int n=0; n<nzeta*2; ++n) {
-                int ang_num = ifr*nang + n*psi_limit+m;
-                q_zeta_(n+NGHOST) = ir(k,j,i,ang_num);
-              }
-              // Add ghost zones
+                for (int n=0; n<nzeta*2; ++n) {
+                  int ang_num = ifr*nang + n*psi_limit+m;
+                  q_zeta_(n+NGHOST) = ir(k,j,i,ang_num);
+                }
+                // Add ghost zones
 //#pragma omp simd
-              for (int n=1; n<=NGHOST; ++n) {
-                q_zeta_(NGHOST-n) = q_zeta_(NGHOST+n-1);
-              }
+                for (int n=1; n<=NGHOST; ++n) {
+                  q_zeta_(NGHOST-n) = q_zeta_(NGHOST+n-1);
+                }
 //#pragma omp simd
-              for (int n=1; n<=NGHOST; ++n) {
-                q_zeta_(2*nzeta+NGHOST+n-1) = q_zeta_(2*nzeta+NGHOST-n);
-              }
-              int zl = NGHOST-1;
-              int zu = 2*nzeta+NGHOST;
-              if (order == 1) {
-                pmb->precon->DonorCellZeta(prad,zl,zu,q_zeta_,
-                                           ql_zeta_,qr_zeta_);
-              } else {
-                pmb->precon->PiecewiseLinearZeta(prad,zl,zu,q_zeta_,
-                                                 ql_zeta_,qr_zeta_);
-              }
+                for (int n=1; n<=NGHOST; ++n) {
+                  q_zeta_(2*nzeta+NGHOST+n-1) = q_zeta_(2*nzeta+NGHOST-n);
+                }
+                int zl = NGHOST-1;
+                int zu = 2*nzeta+NGHOST;
+                if (order == 1) {
+                  pmb->precon->DonorCellZeta(prad,zl,zu,q_zeta_,
+                                             ql_zeta_,qr_zeta_);
+                } else {
+                  pmb->precon->PiecewiseLinearZeta(prad,zl,zu,q_zeta_,
+                                                   ql_zeta_,qr_zeta_);
+                }
 
-              // zeta flux
-              pco->GetGeometryZeta(prad,k,j,i,g_zeta_);
-              for (int n=0; n<nzeta*2+1; ++n) {
-                int ang_num = n*psi_limit+m;
-                Real g_coef = g_zeta_(n);
-                if (g_coef > 0)
-                  zeta_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * qr_zeta_(n+NGHOST)
-                                                   * g_zeta_(n);
-                else if (g_coef < 0)
-                  zeta_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * ql_zeta_(n+NGHOST)
-                                                   * g_zeta_(n);
+                // zeta flux
+                for (int n=0; n<nzeta*2+1; ++n) {
+                  int ang_num = n*psi_limit+m;
+                  Real g_coef = g_zeta_(n);
+                  if (g_coef > 0)
+                    zeta_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * qr_zeta_(n+NGHOST)
+                                                     * g_zeta_(n);
+                  else if (g_coef < 0)
+                    zeta_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * ql_zeta_(n+NGHOST)
+                                                     * g_zeta_(n);
+                }
               }
             }
-          }
-        }
-      }
-    }
-  }
 
-  // Now calculate psi flux
-  if ((prad->angle_flag == 1) && (prad->npsi > 0) && (imp_ang_flx_ == 0)) {
-    for (int k=ks; k<=ke; ++k) {
-      for (int j=js; j<=je; ++j) {
-        for (int i=is; i<=ie; ++i) {
-          for (int ifr=0; ifr<nfreq; ++ifr) {
-            int &nzeta = prad->nzeta;
-            int &npsi = prad->npsi;
-            int zeta_limit=2*nzeta;
-            if (nzeta == 0) zeta_limit=1;
-
-            for (int n=0; n<zeta_limit; ++n) {
-              Real *qpsi = &(q_psi_(NGHOST));
-              Real *irm = &(ir(k,j,i,ifr*nang+n*2*npsi));
-              for (int m=0; m<npsi*2; ++m) {
-                qpsi[m] = irm[m];
-              }
-              // Add ghost zones
-              // phi is periodic
-              // the first one qpsi[NGHOST]
-              // The last one is qpsi[NGHOST+2*npsi-1]
-              for (int m=1; m<=NGHOST; ++m) {
-                q_psi_(NGHOST-m) = q_psi_(2*npsi+NGHOST-m);
-              }
-              for (int m=1; m<=NGHOST; ++m) {
-                q_psi_(2*npsi+NGHOST+m-1) = q_psi_(NGHOST+m-1);
-              }
-              int pl = NGHOST-1;
-              int pu = 2*npsi+NGHOST;
-              if (order == 1) {
-                pmb->precon->DonorCellPsi(prad,pl,pu,q_psi_,
-                                          ql_psi_,qr_psi_);
-              } else {
-                pmb->precon->PiecewiseLinearPsi(prad,pl,pu,q_psi_,
-                                                ql_psi_,qr_psi_);
-              }
+            // Now calculate psi flux
+            if (npsi > 0) {
+              for (int n=0; n<zeta_limit; ++n) {
+                Real *qpsi = &(q_psi_(NGHOST));
+                Real *irm = &(ir(k,j,i,ifr*nang+n*2*npsi));
+                for (int m=0; m<npsi*2; ++m) {
+                  qpsi[m] = irm[m];
+                }
+                // Add ghost zones
+                // phi is periodic
+                // the first one qpsi[NGHOST]
+                // The last one is qpsi[NGHOST+2*npsi-1]
+                for (int m=1; m<=NGHOST; ++m) {
+                  q_psi_(NGHOST-m) = q_psi_(2*npsi+NGHOST-m);
+                }
+                for (int m=1; m<=NGHOST; ++m) {
+                  q_psi_(2*npsi+NGHOST+m-1) = q_psi_(NGHOST+m-1);
+                }
+                int pl = NGHOST-1;
+                int pu = 2*npsi+NGHOST;
+                if (order == 1) {
+                  pmb->precon->DonorCellPsi(prad,pl,pu,q_psi_,
+                                            ql_psi_,qr_psi_);
+                } else {
+                  pmb->precon->PiecewiseLinearPsi(prad,pl,pu,q_psi_,
+                                                  ql_psi_,qr_psi_);
+                }
 
-              // psi flux
-              if (nzeta > 0)
-                pco->GetGeometryPsi(prad,k,j,i,n,g_psi_);
-              else
-                pco->GetGeometryPsi(prad,k,j,i,g_psi_);
-              for (int m=0; m<npsi*2+1; ++m) {
-                int ang_num = n*2*npsi+m;
-                Real g_coef = g_psi_(m);
-                if (g_coef > 0)
-                  psi_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * qr_psi_(m+NGHOST)
-                                                  * g_coef;
-                else if (g_coef < 0)
-                  psi_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * ql_psi_(m+NGHOST)
-                                                  * g_coef;
+                // psi flux
+                if (nzeta > 0)
+                  pco->GetGeometryPsi(prad,k,j,i,n,g_psi_);
+                else
+                  pco->GetGeometryPsi(prad,k,j,i,g_psi_);
+                for (int m=0; m<npsi*2+1; ++m) {
+                  int ang_num = n*2*npsi+m;
+                  Real g_coef = g_psi_(m);
+                  if (g_coef > 0)
+                    psi_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * qr_psi_(m+NGHOST)
+                                                    * g_coef;
+                  else if (g_coef < 0)
+                    psi_flux_(k,j,i,ifr,ang_num) =  -prad->reduced_c * ql_psi_(m+NGHOST)
+                                                    * g_coef;
+                }
               }
             }
           }
@@ -465,6 +408,7 @@ void RadIntegrator::CalculateFluxes(AthenaArray<Real> &w,
 void RadIntegrator::CalculateFluxes(AthenaArray<Real> &ir, const int order) {
   NRRadiation *prad=pmy_rad;
   MeshBlock *pmb=prad->pmy_block;
+  PerfCounters::Scope perf(PerfCounters::rad_fluxes, pmb->GetNumberOfMeshBlockCells());
 
   // int nang=prad->nang;
   // int nfreq=prad->nfreq;
@@ -691,8 +635,11 @@ void RadIntegrator::FluxDivergence(const Real wght, AthenaArray<Real> &ir_in,
                                    AthenaArray<Real> &ir_out) {
   NRRadiation *prad=pmy_rad;
   MeshBlock *pmb=prad->pmy_block;
+  PerfCounters::Scope perf(PerfCounters::rad_divergence,
+                           pmb->GetNumberOfMeshBlockCells());
   int nfreq=prad->nfreq;
   int nang=prad->nang;
+  int n_fre_ang=prad->n_fre_ang;
 
   AthenaArray<Real> &x1flux=prad->flux[X1DIR];
   AthenaArray<Real> &x2flux=prad->flux[X2DIR];
@@ -703,115 +650,71 @@ void RadIntegrator::FluxDivergence(const Real wght, AthenaArray<Real> &ir_in,
 
   AthenaArray<Real> &x1area = x1face_area_, &x2area = x2face_area_,
                  &x2area_p1 = x2face_area_p1_, &x3area = x3face_area_,
-                 &x3area_p1 = x3face_area_p1_, &vol = cell_volume_, &dflx = dflx_;
+                 &x3area_p1 = x3face_area_p1_, &vol = cell_volume_;
 
-  AthenaArray<Real> &area_zeta = zeta_area_, &area_psi = psi_area_,
-                      &ang_vol = ang_vol_, &dflx_ang = dflx_ang_;
-  int &nzeta = prad->nzeta, &npsi = prad->npsi;
+  bool ang_flx = (prad->angle_flag == 1) && (imp_ang_flx_ == 0);
 
   for (int k=ks; k<=ke; ++k) {
     for (int j=js; j<=je; ++j) {
-      // calculate x1-flux divergence
+      // face areas and volumes of the pencil, shared by all the angles
       pmb->pcoord->Face1Area(k,j,is,ie+1,x1area);
-      for (int i=is; i<=ie; ++i) {
-        Real *flxr = &(x1flux(k,j,i+1,0));
-        Real *flxl = &(x1flux(k,j,i,0));
-        Real *flxn = &(dflx(i,0));
-        for (int n=0; n<prad->n_fre_ang; ++n) {
-          flxn[n] = (x1area(i+1) *flxr[n] - x1area(i)*flxl[n]);
-        }
-      }
-
-      // calculate x2-flux
       if (pmb->block_size.nx2 > 1) {
         pmb->pcoord->Face2Area(k,j  ,is,ie,x2area   );
         pmb->pcoord->Face2Area(k,j+1,is,ie,x2area_p1);
-        for (int i=is; i<=ie; ++i) {
-          Real *flxr = &(x2flux(k,j+1,i,0));
-          Real *flxl = &(x2flux(k,j,i,0));
-          Real *flxn = &(dflx(i,0));
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            flxn[n] += (x2area_p1(i)*flxr[n] - x2area(i)*flxl[n]);
-          }
-        }
       }
-
-      // calculate x3-flux divergence
       if (pmb->block_size.nx3 > 1) {
         pmb->pcoord->Face3Area(k  ,j,is,ie,x3area   );
         pmb->pcoord->Face3Area(k+1,j,is,ie,x3area_p1);
-        for (int i=is; i<=ie; ++i) {
-          Real *flxr = &(x3flux(k+1,j,i,0));
-          Real *flxl = &(x3flux(k,j,i,0));
-          Real *flxn = &(dflx(i,0));
-          for (int n=0; n<prad->n_fre_ang; ++n) {
-            flxn[n] += (x3area_p1(i)*flxr[n] - x3area(i)*flxl[n]);
-          }
-        }
       }
-      // update variable with flux divergence
       pmb->pcoord->CellVolume(k,j,is,ie,vol);
-      for (int i=is; i<=ie; ++i) {
-        Real *irin = &(ir_in(k,j,i,0));
-        Real *iro = &(ir_out(k,j,i,0));
-        Real *flxn = &(dflx(i,0));
-        for (int n=0; n<prad->n_fre_ang; ++n) {
-          iro[n] = std::max(irin[n]-wght*flxn[n]/vol(i), static_cast<Real>(TINY_NUMBER));
-        }
-      }
 
-      // add angular flux
-      if ((prad->angle_flag == 1) && (imp_ang_flx_ == 0)) {
+      // Sweep the pencil once per block of angles, so that the x1 fluxes shared by
+      // neighboring cells are still in cache. The spatial flux divergence of all three
+      // directions is added in one pass, followed by the angular flux divergence of
+      // the groups of the block
+      for (int nb=0; nb<n_fre_ang; nb+=ang_blk_) {
+        int ne = std::min(nb+ang_blk_, n_fre_ang);
         for (int i=is; i<=ie; ++i) {
-          for (int ifr=0; ifr<nfreq; ++ifr) {
-            for (int n=0; n<prad->nang; ++n)
-              dflx_ang(n) = 0.0;
-            if (nzeta * npsi > 0) {
-              for (int m=0; m<2*npsi; ++m) {
-//#pragma omp simd
-                for (int n=0; n<2*nzeta; ++n) {
-                  int ang_num = n*2*npsi + m;
-                  int ang_num1 = (n+1)*2*npsi+m;
-                  dflx_ang(ang_num) += (area_zeta(m,n+1) * zeta_flux_(k,j,i,ifr,ang_num1)
-                                        - area_zeta(m,n) * zeta_flux_(k,j,i,ifr,ang_num));
-                }
-              }
-              // now psi flux
-              for (int n=0; n<2*nzeta; ++n) {
-                Real *flxn = &(dflx_ang(n*2*npsi));
-                Real *areapsi = &(area_psi(n,0));
-                Real *psiflx = &(psi_flux_(k,j,i,ifr,n*2*npsi));
-                for (int m=0; m<2*npsi; ++m) {
-                  flxn[m] += (areapsi[m+1] * psiflx[m+1]
-                              - areapsi[m] * psiflx[m]);
-                }
-              }
-            } else if (nzeta >0) {
-              Real *flxn = &(dflx_ang(0));
-              Real *areazeta = &(area_zeta(0));
-              Real *zetaflx = &(zeta_flux_(k,j,i,ifr,0));
-              for (int n=0; n<2*nzeta; ++n) {
-                flxn[n] += (areazeta[n+1] * zetaflx[n+1]
-                            - areazeta[n] * zetaflx[n]);
-              }
-            } else if (npsi > 0) {
-              Real *flxn = &(dflx_ang(0));
-              Real *areapsi = &(area_psi(0));
-              Real *psiflx = &(psi_flux_(k,j,i,ifr,0));
-              for (int m=0; m<2*npsi; ++m) {
-                flxn[m] += (areapsi[m+1] * psiflx[m+1]
-                            - areapsi[m] * psiflx[m]);
-              }
+          Real dtvol = wght/vol(i);
+          Real *irin = &(ir_in(k,j,i,0));
+          Real *iro = &(ir_out(k,j,i,0));
+          Real *flx1r = &(x1flux(k,j,i+1,0));
+          Real *flx1l = &(x1flux(k,j,i,0));
+          Real a1r = x1area(i+1), a1l = x1area(i);
+          if (pmb->block_size.nx3 > 1) {
+            Real *flx2r = &(x2flux(k,j+1,i,0));
+            Real *flx2l = &(x2flux(k,j,i,0));
+            Real *flx3r = &(x3flux(k+1,j,i,0));
+            Real *flx3l = &(x3flux(k,j,i,0));
+            Real a2r = x2area_p1(i), a2l = x2area(i);
+            Real a3r = x3area_p1(i), a3l = x3area(i);
+#pragma omp simd
+            for (int n=nb; n<ne; ++n) {
+              Real dflx = (a1r*flx1r[n] - a1l*flx1l[n]) + (a2r*flx2r[n] - a2l*flx2l[n])
+                          + (a3r*flx3r[n] - a3l*flx3l[n]);
+              iro[n] = std::max(irin[n]-dtvol*dflx, static_cast<Real>(TINY_NUMBER));
             }
-            // apply the flux divergence back
-            // We need ir_out, not ir_in, as ir_out is already partially updated
-            Real *iro = &(ir_out(k,j,i,ifr*nang));
-            Real *flxn = &(dflx_ang(0));
-            Real *angv = &(ang_vol(0));
-            for (int n=0; n<prad->nang; ++n) {
-              iro[n] = std::max(iro[n]-wght*flxn[n]/angv[n],
-                                static_cast<Real>(TINY_NUMBER));
+          } else if (pmb->block_size.nx2 > 1) {
+            Real *flx2r = &(x2flux(k,j+1,i,0));
+            Real *flx2l = &(x2flux(k,j,i,0));
+            Real a2r = x2area_p1(i), a2l = x2area(i);
+#pragma omp simd
+            for (int n=nb; n<ne; ++n) {
+              Real dflx = (a1r*flx1r[n] - a1l*flx1l[n]) + (a2r*flx2r[n] - a2l*flx2l[n]);
+              iro[n] = std::max(irin[n]-dtvol*dflx, static_cast<Real>(TINY_NUMBER));
             }
+          } else {
+#pragma omp simd
+            for (int n=nb; n<ne; ++n) {
+              Real dflx = a1r*flx1r[n] - a1l*flx1l[n];
+              iro[n] = std::max(irin[n]-dtvol*dflx, static_cast<Real>(TINY_NUMBER));
+            }
+          }
+
+          // add angular flux, the block holds whole frequency groups in this case
+          if (ang_flx) {
+            for (int ifr=nb/nang; ifr<ne/nang; ++ifr)
+              AngularFluxDivergence(k, j, i, ifr, wght, ir_out);
           }
         }
       }
@@ -838,3 +741,64 @@ void RadIntegrator::FluxDivergence(const Real wght, AthenaArray<Real> &ir_in,
     }
   }
 }
+
+// apply the explicit divergence of the zeta and psi fluxes to the intensities of the
+// frequency group ifr in cell (k,j,i)
+void RadIntegrator::AngularFluxDivergence(const int k, const int j, const int i,
+                                          const int ifr, const Real wght,
+                                          AthenaArray<Real> &ir_out) {
+  NRRadiation *prad=pmy_rad;
+  int nang=prad->nang;
+  int &nzeta = prad->nzeta, &npsi = prad->npsi;
+  AthenaArray<Real> &area_zeta = zeta_area_, &area_psi = psi_area_,
+                      &ang_vol = ang_vol_, &dflx_ang = dflx_ang_;
+
+  for (int n=0; n<nang; ++n)
+    dflx_ang(n) = 0.0;
+  if (nzeta * npsi > 0) {
+    for (int m=0; m<2*npsi; ++m) {
+//#pragma omp simd
+      for (int n=0; n<2*nzeta; ++n) {
+        int ang_num = n*2*npsi + m;
+        int ang_num1 = (n+1)*2*npsi+m;
+        dflx_ang(ang_num) += (area_zeta(m,n+1) * zeta_flux_(k,j,i,ifr,ang_num1)
+                              - area_zeta(m,n) * zeta_flux_(k,j,i,ifr,ang_num));
+      }
+    }
+    // now psi flux
+    for (int n=0; n<2*nzeta; ++n) {
+      Real *flxn = &(dflx_ang(n*2*npsi));
+      Real *areapsi = &(area_psi(n,0));
+      Real *psiflx = &(psi_flux_(k,j,i,ifr,n*2*npsi));
+      for (int m=0; m<2*npsi; ++m) {
+        flxn[m] += (areapsi[m+1] * psiflx[m+1]
+                    - areapsi[m] * psiflx[m]);
+      }
+    }
+  } else if (nzeta >0) {
+    Real *flxn = &(dflx_ang(0));
+    Real *areazeta = &(area_zeta(0));
+    Real *zetaflx = &(zeta_flux_(k,j,i,ifr,0));
+    for (int n=0; n<2*nzeta; ++n) {
+      flxn[n] += (areazeta[n+1] * zetaflx[n+1]
+                  - areazeta[n] * zetaflx[n]);
+    }
+  } else if (npsi > 0) {
+    Real *flxn = &(dflx_ang(0));
+    Real *areapsi = &(area_psi(0));
+    Real *psiflx = &(psi_flux_(k,j,i,ifr,0));
+    for (int m=0; m<2*npsi; ++m) {
+      flxn[m] += (areapsi[m+1] * psiflx[m+1]
+                  - areapsi[m] * psiflx[m]);
+    }
+  }
+  // apply the flux divergence back
+  // We need ir_out, not ir_in, as ir_out is already partially updated
+  Real *iro = &(ir_out(k,j,i,ifr*nang));
+  Real *flxn = &(dflx_ang(0));
+  Real *angv = &(ang_vol(0));
+  for (int n=0; n<nang; ++n) {
+    iro[n] = std::max(iro[n]-wght*flxn[n]/angv[n],
+                      static_cast<Real>(TINY_NUMBER));
+  }
+}
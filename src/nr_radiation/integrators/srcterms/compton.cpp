@@ -149,6 +149,10 @@ void RadIntegrator::MultiGroupCompton(
   // do not include the correction factor when estimate T
   Real tgas_new = tgas;
 
+  // the groups are independent here and in the final update of the intensities, so
+  // they are shared among the group threads; the Kompaneets solve is a sweep across
+  // the groups and stays sequential
+#pragma omp parallel for num_threads(group_threads_) if (group_threads_ > 1)
   for (int ifr=0; ifr<nfreq; ++ifr) {
     j_nu[ifr] = 0.0;
     Real *irn = &(ir_cm(nang*ifr));
@@ -419,6 +423,7 @@ void RadIntegrator::MultiGroupCompton(
     tgas = tgas_test;
     // now update intensity isotropically
     Real *tcoef = &(tran_coef(0));
+#pragma omp parallel for num_threads(group_threads_) if (group_threads_ > 1)
     for (int ifr=0; ifr<nfreq; ++ifr) {
       Real *irn = &(ir_cm(nang*ifr));
       for (int n=0; n<nang; n++) {
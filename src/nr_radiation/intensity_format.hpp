@@ -0,0 +1,132 @@
+#ifndef NR_RADIATION_INTENSITY_FORMAT_HPP_
+#define NR_RADIATION_INTENSITY_FORMAT_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file intensity_format.hpp
+//! \brief reduced-precision storage formats of the specific intensities of one cell
+//!
+//! The intensities are computed in Real, and rounded to the storage format once per
+//! stage by QuantizeCell(). PackCell()/UnpackCell() convert between the rounded values
+//! and the compact format of the boundary buffers without any further loss, so that the
+//! ghost cells hold exactly the values of the neighboring active cells.
+//! - float32: every value as a 32-bit float
+//! - scaled16: one 16-bit exponent e per cell, chosen such that max|I| < 2^e, and every
+//!   value as a 16-bit integer q with I = q*2^(e-15)
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max, min
+#include <cmath>      // abs, frexp, ldexp, round
+#include <cstdint>    // int16_t
+#include <cstring>    // memcpy
+
+// Athena++ headers
+#include "../athena.hpp"
+
+enum class IntensityFormat {real, float32, scaled16};
+
+namespace IntensityFormatting {
+
+//! bytes of one cell of nvar intensities in the given format
+inline int CellBytes(IntensityFormat fmt, int nvar) {
+  if (fmt == IntensityFormat::float32) return nvar*sizeof(float);
+  if (fmt == IntensityFormat::scaled16) return (nvar + 1)*sizeof(std::int16_t);
+  return nvar*sizeof(Real);
+}
+
+//! number of Real words of a buffer holding ncells cells of nvar intensities
+inline int BufferSize(IntensityFormat fmt, int ncells, int nvar) {
+  return (ncells*CellBytes(fmt, nvar) + sizeof(Real) - 1)/sizeof(Real);
+}
+
+//! exponent and scale factors 2^(15-e), 2^(e-15) of the scaled16 format of one cell
+inline int CellExponent(const Real *ir, int nvar, Real &scale, Real &iscale) {
+  Real amax = 0.0;
+  for (int n=0; n<nvar; ++n)
+    amax = std::max(amax, std::abs(ir[n]));
+  int e = 0;
+  if (amax > 0.0) std::frexp(amax, &e);
+  // amax*2^(15-e) is in [2^14, 2^15) but may round up to 2^15, which does not fit
+  if (std::round(std::ldexp(amax, 15 - e)) > 32767.0) ++e;
+  scale = std::ldexp(static_cast<Real>(1.0), 15 - e);
+  iscale = std::ldexp(static_cast<Real>(1.0), e - 15);
+  return e;
+}
+
+inline Real Scaled16(Real v, Real scale) {
+  return std::min(std::max(std::round(v*scale), static_cast<Real>(-32767.0)),
+                  static_cast<Real>(32767.0));
+}
+
+//! round the intensities of one cell to the values representable in the format
+inline void QuantizeCell(IntensityFormat fmt, Real *ir, int nvar) {
+  if (fmt == IntensityFormat::float32) {
+    for (int n=0; n<nvar; ++n)
+      ir[n] = static_cast<Real>(static_cast<float>(ir[n]));
+  } else if (fmt == IntensityFormat::scaled16) {
+    Real scale, iscale;
+    CellExponent(ir, nvar, scale, iscale);
+    for (int n=0; n<nvar; ++n)
+      ir[n] = Scaled16(ir[n], scale)*iscale;
+  }
+  return;
+}
+
+//! write one cell to buf and return the pointer past it
+inline char *PackCell(IntensityFormat fmt, const Real *ir, int nvar, char *buf) {
+  if (fmt == IntensityFormat::float32) {
+    for (int n=0; n<nvar; ++n) {
+      float v = static_cast<float>(ir[n]);
+      std::memcpy(buf, &v, sizeof(float));
+      buf += sizeof(float);
+    }
+  } else if (fmt == IntensityFormat::scaled16) {
+    Real scale, iscale;
+    std::int16_t q = static_cast<std::int16_t>(CellExponent(ir, nvar, scale, iscale));
+    std::memcpy(buf, &q, sizeof(std::int16_t));
+    buf += sizeof(std::int16_t);
+    for (int n=0; n<nvar; ++n) {
+      q = static_cast<std::int16_t>(Scaled16(ir[n], scale));
+      std::memcpy(buf, &q, sizeof(std::int16_t));
+      buf += sizeof(std::int16_t);
+    }
+  } else {
+    std::memcpy(buf, ir, nvar*sizeof(Real));
+    buf += nvar*sizeof(Real);
+  }
+  return buf;
+}
+
+//! read one cell from buf and return the pointer past it
+inline const char *UnpackCell(IntensityFormat fmt, const char *buf, int nvar, Real *ir) {
+  if (fmt == IntensityFormat::float32) {
+    for (int n=0; n<nvar; ++n) {
+      float v;
+      std::memcpy(&v, buf, sizeof(float));
+      ir[n] = static_cast<Real>(v);
+      buf += sizeof(float);
+    }
+  } else if (fmt == IntensityFormat::scaled16) {
+    std::int16_t q;
+    std::memcpy(&q, buf, sizeof(std::int16_t));
+    buf += sizeof(std::int16_t);
+    Real iscale = std::ldexp(static_cast<Real>(1.0), q - 15);
+    for (int n=0; n<nvar; ++n) {
+      std::memcpy(&q, buf, sizeof(std::int16_t));
+      ir[n] = static_cast<Real>(q)*iscale;
+      buf += sizeof(std::int16_t);
+    }
+  } else {
+    std::memcpy(ir, buf, nvar*sizeof(Real));
+    buf += nvar*sizeof(Real);
+  }
+  return buf;
+}
+
+} // namespace IntensityFormatting
+
+#endif // NR_RADIATION_INTENSITY_FORMAT_HPP_
@@ -21,9 +21,11 @@
 
 // C++ headers
 #include <cstdio>  // fopen and fwrite
+#include <cstring>  // memcpy
 #include <iostream>  // cout
 #include <sstream>  // msg
 #include <stdexcept> // runtime erro
+#include <string>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -133,6 +135,31 @@ NRRadiation::NRRadiation(MeshBlock *pmb, ParameterInput *pin):
 
   set_source_flag = pin->GetOrAddInteger("radiation","source_flag",1);
 
+  // intensities are rounded to this format once per stage, and sent to the neighbors
+  // and written to restart files in it
+  std::string storage = pin->GetOrAddString("radiation","intensity_storage","double");
+  if (storage == "double") {
+    ir_storage = IntensityFormat::real;
+  } else if (storage == "float") {
+    ir_storage = IntensityFormat::float32;
+  } else if (storage == "scaled16") {
+    ir_storage = IntensityFormat::scaled16;
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in radiation class" << std::endl
+        << "intensity_storage=" << storage << " is not supported; "
+        << "use double, float or scaled16" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (IM_RADIATION_ENABLED && ir_storage != IntensityFormat::real) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in radiation class" << std::endl
+        << "intensity_storage=" << storage
+        << " is only supported by the explicit radiation module" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  rad_bvar.format = ir_storage;
+
   // number of cells for three dimensions
   int nc1 = pmb->ncells1, nc2 = pmb->ncells2, nc3 = pmb->ncells3;
   // calculate noct based on dimension
@@ -421,3 +448,65 @@ void NRRadiation::EnrollFrequencyFunction(FrequencyFunc MyFrequencyFunction) {
 void NRRadiation::EnrollEmissionFunction(EmissionFunc MyEmissionSpec) {
   UserEmissionSpec = MyEmissionSpec;
 }
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void NRRadiation::QuantizeIntensity(AthenaArray<Real> &ir_in)
+//  \brief round the intensities of the active cells to the storage format
+
+void NRRadiation::QuantizeIntensity(AthenaArray<Real> &ir_in) {
+  if (ir_storage == IntensityFormat::real) return;
+  MeshBlock *pmb = pmy_block;
+  for (int k=pmb->ks; k<=pmb->ke; ++k) {
+    for (int j=pmb->js; j<=pmb->je; ++j) {
+      for (int i=pmb->is; i<=pmb->ie; ++i)
+        IntensityFormatting::QuantizeCell(ir_storage, &(ir_in(k,j,i,0)), n_fre_ang);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t NRRadiation::GetRestartSizeInBytes()
+//  \brief size of ir in restart files: Real, or float for the reduced-precision formats
+//  (scaled16 values are exactly representable as float)
+
+std::size_t NRRadiation::GetRestartSizeInBytes() {
+  if (ir_storage == IntensityFormat::real) return ir.GetSizeInBytes();
+  return ir.GetSize()*sizeof(float);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t NRRadiation::SaveRestartData(char *pdata)
+//  \brief write ir to the restart buffer and return the number of bytes written
+
+std::size_t NRRadiation::SaveRestartData(char *pdata) {
+  if (ir_storage == IntensityFormat::real) {
+    std::memcpy(pdata, ir.data(), ir.GetSizeInBytes());
+  } else {
+    const Real *pir = ir.data();
+    for (int n=0; n<ir.GetSize(); ++n) {
+      float v = static_cast<float>(pir[n]);
+      std::memcpy(pdata + n*sizeof(float), &v, sizeof(float));
+    }
+  }
+  return GetRestartSizeInBytes();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t NRRadiation::LoadRestartData(const char *pdata)
+//  \brief read ir from the restart buffer and return the number of bytes read
+
+std::size_t NRRadiation::LoadRestartData(const char *pdata) {
+  if (ir_storage == IntensityFormat::real) {
+    std::memcpy(ir.data(), pdata, ir.GetSizeInBytes());
+  } else {
+    Real *pir = ir.data();
+    for (int n=0; n<ir.GetSize(); ++n) {
+      float v;
+      std::memcpy(&v, pdata + n*sizeof(float), sizeof(float));
+      pir[n] = static_cast<Real>(v);
+    }
+  }
+  return GetRestartSizeInBytes();
+}
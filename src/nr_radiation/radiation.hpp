@@ -12,6 +12,7 @@
 // C headers
 
 // C++ headers
+#include <cstddef>     // size_t
 #include <cstdint>     // int64_t
 #include <functional>  // reference_wrapper
 #include <string>
@@ -22,6 +23,7 @@
 #include "../athena_arrays.hpp"
 #include "../bvals/cc/nr_radiation/bvals_rad.hpp"
 #include "../parameter_input.hpp"
+#include "intensity_format.hpp"
 
 class MeshBlock;
 class ParameterInput;
@@ -115,6 +117,8 @@ class NRRadiation {
   int rotate_theta; // flag to rotate the boundary
   int rotate_phi;
   int set_source_flag; // flag to add radiation source term or not
+  // precision of ir between the stages, in ghost-cell messages and in restart files
+  IntensityFormat ir_storage;
 
   // Functions
   // Function in problem generators to update opacity
@@ -128,6 +132,12 @@ class NRRadiation {
 
   void FrequencyGrid();
 
+  // reduced-precision storage of the intensities
+  void QuantizeIntensity(AthenaArray<Real> &ir_in);
+  std::size_t GetRestartSizeInBytes();
+  std::size_t SaveRestartData(char *pdata);
+  std::size_t LoadRestartData(const char *pdata);
+
   Real FitIntPlanckFunc(Real nu_t);
 
   Real IntPlanckFunc(Real nu_min, Real nu_max);
@@ -55,6 +55,34 @@ using H5Real = float;
 #define H5T_NATIVE_REAL H5T_NATIVE_FLOAT
 #endif
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn Real CoarsenedValue(const AthenaArray<Real> &data, int v, int k, int j, int i,
+//!                         int cf1, int cf2, int cf3, Coordinates *pco)
+//! \brief volume-weighted average of the cf3 x cf2 x cf1 cells starting at (k,j,i).
+//!
+//! For cf=2 this is the average of MeshRefinement::RestrictCellCenteredValues, which
+//! cannot be reused directly since it is limited to one level and needs the coarse
+//! Coordinates that only exist on multilevel meshes. In sliced or summed directions the
+//! data index differs from the cell index, but the cell volumes of all supported
+//! coordinate systems factorize, so the relative weights are still correct.
+
+Real CoarsenedValue(const AthenaArray<Real> &data, int v, int k, int j, int i,
+                    int cf1, int cf2, int cf3, Coordinates *pco) {
+  if (cf1*cf2*cf3 == 1) return data(v,k,j,i);
+  Real sum = 0.0, vol = 0.0;
+  for (int kk=k; kk<k+cf3; ++kk) {
+    for (int jj=j; jj<j+cf2; ++jj) {
+      for (int ii=i; ii<i+cf1; ++ii) {
+        const Real dv = pco->GetCellVolume(kk,jj,ii);
+        sum += dv*data(v,kk,jj,ii);
+        vol += dv;
+      }
+    }
+  }
+  return sum/vol;
+}
+} // namespace
 
 //----------------------------------------------------------------------------------------
 //! \fn void ATHDF5Output:::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
@@ -246,12 +274,23 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   ClearOutputData();
 
-  // count the number of active blocks if slicing
+  // count the number of active blocks if slicing or restricting to a region of interest
   if (output_params.output_slicex1 || output_params.output_slicex2
-      || output_params.output_slicex3) {
+      || output_params.output_slicex3 || output_params.output_roi) {
     int nb = 0, nba = 0;
     for (int b=0; b<pm->nblocal; ++b) {
       pmb = pm->my_blocks(b);
+      if (output_params.output_roi) {
+        const int level = pmb->loc.level - pm->root_level;
+        if (level < output_params.roi_level_min || level > output_params.roi_level_max
+            || pmb->block_size.x1min >= output_params.roi_xmax[0]
+            || pmb->block_size.x1max <= output_params.roi_xmin[0]
+            || pmb->block_size.x2min >= output_params.roi_xmax[1]
+            || pmb->block_size.x2max <= output_params.roi_xmin[1]
+            || pmb->block_size.x3min >= output_params.roi_xmax[2]
+            || pmb->block_size.x3max <= output_params.roi_xmin[2])
+          active_flags[nb] = false;
+      }
       if (output_params.output_slicex1) {
         if (pmb->block_size.x1min >  output_params.x1_slice
             || pmb->block_size.x1max <= output_params.x1_slice)
@@ -307,6 +346,25 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   if (output_params.output_sumx2) nx2=1;
   if (output_params.output_sumx3) nx3=1;
 
+  // downsampling factors in the directions that are neither sliced nor summed
+  int cf1 = 1, cf2 = 1, cf3 = 1;
+  if (output_params.coarsen_level > 0) {
+    const int cf = 1 << output_params.coarsen_level;
+    if (nx1 > 1) cf1 = cf;
+    if (nx2 > 1) cf2 = cf;
+    if (nx3 > 1) cf3 = cf;
+    if (nx1 % cf1 != 0 || nx2 % cf2 != 0 || nx3 % cf3 != 0) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [ATHDF5Output::WriteOutputFile]" << std::endl
+          << "MeshBlock size " << nx1 << "x" << nx2 << "x" << nx3
+          << " is not divisible by the coarsening factor " << cf << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    nx1 /= cf1;
+    nx2 /= cf2;
+    nx3 /= cf3;
+  }
+
   // Allocate contiguous buffers for data in memory
   levels_mesh = new int[num_blocks_local];
   locations_mesh = new std::int64_t[num_blocks_local * 3];
@@ -368,10 +426,12 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           x1v_mesh[nba*nx1] = pmb->pcoord->x1v((pmb->is + pmb->ie) / 2);
         }
       } else {
-        for (int i=out_is, index=0; i <= out_ie+1; ++i, ++index)
+        for (int i=out_is, index=0; i <= out_ie+1; i+=cf1, ++index)
           x1f_mesh[nba*(nx1+1) + index] = static_cast<H5Real>(pmb->pcoord->x1f(i));
-        for (int i=out_is, index=0; i <= out_ie; ++i, ++index)
-          x1v_mesh[nba*nx1 + index] = static_cast<H5Real>(pmb->pcoord->x1v(i));
+        for (int i=out_is, index=0; i <= out_ie; i+=cf1, ++index)
+          x1v_mesh[nba*nx1 + index] = static_cast<H5Real>((cf1 == 1) ?
+              pmb->pcoord->x1v(i) :
+              0.5*(pmb->pcoord->x1f(i) + pmb->pcoord->x1f(i+cf1)));
       }
       if (output_params.output_slicex2) {
         x2f_mesh[nba*(nx2+1)]
@@ -389,10 +449,12 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           x2v_mesh[nba*nx2] = pmb->pcoord->x2v((pmb->js + pmb->je) / 2);
         }
       } else {
-        for (int j=out_js, index=0; j <= out_je+1; ++j, ++index)
+        for (int j=out_js, index=0; j <= out_je+1; j+=cf2, ++index)
           x2f_mesh[nba*(nx2+1) + index] = static_cast<H5Real>(pmb->pcoord->x2f(j));
-        for (int j=out_js, index=0; j <= out_je; ++j, ++index)
-          x2v_mesh[nba*nx2 + index] = static_cast<H5Real>(pmb->pcoord->x2v(j));
+        for (int j=out_js, index=0; j <= out_je; j+=cf2, ++index)
+          x2v_mesh[nba*nx2 + index] = static_cast<H5Real>((cf2 == 1) ?
+              pmb->pcoord->x2v(j) :
+              0.5*(pmb->pcoord->x2f(j) + pmb->pcoord->x2f(j+cf2)));
       }
       if (output_params.output_slicex3) {
         x3f_mesh[nba*(nx3+1)]
@@ -410,10 +472,12 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           x3v_mesh[nba*nx3] = pmb->pcoord->x3v((pmb->ks + pmb->ke) / 2);
         }
       } else {
-        for (int k=out_ks, index=0; k <= out_ke+1; ++k, ++index)
+        for (int k=out_ks, index=0; k <= out_ke+1; k+=cf3, ++index)
           x3f_mesh[nba*(nx3+1) + index] = static_cast<H5Real>(pmb->pcoord->x3f(k));
-        for (int k=out_ks, index=0; k <= out_ke; ++k, ++index)
-          x3v_mesh[nba*nx3 + index] = static_cast<H5Real>(pmb->pcoord->x3v(k));
+        for (int k=out_ks, index=0; k <= out_ke; k+=cf3, ++index)
+          x3v_mesh[nba*nx3 + index] = static_cast<H5Real>((cf3 == 1) ?
+              pmb->pcoord->x3v(k) :
+              0.5*(pmb->pcoord->x3f(k) + pmb->pcoord->x3f(k+cf3)));
       }
 
       // store the data into the data_buffers
@@ -432,11 +496,12 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
           for (int v=0; v < nv; v++, ndv++) {
             int index = 0;
-            for (int k = out_ks; k <= out_ke; k++) {
-              for (int j = out_js; j <= out_je; j++) {
-                for (int i = out_is; i <= out_ie; i++, index++)
+            for (int k = out_ks; k <= out_ke; k += cf3) {
+              for (int j = out_js; j <= out_je; j += cf2) {
+                for (int i = out_is; i <= out_ie; i += cf1, index++)
                   data_buffers[n_dataset][(ndv*num_blocks_local+nba)*nx3*nx2*nx1+index]
-                      = pod->data(v,k,j,i);
+                      = CoarsenedValue(pod->data, v, k, j, i, cf1, cf2, cf3,
+                                       pmb->pcoord);
               }
             }
           }
@@ -451,11 +516,12 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           else if(pod->type == "TENSORS") nv=9;
           for (int v=0; v < nv; v++, ndv++) {
             int index = 0;
-            for (int k = out_ks; k <= out_ke; k++) {
-              for (int j = out_js; j <= out_je; j++) {
-                for (int i = out_is; i <= out_ie; i++, index++)
+            for (int k = out_ks; k <= out_ke; k += cf3) {
+              for (int j = out_js; j <= out_je; j += cf2) {
+                for (int i = out_is; i <= out_ie; i += cf1, index++)
                   data_buffers[0][(ndv*num_blocks_local+nba)*nx3*nx2*nx1+index]
-                      = pod->data(v,k,j,i);
+                      = CoarsenedValue(pod->data, v, k, j, i, cf1, cf2, cf3,
+                                       pmb->pcoord);
               }
             }
           }
@@ -562,9 +628,9 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   // Write root grid size
   int root_grid_size[3];
-  root_grid_size[0] = pm->mesh_size.nx1;
-  root_grid_size[1] = pm->mesh_size.nx2;
-  root_grid_size[2] = pm->mesh_size.nx3;
+  root_grid_size[0] = pm->mesh_size.nx1/cf1;
+  root_grid_size[1] = pm->mesh_size.nx2/cf2;
+  root_grid_size[2] = pm->mesh_size.nx3/cf3;
   attribute = H5Acreate2(file, "RootGridSize", H5T_STD_I32BE, dataspace_triple,
                          H5P_DEFAULT, H5P_DEFAULT);
   H5Awrite(attribute, H5T_NATIVE_INT, root_grid_size);
@@ -0,0 +1,213 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file histogram.cpp
+//! \brief histograms (PDFs) of one variable, or joint histograms of two variables,
+//!        reduced in parallel and written as a text table
+//!
+//! The quantity binned is the first OutputData node selected by variable (variable2),
+//! or its magnitude if that node is a vector. Each cell adds its volume (weight=volume)
+//! or mass (weight=mass) to the bin containing its value; bins are linear or, with
+//! log_bins (log_bins2), logarithmic between bin_min and bin_max (bin2_min, bin2_max).
+//! The fraction column is normalized by the total weight of the Mesh, so it does not
+//! sum to one if some cells fall outside the bins.
+
+// C headers
+
+// C++ headers
+#include <cmath>      // floor(), log10(), pow(), sqrt()
+#include <cstddef>    // size_t
+#include <cstdio>     // fopen(), fprintf(), snprintf()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // string
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "outputs.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void BinCells(OutputData *pdata, int is, int ie, int js, int je, int ks, int ke,
+//!                   int nbin, Real bmin, Real bmax, bool logb, std::vector<int> &ibin)
+//! \brief bin index of every active cell, -1 for values outside [bmin, bmax)
+
+void BinCells(OutputData *pdata, int is, int ie, int js, int je, int ks, int ke,
+              int nbin, Real bmin, Real bmax, bool logb, std::vector<int> &ibin) {
+  if (pdata == nullptr) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [HistogramOutput::WriteOutputFile]"
+        << std::endl << "No output variable selected for the histogram" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  const bool vector = (pdata->type == "VECTORS");
+  if (logb) {
+    bmin = std::log10(bmin);
+    bmax = std::log10(bmax);
+  }
+  const Real idb = nbin/(bmax - bmin);
+  int n = 0;
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie; ++i, ++n) {
+        Real q = pdata->data(0,k,j,i);
+        if (vector)
+          q = std::sqrt(SQR(q) + SQR(pdata->data(1,k,j,i)) + SQR(pdata->data(2,k,j,i)));
+        if (logb) q = (q > 0.0) ? std::log10(q) : bmin - 1.0;
+        const int b = static_cast<int>(std::floor((q - bmin)*idb));
+        ibin[n] = (b >= 0 && b < nbin) ? b : -1;
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real BinEdge(int n, int nbin, Real bmin, Real bmax, bool logb)
+//! \brief lower edge of bin n
+
+Real BinEdge(int n, int nbin, Real bmin, Real bmax, bool logb) {
+  if (logb)
+    return bmin*std::pow(bmax/bmin, static_cast<Real>(n)/nbin);
+  return bmin + n*(bmax - bmin)/nbin;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void HistogramOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//! \brief Bins the cells of all MeshBlocks, reduces the histogram over all ranks and
+//!        writes it from rank 0.
+
+void HistogramOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+  const bool joint = !output_params.variable2.empty();
+  const bool use_mass = (output_params.reduce_weight == "mass");
+  const int nb1 = output_params.nbin;
+  const int nb2 = joint ? output_params.nbin2 : 1;
+  // weight per bin followed by the total weight of the Mesh
+  std::vector<Real> hist(nb1*nb2 + 1, 0.0);
+  std::vector<int> ibin1, ibin2;
+
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    Coordinates *pco = pmb->pcoord;
+    out_is = pmb->is; out_ie = pmb->ie;
+    out_js = pmb->js; out_je = pmb->je;
+    out_ks = pmb->ks; out_ke = pmb->ke;
+    const std::size_t ncells = static_cast<std::size_t>(out_ie - out_is + 1)
+                               *(out_je - out_js + 1)*(out_ke - out_ks + 1);
+    ibin1.resize(ncells);
+    ibin2.assign(ncells, 0);
+
+    LoadOutputData(pmb);
+    BinCells(pfirst_data_, out_is, out_ie, out_js, out_je, out_ks, out_ke, nb1,
+             output_params.bin_min, output_params.bin_max, output_params.log_bins,
+             ibin1);
+    ClearOutputData();
+    if (joint) {
+      LoadOutputData(pmb, output_params.variable2);
+      BinCells(pfirst_data_, out_is, out_ie, out_js, out_je, out_ks, out_ke, nb2,
+               output_params.bin2_min, output_params.bin2_max, output_params.log_bins2,
+               ibin2);
+      ClearOutputData();
+    }
+
+    int n = 0;
+    for (int k=out_ks; k<=out_ke; ++k) {
+      for (int j=out_js; j<=out_je; ++j) {
+        for (int i=out_is; i<=out_ie; ++i, ++n) {
+          Real w = pco->GetCellVolume(k,j,i);
+          if (use_mass) w *= pmb->phydro->w(IDN,k,j,i);
+          hist[nb1*nb2] += w;
+          if (ibin1[n] >= 0 && ibin2[n] >= 0)
+            hist[ibin2[n]*nb1 + ibin1[n]] += w;
+        }
+      }
+    }
+  }
+
+#ifdef MPI_PARALLEL
+  if (Globals::my_rank == 0)
+    MPI_Reduce(MPI_IN_PLACE, hist.data(), nb1*nb2+1, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+  else
+    MPI_Reduce(hist.data(), nullptr, nb1*nb2+1, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+#endif
+
+  // only the master rank writes the file
+  // create filename: "file_basename"."file_id".XXXXX.hist
+  if (Globals::my_rank == 0) {
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", output_params.file_number);
+    fname.assign(output_params.file_basename);
+    fname.append(".");
+    fname.append(output_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".hist");
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [HistogramOutput::WriteOutputFile]"
+          << std::endl << "Output file '" << fname << "' could not be opened"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    const char *v1 = output_params.variable.c_str();
+    const char *v2 = output_params.variable2.c_str();
+    std::fprintf(pfile, "# Athena++ histogram at time=%e  cycle=%d  weight=%s\n",
+                 pm->time, pm->ncycle, output_params.reduce_weight.c_str());
+    if (joint)
+      std::fprintf(pfile, "# [1]=%s_lo [2]=%s_hi [3]=%s_lo [4]=%s_hi [5]=weight "
+                   "[6]=fraction\n", v1, v1, v2, v2);
+    else
+      std::fprintf(pfile, "# [1]=%s_lo [2]=%s_hi [3]=weight [4]=fraction\n", v1, v1);
+    const Real total = hist[nb1*nb2];
+    for (int n2=0; n2<nb2; ++n2) {
+      for (int n1=0; n1<nb1; ++n1) {
+        std::fprintf(pfile, output_params.data_format.c_str(),
+                     BinEdge(n1, nb1, output_params.bin_min, output_params.bin_max,
+                             output_params.log_bins));
+        std::fprintf(pfile, output_params.data_format.c_str(),
+                     BinEdge(n1+1, nb1, output_params.bin_min, output_params.bin_max,
+                             output_params.log_bins));
+        if (joint) {
+          std::fprintf(pfile, output_params.data_format.c_str(),
+                       BinEdge(n2, nb2, output_params.bin2_min, output_params.bin2_max,
+                               output_params.log_bins2));
+          std::fprintf(pfile, output_params.data_format.c_str(),
+                       BinEdge(n2+1, nb2, output_params.bin2_min,
+                               output_params.bin2_max, output_params.log_bins2));
+        }
+        const Real w = hist[n2*nb1 + n1];
+        std::fprintf(pfile, output_params.data_format.c_str(), w);
+        std::fprintf(pfile, output_params.data_format.c_str(),
+                     total > 0.0 ? w/total : 0.0);
+        std::fprintf(pfile, "\n");
+      }
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+  return;
+}
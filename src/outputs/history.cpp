@@ -29,6 +29,7 @@
 #include "../field/field.hpp"
 #include "../globals.hpp"
 #include "../gravity/gravity.hpp"
+#include "../gravity/gravity_cadence.hpp"
 #include "../hydro/hydro.hpp"
 #include "../mesh/mesh.hpp"
 #include "../nr_radiation/radiation.hpp"
@@ -56,6 +57,9 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   if (CHEMRADIATION_ENABLED) {
     nhistory_vars += pmb->pchemrad->nfreq;
   }
+  // number of Poisson solves and extrapolation error of the gravity solve cadence control
+  const int igcad = nhistory_vars;
+  if (pm->pgcad != nullptr) nhistory_vars += 2;
   const int nhistory_output = nhistory_vars + pm->nuser_history_output_;
   std::unique_ptr<Real[]> hst_data(new Real[nhistory_output]);
   // initialize built-in variable sums to 0.0
@@ -352,6 +356,11 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   }
 #endif
 
+  if (pm->pgcad != nullptr) { // identical on all ranks, not summed over MeshBlocks
+    hst_data[igcad] = static_cast<Real>(pm->pgcad->nsolve);
+    hst_data[igcad+1] = pm->pgcad->error;
+  }
+
   // only the master rank writes the file
   // create filename: "file_basename" + ".hst".  There is no file number.
   if (Globals::my_rank == 0) {
@@ -440,6 +449,10 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
         std::fprintf(pfile,"[%d]=Fc2    ", iout++);
         std::fprintf(pfile,"[%d]=Fc3    ", iout++);
       }
+      if (pm->pgcad != nullptr) {
+        std::fprintf(pfile,"[%d]=grav-nsolve    ", iout++);
+        std::fprintf(pfile,"[%d]=grav-err    ", iout++);
+      }
       for (int n=0; n<pm->nuser_history_output_; n++)
         std::fprintf(pfile,"[%d]=%-7s ", iout++,
                      pm->user_history_output_names_[n].c_str());
@@ -20,7 +20,7 @@
 //! Required parameters that must be specified in an <output[n]> block are:
 //!   - variable     = cons,prim,D,d,E,e,m,m1,m2,m3,v,v1=vx,v2=vy,v3=vz,p,
 //!                    bcc,bcc1,bcc2,bcc3,b,b1,b2,b3,phi,uov
-//!   - file_type    = rst,tab,vtk,hst,hdf5
+//!   - file_type    = rst,tab,vtk,hst,hdf5,proj,hist,prof,spec
 //!   - dt           = problem time between outputs
 //!
 //! EXAMPLE of an <output[n]> block for a VTK dump:
@@ -33,6 +33,19 @@
 //!     x2_slice    = 0.0       # slice in x2
 //!     x3_slice    = 0.0       # slice in x3
 //!
+//! Outputs with file_type = proj (requires HDF5 and Cartesian coordinates) additionally
+//! accept axis (1,2,3; default the last direction of the Mesh with more than one cell),
+//! weight (column,volume,mass,max), nx_image and ny_image, and a slice in the
+//! direction of axis; see projection.cpp.
+//!
+//! HDF5 outputs accept coarsen = n to average every MeshBlock down by 2^n, and a region
+//! of interest (roi_x1min ... roi_x3max, roi_level_min, roi_level_max) that restricts
+//! the output to the MeshBlocks overlapping the box within the range of levels.
+//!
+//! In-situ reductions are written as small text files: hist (histograms/PDFs of
+//! variable, optionally joint with variable2; see histogram.cpp), prof (radial profiles
+//! about x_center,y_center,z_center; see profile.cpp) and spec (power spectra of
+//! uniform meshes, requires FFT; see spectrum.cpp). All accept weight (volume,mass).
 //!
 //! Each <output[n]> block will result in a new node being created in a linked list of
 //! OutputType stored in the Outputs class.  During a simulation, outputs are made when
@@ -77,6 +90,8 @@
 // C headers
 
 // C++ headers
+#include <algorithm>  // max
+#include <cmath>      // ceil, sqrt
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>    // strcmp
@@ -265,6 +280,37 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
         } else if (op.file_type.compare("ath5") == 0
                    || op.file_type.compare("hdf5") == 0) {
 #ifdef HDF5OUTPUT
+          // optional downsampling of every MeshBlock by 2^coarsen
+          op.coarsen_level = pin->GetOrAddInteger(op.block_name, "coarsen", 0);
+          if (op.coarsen_level < 0 || (op.coarsen_level > 0
+                                       && op.include_ghost_zones)) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "coarsen=" << op.coarsen_level << " in output block '"
+                << op.block_name << "' must be >= 0 and cannot be combined with "
+                << "ghost_zones" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          // optional region of interest: bounding box and range of refinement levels
+          const char *roi_min_names[3] = {"roi_x1min", "roi_x2min", "roi_x3min"};
+          const char *roi_max_names[3] = {"roi_x1max", "roi_x2max", "roi_x3max"};
+          const Real mesh_min[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min,
+                                    pm->mesh_size.x3min};
+          const Real mesh_max[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max,
+                                    pm->mesh_size.x3max};
+          for (int d=0; d<3; ++d) {
+            if (pin->DoesParameterExist(op.block_name, roi_min_names[d])
+                || pin->DoesParameterExist(op.block_name, roi_max_names[d]))
+              op.output_roi = true;
+            op.roi_xmin[d] = pin->GetOrAddReal(op.block_name, roi_min_names[d],
+                                               mesh_min[d]);
+            op.roi_xmax[d] = pin->GetOrAddReal(op.block_name, roi_max_names[d],
+                                               mesh_max[d]);
+          }
+          if (pin->DoesParameterExist(op.block_name, "roi_level_min")
+              || pin->DoesParameterExist(op.block_name, "roi_level_max"))
+            op.output_roi = true;
+          op.roi_level_min = pin->GetOrAddInteger(op.block_name, "roi_level_min", 0);
+          op.roi_level_max = pin->GetOrAddInteger(op.block_name, "roi_level_max", 63);
           pnew_type = new ATHDF5Output(op);
 #else
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
@@ -272,6 +318,103 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
               << "is requested in output block '" << op.block_name << "'" << std::endl;
           ATHENA_ERROR(msg);
 #endif
+        } else if (op.file_type.compare("proj") == 0) {
+#ifdef HDF5OUTPUT
+          if (std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Projection output in block '" << op.block_name
+                << "' requires Cartesian coordinates" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          op.proj_axis = pin->GetOrAddInteger(op.block_name, "axis",
+                                              pm->f3 ? 3 : (pm->f2 ? 2 : 1));
+          op.proj_weight = pin->GetOrAddString(op.block_name, "weight", "column");
+          if (op.proj_axis < 1 || op.proj_axis > 3 || (op.proj_axis == 3 && !pm->f3)
+              || (op.proj_axis == 2 && !pm->f2)) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Projection axis=" << op.proj_axis << " in output block '"
+                << op.block_name << "' is not a direction of the Mesh" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (op.proj_weight != "column" && op.proj_weight != "volume"
+              && op.proj_weight != "mass" && op.proj_weight != "max") {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Unrecognized weight = '" << op.proj_weight << "' in output block '"
+                << op.block_name << "'; choose from {column, volume, mass, max}"
+                << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          // image axes are the two remaining directions in cyclic order
+          int nxa[3] = {pm->mesh_size.nx1, pm->mesh_size.nx2, pm->mesh_size.nx3};
+          op.proj_nx = pin->GetOrAddInteger(op.block_name, "nx_image",
+                                            nxa[op.proj_axis%3]);
+          op.proj_ny = pin->GetOrAddInteger(op.block_name, "ny_image",
+                                            nxa[(op.proj_axis+1)%3]);
+          pnew_type = new ProjectionOutput(op);
+#else
+          msg << "### FATAL ERROR in Outputs constructor" << std::endl
+              << "Executable not configured for HDF5 outputs, but projection output "
+              << "is requested in output block '" << op.block_name << "'" << std::endl;
+          ATHENA_ERROR(msg);
+#endif
+        } else if (op.file_type.compare("hist") == 0
+                   || op.file_type.compare("prof") == 0
+                   || op.file_type.compare("spec") == 0) {
+          op.reduce_weight = pin->GetOrAddString(op.block_name, "weight", "volume");
+          if (op.reduce_weight != "volume" && op.reduce_weight != "mass") {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Unrecognized weight = '" << op.reduce_weight << "' in output block '"
+                << op.block_name << "'; choose from {volume, mass}" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (op.file_type.compare("hist") == 0) {
+            op.nbin = pin->GetOrAddInteger(op.block_name, "nbin", 100);
+            op.bin_min = pin->GetReal(op.block_name, "bin_min");
+            op.bin_max = pin->GetReal(op.block_name, "bin_max");
+            op.log_bins = pin->GetOrAddBoolean(op.block_name, "log_bins", false);
+            op.variable2 = pin->GetOrAddString(op.block_name, "variable2", "");
+            if (!op.variable2.empty()) {
+              op.nbin2 = pin->GetOrAddInteger(op.block_name, "nbin2", op.nbin);
+              op.bin2_min = pin->GetReal(op.block_name, "bin2_min");
+              op.bin2_max = pin->GetReal(op.block_name, "bin2_max");
+              op.log_bins2 = pin->GetOrAddBoolean(op.block_name, "log_bins2", false);
+            }
+            pnew_type = new HistogramOutput(op);
+          } else if (op.file_type.compare("prof") == 0) {
+            op.nbin = pin->GetOrAddInteger(op.block_name, "nbin", 100);
+            op.bin_min = pin->GetOrAddReal(op.block_name, "rmin", 0.0);
+            op.bin_max = pin->GetReal(op.block_name, "rmax");
+            op.log_bins = pin->GetOrAddBoolean(op.block_name, "log_bins", false);
+            op.x_center = pin->GetOrAddReal(op.block_name, "x_center", 0.0);
+            op.y_center = pin->GetOrAddReal(op.block_name, "y_center", 0.0);
+            op.z_center = pin->GetOrAddReal(op.block_name, "z_center", 0.0);
+            pnew_type = new ProfileOutput(op);
+          } else {
+#ifdef FFT
+            // by default the shells reach the corner of the k-space cube, so that the
+            // spectrum sums to the mean square of the data
+            int nxmax = std::max(pm->mesh_size.nx1,
+                                 std::max(pm->mesh_size.nx2, pm->mesh_size.nx3));
+            op.nbin = pin->GetOrAddInteger(op.block_name, "nbin", static_cast<int>(
+                std::ceil(0.5*std::sqrt(static_cast<Real>(pm->ndim))*nxmax)) + 1);
+            pnew_type = new SpectrumOutput(op);
+#else
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Executable not configured for FFT, but spectrum output "
+                << "is requested in output block '" << op.block_name << "'"
+                << std::endl;
+            ATHENA_ERROR(msg);
+#endif
+          }
+          if (op.nbin < 1 || (!op.variable2.empty() && op.nbin2 < 1)
+              || (op.file_type.compare("spec") != 0 && op.bin_max <= op.bin_min)
+              || (!op.variable2.empty() && op.bin2_max <= op.bin2_min)
+              || (op.log_bins && op.bin_min <= 0.0)
+              || (op.log_bins2 && op.bin2_min <= 0.0)) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Invalid bins in output block '" << op.block_name << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
         } else {
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
               << "Unrecognized file format = '" << op.file_type
@@ -345,9 +488,19 @@ Outputs::~Outputs() {
 
 //----------------------------------------------------------------------------------------
 //! \fn void OutputType::LoadOutputData(MeshBlock *pmb)
-//! \brief Create doubly linked list of OutputData's containing requested variables
+//! \brief Create doubly linked list of OutputData's containing the variables of the
+//!        <output> block
 
 void OutputType::LoadOutputData(MeshBlock *pmb) {
+  LoadOutputData(pmb, output_params.variable);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void OutputType::LoadOutputData(MeshBlock *pmb, const std::string &variable)
+//! \brief Create doubly linked list of OutputData's containing requested variables
+
+void OutputType::LoadOutputData(MeshBlock *pmb, const std::string &variable) {
   Hydro *phyd = pmb->phydro;
   Field *pfld = pmb->pfield;
   NRRadiation *prad=pmb->pnrrad;
@@ -362,8 +515,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   // NEW_OUTPUT_TYPES:
 
   // (lab-frame) density
-  if (ContainVariable(output_params.variable, "D") ||
-      ContainVariable(output_params.variable, "cons")) {
+  if (ContainVariable(variable, "D") ||
+      ContainVariable(variable, "cons")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "dens";
@@ -373,8 +526,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   // (rest-frame) density
-  if (ContainVariable(output_params.variable, "d") ||
-      ContainVariable(output_params.variable, "prim")) {
+  if (ContainVariable(variable, "d") ||
+      ContainVariable(variable, "prim")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "rho";
@@ -385,8 +538,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
 
   // total energy
   if (NON_BAROTROPIC_EOS) {
-    if (ContainVariable(output_params.variable, "E") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "E") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "Etot";
@@ -402,8 +555,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     }
 
     // pressure
-    if (ContainVariable(output_params.variable, "p") ||
-        ContainVariable(output_params.variable, "prim")) {
+    if (ContainVariable(variable, "p") ||
+        ContainVariable(variable, "prim")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "press";
@@ -414,8 +567,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   // momentum vector
-  if (ContainVariable(output_params.variable, "m") ||
-      ContainVariable(output_params.variable, "cons")) {
+  if (ContainVariable(variable, "m") ||
+      ContainVariable(variable, "cons")) {
     pod = new OutputData;
     pod->type = "VECTORS";
     pod->name = "mom";
@@ -448,7 +601,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   // each component of momentum
-  if (ContainVariable(output_params.variable, "m1")) {
+  if (ContainVariable(variable, "m1")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "mom1";
@@ -456,7 +609,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     AppendOutputDataNode(pod);
     num_vars_++;
   }
-  if (ContainVariable(output_params.variable, "m2")) {
+  if (ContainVariable(variable, "m2")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "mom2";
@@ -471,7 +624,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     AppendOutputDataNode(pod);
     num_vars_++;
   }
-  if (ContainVariable(output_params.variable, "m3")) {
+  if (ContainVariable(variable, "m3")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "mom3";
@@ -488,8 +641,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   // velocity vector
-  if (ContainVariable(output_params.variable, "v") ||
-      ContainVariable(output_params.variable, "prim")) {
+  if (ContainVariable(variable, "v") ||
+      ContainVariable(variable, "prim")) {
     pod = new OutputData;
     pod->type = "VECTORS";
     pod->name = "vel";
@@ -522,8 +675,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   // each component of velocity
-  if (ContainVariable(output_params.variable, "vx") ||
-      ContainVariable(output_params.variable, "v1")) {
+  if (ContainVariable(variable, "vx") ||
+      ContainVariable(variable, "v1")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "vel1";
@@ -531,8 +684,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     AppendOutputDataNode(pod);
     num_vars_++;
   }
-  if (ContainVariable(output_params.variable, "vy") ||
-      ContainVariable(output_params.variable, "v2")) {
+  if (ContainVariable(variable, "vy") ||
+      ContainVariable(variable, "v2")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "vel2";
@@ -547,8 +700,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     AppendOutputDataNode(pod);
     num_vars_++;
   }
-  if (ContainVariable(output_params.variable, "vz") ||
-      ContainVariable(output_params.variable, "v3")) {
+  if (ContainVariable(variable, "vz") ||
+      ContainVariable(variable, "v3")) {
     pod = new OutputData;
     pod->type = "SCALARS";
     pod->name = "vel3";
@@ -565,9 +718,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   if (SELF_GRAVITY_ENABLED) {
-    if (ContainVariable(output_params.variable, "phi") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "phi") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "phi";
@@ -604,8 +757,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         scalar_name_cons = root_name_cons + std::to_string(n);
         scalar_name_prim = root_name_prim + std::to_string(n);
       }
-      if (ContainVariable(output_params.variable, scalar_name_cons) ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, scalar_name_cons) ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = scalar_name_cons;
@@ -613,8 +766,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         AppendOutputDataNode(pod);
         num_vars_++;
       }
-      if (ContainVariable(output_params.variable, scalar_name_prim) ||
-          ContainVariable(output_params.variable, "prim")) {
+      if (ContainVariable(variable, scalar_name_prim) ||
+          ContainVariable(variable, "prim")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = scalar_name_prim;
@@ -626,9 +779,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   }
 
   if (CHEMRADIATION_ENABLED) {
-    if (ContainVariable(output_params.variable, "rad") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "rad") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       std::string name_ir_avg = "ir_avg";
       for (int i=0; i<pchemrad->nfreq; i++) {
         std::string vi = name_ir_avg + std::to_string(i);
@@ -713,9 +866,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) {
     if (prad->nfreq == 1) {
       // (lab-frame) radiation energy density
-      if (ContainVariable(output_params.variable, "Er") ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, "Er") ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Er";
@@ -725,9 +878,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       }
 
       // comoving frame fram radiation flux vector
-      if (ContainVariable(output_params.variable, "Fr") ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, "Fr") ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "VECTORS";
         pod->name = "Fr";
@@ -750,8 +903,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
 
 
       // each component of radiation flux
-      if (ContainVariable(output_params.variable, "Frx") ||
-          ContainVariable(output_params.variable, "Fr1")) {
+      if (ContainVariable(variable, "Frx") ||
+          ContainVariable(variable, "Fr1")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr1";
@@ -760,8 +913,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_++;
       }
 
-      if (ContainVariable(output_params.variable, "Fry") ||
-          ContainVariable(output_params.variable, "Fr2")) {
+      if (ContainVariable(variable, "Fry") ||
+          ContainVariable(variable, "Fr2")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr2";
@@ -770,8 +923,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_++;
       }
 
-      if (ContainVariable(output_params.variable, "Frz") ||
-          ContainVariable(output_params.variable, "Fr3")) {
+      if (ContainVariable(variable, "Frz") ||
+          ContainVariable(variable, "Fr3")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr3";
@@ -781,9 +934,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       }
 
       // lab frame radiation pressure
-      if (ContainVariable(output_params.variable, "Pr") ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, "Pr") ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "TENSORS";
         pod->name = "Pr";
@@ -795,9 +948,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
 
 
       // (comoving-frame) radiation energy density
-      if (ContainVariable(output_params.variable, "Er0") ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, "Er0") ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Er0";
@@ -809,9 +962,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
 
 
       // comoving frame fram radiation flux vector
-      if (ContainVariable(output_params.variable, "Fr0") ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, "Fr0") ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "VECTORS";
         pod->name = "Fr0";
@@ -833,8 +986,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         }
       }
 
-      if (ContainVariable(output_params.variable, "Fr0x") ||
-          ContainVariable(output_params.variable, "Fr01")) {
+      if (ContainVariable(variable, "Fr0x") ||
+          ContainVariable(variable, "Fr01")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr01";
@@ -843,8 +996,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_++;
       }
 
-      if (ContainVariable(output_params.variable, "Fr0y") ||
-          ContainVariable(output_params.variable, "Fr02")) {
+      if (ContainVariable(variable, "Fr0y") ||
+          ContainVariable(variable, "Fr02")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr02";
@@ -853,8 +1006,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_++;
       }
 
-      if (ContainVariable(output_params.variable, "Fr0z") ||
-          ContainVariable(output_params.variable, "Fr03")) {
+      if (ContainVariable(variable, "Fr0z") ||
+          ContainVariable(variable, "Fr03")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = "Fr03";
@@ -880,9 +1033,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         std::string fr0z_ifr = "Fr0z_" + std::to_string(ifr)+"_";
 
 
-        if (ContainVariable(output_params.variable, er_ifr) ||
-            ContainVariable(output_params.variable, "prim") ||
-            ContainVariable(output_params.variable, "cons")) {
+        if (ContainVariable(variable, er_ifr) ||
+            ContainVariable(variable, "prim") ||
+            ContainVariable(variable, "cons")) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = er_ifr;
@@ -892,9 +1045,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         }
 
         // comoving frame fram radiation flux vector
-        if (ContainVariable(output_params.variable, fr_ifr) ||
-            ContainVariable(output_params.variable, "prim") ||
-            ContainVariable(output_params.variable, "cons")) {
+        if (ContainVariable(variable, fr_ifr) ||
+            ContainVariable(variable, "prim") ||
+            ContainVariable(variable, "cons")) {
           pod = new OutputData;
           pod->type = "VECTORS";
           pod->name = fr_ifr;
@@ -917,7 +1070,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         }
 
 
-        if (ContainVariable(output_params.variable, frx_ifr)) {
+        if (ContainVariable(variable, frx_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = frx_ifr;
@@ -926,7 +1079,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, fry_ifr)) {
+        if (ContainVariable(variable, fry_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = fry_ifr;
@@ -935,7 +1088,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, frz_ifr)) {
+        if (ContainVariable(variable, frz_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = frz_ifr;
@@ -944,9 +1097,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, pr_ifr) ||
-            ContainVariable(output_params.variable, "prim") ||
-            ContainVariable(output_params.variable, "cons")) {
+        if (ContainVariable(variable, pr_ifr) ||
+            ContainVariable(variable, "prim") ||
+            ContainVariable(variable, "cons")) {
           pod = new OutputData;
           pod->type = "TENSORS";
           pod->name = pr_ifr;
@@ -955,9 +1108,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_+=9;
         }
 
-        if (ContainVariable(output_params.variable, er0_ifr) ||
-            ContainVariable(output_params.variable, "prim") ||
-            ContainVariable(output_params.variable, "cons")) {
+        if (ContainVariable(variable, er0_ifr) ||
+            ContainVariable(variable, "prim") ||
+            ContainVariable(variable, "cons")) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = er0_ifr;
@@ -966,9 +1119,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, fr0_ifr) ||
-            ContainVariable(output_params.variable, "prim") ||
-            ContainVariable(output_params.variable, "cons")) {
+        if (ContainVariable(variable, fr0_ifr) ||
+            ContainVariable(variable, "prim") ||
+            ContainVariable(variable, "cons")) {
           pod = new OutputData;
           pod->type = "VECTORS";
           pod->name = fr0_ifr;
@@ -991,7 +1144,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         }
 
 
-        if (ContainVariable(output_params.variable, fr0x_ifr)) {
+        if (ContainVariable(variable, fr0x_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = fr0x_ifr;
@@ -1000,7 +1153,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, fr0y_ifr)) {
+        if (ContainVariable(variable, fr0y_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = fr0y_ifr;
@@ -1009,7 +1162,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
           num_vars_++;
         }
 
-        if (ContainVariable(output_params.variable, fr0z_ifr)) {
+        if (ContainVariable(variable, fr0z_ifr)) {
           pod = new OutputData;
           pod->type = "SCALARS";
           pod->name = fr0z_ifr;
@@ -1024,9 +1177,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       std::string sigmaa_ifr = "Sigma_a_" + std::to_string(ifr);
       std::string sigmas_ifr = "Sigma_s_" + std::to_string(ifr);
       std::string sigmap_ifr = "Sigma_p_" + std::to_string(ifr);
-      if (ContainVariable(output_params.variable, sigmas_ifr) ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, sigmas_ifr) ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = sigmas_ifr;
@@ -1035,9 +1188,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_ += 1;
       }
 
-      if (ContainVariable(output_params.variable, sigmaa_ifr) ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, sigmaa_ifr) ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = sigmaa_ifr;
@@ -1046,9 +1199,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
         num_vars_ += 1;
       }
 
-      if (ContainVariable(output_params.variable, sigmap_ifr) ||
-          ContainVariable(output_params.variable, "prim") ||
-          ContainVariable(output_params.variable, "cons")) {
+      if (ContainVariable(variable, sigmap_ifr) ||
+          ContainVariable(variable, "prim") ||
+          ContainVariable(variable, "cons")) {
         pod = new OutputData;
         pod->type = "SCALARS";
         pod->name = sigmap_ifr;
@@ -1060,9 +1213,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   } // End (RADIATION_ENABLED)
 
   if (CR_ENABLED) {
-    if (ContainVariable(output_params.variable, "Ec") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "Ec") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "Ec";
@@ -1072,9 +1225,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     }
 
     // comoving frame fram radiation flux vector
-    if (ContainVariable(output_params.variable, "Fc") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "Fc") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "VECTORS";
       pod->name = "Fc";
@@ -1095,9 +1248,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       }
     }
 
-    if (ContainVariable(output_params.variable, "Sigma_diff") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "Sigma_diff") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "VECTORS";
       pod->name = "Sigma_diff";
@@ -1106,9 +1259,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       num_vars_+=3;
     }
 
-    if (ContainVariable(output_params.variable, "Sigma_adv") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "Sigma_adv") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "VECTORS";
       pod->name = "Sigma_adv";
@@ -1118,9 +1271,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     }
 
     // The streaming velocity
-    if (ContainVariable(output_params.variable, "Vc") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "Vc") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "VECTORS";
       pod->name = "Vc";
@@ -1147,9 +1300,9 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   // nodes, and it must come after those nodes in the linked list
   if (MAGNETIC_FIELDS_ENABLED) {
     // vector of cell-centered magnetic field
-    if (ContainVariable(output_params.variable, "bcc") ||
-        ContainVariable(output_params.variable, "prim") ||
-        ContainVariable(output_params.variable, "cons")) {
+    if (ContainVariable(variable, "bcc") ||
+        ContainVariable(variable, "prim") ||
+        ContainVariable(variable, "cons")) {
       pod = new OutputData;
       pod->type = "VECTORS";
       pod->name = "Bcc";
@@ -1171,7 +1324,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     }
 
     // each component of cell-centered magnetic field
-    if (ContainVariable(output_params.variable, "bcc1")) {
+    if (ContainVariable(variable, "bcc1")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "Bcc1";
@@ -1179,7 +1332,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       AppendOutputDataNode(pod);
       num_vars_++;
     }
-    if (ContainVariable(output_params.variable, "bcc2")) {
+    if (ContainVariable(variable, "bcc2")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "Bcc2";
@@ -1187,7 +1340,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       AppendOutputDataNode(pod);
       num_vars_++;
     }
-    if (ContainVariable(output_params.variable, "bcc3")) {
+    if (ContainVariable(variable, "bcc3")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "Bcc3";
@@ -1196,8 +1349,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       num_vars_++;
     }
     // each component of face-centered magnetic field
-    if (ContainVariable(output_params.variable, "b1")
-        || ContainVariable(output_params.variable, "b")) {
+    if (ContainVariable(variable, "b1")
+        || ContainVariable(variable, "b")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "B1";
@@ -1205,8 +1358,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       AppendOutputDataNode(pod);
       num_vars_++;
     }
-    if (ContainVariable(output_params.variable, "b2")
-        || ContainVariable(output_params.variable, "b")) {
+    if (ContainVariable(variable, "b2")
+        || ContainVariable(variable, "b")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "B2";
@@ -1214,8 +1367,8 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
       AppendOutputDataNode(pod);
       num_vars_++;
     }
-    if (ContainVariable(output_params.variable, "b3")
-        || ContainVariable(output_params.variable, "b")) {
+    if (ContainVariable(variable, "b3")
+        || ContainVariable(variable, "b")) {
       pod = new OutputData;
       pod->type = "SCALARS";
       pod->name = "B3";
@@ -1225,17 +1378,17 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
     }
   } // endif (MAGNETIC_FIELDS_ENABLED)
 
-  bool output_all_uov = ContainVariable(output_params.variable, "uov")
-                        || ContainVariable(output_params.variable, "user_out_var");
+  bool output_all_uov = ContainVariable(variable, "uov")
+                        || ContainVariable(variable, "user_out_var");
   for (int n = 0; n < pmb->nuser_out_var; ++n) {
     char abbr_name[16], full_name[32];
     std::snprintf(abbr_name, sizeof(abbr_name), "uov%d", n);
     std::snprintf(full_name, sizeof(full_name), "user_out_var%d", n);
     if (output_all_uov ||
         (pmb->user_out_var_names_[n].length() != 0
-         && ContainVariable(output_params.variable, pmb->user_out_var_names_[n]))
-        || ContainVariable(output_params.variable, abbr_name)
-        || ContainVariable(output_params.variable, full_name)) {
+         && ContainVariable(variable, pmb->user_out_var_names_[n]))
+        || ContainVariable(variable, abbr_name)
+        || ContainVariable(variable, full_name)) {
       pod = new OutputData;
       pod->type = "SCALARS";
       if (pmb->user_out_var_names_[n].length() != 0) {
@@ -1253,7 +1406,7 @@ void OutputType::LoadOutputData(MeshBlock *pmb) {
   if (num_vars_ == 0) {
     std::stringstream msg;
     msg << "### FATAL ERROR in function [OutputType::LoadOutputData]" << std::endl
-        << "Output variable '" << output_params.variable << "' not implemented"
+        << "Output variable '" << variable << "' not implemented"
         << std::endl;
     ATHENA_ERROR(msg);
   }
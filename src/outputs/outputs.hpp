@@ -13,6 +13,7 @@
 // C++ headers
 #include <cstdio>  // std::size_t
 #include <string>
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -26,6 +27,7 @@
 class Mesh;
 class ParameterInput;
 class Coordinates;
+class FFTDriver;
 
 //----------------------------------------------------------------------------------------
 //! \struct OutputParameters
@@ -48,12 +50,32 @@ struct OutputParameters {
   bool orbital_system_output;
   int islice, jslice, kslice;
   Real x1_slice, x2_slice, x3_slice;
+  // global projection/slice images (file_type = proj)
+  int proj_axis, proj_nx, proj_ny;
+  std::string proj_weight;
+  // in-situ reductions (file_type = hist, prof, spec)
+  std::string variable2, reduce_weight;
+  int nbin, nbin2;
+  Real bin_min, bin_max, bin2_min, bin2_max;
+  bool log_bins, log_bins2;
+  Real x_center, y_center, z_center;
+  // coarsened and region-of-interest HDF5 outputs (file_type = hdf5)
+  int coarsen_level;
+  bool output_roi;
+  Real roi_xmin[3], roi_xmax[3];
+  int roi_level_min, roi_level_max;
   // TODO(felker): some of the parameters in this class are not initialized in constructor
   OutputParameters() : block_number(0), next_time(0.0), dt(0.0), file_number(0),
                        output_slicex1(false),output_slicex2(false),output_slicex3(false),
                        output_sumx1(false), output_sumx2(false), output_sumx3(false),
                        include_ghost_zones(false), cartesian_vector(false),
-                       islice(0), jslice(0), kslice(0) {}
+                       islice(0), jslice(0), kslice(0),
+                       proj_axis(3), proj_nx(0), proj_ny(0), nbin(0), nbin2(0),
+                       bin_min(0.0), bin_max(0.0), bin2_min(0.0), bin2_max(0.0),
+                       log_bins(false), log_bins2(false),
+                       x_center(0.0), y_center(0.0), z_center(0.0),
+                       coarsen_level(0), output_roi(false), roi_xmin{}, roi_xmax{},
+                       roi_level_min(0), roi_level_max(0) {}
 };
 
 //----------------------------------------------------------------------------------------
@@ -97,6 +119,7 @@ class OutputType {
 
   // functions
   void LoadOutputData(MeshBlock *pmb);
+  void LoadOutputData(MeshBlock *pmb, const std::string &variable);
   void AppendOutputDataNode(OutputData *pdata);
   void ReplaceOutputDataNode(OutputData *pold, OutputData *pnew);
   void ClearOutputData();
@@ -126,6 +149,47 @@ class HistoryOutput : public OutputType {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
 };
 
+//----------------------------------------------------------------------------------------
+//! \class HistogramOutput
+//! \brief derived OutputType class for 1D or joint 2D histograms (PDFs) of one or two
+//!        variables, reduced over all MeshBlocks and ranks
+
+class HistogramOutput : public OutputType {
+ public:
+  explicit HistogramOutput(OutputParameters oparams) : OutputType(oparams) {}
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+};
+
+//----------------------------------------------------------------------------------------
+//! \class ProfileOutput
+//! \brief derived OutputType class for spherically averaged radial profiles about a
+//!        given center, reduced over all MeshBlocks and ranks
+
+class ProfileOutput : public OutputType {
+ public:
+  explicit ProfileOutput(OutputParameters oparams) : OutputType(oparams) {}
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+};
+
+//----------------------------------------------------------------------------------------
+//! \class SpectrumOutput
+//! \brief derived OutputType class for shell-summed power spectra computed with the
+//!        FFTDriver on uniform meshes
+
+class SpectrumOutput : public OutputType {
+ public:
+  explicit SpectrumOutput(OutputParameters oparams)
+      : OutputType(oparams), pfftd_(nullptr) {}
+  ~SpectrumOutput();
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+
+ private:
+  // FFTDriver and plans are kept between outputs and rebuilt only when the
+  // distribution of MeshBlocks over the ranks (fft_ranks_) changes
+  FFTDriver *pfftd_;
+  std::vector<int> fft_ranks_;
+};
+
 //----------------------------------------------------------------------------------------
 //! \class FormattedTableOutput
 //! \brief derived OutputType class for formatted table (tabular) data
@@ -182,6 +246,17 @@ class ATHDF5Output : public OutputType {
   char (*dataset_names)[max_name_length+1];   // array of C-string names of datasets
   char (*variable_names)[max_name_length+1];  // array of C-string names of variables
 };
+
+//----------------------------------------------------------------------------------------
+//! \class ProjectionOutput
+//! \brief derived OutputType class for global 2D projections and slices, reduced over
+//!        all MeshBlocks and ranks and written as one HDF5 image per output
+
+class ProjectionOutput : public OutputType {
+ public:
+  explicit ProjectionOutput(OutputParameters oparams) : OutputType(oparams) {}
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) override;
+};
 #endif
 
 //----------------------------------------------------------------------------------------
@@ -0,0 +1,191 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file profile.cpp
+//! \brief spherically averaged radial profiles, reduced in parallel and written as a
+//!        text table
+//!
+//! Cells are binned by the distance r of their center from (x_center, y_center,
+//! z_center), given in Cartesian coordinates also for cylindrical and spherical_polar
+//! meshes. Bins are linear or, with log_bins, logarithmic between rmin and rmax. For
+//! every bin the table lists the total weight (volume or mass) and the weighted average
+//! of each component of the OutputData selected by variable.
+
+// C headers
+
+// C++ headers
+#include <cmath>      // cos(), floor(), log10(), pow(), sin(), sqrt()
+#include <cstdio>     // fopen(), fprintf(), snprintf()
+#include <cstring>    // strcmp()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // string
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "outputs.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProfileOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//! \brief Bins the cells of all MeshBlocks in radius, reduces the sums over all ranks
+//!        and writes the averages from rank 0.
+
+void ProfileOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+  std::stringstream msg;
+  int geometry = 0;
+  if (std::strcmp(COORDINATE_SYSTEM, "cartesian") == 0) {
+    geometry = 0;
+  } else if (std::strcmp(COORDINATE_SYSTEM, "cylindrical") == 0) {
+    geometry = 1;
+  } else if (std::strcmp(COORDINATE_SYSTEM, "spherical_polar") == 0) {
+    geometry = 2;
+  } else {
+    msg << "### FATAL ERROR in function [ProfileOutput::WriteOutputFile]" << std::endl
+        << "Radial profiles require cartesian, cylindrical or spherical_polar "
+        << "coordinates" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  const bool use_mass = (output_params.reduce_weight == "mass");
+  const bool logb = output_params.log_bins;
+  const int nbin = output_params.nbin;
+  const Real rmin = logb ? std::log10(output_params.bin_min) : output_params.bin_min;
+  const Real rmax = logb ? std::log10(output_params.bin_max) : output_params.bin_max;
+  const Real idr = nbin/(rmax - rmin);
+  const Real xc = output_params.x_center;
+  const Real yc = output_params.y_center;
+  const Real zc = output_params.z_center;
+
+  // variable names are taken from the first MeshBlock
+  std::vector<std::string> names;
+  MeshBlock *pmb = pm->my_blocks(0);
+  LoadOutputData(pmb);
+  for (OutputData *pdata = pfirst_data_; pdata != nullptr; pdata = pdata->pnext) {
+    int nvar = pdata->data.GetDim4();
+    for (int n=0; n<nvar; ++n)
+      names.push_back(nvar == 1 ? pdata->name : pdata->name + std::to_string(n+1));
+  }
+  ClearOutputData();
+  const int nv = static_cast<int>(names.size());
+
+  // weighted sum per variable followed by the weight, for every bin
+  AthenaArray<Real> prof(nv+1, nbin);
+
+  for (int b=0; b<pm->nblocal; ++b) {
+    pmb = pm->my_blocks(b);
+    Coordinates *pco = pmb->pcoord;
+    out_is = pmb->is; out_ie = pmb->ie;
+    out_js = pmb->js; out_je = pmb->je;
+    out_ks = pmb->ks; out_ke = pmb->ke;
+    LoadOutputData(pmb);
+    for (int k=out_ks; k<=out_ke; ++k) {
+      for (int j=out_js; j<=out_je; ++j) {
+        for (int i=out_is; i<=out_ie; ++i) {
+          Real x, y, z;
+          if (geometry == 0) {
+            x = pco->x1v(i); y = pco->x2v(j); z = pco->x3v(k);
+          } else if (geometry == 1) {
+            x = pco->x1v(i)*std::cos(pco->x2v(j));
+            y = pco->x1v(i)*std::sin(pco->x2v(j));
+            z = pco->x3v(k);
+          } else {
+            x = pco->x1v(i)*std::sin(pco->x2v(j))*std::cos(pco->x3v(k));
+            y = pco->x1v(i)*std::sin(pco->x2v(j))*std::sin(pco->x3v(k));
+            z = pco->x1v(i)*std::cos(pco->x2v(j));
+          }
+          Real r = std::sqrt(SQR(x - xc) + SQR(y - yc) + SQR(z - zc));
+          if (logb) {
+            if (r <= 0.0) continue;
+            r = std::log10(r);
+          }
+          const int ib = static_cast<int>(std::floor((r - rmin)*idr));
+          if (ib < 0 || ib >= nbin) continue;
+          Real w = pco->GetCellVolume(k,j,i);
+          if (use_mass) w *= pmb->phydro->w(IDN,k,j,i);
+          int n = 0;
+          for (OutputData *pdata = pfirst_data_; pdata != nullptr;
+               pdata = pdata->pnext) {
+            for (int v=0; v<pdata->data.GetDim4(); ++v, ++n)
+              prof(n,ib) += w*pdata->data(v,k,j,i);
+          }
+          prof(nv,ib) += w;
+        }
+      }
+    }
+    ClearOutputData();
+  }
+
+#ifdef MPI_PARALLEL
+  if (Globals::my_rank == 0)
+    MPI_Reduce(MPI_IN_PLACE, prof.data(), (nv+1)*nbin, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+  else
+    MPI_Reduce(prof.data(), nullptr, (nv+1)*nbin, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+#endif
+
+  // only the master rank writes the file
+  // create filename: "file_basename"."file_id".XXXXX.prof
+  if (Globals::my_rank == 0) {
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", output_params.file_number);
+    fname.assign(output_params.file_basename);
+    fname.append(".");
+    fname.append(output_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".prof");
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      msg << "### FATAL ERROR in function [ProfileOutput::WriteOutputFile]"
+          << std::endl << "Output file '" << fname << "' could not be opened"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    std::fprintf(pfile, "# Athena++ radial profile at time=%e  cycle=%d  weight=%s  "
+                 "center=(%e,%e,%e)\n", pm->time, pm->ncycle,
+                 output_params.reduce_weight.c_str(), xc, yc, zc);
+    int iout = 1;
+    std::fprintf(pfile, "# [%d]=r_lo [%d]=r_hi [%d]=weight", iout, iout+1, iout+2);
+    iout += 3;
+    for (int n=0; n<nv; ++n)
+      std::fprintf(pfile, " [%d]=%s", iout++, names[n].c_str());
+    std::fprintf(pfile, "\n");
+    for (int ib=0; ib<nbin; ++ib) {
+      Real rl = rmin + ib/idr, rr = rmin + (ib+1)/idr;
+      if (logb) {
+        rl = std::pow(10.0, rl);
+        rr = std::pow(10.0, rr);
+      }
+      std::fprintf(pfile, output_params.data_format.c_str(), rl);
+      std::fprintf(pfile, output_params.data_format.c_str(), rr);
+      std::fprintf(pfile, output_params.data_format.c_str(), prof(nv,ib));
+      for (int n=0; n<nv; ++n)
+        std::fprintf(pfile, output_params.data_format.c_str(),
+                     prof(nv,ib) > 0.0 ? prof(n,ib)/prof(nv,ib) : 0.0);
+      std::fprintf(pfile, "\n");
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+  return;
+}
@@ -0,0 +1,264 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file projection.cpp
+//! \brief global projection and slice images, reduced in parallel and written to HDF5
+//!
+//! Every cell of every MeshBlock is deposited onto a uniform image of nx_image x
+//! ny_image pixels spanning the Mesh perpendicular to the projection axis, weighted by
+//! the fraction of each pixel it covers. Since only leaf MeshBlocks are visited, this is
+//! independent of the refinement level. The image is then reduced onto rank 0, which
+//! writes it as one HDF5 file per output. Along the axis, with weight:
+//!  - column: integral of q dl (e.g. column density for q = rho)
+//!  - volume: integral of q dl / integral of dl
+//!  - mass:   integral of rho q dl / integral of rho dl
+//!  - max:    maximum of q
+//! If a slice position is given for the projection axis (x1_slice etc.), the image is
+//! instead the area-weighted average of the cells intersecting the slice.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max(), min()
+#include <cmath>      // floor()
+#include <cstdio>     // snprintf()
+#include <limits>     // numeric_limits
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // string
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "outputs.hpp"
+
+// Only proceed if HDF5 output enabled
+#ifdef HDF5OUTPUT
+
+// External library headers
+#include <hdf5.h>
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProjectionOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//! \brief Deposits OutputData of all MeshBlocks onto a global 2D image, reduces it over
+//!        all ranks and writes it from rank 0.
+
+void ProjectionOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+  std::stringstream msg;
+  // directions (0-based) of the image x, image y and line of sight
+  const int dc = output_params.proj_axis - 1;
+  const int da = output_params.proj_axis%3;
+  const int db = (output_params.proj_axis+1)%3;
+  const int nx = output_params.proj_nx, ny = output_params.proj_ny;
+  const std::string &weight = output_params.proj_weight;
+  const bool use_max = (weight == "max");
+  const bool use_mass = (weight == "mass");
+  bool slice = false;
+  Real xslice = 0.0;
+  if (dc == 0 && output_params.output_slicex1) {
+    slice = true; xslice = output_params.x1_slice;
+  } else if (dc == 1 && output_params.output_slicex2) {
+    slice = true; xslice = output_params.x2_slice;
+  } else if (dc == 2 && output_params.output_slicex3) {
+    slice = true; xslice = output_params.x3_slice;
+  }
+  const Real xmin[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min, pm->mesh_size.x3min};
+  const Real xmax[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max, pm->mesh_size.x3max};
+  const Real dpx = (xmax[da] - xmin[da])/nx, dpy = (xmax[db] - xmin[db])/ny;
+
+  // variable names are taken from the first MeshBlock
+  std::vector<std::string> names;
+  MeshBlock *pmb = pm->my_blocks(0);
+  out_is = pmb->is; out_ie = pmb->ie;
+  out_js = pmb->js; out_je = pmb->je;
+  out_ks = pmb->ks; out_ke = pmb->ke;
+  LoadOutputData(pmb);
+  for (OutputData *pdata = pfirst_data_; pdata != nullptr; pdata = pdata->pnext) {
+    int nvar = pdata->data.GetDim4();
+    for (int n=0; n<nvar; ++n)
+      names.push_back(nvar == 1 ? pdata->name : pdata->name + std::to_string(n+1));
+  }
+  ClearOutputData();
+  const int nv = static_cast<int>(names.size());
+
+  // numerator per variable and a common denominator, num(nv) followed by den
+  AthenaArray<Real> img(nv+1, ny, nx);
+  if (use_max) {
+    for (int n=0; n<(nv+1)*nx*ny; ++n)
+      img(n) = -std::numeric_limits<Real>::max();
+  }
+
+  for (int b=0; b<pm->nblocal; ++b) {
+    pmb = pm->my_blocks(b);
+    Coordinates *pco = pmb->pcoord;
+    out_is = pmb->is; out_ie = pmb->ie;
+    out_js = pmb->js; out_je = pmb->je;
+    out_ks = pmb->ks; out_ke = pmb->ke;
+    LoadOutputData(pmb);
+    for (int k=out_ks; k<=out_ke; ++k) {
+      for (int j=out_js; j<=out_je; ++j) {
+        for (int i=out_is; i<=out_ie; ++i) {
+          const Real xl[3] = {pco->x1f(i), pco->x2f(j), pco->x3f(k)};
+          const Real xr[3] = {pco->x1f(i+1), pco->x2f(j+1), pco->x3f(k+1)};
+          Real dl = xr[dc] - xl[dc];
+          if (slice) {
+            if (xslice < xl[dc] || xslice >= xr[dc]) continue;
+            dl = 1.0;
+          }
+          Real w = dl;
+          if (use_mass) w *= pmb->phydro->w(IDN,k,j,i);
+          // range of pixels overlapped by the cell
+          int ia0 = static_cast<int>(std::floor((xl[da] - xmin[da])/dpx));
+          int ib0 = static_cast<int>(std::floor((xl[db] - xmin[db])/dpy));
+          ia0 = std::max(0, ia0);
+          ib0 = std::max(0, ib0);
+          const int ia1 = std::min(nx-1, static_cast<int>((xr[da] - xmin[da])/dpx));
+          const int ib1 = std::min(ny-1, static_cast<int>((xr[db] - xmin[db])/dpy));
+          for (int ib=ib0; ib<=ib1; ++ib) {
+            const Real pyl = xmin[db] + ib*dpy;
+            const Real fy = (std::min(xr[db], pyl+dpy) - std::max(xl[db], pyl))/dpy;
+            if (fy <= 0.0) continue;
+            for (int ia=ia0; ia<=ia1; ++ia) {
+              const Real pxl = xmin[da] + ia*dpx;
+              const Real fx = (std::min(xr[da], pxl+dpx) - std::max(xl[da], pxl))/dpx;
+              if (fx <= 0.0) continue;
+              const Real area = fx*fy;
+              int n = 0;
+              for (OutputData *pdata = pfirst_data_; pdata != nullptr;
+                   pdata = pdata->pnext) {
+                for (int v=0; v<pdata->data.GetDim4(); ++v, ++n) {
+                  const Real q = pdata->data(v,k,j,i);
+                  if (use_max)
+                    img(n,ib,ia) = std::max(img(n,ib,ia), q);
+                  else
+                    img(n,ib,ia) += q*w*area;
+                }
+              }
+              if (!use_max) img(nv,ib,ia) += w*area;
+            }
+          }
+        }
+      }
+    }
+    ClearOutputData();
+  }
+
+#ifdef MPI_PARALLEL
+  if (Globals::my_rank == 0)
+    MPI_Reduce(MPI_IN_PLACE, img.data(), (nv+1)*nx*ny, MPI_ATHENA_REAL,
+               use_max ? MPI_MAX : MPI_SUM, 0, MPI_COMM_WORLD);
+  else
+    MPI_Reduce(img.data(), nullptr, (nv+1)*nx*ny, MPI_ATHENA_REAL,
+               use_max ? MPI_MAX : MPI_SUM, 0, MPI_COMM_WORLD);
+#endif
+
+  if (Globals::my_rank == 0) {
+    // normalize averages; column projections are integrals and slices averages
+    if (weight == "volume" || weight == "mass" || (slice && !use_max)) {
+      for (int n=0; n<nv; ++n) {
+        for (int ib=0; ib<ny; ++ib) {
+          for (int ia=0; ia<nx; ++ia) {
+            if (img(nv,ib,ia) > 0.0) img(n,ib,ia) /= img(nv,ib,ia);
+          }
+        }
+      }
+    }
+
+    // create filename: "file_basename"."file_id".XXXXX.proj.h5
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", output_params.file_number);
+    fname.assign(output_params.file_basename);
+    fname.append(".");
+    fname.append(output_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".proj.h5");
+
+    hid_t file = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (file < 0) {
+      msg << "### FATAL ERROR in function [ProjectionOutput::WriteOutputFile]"
+          << std::endl << "Output file '" << fname << "' could not be opened"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    hid_t dataspace_scalar = H5Screate(H5S_SCALAR);
+    hid_t attribute = H5Acreate2(file, "Time", H5T_NATIVE_DOUBLE, dataspace_scalar,
+                                 H5P_DEFAULT, H5P_DEFAULT);
+    double time = pm->time;
+    H5Awrite(attribute, H5T_NATIVE_DOUBLE, &time);
+    H5Aclose(attribute);
+    attribute = H5Acreate2(file, "NumCycles", H5T_NATIVE_INT, dataspace_scalar,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, H5T_NATIVE_INT, &pm->ncycle);
+    H5Aclose(attribute);
+    attribute = H5Acreate2(file, "Axis", H5T_NATIVE_INT, dataspace_scalar,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, H5T_NATIVE_INT, &output_params.proj_axis);
+    H5Aclose(attribute);
+    std::string mode = slice ? "slice" : weight;
+    hid_t string_type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(string_type, mode.size()+1);
+    attribute = H5Acreate2(file, "Weight", string_type, dataspace_scalar,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, string_type, mode.c_str());
+    H5Aclose(attribute);
+    H5Tclose(string_type);
+    H5Sclose(dataspace_scalar);
+
+    // pixel edges along the image x (axis%3+1) and y ((axis+1)%3+1) directions
+    std::vector<double> edges(std::max(nx, ny)+1);
+    hsize_t dims[2];
+    const char *edge_names[2] = {"xf", "yf"};
+    for (int d=0; d<2; ++d) {
+      int np = (d == 0) ? nx : ny;
+      int dim = (d == 0) ? da : db;
+      for (int n=0; n<=np; ++n)
+        edges[n] = xmin[dim] + n*(xmax[dim] - xmin[dim])/np;
+      dims[0] = np + 1;
+      hid_t space = H5Screate_simple(1, dims, nullptr);
+      hid_t dset = H5Dcreate2(file, edge_names[d], H5T_NATIVE_DOUBLE, space,
+                              H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, edges.data());
+      H5Dclose(dset);
+      H5Sclose(space);
+    }
+
+    // one (ny, nx) dataset per variable
+    std::vector<double> buf(nx*ny);
+    dims[0] = ny; dims[1] = nx;
+    hid_t space = H5Screate_simple(2, dims, nullptr);
+    for (int n=0; n<nv; ++n) {
+      for (int ib=0; ib<ny; ++ib) {
+        for (int ia=0; ia<nx; ++ia)
+          buf[ib*nx+ia] = static_cast<double>(img(n,ib,ia));
+      }
+      hid_t dset = H5Dcreate2(file, names[n].c_str(), H5T_NATIVE_DOUBLE, space,
+                              H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf.data());
+      H5Dclose(dset);
+    }
+    H5Sclose(space);
+    H5Fclose(file);
+  }
+
+  // increment counters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+  return;
+}
+
+#endif  // HDF5OUTPUT
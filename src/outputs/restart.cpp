@@ -181,8 +181,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool force_wr
     }
 
     if (NR_RADIATION_ENABLED || IM_RADIATION_ENABLED) {
-      std::memcpy(pdata,pmb->pnrrad->ir.data(),pmb->pnrrad->ir.GetSizeInBytes());
-      pdata += pmb->pnrrad->ir.GetSizeInBytes();
+      pdata += pmb->pnrrad->SaveRestartData(pdata);
     }
 
     if (CR_ENABLED) {
@@ -0,0 +1,203 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file spectrum.cpp
+//! \brief shell-summed power spectra of uniform meshes, computed with the FFTDriver and
+//!        written as a text table
+//!
+//! Each component q of the OutputData selected by variable (multiplied by sqrt(rho) for
+//! weight=mass) is Fourier transformed over the whole Mesh. The power |q_k|^2/N^2 of
+//! every mode is summed into shells of width dk = 2 pi/L_max centered on multiples of
+//! dk, and the components of a vector are summed, so that the spectrum of a variable
+//! adds up to the volume average of q.q. For example, variable=v with weight=mass gives
+//! twice the kinetic energy spectrum.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // equal(), min()
+#include <cmath>      // floor(), sqrt()
+#include <complex>    // norm()
+#include <cstdint>    // int64_t
+#include <cstdio>     // fopen(), fprintf(), snprintf()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // string
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../fft/athena_fft.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "outputs.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn SpectrumOutput::~SpectrumOutput()
+//! \brief destroys the FFTDriver kept between outputs
+
+SpectrumOutput::~SpectrumOutput() {
+  delete pfftd_;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SpectrumOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
+//! \brief Transforms the OutputData of all MeshBlocks, reduces the shell sums over all
+//!        ranks and writes them from rank 0.
+//!
+//! The FFTDriver and its plans are created at the first output and reused until the
+//! distribution of MeshBlocks over the ranks changes (e.g. by load balancing).
+
+void SpectrumOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
+#ifdef FFT
+  if (pm->multilevel) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [SpectrumOutput::WriteOutputFile]" << std::endl
+        << "Spectrum outputs require a uniform Mesh without refinement" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  const bool use_mass = (output_params.reduce_weight == "mass");
+  const int nbin = output_params.nbin;
+
+  if (pfftd_ != nullptr && !std::equal(fft_ranks_.begin(), fft_ranks_.end(),
+                                       pm->ranklist)) {
+    delete pfftd_;
+    pfftd_ = nullptr;
+  }
+  if (pfftd_ == nullptr) {
+    pfftd_ = new FFTDriver(pm, pin);
+    pfftd_->InitializeFFTBlock(false);
+    pfftd_->QuickCreatePlan();
+    fft_ranks_.assign(pm->ranklist, pm->ranklist + pm->nbtotal);
+  }
+  FFTBlock *pfb = pfftd_->pmy_fb;
+  const Real gcnt = static_cast<Real>(pm->GetTotalCells());
+
+  // variable names and number of components, taken from the first MeshBlock
+  std::vector<std::string> names;
+  std::vector<int> ncomp;
+  MeshBlock *pmb = pm->my_blocks(0);
+  LoadOutputData(pmb);
+  for (OutputData *pdata = pfirst_data_; pdata != nullptr; pdata = pdata->pnext) {
+    names.push_back(pdata->name);
+    ncomp.push_back(pdata->data.GetDim4());
+  }
+  ClearOutputData();
+  const int nv = static_cast<int>(names.size());
+  AthenaArray<Real> src(pmb->ncells3, pmb->ncells2, pmb->ncells1);
+
+  // shells are spaced by the smallest fundamental wavenumber
+  Real dk = pfb->dkx[0];
+  if (pfb->kNx[1] > 1) dk = std::min(dk, pfb->dkx[1]);
+  if (pfb->kNx[2] > 1) dk = std::min(dk, pfb->dkx[2]);
+
+  // number of modes per shell followed by the power of every variable
+  AthenaArray<Real> spec(nv+1, nbin);
+
+  for (int v=0; v<nv; ++v) {
+    for (int c=0; c<ncomp[v]; ++c) {
+      for (int b=0; b<pm->nblocal; ++b) {
+        pmb = pm->my_blocks(b);
+        LoadOutputData(pmb);
+        OutputData *pdata = pfirst_data_;
+        for (int n=0; n<v; ++n) pdata = pdata->pnext;
+        for (int k=pmb->ks; k<=pmb->ke; ++k) {
+          for (int j=pmb->js; j<=pmb->je; ++j) {
+            for (int i=pmb->is; i<=pmb->ie; ++i) {
+              src(k,j,i) = pdata->data(c,k,j,i);
+              if (use_mass) src(k,j,i) *= std::sqrt(pmb->phydro->w(IDN,k,j,i));
+            }
+          }
+        }
+        ClearOutputData();
+        pfb->LoadSource(src, 0, NGHOST, pmb->loc, pmb->block_size);
+      }
+      pfb->ExecuteForward();
+
+      for (int k=0; k<pfb->knx[2]; ++k) {
+        for (int j=0; j<pfb->knx[1]; ++j) {
+          for (int i=0; i<pfb->knx[0]; ++i) {
+            Real kx = i + pfb->kdisp[0];
+            Real ky = j + pfb->kdisp[1];
+            Real kz = k + pfb->kdisp[2];
+            if (kx > 0.5*pfb->kNx[0]) kx -= pfb->kNx[0];
+            if (ky > 0.5*pfb->kNx[1]) ky -= pfb->kNx[1];
+            if (kz > 0.5*pfb->kNx[2]) kz -= pfb->kNx[2];
+            const Real kmag = std::sqrt(SQR(kx*pfb->dkx[0]) + SQR(ky*pfb->dkx[1])
+                                        + SQR(kz*pfb->dkx[2]));
+            const int ib = static_cast<int>(std::floor(kmag/dk + 0.5));
+            if (ib >= nbin) continue;
+            std::int64_t idx = pfb->GetIndex(i, j, k, pfb->f_out_);
+            spec(v,ib) += std::norm(pfb->out_[idx])/SQR(gcnt);
+            if (v == 0 && c == 0) spec(nv,ib) += 1.0;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef MPI_PARALLEL
+  if (Globals::my_rank == 0)
+    MPI_Reduce(MPI_IN_PLACE, spec.data(), (nv+1)*nbin, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+  else
+    MPI_Reduce(spec.data(), nullptr, (nv+1)*nbin, MPI_ATHENA_REAL, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+#endif
+
+  // only the master rank writes the file
+  // create filename: "file_basename"."file_id".XXXXX.spec
+  if (Globals::my_rank == 0) {
+    std::string fname;
+    char number[6];
+    std::snprintf(number, sizeof(number), "%05d", output_params.file_number);
+    fname.assign(output_params.file_basename);
+    fname.append(".");
+    fname.append(output_params.file_id);
+    fname.append(".");
+    fname.append(number);
+    fname.append(".spec");
+
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [SpectrumOutput::WriteOutputFile]"
+          << std::endl << "Output file '" << fname << "' could not be opened"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    std::fprintf(pfile, "# Athena++ power spectrum at time=%e  cycle=%d  weight=%s\n",
+                 pm->time, pm->ncycle, output_params.reduce_weight.c_str());
+    int iout = 1;
+    std::fprintf(pfile, "# [%d]=k [%d]=nmodes", iout, iout+1);
+    iout += 2;
+    for (int v=0; v<nv; ++v)
+      std::fprintf(pfile, " [%d]=%s", iout++, names[v].c_str());
+    std::fprintf(pfile, "\n");
+    for (int ib=0; ib<nbin; ++ib) {
+      std::fprintf(pfile, output_params.data_format.c_str(), ib*dk);
+      std::fprintf(pfile, output_params.data_format.c_str(), spec(nv,ib));
+      for (int v=0; v<nv; ++v)
+        std::fprintf(pfile, output_params.data_format.c_str(), spec(v,ib));
+      std::fprintf(pfile, "\n");
+    }
+    std::fclose(pfile);
+  }
+#endif  // FFT
+
+  // increment counters
+  output_params.file_number++;
+  output_params.next_time += output_params.dt;
+  pin->SetInteger(output_params.block_name, "file_number", output_params.file_number);
+  pin->SetReal(output_params.block_name, "next_time", output_params.next_time);
+  return;
+}
@@ -0,0 +1,141 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file conduction_wave.cpp
+//! \brief Sound wave damped by thermal conduction, propagating obliquely to the grid.
+//!
+//! The wavevector k = 2 PI (1/Lx1, 1/Lx2, 1/Lx3) points along the domain diagonal and
+//! the uniform magnetic field is parallel to k, so the acoustic mode is not coupled to
+//! the field and isotropic (kappa_iso) and field-aligned (kappa_aniso) conduction damp
+//! the wave at the same rate. With a periodic domain it tests the cross terms of the
+//! anisotropic conduction flux and of the implicit Multigrid conduction solver.
+//========================================================================================
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max()
+#include <cmath>      // sqrt(), cos()
+#include <iostream>   // endl
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // c_str()
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../eos/eos.hpp"
+#include "../field/field.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+
+#if !MAGNETIC_FIELDS_ENABLED
+#error "This problem generator requires magnetic fields"
+#endif
+
+#if !NON_BAROTROPIC_EOS
+#error "This problem generator requires a non-barotropic equation of state"
+#endif
+
+namespace {
+Real kx, ky, kz, kmag; // wavevector and its magnitude
+Real MaxVpar(MeshBlock *pmb, int iout);
+} // namespace
+
+//========================================================================================
+//! \fn void Mesh::InitUserMeshData(ParameterInput *pin)
+//! \brief set the wavevector along the domain diagonal and enroll the history output
+//========================================================================================
+
+void Mesh::InitUserMeshData(ParameterInput *pin) {
+  if (mesh_size.nx2 == 1 || mesh_size.nx3 == 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in conduction_wave.cpp InitUserMeshData" << std::endl
+        << "This problem requires a 3D mesh" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  kx = 2.0*PI/(mesh_size.x1max - mesh_size.x1min);
+  ky = 2.0*PI/(mesh_size.x2max - mesh_size.x2min);
+  kz = 2.0*PI/(mesh_size.x3max - mesh_size.x3min);
+  kmag = std::sqrt(SQR(kx) + SQR(ky) + SQR(kz));
+  AllocateUserHistoryOutput(1);
+  EnrollUserHistoryOutput(0, MaxVpar, "max-v", UserHistoryOperation::max);
+  return;
+}
+
+//========================================================================================
+//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \brief sound wave of amplitude amp on a uniform background with p = 1/gamma (c_s = 1)
+//========================================================================================
+
+void MeshBlock::ProblemGenerator(ParameterInput *pin) {
+  Real amp = pin->GetOrAddReal("problem", "amp", 1.0e-4);
+  Real b0 = pin->GetOrAddReal("problem", "b0", 0.5);
+  Real gm1 = peos->GetGamma() - 1.0;
+  Real p0 = 1.0/peos->GetGamma();
+  Real bx = b0*kx/kmag, by = b0*ky/kmag, bz = b0*kz/kmag;
+
+  for (int k=ks; k<=ke; k++) {
+    for (int j=js; j<=je; j++) {
+      for (int i=is; i<=ie; i++) {
+        Real dw = amp*std::cos(kx*pcoord->x1v(i) + ky*pcoord->x2v(j)
+                               + kz*pcoord->x3v(k));
+        Real d = 1.0 + dw;
+        Real v = dw; // c_s = 1 along k
+        phydro->u(IDN,k,j,i) = d;
+        phydro->u(IM1,k,j,i) = d*v*kx/kmag;
+        phydro->u(IM2,k,j,i) = d*v*ky/kmag;
+        phydro->u(IM3,k,j,i) = d*v*kz/kmag;
+        phydro->u(IEN,k,j,i) = (p0 + dw)/gm1 + 0.5*d*SQR(v)
+                               + 0.5*(SQR(bx) + SQR(by) + SQR(bz));
+      }
+    }
+  }
+
+  for (int k=ks; k<=ke; k++) {
+    for (int j=js; j<=je; j++) {
+      for (int i=is; i<=ie+1; i++) {
+        pfield->b.x1f(k,j,i) = bx;
+      }
+    }
+  }
+  for (int k=ks; k<=ke; k++) {
+    for (int j=js; j<=je+1; j++) {
+      for (int i=is; i<=ie; i++) {
+        pfield->b.x2f(k,j,i) = by;
+      }
+    }
+  }
+  for (int k=ks; k<=ke+1; k++) {
+    for (int j=js; j<=je; j++) {
+      for (int i=is; i<=ie; i++) {
+        pfield->b.x3f(k,j,i) = bz;
+      }
+    }
+  }
+  return;
+}
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn Real MaxVpar(MeshBlock *pmb, int iout)
+//! \brief maximum of |v.k|/|k|, the velocity amplitude of the wave
+
+Real MaxVpar(MeshBlock *pmb, int iout) {
+  Real max_v = 0.0;
+  AthenaArray<Real> &w = pmb->phydro->w;
+  for (int k=pmb->ks; k<=pmb->ke; k++) {
+    for (int j=pmb->js; j<=pmb->je; j++) {
+      for (int i=pmb->is; i<=pmb->ie; i++) {
+        Real v = (w(IVX,k,j,i)*kx + w(IVY,k,j,i)*ky + w(IVZ,k,j,i)*kz)/kmag;
+        max_v = std::max(std::abs(v), max_v);
+      }
+    }
+  }
+  return max_v;
+}
+} // namespace
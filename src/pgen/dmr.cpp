@@ -48,6 +48,13 @@ void DMRInnerX2(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim, FaceF
 void DMROuterX2(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim, FaceField &b,
                 Real time, Real dt,
                 int il, int iu, int jl, int ju, int kl, int ku, int ngh);
+// the same boundary conditions, set one row of ghost cells at a time
+void DMRInnerX1Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib);
+void DMRInnerX2Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib);
+void DMROuterX2Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib);
 int RefinementCondition(MeshBlock *pmb);
 
 //========================================================================================
@@ -58,10 +65,16 @@ int RefinementCondition(MeshBlock *pmb);
 //========================================================================================
 
 void Mesh::InitUserMeshData(ParameterInput *pin) {
-  // Enroll user-defined boundary functions
-  EnrollUserBoundaryFunction(BoundaryFace::inner_x1, DMRInnerX1);
-  EnrollUserBoundaryFunction(BoundaryFace::inner_x2, DMRInnerX2);
-  EnrollUserBoundaryFunction(BoundaryFace::outer_x2, DMROuterX2);
+  // Enroll user-defined boundary functions, either for the whole face or per row
+  if (pin->GetOrAddBoolean("problem", "pencil_bc", false)) {
+    EnrollUserBoundaryPencilFunction(BoundaryFace::inner_x1, DMRInnerX1Pencil);
+    EnrollUserBoundaryPencilFunction(BoundaryFace::inner_x2, DMRInnerX2Pencil);
+    EnrollUserBoundaryPencilFunction(BoundaryFace::outer_x2, DMROuterX2Pencil);
+  } else {
+    EnrollUserBoundaryFunction(BoundaryFace::inner_x1, DMRInnerX1);
+    EnrollUserBoundaryFunction(BoundaryFace::inner_x2, DMRInnerX2);
+    EnrollUserBoundaryFunction(BoundaryFace::outer_x2, DMROuterX2);
+  }
   // Enroll user-defined AMR criterion
   if (adaptive)
     EnrollUserRefinementCondition(RefinementCondition);
@@ -255,6 +268,97 @@ void DMROuterX2(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim, FaceF
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void DMRInnerX1Pencil()
+//! \brief Sets the ghost cells il..iu of row (k,j) on the left X boundary, as
+//! DMRInnerX1()
+
+void DMRInnerX1Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib) {
+  Real d0 = 8.0;
+  Real e0 = 291.25;
+  Real u0 =  8.25*std::sqrt(3.0)/2.0;
+  Real v0 = -8.25*0.5;
+  Real gamma = pmb->peos->GetGamma();
+  Real p0 = e0*(gamma-1.0);
+
+  for (int i=il; i<=iu; ++i) {
+    prim(IDN,k,j,i) = d0;
+    prim(IVX,k,j,i) = u0;
+    prim(IVY,k,j,i) = v0;
+    prim(IVZ,k,j,i) = 0.0;
+    prim(IPR,k,j,i) = p0;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void DMRInnerX2Pencil()
+//! \brief Sets the ghost row (k,j) on the lower Y boundary, as DMRInnerX2(); row j
+//! reflects the active row 2*ib-1-j
+
+void DMRInnerX2Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib) {
+  Real d0 = 8.0;
+  Real e0 = 291.25;
+  Real u0 =  8.25*std::sqrt(3.0)/2.0;
+  Real v0 = -8.25*0.5;
+  Real gamma = pmb->peos->GetGamma();
+  Real p0=e0*(gamma-1.0);
+  int jr = 2*ib - 1 - j;
+
+  for (int i=il; i<=iu; ++i) {
+    if (pco->x1v(i) < 0.1666666666) {
+      // fixed at downstream state
+      prim(IDN,k,j,i) = d0;
+      prim(IVX,k,j,i) = u0;
+      prim(IVY,k,j,i) = v0;
+      prim(IVZ,k,j,i) = 0.0;
+      prim(IPR,k,j,i) = p0;
+    } else {
+      // reflected
+      prim(IDN,k,j,i) = prim(IDN,k,jr,i);
+      prim(IVX,k,j,i) = prim(IVX,k,jr,i);
+      prim(IVY,k,j,i) = -prim(IVY,k,jr,i);
+      prim(IVZ,k,j,i) = 0.0;
+      prim(IPR,k,j,i) = prim(IPR,k,jr,i);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void DMROuterX2Pencil()
+//! \brief Sets the ghost row (k,j) on the upper Y boundary, as DMROuterX2()
+
+void DMROuterX2Pencil(MeshBlock *pmb, Coordinates *pco, AthenaArray<Real> &prim,
+                      Real time, Real dt, int k, int j, int il, int iu, int ib) {
+  Real d0 = 8.0;
+  Real e0 = 291.25;
+  Real u0 =  8.25*std::sqrt(3.0)/2.0;
+  Real v0 = -8.25*0.5;
+  Real shock_pos = 0.1666666666 + (1. + 20.*time)/std::sqrt(3.0);
+  Real gamma = pmb->peos->GetGamma();
+  Real p0 = e0*(gamma-1.0);
+  Real p1 = 2.5*(gamma-1.0);
+
+  for (int i=il; i<=iu; ++i) {
+    if (pco->x1v(i) < shock_pos) {
+      // fixed at downstream state
+      prim(IDN,k,j,i) = d0;
+      prim(IVX,k,j,i) = u0;
+      prim(IVY,k,j,i) = v0;
+      prim(IVZ,k,j,i) = 0.0;
+      prim(IPR,k,j,i) = p0;
+    } else {
+      // fixed at upstream state
+      prim(IDN,k,j,i) = 1.4;
+      prim(IVX,k,j,i) = 0.0;
+      prim(IVY,k,j,i) = 0.0;
+      prim(IVZ,k,j,i) = 0.0;
+      prim(IPR,k,j,i) = p1;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn int RefinementCondition(MeshBlock *pmb)
 //! \brief refinement condition: maximum density and pressure curvature
@@ -8,6 +8,8 @@
 //!
 //! - iprob = 0 - Resistive Diffusion of 1-D Gaussian
 //! - iprob = 1 - Resistive Diffusion of 2-D Gaussian
+//! - iprob = 2 - Resistive Decay of a 3-D sinusoidal field, wavevector along the
+//!               diagonal of a periodic box
 //========================================================================================
 
 // C headers
@@ -172,13 +174,90 @@ void MeshBlock::ProblemGenerator(ParameterInput *pin) {
           << std::endl << "cylindrical coord" << std::endl;
       ATHENA_ERROR(msg);
     }
+  } else if (iprob == 2) { // 3-d decay of B = amp e cos(k.x), e perpendicular to k
+    if (std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0 || pmy_mesh->f3 == 0) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in resist.cpp ProblemGenerator" << std::endl
+          << "3-d decay test only compatible with 3-d cartesian coord" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    RegionSize &ms = pmy_mesh->mesh_size;
+    Real kx = 2.0*PI/(ms.x1max - ms.x1min);
+    Real ky = 2.0*PI/(ms.x2max - ms.x2min);
+    Real kz = 2.0*PI/(ms.x3max - ms.x3min);
+    Real ksq = SQR(kx) + SQR(ky) + SQR(kz);
+    // B = curl A with A = amp (e x k)/k^2 sin(k.x) and e = (ky, -kx, 0)/|(ky, -kx, 0)|;
+    // A is evaluated at the cell edges so that the face fields are divergence-free
+    Real enorm = amp/std::sqrt(SQR(kx) + SQR(ky));
+    Real ax = -enorm*kx*kz/ksq, ay = -enorm*ky*kz/ksq,
+         az = enorm*(SQR(kx) + SQR(ky))/ksq;
+    AthenaArray<Real> a1, a2, a3;
+    int nx1 = ie - is + 2, nx2 = je - js + 2, nx3 = ke - ks + 2;
+    a1.NewAthenaArray(nx3, nx2, nx1);
+    a2.NewAthenaArray(nx3, nx2, nx1);
+    a3.NewAthenaArray(nx3, nx2, nx1);
+    for (int k=ks; k<=ke+1; k++) {
+      for (int j=js; j<=je+1; j++) {
+        for (int i=is; i<=ie+1; i++) {
+          a1(k-ks,j-js,i-is) = ax*std::sin(kx*pcoord->x1v(i) + ky*pcoord->x2f(j)
+                                           + kz*pcoord->x3f(k));
+          a2(k-ks,j-js,i-is) = ay*std::sin(kx*pcoord->x1f(i) + ky*pcoord->x2v(j)
+                                           + kz*pcoord->x3f(k));
+          a3(k-ks,j-js,i-is) = az*std::sin(kx*pcoord->x1f(i) + ky*pcoord->x2f(j)
+                                           + kz*pcoord->x3v(k));
+        }
+      }
+    }
+    for (int k=ks; k<=ke; k++) {
+      for (int j=js; j<=je; j++) {
+        for (int i=is; i<=ie+1; i++) {
+          int mk = k - ks, mj = j - js, mi = i - is;
+          pfield->b.x1f(k,j,i) = (a3(mk,mj+1,mi) - a3(mk,mj,mi))/pcoord->dx2f(j)
+                                 - (a2(mk+1,mj,mi) - a2(mk,mj,mi))/pcoord->dx3f(k);
+        }
+      }
+    }
+    for (int k=ks; k<=ke; k++) {
+      for (int j=js; j<=je+1; j++) {
+        for (int i=is; i<=ie; i++) {
+          int mk = k - ks, mj = j - js, mi = i - is;
+          pfield->b.x2f(k,j,i) = (a1(mk+1,mj,mi) - a1(mk,mj,mi))/pcoord->dx3f(k)
+                                 - (a3(mk,mj,mi+1) - a3(mk,mj,mi))/pcoord->dx1f(i);
+        }
+      }
+    }
+    for (int k=ks; k<=ke+1; k++) {
+      for (int j=js; j<=je; j++) {
+        for (int i=is; i<=ie; i++) {
+          int mk = k - ks, mj = j - js, mi = i - is;
+          pfield->b.x3f(k,j,i) = (a2(mk,mj,mi+1) - a2(mk,mj,mi))/pcoord->dx1f(i)
+                                 - (a1(mk,mj+1,mi) - a1(mk,mj,mi))/pcoord->dx2f(j);
+        }
+      }
+    }
   } else {
     std::stringstream msg;
     msg << "### FATAL ERROR in resist.cpp ProblemGenerator" << std::endl
-        << "iprob must be set to 0 or 1" << std::endl;
+        << "iprob must be set to 0, 1 or 2" << std::endl;
     ATHENA_ERROR(msg);
   }
 
+  // set total energy for an adiabatic EOS
+  if (NON_BAROTROPIC_EOS) {
+    Real pres = pin->GetOrAddReal("problem", "pres", 1.0);
+    Real gm1 = peos->GetGamma() - 1.0;
+    for (int k=ks; k<=ke; k++) {
+      for (int j=js; j<=je; j++) {
+        for (int i=is; i<=ie; i++) {
+          phydro->u(IEN,k,j,i) = pres/gm1 + 0.5*(
+              SQR(0.5*(pfield->b.x1f(k,j,i) + pfield->b.x1f(k,j,i+1)))
+              + SQR(0.5*(pfield->b.x2f(k,j,i) + pfield->b.x2f(k,j+1,i)))
+              + SQR(0.5*(pfield->b.x3f(k,j,i) + pfield->b.x3f(k+1,j,i))));
+        }
+      }
+    }
+  }
+
   return;
 }
 
@@ -57,6 +57,8 @@ void MeshBlock::ProblemGenerator(ParameterInput *pin) {
   sigma3 = pin->GetOrAddReal("problem","sigma_3",300.0);
   kappa_es = pin->GetOrAddReal("problem","kappa_es",0.0);
   bd_flag = pin->GetOrAddInteger("problem","black_body",0.0);
+  // uniform flow along x1, which shifts the frequencies in the co-moving frame
+  Real vx = pin->GetOrAddReal("problem","vx",0.0);
 
   Real gamma = peos->GetGamma();
   Real tr_ini = std::pow(er1,0.25);
@@ -66,7 +68,7 @@ void MeshBlock::ProblemGenerator(ParameterInput *pin) {
     for (int j=js; j<=je; ++j) {
       for (int i=is; i<=ie; ++i) {
         phydro->u(IDN,k,j,i) = 1.0;
-        phydro->u(IM1,k,j,i) = 0.0;
+        phydro->u(IM1,k,j,i) = vx;
         phydro->u(IM2,k,j,i) = 0.0;
         phydro->u(IM3,k,j,i) = 0.0;
         if (NON_BAROTROPIC_EOS) {
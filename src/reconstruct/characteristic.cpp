@@ -19,15 +19,14 @@
 #include "reconstruction.hpp"
 
 //----------------------------------------------------------------------------------------
-//! \fn Reconstruction::LeftEigenmatrixDotVector()
-//! \brief Computes inner-product of left-eigenmatrix of Roe's matrix A in the primitive
-//! variables and an input vector.  This operation converts primitive to characteristic
-//! variables.  The result is returned in the input vector, with the components of the
-//! characteristic field stored such that vect(1,i) is in the direction of the sweep.
+//! \fn Reconstruction::ComputeEigensystem()
+//! \brief Computes the quantities that define the left- and right-eigenmatrices of Roe's
+//! matrix A in the primitive variables for each cell of the pencil [il,iu], and caches
+//! them in eig_ (one row per quantity) for the subsequent calls to
+//! LeftEigenmatrixDotVector() and RightEigenmatrixDotVector() in the same direction.
 //!
-//! The order of the components in the input vector should be:
-//!    (IDN,IVX,IVY,IVZ,[IPR],[IBY,IBZ])
-//! and these are permuted according to the direction specified by the input flag "ivx".
+//! The primitive states w and longitudinal field b1 are ordered as in
+//! LeftEigenmatrixDotVector(), so that the transverse fields are in (IBY,IBZ).
 //!
 //! REFERENCES:
 //! - J. Stone, T. Gardiner, P. Teuben, J. Hawley, & J. Simon "Athena: A new code for
@@ -39,83 +38,169 @@
 //! - Brio, Moysey, and Cheng Chin Wu. "An upwind differencing scheme for the equations of
 //!   ideal magnetohydrodynamics." Journal of computational physics 75.2 (1988): 400-422.
 
+void Reconstruction::ComputeEigensystem(const int il, const int iu,
+                                        const AthenaArray<Real> &b1,
+                                        const AthenaArray<Real> &w) {
+  AthenaArray<Real> &eig = eig_;
+  if (MAGNETIC_FIELDS_ENABLED) {
+    // the isothermal sound speed takes the role of a in the eigenvectors
+    bool adiabatic = NON_BAROTROPIC_EOS;
+    Real gamma = 0.0, iso_cs = 0.0, iso_cs2 = 0.0;
+    if (adiabatic) {
+      gamma = pmy_block_->peos->GetGamma();
+    } else {
+      iso_cs = pmy_block_->peos->GetIsoSoundSpeed();
+      iso_cs2 = SQR(iso_cs);
+    }
+#pragma omp simd simdlen(SIMD_WIDTH)
+    for (int i=il; i<=iu; ++i) {
+      Real id = 1.0/w(IDN,i);
+      Real sqrtd = std::sqrt(w(IDN,i));
+      Real isqrtd = 1.0/sqrtd;
+
+      Real btsq = SQR(w(IBY,i)) + SQR(w(IBZ,i));
+      Real bxsq = b1(i)*b1(i);
+      Real gamp = adiabatic ? gamma*w(IPR,i) : iso_cs2*w(IDN,i);
+
+      // Compute fast- and slow-magnetosonic speeds (eq. A10)
+      Real tdif = bxsq + btsq - gamp;
+      Real cf2_cs2 = std::sqrt(tdif*tdif + 4.0*gamp*btsq);
+
+      Real cfsq = 0.5*(bxsq + btsq + gamp + cf2_cs2);
+      Real cssq = gamp*bxsq/cfsq;
+
+      cfsq *= id;
+      Real cf = std::sqrt(cfsq);
+
+      cssq *= id;
+      Real cs = std::sqrt(cssq);
+
+      Real asq = adiabatic ? gamp*id : iso_cs2;
+      Real a = adiabatic ? std::sqrt(asq) : iso_cs;
+
+      // Compute beta(s) (eq A17)
+      Real bt  = std::sqrt(btsq);
+      // edge case when transverse fields disappear: they can be set arbitrarily, except
+      // cannot both be 0. this preserves orthonormality of the eigenvectors.
+      // See BW88 eq 45, Roe96 pg 60. The right-eigenmatrix uses bet2=bet3=0 instead.
+      Real bet2 = 1.0;
+      Real bet3 = 0.0;
+      Real bet2r = 0.0;
+      Real bet3r = 0.0;
+      if (bt != 0.0) {
+        bet2 = w(IBY,i)/bt;
+        bet3 = w(IBZ,i)/bt;
+        bet2r = bet2;
+        bet3r = bet3;
+      }
+
+      // Compute alpha(s) (eq A16)
+      Real alpha_f, alpha_s;
+      // handle special cases in which bet2=be3=0
+      if ((cfsq - cssq) <= 0.0) { // Roe96 case V (the triple umbilic)
+        // degenerate case mentioned before A18
+        alpha_f = 1.0;
+        alpha_s = 0.0;
+      } else if ( (asq - cssq) <= 0.0) { // Roe96 case IV
+        // low beta; slow waves are regular acoustic waves
+        alpha_f = 0.0;
+        alpha_s = 1.0;
+      } else if ( (cfsq - asq) <= 0.0) { // Roe96 case III
+        // high beta; fast waves are regular acoustic waves
+        alpha_f = 1.0;
+        alpha_s = 0.0;
+      } else {
+        alpha_f = std::sqrt((asq - cssq)/(cfsq - cssq));
+        alpha_s = std::sqrt((cfsq - asq)/(cfsq - cssq));
+      }
 
-void Reconstruction::LeftEigenmatrixDotVector(
-    const int ivx, const int il, const int iu,
-    const AthenaArray<Real> &b1, const AthenaArray<Real> &w, AthenaArray<Real> &vect) {
+      // Compute Q(s) and A(s) (eq. A14-15), etc., with the normalizations of eq. A18
+      // (adiabatic) or A22 (isothermal) for the left-eigenvectors
+      Real s = SIGN(b1(i));
+      Real nf = 0.5/asq;
+      eig(ED,i) = w(IDN,i);
+      eig(EID,i) = id;
+      eig(ESQRTD,i) = sqrtd;
+      eig(EISQRTD,i) = isqrtd;
+      eig(ESIGN,i) = s;
+      eig(ECF,i) = cf;
+      eig(ECS,i) = cs;
+      eig(EASQ,i) = asq;
+      eig(EALPHAF,i) = alpha_f;
+      eig(EALPHAS,i) = alpha_s;
+      eig(EBET2,i) = bet2;
+      eig(EBET3,i) = bet3;
+      eig(EBET2R,i) = bet2r;
+      eig(EBET3R,i) = bet3r;
+      eig(ENF,i) = nf;
+      if (adiabatic) {
+        eig(EQFL,i) = nf*cf*alpha_f*s;
+        eig(EQSL,i) = nf*cs*alpha_s*s;
+      } else {
+        eig(EQFL,i) = 0.5*(cf*alpha_f*s)/iso_cs2;
+        eig(EQSL,i) = 0.5*(cs*alpha_s*s)/iso_cs2;
+      }
+      eig(EAFL,i) = 0.5*alpha_f/(a*sqrtd);
+      eig(EASL,i) = 0.5*alpha_s/(a*sqrtd);
+      eig(EQFR,i) = cf*alpha_f*s;
+      eig(EQSR,i) = cs*alpha_s*s;
+      eig(EAFR,i) = a*alpha_f*sqrtd;
+      eig(EASR,i) = a*alpha_s*sqrtd;
+    }
+  } else {
+    if (NON_BAROTROPIC_EOS) {
+      Real gamma = pmy_block_->peos->GetGamma();
+#pragma omp simd simdlen(SIMD_WIDTH)
+      for (int i=il; i<=iu; ++i) {
+        Real asq = gamma*w(IPR,i)/w(IDN,i);
+        eig(ED,i) = w(IDN,i);
+        eig(EASQ,i) = asq;
+        eig(EA,i) = std::sqrt(asq);
+      }
+    } else {
+#pragma omp simd simdlen(SIMD_WIDTH)
+      for (int i=il; i<=iu; ++i) {
+        eig(ED,i) = w(IDN,i);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Reconstruction::LeftEigenmatrixDotVector()
+//! \brief Computes inner-product of left-eigenmatrix of Roe's matrix A in the primitive
+//! variables and an input vector.  This operation converts primitive to characteristic
+//! variables.  The result is returned in the input vector, with the components of the
+//! characteristic field stored such that vect(1,i) is in the direction of the sweep.
+//!
+//! The eigensystem of each cell must have been cached by ComputeEigensystem() for the
+//! same pencil. The order of the components in the input vector should be:
+//!    (IDN,IVX,IVY,IVZ,[IPR],[IBY,IBZ])
+//! and these are permuted according to the direction specified by the input flag "ivx".
+//!
+//! REFERENCES:
+//! - J. Stone, T. Gardiner, P. Teuben, J. Hawley, & J. Simon "Athena: A new code for
+//!   astrophysical MHD", ApJS, (2008), Appendix A. (Equation numbers refer to this paper)
+
+void Reconstruction::LeftEigenmatrixDotVector(const int ivx, const int il, const int iu,
+                                              AthenaArray<Real> &vect) {
   // permute components of input primitive vector depending on direction
   int ivy = IVX + ((ivx-IVX)+1)%3;
   int ivz = IVX + ((ivx-IVX)+2)%3;
+  const AthenaArray<Real> &eig = eig_;
 
   if (MAGNETIC_FIELDS_ENABLED) {
     // Adiabatic MHD ---------------------------------------------------------------------
     if (NON_BAROTROPIC_EOS) {
-      Real gamma = pmy_block_->peos->GetGamma();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real id = 1.0/w(IDN,i);
-        Real sqrtd = std::sqrt(w(IDN,i));
-        Real isqrtd = 1.0/sqrtd;
-
-        Real btsq = SQR(w(IBY,i)) + SQR(w(IBZ,i));
-        Real bxsq = b1(i)*b1(i);
-        Real gamp = gamma*w(IPR,i);
-
-        // Compute fast- and slow-magnetosonic speeds (eq. A10)
-        Real tdif = bxsq + btsq - gamp;
-        Real cf2_cs2 = std::sqrt(tdif*tdif + 4.0*gamp*btsq);
-
-        Real cfsq = 0.5*(bxsq + btsq + gamp + cf2_cs2);
-        Real cssq = gamp*bxsq/cfsq;
-
-        cfsq *= id;
-        Real cf = std::sqrt(cfsq);
-
-        cssq *= id;
-        Real cs = std::sqrt(cssq);
-
-        Real asq = gamp*id;
-        Real a = std::sqrt(asq);
-
-        // Compute beta(s) (eq A17)
-        Real bt  = std::sqrt(btsq);
-        // edge case when transverse fields disappear: they can be set arbitrarily, except
-        // cannot both be 0. this preserves orthonormality of the eigenvectors.
-        // See BW88 eq 45, Roe96 pg 60
-        Real bet2 = 1.0;
-        Real bet3 = 0.0;
-        if (bt != 0.0) {
-          bet2 = w(IBY,i)/bt;
-          bet3 = w(IBZ,i)/bt;
-        }
-
-        // Compute alpha(s) (eq A16)
-        Real alpha_f, alpha_s;
-        // handle special cases in which bet2=be3=0
-        if ((cfsq - cssq) <= 0.0) { // Roe96 case V (the triple umbilic)
-          // degenerate case mentioned before A18
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else if ( (asq - cssq) <= 0.0) { // Roe96 case IV
-          // low beta; slow waves are regular acoustic waves
-          alpha_f = 0.0;
-          alpha_s = 1.0;
-        } else if ( (cfsq - asq) <= 0.0) { // Roe96 case III
-          // high beta; fast waves are regular acoustic waves
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else {
-          alpha_f = std::sqrt((asq - cssq)/(cfsq - cssq));
-          alpha_s = std::sqrt((cfsq - asq)/(cfsq - cssq));
-        }
-
-        // Compute Q(s) and A(s) (eq. A14-15), etc.
-        Real s = SIGN(b1(i));
-        Real nf = 0.5/asq;
-        Real qf = nf*cf*alpha_f*s;
-        Real qs = nf*cs*alpha_s*s;
-        Real af_prime = 0.5*alpha_f/(a*sqrtd);
-        Real as_prime = 0.5*alpha_s/(a*sqrtd);
+        Real id = eig(EID,i), isqrtd = eig(EISQRTD,i), s = eig(ESIGN,i);
+        Real cf = eig(ECF,i), cs = eig(ECS,i), asq = eig(EASQ,i), nf = eig(ENF,i);
+        Real alpha_f = eig(EALPHAF,i), alpha_s = eig(EALPHAS,i);
+        Real bet2 = eig(EBET2,i), bet3 = eig(EBET3,i);
+        Real qf = eig(EQFL,i), qs = eig(EQSL,i);
+        Real af_prime = eig(EAFL,i), as_prime = eig(EASL,i);
 
         // Multiply row of L-eigenmatrix with vector using matrix elements from eq. A18
         Real v_0 = nf*alpha_f*(vect(IPR,i)*id - cf*vect(ivx,i)) +
@@ -149,60 +234,14 @@ void Reconstruction::LeftEigenmatrixDotVector(
     } else {
       Real iso_cs = pmy_block_->peos->GetIsoSoundSpeed();
       Real iso_cs2 = SQR(iso_cs);
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real id = 1.0/w(IDN,i);
-        Real sqrtd = std::sqrt(w(IDN,i));
-        Real isqrtd = 1.0/sqrtd;
-
-        Real btsq = SQR(w(IBY,i)) + SQR(w(IBZ,i));
-        Real bxsq = b1(i)*b1(i);
-        Real gamp = iso_cs2*w(IDN,i);
-
-        // Compute fast- and slow-magnetosonic speeds (eq. A10)
-        Real tdif = bxsq + btsq - gamp;
-        Real cf2_cs2 = std::sqrt(tdif*tdif + 4.0*gamp*btsq);
-
-        Real cfsq = 0.5*(bxsq + btsq + gamp + cf2_cs2);
-        Real cssq = gamp*bxsq/cfsq;
-
-        cfsq *= id;
-        Real cf = std::sqrt(cfsq);
-
-        cssq *= id;
-        Real cs = std::sqrt(cssq);
-
-        // Compute beta(s) (eq A17)
-        Real bt  = std::sqrt(btsq);
-        Real bet2 = 1.0;  // see above note
-        Real bet3 = 0.0;
-        if (bt != 0.0) {
-          bet2 = w(IBY,i)/bt;
-          bet3 = w(IBZ,i)/bt;
-        }
-
-        // Compute alpha(s) (eq A16)
-        Real alpha_f, alpha_s;
-        if ((cfsq-cssq) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else if ( (iso_cs2 - cssq) <= 0.0) {
-          alpha_f = 0.0;
-          alpha_s = 1.0;
-        } else if ( (cfsq - iso_cs2) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else {
-          alpha_f = std::sqrt((iso_cs2 - cssq)/(cfsq - cssq));
-          alpha_s = std::sqrt((cfsq - iso_cs2)/(cfsq - cssq));
-        }
-
-        // Compute Q(s) and A(s) (eq. A14-15), etc.
-        Real s = SIGN(b1(i));
-        Real qf = 0.5*(cf*alpha_f*s)/iso_cs2;
-        Real qs = 0.5*(cs*alpha_s*s)/iso_cs2;
-        Real af_prime = 0.5*alpha_f/(iso_cs*sqrtd);
-        Real as_prime = 0.5*alpha_s/(iso_cs*sqrtd);
+        Real id = eig(EID,i), isqrtd = eig(EISQRTD,i), s = eig(ESIGN,i);
+        Real cf = eig(ECF,i), cs = eig(ECS,i);
+        Real alpha_f = eig(EALPHAF,i), alpha_s = eig(EALPHAS,i);
+        Real bet2 = eig(EBET2,i), bet3 = eig(EBET3,i);
+        Real qf = eig(EQFL,i), qs = eig(EQSL,i);
+        Real af_prime = eig(EAFL,i), as_prime = eig(EASL,i);
 
         // Multiply row of L-eigenmatrix with vector using matrix elements from eq. A22
         Real v_0 = 0.5*alpha_f*(vect(IDN,i)*id - cf*vect(ivx,i)/iso_cs2) +
@@ -234,18 +273,16 @@ void Reconstruction::LeftEigenmatrixDotVector(
   } else {
     // Adiabatic hydrodynamics -----------------------------------------------------------
     if (NON_BAROTROPIC_EOS) {
-      Real gamma = pmy_block_->peos->GetGamma();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real asq = gamma*w(IPR,i)/w(IDN,i);
-        Real a   = std::sqrt(asq);
+        Real d = eig(ED,i), asq = eig(EASQ,i), a = eig(EA,i);
 
         // Multiply row of L-eigenmatrix with vector using matrix elements from eq. A4
-        Real v_0 = 0.5*(vect(IPR,i)/asq - w(IDN,i)*vect(ivx,i)/a);
+        Real v_0 = 0.5*(vect(IPR,i)/asq - d*vect(ivx,i)/a);
         Real v_1 = vect(IDN,i) - vect(IPR,i)/asq;
         Real v_2 = vect(ivy,i);
         Real v_3 = vect(ivz,i);
-        Real v_4 = 0.5*(vect(IPR,i)/asq + w(IDN,i)*vect(ivx,i)/a);
+        Real v_4 = 0.5*(vect(IPR,i)/asq + d*vect(ivx,i)/a);
 
         vect(0,i) = v_0;
         vect(1,i) = v_1;
@@ -257,13 +294,14 @@ void Reconstruction::LeftEigenmatrixDotVector(
       // Isothermal hydrodynamics --------------------------------------------------------
     } else {
       Real iso_cs = pmy_block_->peos->GetIsoSoundSpeed();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
+        Real d = eig(ED,i);
         // Multiply row of L-eigenmatrix with vector using matrix elements from eq. A7
-        Real v_0 = 0.5*(vect(IDN,i) - w(IDN,i)*vect(ivx,i)/iso_cs);
+        Real v_0 = 0.5*(vect(IDN,i) - d*vect(ivx,i)/iso_cs);
         Real v_1 = vect(ivy,i);
         Real v_2 = vect(ivz,i);
-        Real v_3 = 0.5*(vect(IDN,i) + w(IDN,i)*vect(ivx,i)/iso_cs);
+        Real v_3 = 0.5*(vect(IDN,i) + d*vect(ivx,i)/iso_cs);
 
         vect(0,i) = v_0;
         vect(1,i) = v_1;
@@ -281,7 +319,9 @@ void Reconstruction::LeftEigenmatrixDotVector(
 //! variables and an input vector.  This operation converts characteristic to primitive
 //! variables.  The result is returned in the input vector.
 //!
-//! The order of the components in the input vector (characteristic fields) should be:
+//! The eigensystem of each cell must have been cached by ComputeEigensystem() for the
+//! same pencil. The order of the components in the input vector (characteristic fields)
+//! should be:
 //!    (IDN,ivx,ivy,ivz,[IPR],[IBY,IBZ])
 //! where the lower-case indices indicate that the characteristic field in the direction
 //! of the sweep (designated by the input flag "ivx") is stored first.  On output, the
@@ -291,85 +331,36 @@ void Reconstruction::LeftEigenmatrixDotVector(
 //! - J. Stone, T. Gardiner, P. Teuben, J. Hawley, & J. Simon "Athena: A new code for
 //!   astrophysical MHD", ApJS, (2008), Appendix A.  Equation numbers refer to this paper.
 
-void Reconstruction::RightEigenmatrixDotVector(
-    const int ivx, const int il, const int iu,
-    const AthenaArray<Real> &b1, const AthenaArray<Real> &w, AthenaArray<Real> &vect) {
+void Reconstruction::RightEigenmatrixDotVector(const int ivx, const int il, const int iu,
+                                               AthenaArray<Real> &vect) {
   // permute components of output primitive vector depending on direction
   int ivy = IVX + ((ivx-IVX)+1)%3;
   int ivz = IVX + ((ivx-IVX)+2)%3;
+  const AthenaArray<Real> &eig = eig_;
 
   if (MAGNETIC_FIELDS_ENABLED) {
     // Adiabatic MHD ---------------------------------------------------------------------
     if (NON_BAROTROPIC_EOS) {
-      Real gamma = pmy_block_->peos->GetGamma();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real id = 1.0/w(IDN,i);
-        Real sqrtd = std::sqrt(w(IDN,i));
-
-        Real btsq = SQR(w(IBY,i)) + SQR(w(IBZ,i));
-        Real bxsq = b1(i)*b1(i);
-        Real gamp = gamma*w(IPR,i);
-
-        // Compute fast- and slow-magnetosonic speeds (eq. A10)
-        Real tdif = bxsq + btsq - gamp;
-        Real cf2_cs2 = std::sqrt(tdif*tdif + 4.0*gamp*btsq);
-
-        Real cfsq = 0.5*(bxsq + btsq + gamp + cf2_cs2);
-        Real cssq = gamp*bxsq/cfsq;
-
-        cfsq *= id;
-        Real cf = std::sqrt(cfsq);
-
-        cssq *= id;
-        Real cs = std::sqrt(cssq);
-
-        Real asq = gamp*id;
-        Real a = std::sqrt(asq);
-
-        // Compute beta(s) (eq A17)
-        Real bt  = std::sqrt(btsq);
-        Real bet2 = 0.0;
-        Real bet3 = 0.0;
-        if (bt != 0.0) {
-          bet2 = w(IBY,i)/bt;
-          bet3 = w(IBZ,i)/bt;
-        }
-
-        // Compute alpha(s) (eq A16)
-        Real alpha_f, alpha_s;
-        if ((cfsq - cssq) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else if ( (asq - cssq) <= 0.0) {
-          alpha_f = 0.0;
-          alpha_s = 1.0;
-        } else if ( (cfsq - asq) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else {
-          alpha_f = std::sqrt((asq - cssq)/(cfsq - cssq));
-          alpha_s = std::sqrt((cfsq - asq)/(cfsq - cssq));
-        }
-
-        // Compute Q(s) and A(s) (eq. A14-15), etc.
-        Real s = SIGN(b1(i));
-        Real qf = cf*alpha_f*s;
-        Real qs = cs*alpha_s*s;
-        Real af = a*alpha_f*sqrtd;
-        Real as = a*alpha_s*sqrtd;
+        Real d = eig(ED,i), sqrtd = eig(ESQRTD,i), s = eig(ESIGN,i);
+        Real cf = eig(ECF,i), cs = eig(ECS,i), asq = eig(EASQ,i);
+        Real alpha_f = eig(EALPHAF,i), alpha_s = eig(EALPHAS,i);
+        Real bet2 = eig(EBET2R,i), bet3 = eig(EBET3R,i);
+        Real qf = eig(EQFR,i), qs = eig(EQSR,i);
+        Real af = eig(EAFR,i), as = eig(EASR,i);
 
         // Multiply row of R-eigenmatrix with vector using matrix elements from eq. A12
         // Components of vect() are addressed directly as they are input in permuted order
-        Real v_0 = w(IDN,i)*(alpha_f*(vect(0,i) + vect(6,i)) +
-                             alpha_s*(vect(2,i) + vect(4,i))) + vect(3,i);
+        Real v_0 = d*(alpha_f*(vect(0,i) + vect(6,i)) +
+                      alpha_s*(vect(2,i) + vect(4,i))) + vect(3,i);
         Real v_1 = cf*alpha_f*(vect(6,i)-vect(0,i)) + cs*alpha_s*(vect(4,i)-vect(2,i));
         Real v_2 = bet2*(qs*(vect(0,i) - vect(6,i)) + qf*(vect(4,i) - vect(2,i)))
                    + bet3*(vect(5,i) - vect(1,i));
         Real v_3 = bet3*(qs*(vect(0,i) - vect(6,i)) + qf*(vect(4,i) - vect(2,i)))
                    + bet2*(vect(1,i) - vect(5,i));
-        Real v_4 = w(IDN,i)*asq*(alpha_f*(vect(0,i) + vect(6,i)) +
-                                 alpha_s*(vect(2,i) + vect(4,i)));
+        Real v_4 = d*asq*(alpha_f*(vect(0,i) + vect(6,i)) +
+                          alpha_s*(vect(2,i) + vect(4,i)));
         Real v_5 = bet2*(as*(vect(0,i) + vect(6,i)) - af*(vect(2,i) + vect(4,i)))
                    - bet3*s*sqrtd*(vect(5,i) + vect(1,i));
         Real v_6 = bet3*(as*(vect(0,i) + vect(6,i)) - af*(vect(2,i) + vect(4,i)))
@@ -387,66 +378,19 @@ void Reconstruction::RightEigenmatrixDotVector(
 
       // Isothermal MHD ------------------------------------------------------------------
     } else {
-      Real iso_cs = pmy_block_->peos->GetIsoSoundSpeed();
-      Real iso_cs2 = SQR(iso_cs);
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real id = 1.0/w(IDN,i);
-        Real sqrtd = std::sqrt(w(IDN,i));
-
-        Real btsq = SQR(w(IBY,i)) + SQR(w(IBZ,i));
-        Real bxsq = b1(i)*b1(i);
-        Real gamp = iso_cs2*w(IDN,i);
-
-        // Compute fast- and slow-magnetosonic speeds (eq. A10)
-        Real tdif = bxsq + btsq - gamp;
-        Real cf2_cs2 = std::sqrt(tdif*tdif + 4.0*gamp*btsq);
-
-        Real cfsq = 0.5*(bxsq + btsq + gamp + cf2_cs2);
-        Real cssq = gamp*bxsq/cfsq;
-
-        cfsq *= id;
-        Real cf = std::sqrt(cfsq);
-
-        cssq *= id;
-        Real cs = std::sqrt(cssq);
-
-        // Compute beta(s) (eq A17)
-        Real bt  = std::sqrt(btsq);
-        Real bet2 = 0.0;
-        Real bet3 = 0.0;
-        if (bt != 0.0) {
-          bet2 = w(IBY,i)/bt;
-          bet3 = w(IBZ,i)/bt;
-        }
-
-        // Compute alpha(s) (eq A16)
-        Real alpha_f, alpha_s;
-        if ((cfsq - cssq) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else if ( (iso_cs2 - cssq) <= 0.0) {
-          alpha_f = 0.0;
-          alpha_s = 1.0;
-        } else if ( (cfsq - iso_cs2) <= 0.0) {
-          alpha_f = 1.0;
-          alpha_s = 0.0;
-        } else {
-          alpha_f = std::sqrt((iso_cs2 - cssq)/(cfsq - cssq));
-          alpha_s = std::sqrt((cfsq - iso_cs2)/(cfsq - cssq));
-        }
-
-        // Compute Q(s) and A(s) (eq. A14-15), etc.
-        Real s = SIGN(b1(i));
-        Real qf = cf*alpha_f*s;
-        Real qs = cs*alpha_s*s;
-        Real af = iso_cs*alpha_f*sqrtd;
-        Real as = iso_cs*alpha_s*sqrtd;
+        Real d = eig(ED,i), sqrtd = eig(ESQRTD,i), s = eig(ESIGN,i);
+        Real cf = eig(ECF,i), cs = eig(ECS,i);
+        Real alpha_f = eig(EALPHAF,i), alpha_s = eig(EALPHAS,i);
+        Real bet2 = eig(EBET2R,i), bet3 = eig(EBET3R,i);
+        Real qf = eig(EQFR,i), qs = eig(EQSR,i);
+        Real af = eig(EAFR,i), as = eig(EASR,i);
 
         // Multiply row of R-eigenmatrix with vector using matrix elements from eq. A12
         // Components of vect() are addressed directly as they are input in permuted order
-        Real v_0 = w(IDN,i)*(alpha_f*(vect(0,i) + vect(5,i)) +
-                             alpha_s*(vect(2,i) + vect(3,i)));
+        Real v_0 = d*(alpha_f*(vect(0,i) + vect(5,i)) +
+                      alpha_s*(vect(2,i) + vect(3,i)));
         Real v_1 = cf*alpha_f*(vect(5,i) - vect(0,i)) + cs*alpha_s*(vect(3,i)-vect(2,i));
         Real v_2 = bet2*(qs*(vect(0,i) - vect(5,i)) + qf*(vect(3,i) - vect(2,i)))
                    + bet3*(vect(4,i) - vect(1,i));
@@ -469,16 +413,14 @@ void Reconstruction::RightEigenmatrixDotVector(
   } else {
     // Adiabatic hydrodynamics -----------------------------------------------------------
     if (NON_BAROTROPIC_EOS) {
-      Real gamma = pmy_block_->peos->GetGamma();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
-        Real asq = gamma*w(IPR,i)/w(IDN,i);
-        Real a   = std::sqrt(asq);
+        Real d = eig(ED,i), asq = eig(EASQ,i), a = eig(EA,i);
 
         // Multiply row of R-eigenmatrix with vector using matrix elements from eq. A3
         // Components of vect() are addressed directly as they are input in permuted order
         Real v_0 = vect(0,i) + vect(1,i) + vect(4,i);
-        Real v_1 = a*(vect(4,i) - vect(0,i))/w(IDN,i);
+        Real v_1 = a*(vect(4,i) - vect(0,i))/d;
         Real v_2 = vect(2,i);
         Real v_3 = vect(3,i);
         Real v_4 = asq*(vect(0,i) + vect(4,i));
@@ -494,12 +436,13 @@ void Reconstruction::RightEigenmatrixDotVector(
       // Isothermal hydrodynamics --------------------------------------------------------
     } else {
       Real iso_cs = pmy_block_->peos->GetIsoSoundSpeed();
-#pragma omp simd
+#pragma omp simd simdlen(SIMD_WIDTH)
       for (int i=il; i<=iu; ++i) {
+        Real d = eig(ED,i);
         // Multiply row of R-eigenmatrix with vector using matrix elements from eq. A3
         // Components of vect() are addressed directly as they are input in permuted order
         Real v_0 = vect(0,i) + vect(3,i);
-        Real v_1 = iso_cs*(vect(3,i) - vect(0,i))/w(IDN,i);
+        Real v_1 = iso_cs*(vect(3,i) - vect(0,i))/d;
         Real v_2 = vect(1,i);
         Real v_3 = vect(2,i);
 
@@ -60,8 +60,9 @@ void Reconstruction::PiecewiseLinearX1(
   // Project slopes to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVX,IVY,IVZ)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, dwl);
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, dwr);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVX, il, iu, dwl);
+    LeftEigenmatrixDotVector(IVX, il, iu, dwr);
   }
 
   // Apply simplified van Leer (VL) limiter expression for a Cartesian-like coordinate
@@ -106,7 +107,7 @@ void Reconstruction::PiecewiseLinearX1(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVX, il, iu, bx, wc, dwm);
+    RightEigenmatrixDotVector(IVX, il, iu, dwm);
   }
 
   // compute ql_(i+1/2) and qr_(i-1/2) using limited slopes
@@ -174,8 +175,9 @@ void Reconstruction::PiecewiseLinearX2(
   // Project slopes to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVY,IVZ,IVX)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, dwl);
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, dwr);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVY, il, iu, dwl);
+    LeftEigenmatrixDotVector(IVY, il, iu, dwr);
   }
 
   // Apply simplified van Leer (VL) limiter expression for a Cartesian-like coordinate
@@ -218,7 +220,7 @@ void Reconstruction::PiecewiseLinearX2(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVY, il, iu, bx, wc, dwm);
+    RightEigenmatrixDotVector(IVY, il, iu, dwm);
   }
 
   // compute ql_(j+1/2) and qr_(j-1/2) using limited slopes
@@ -287,8 +289,9 @@ void Reconstruction::PiecewiseLinearX3(
   // Project slopes to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVZ,IVX,IVY)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, dwl);
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, dwr);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVZ, il, iu, dwl);
+    LeftEigenmatrixDotVector(IVZ, il, iu, dwr);
   }
 
 
@@ -325,7 +328,7 @@ void Reconstruction::PiecewiseLinearX3(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVZ, il, iu, bx, wc, dwm);
+    RightEigenmatrixDotVector(IVZ, il, iu, dwm);
   }
 
   // compute ql_(k+1/2) and qr_(k-1/2) using limited slopes
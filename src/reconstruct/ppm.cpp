@@ -99,11 +99,12 @@ void Reconstruction::PiecewiseParabolicX1(
   // Project cell-averages to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVX,IVY,IVZ)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, q_im2);
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, q_im1);
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, q);
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, q_ip1);
-    LeftEigenmatrixDotVector(IVX, il, iu, bx, wc, q_ip2);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVX, il, iu, q_im2);
+    LeftEigenmatrixDotVector(IVX, il, iu, q_im1);
+    LeftEigenmatrixDotVector(IVX, il, iu, q);
+    LeftEigenmatrixDotVector(IVX, il, iu, q_ip1);
+    LeftEigenmatrixDotVector(IVX, il, iu, q_ip2);
   }
 
   //--- Step 1. --------------------------------------------------------------------------
@@ -311,8 +312,8 @@ void Reconstruction::PiecewiseParabolicX1(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVX, il, iu, bx, wc, ql_iph);
-    RightEigenmatrixDotVector(IVX, il, iu, bx, wc, qr_imh);
+    RightEigenmatrixDotVector(IVX, il, iu, ql_iph);
+    RightEigenmatrixDotVector(IVX, il, iu, qr_imh);
   }
 
   // compute ql_(i+1/2) and qr_(i-1/2)
@@ -399,11 +400,12 @@ void Reconstruction::PiecewiseParabolicX2(
   // Project cell-averages to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVY,IVZ,IVX)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, q_jm2);
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, q_jm1);
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, q);
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, q_jp1);
-    LeftEigenmatrixDotVector(IVY, il, iu, bx, wc, q_jp2);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVY, il, iu, q_jm2);
+    LeftEigenmatrixDotVector(IVY, il, iu, q_jm1);
+    LeftEigenmatrixDotVector(IVY, il, iu, q);
+    LeftEigenmatrixDotVector(IVY, il, iu, q_jp1);
+    LeftEigenmatrixDotVector(IVY, il, iu, q_jp2);
   }
 
   //--- Step 1. ------------------------------------------------------------------------
@@ -610,8 +612,8 @@ void Reconstruction::PiecewiseParabolicX2(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVY, il, iu, bx, wc, ql_jph);
-    RightEigenmatrixDotVector(IVY, il, iu, bx, wc, qr_jmh);
+    RightEigenmatrixDotVector(IVY, il, iu, ql_jph);
+    RightEigenmatrixDotVector(IVY, il, iu, qr_jmh);
   }
 
   // compute ql_(j+1/2) and qr_(j-1/2)
@@ -697,11 +699,12 @@ void Reconstruction::PiecewiseParabolicX3(
   // Project cell-averages to characteristic variables, if necessary
   // Note order of characteristic fields in output vect corresponds to (IVZ,IVX,IVY)
   if (characteristic_projection) {
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, q_km2);
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, q_km1);
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, q);
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, q_kp1);
-    LeftEigenmatrixDotVector(IVZ, il, iu, bx, wc, q_kp2);
+    ComputeEigensystem(il, iu, bx, wc);
+    LeftEigenmatrixDotVector(IVZ, il, iu, q_km2);
+    LeftEigenmatrixDotVector(IVZ, il, iu, q_km1);
+    LeftEigenmatrixDotVector(IVZ, il, iu, q);
+    LeftEigenmatrixDotVector(IVZ, il, iu, q_kp1);
+    LeftEigenmatrixDotVector(IVZ, il, iu, q_kp2);
   }
 
   //--- Step 1. -------------------------------------------------------------------------
@@ -901,8 +904,8 @@ void Reconstruction::PiecewiseParabolicX3(
 
   // Project limited slope back to primitive variables, if necessary
   if (characteristic_projection) {
-    RightEigenmatrixDotVector(IVZ, il, iu, bx, wc, ql_kph);
-    RightEigenmatrixDotVector(IVZ, il, iu, bx, wc, qr_kmh);
+    RightEigenmatrixDotVector(IVZ, il, iu, ql_kph);
+    RightEigenmatrixDotVector(IVZ, il, iu, qr_kmh);
   }
 
   // compute ql_(k+1/2) and qr_(k-1/2)
@@ -239,6 +239,7 @@ Reconstruction::Reconstruction(MeshBlock *pmb, ParameterInput *pin) :
   scr2_ni_.NewAthenaArray(nsize, nc1);
   scr3_ni_.NewAthenaArray(nsize, nc1);
   scr4_ni_.NewAthenaArray(nsize, nc1);
+  eig_.NewAthenaArray(NEIGEN, nc1);
 
   scr1_in_.NewAthenaArray(nvar_, nc1);
   scr2_in_.NewAthenaArray(nvar_, nc1);
@@ -47,13 +47,14 @@ class Reconstruction {
   AthenaArray<Real> hplus_ratio_k, hminus_ratio_k; // for curvilinear PPMx3
 
   // functions
-  // linear transformations of vectors between primitive and characteristic variables
-  void LeftEigenmatrixDotVector(
-      const int ivx, const int il, const int iu,
-      const AthenaArray<Real> &b1, const AthenaArray<Real> &w, AthenaArray<Real> &vect);
-  void RightEigenmatrixDotVector(
-      const int ivx, const int il, const int iu,
-      const AthenaArray<Real> &b1, const AthenaArray<Real> &w, AthenaArray<Real> &vect);
+  // linear transformations of vectors between primitive and characteristic variables,
+  // using the eigensystem of the pencil cached by ComputeEigensystem()
+  void ComputeEigensystem(const int il, const int iu,
+                          const AthenaArray<Real> &b1, const AthenaArray<Real> &w);
+  void LeftEigenmatrixDotVector(const int ivx, const int il, const int iu,
+                                AthenaArray<Real> &vect);
+  void RightEigenmatrixDotVector(const int ivx, const int il, const int iu,
+                                 AthenaArray<Real> &vect);
 
   // reconstruction functions of various orders in each dimension
   void DonorCellX1(const int k, const int j, const int il, const int iu,
@@ -194,6 +195,14 @@ class Reconstruction {
   AthenaArray<Real> scr1_ni_, scr2_ni_, scr3_ni_, scr4_ni_, scr5_ni_;
   AthenaArray<Real> scr6_ni_, scr7_ni_, scr8_ni_;
 
+  // rows of eig_, the per-cell eigensystem of the current pencil (SoA): density and its
+  // powers, sign(bx), fast/slow/sound speeds, alpha(s) and beta(s), and the coefficients
+  // of the left (L) and right (R) eigenmatrices
+  enum EigenIndex {ED, EID, ESQRTD, EISQRTD, ESIGN, ECF, ECS, EASQ, EA, EALPHAF, EALPHAS,
+                   EBET2, EBET3, EBET2R, EBET3R, ENF, EQFL, EQSL, EAFL, EASL,
+                   EQFR, EQSR, EAFR, EASR, NEIGEN};
+  AthenaArray<Real> eig_;
+
   // scratch arrays for arrays with different ordering
   int nvar_;// the maximum numver of variables for reconstruction
   AthenaArray<Real> scr1_in_, scr2_in_, scr3_in_, scr4_in_, scr5_in_;
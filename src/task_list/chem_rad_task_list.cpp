@@ -15,6 +15,7 @@
 // Athena++ classes headers
 #include "../athena.hpp"
 #include "../chem_rad/chem_rad.hpp"
+#include "../chem_rad/column_scan.hpp"
 #include "../chem_rad/integrators/rad_integrators.hpp"
 #include "../defs.hpp"
 #include "../mesh/mesh.hpp"
@@ -24,11 +25,33 @@
 //--------------------------------------------------------------------------------------
 //! ChemRadiationIntegratorTaskList constructor
 ChemRadiationIntegratorTaskList::ChemRadiationIntegratorTaskList(ParameterInput *pin,
-                                                                 Mesh *pm) {
+                                                                 Mesh *pm)
+    : pcolscan_(nullptr) {
   integrator = CHEMRADIATION_INTEGRATOR;
+  // "scan" combines whole block lines, so it only handles the six grid-aligned rays;
+  // angle sets with more rays (e.g. HEALPix) cross blocks diagonally and need "sweep"
+  column_solver = pin->GetOrAddString("chem_radiation", "column_solver", "sweep");
   // Now assemble list of tasks for each step of chemistry integrator
   {using namespace ChemRadiationIntegratorTaskNames; // NOLINT (build/namespace)
-    if (integrator == "six_ray") {
+    if (integrator == "six_ray" && column_solver == "scan") {
+      // block-local columns only; blocks are combined by ColumnDensityScan and the
+      // radiation is updated in DoIntegration()
+      AddTask(GET_COL_MB_IX1,NONE);
+      AddTask(GET_COL_MB_OX1,NONE);
+      AddTask(GET_COL_MB_IX2,NONE);
+      AddTask(GET_COL_MB_OX2,NONE);
+      AddTask(GET_COL_MB_IX3,NONE);
+      AddTask(GET_COL_MB_OX3,NONE);
+      if (CHEMISTRY_ENABLED) {
+        pcolscan_ = new ColumnDensityScan(pm);
+      }
+    } else if (integrator == "six_ray" && column_solver != "sweep") {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in ChemRadiationIntegratorTaskList constructor" << std::endl
+        << "column_solver=" << column_solver << " not valid, "
+        << std::endl << "choose from {sweep, scan}" << std::endl;
+      ATHENA_ERROR(msg);
+    } else if (integrator == "six_ray") {
       AddTask(GET_COL_MB_IX1,NONE);
       AddTask(RECV_SEND_COL_IX1,GET_COL_MB_IX1);
       AddTask(GET_COL_MB_OX1,NONE);
@@ -58,6 +81,31 @@ ChemRadiationIntegratorTaskList::ChemRadiationIntegratorTaskList(ParameterInput
   } // end of using namespace block
 }
 
+//--------------------------------------------------------------------------------------
+//! ChemRadiationIntegratorTaskList destructor
+ChemRadiationIntegratorTaskList::~ChemRadiationIntegratorTaskList() {
+  delete pcolscan_;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ChemRadiationIntegratorTaskList::DoIntegration(Mesh *pm)
+//! \brief update the radiation field on all MeshBlocks. With column_solver=scan the task
+//! list only computes block-local columns, which are then combined across blocks by a
+//! parallel prefix scan before the radiation is updated.
+void ChemRadiationIntegratorTaskList::DoIntegration(Mesh *pm) {
+  DoTaskListOneStage(pm, 1);
+  if (pcolscan_ != nullptr) {
+    pcolscan_->Execute();
+    int nthreads = pm->GetNumMeshThreads();
+    int nmb = pm->nblocal;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+    for (int i=0; i<nmb; ++i) {
+      UpdateRadiationSixRay(pm->my_blocks(i), 1);
+    }
+  }
+  return;
+}
+
 //--------------------------------------------------------------------------------------
 //! \fn void ChemRadiationIntegratorTaskList::AddTask(const TaskID& id, const TaskID& dep)
 //! \brief Sets id and dependency for "ntask" member of task_list_ array, then iterates
@@ -141,7 +189,7 @@ void ChemRadiationIntegratorTaskList::AddTask(const TaskID& id, const TaskID& de
 //! \fn void ChemRadiationIntegratorTaskList::StartupTaskList(MeshBlock *pmb, int stage)
 //! \brief Initialize boundary
 void ChemRadiationIntegratorTaskList::StartupTaskList(MeshBlock *pmb, int stage) {
-  if (CHEMISTRY_ENABLED && integrator == "six_ray") {
+  if (CHEMISTRY_ENABLED && integrator == "six_ray" && column_solver == "sweep") {
     pmb->pchemrad->pchemradintegrator->col_bvar.StartReceiving(BoundaryCommSubset::all);
   }
   return;
@@ -22,6 +22,7 @@
 // forward declarations
 class Mesh;
 class MeshBlock;
+class ColumnDensityScan;
 
 //--------------------------------------------------------------------------------------
 //! \class ChemRadiationIntegratorTaskList
@@ -31,7 +32,11 @@ class ChemRadiationIntegratorTaskList : public TaskList {
   friend class ChemRadIntegrator;
  public:
   ChemRadiationIntegratorTaskList(ParameterInput *pin, Mesh *pm);
+  ~ChemRadiationIntegratorTaskList();
   std::string integrator;
+  std::string column_solver; // six-ray: block-to-block "sweep" or prefix "scan"
+
+  void DoIntegration(Mesh *pm);
 
   // six-ray
   enum TaskStatus GetColMB_ix1(MeshBlock *pmb, int step);
@@ -55,6 +60,7 @@ class ChemRadiationIntegratorTaskList : public TaskList {
   void StartupTaskList(MeshBlock *pmb, int stage) override;
   void AddTask(const TaskID& id, const TaskID& dep) override;
   enum TaskStatus RecvAndSend_direction(MeshBlock *pmb, int step, BoundaryFace direction);
+  ColumnDensityScan *pcolscan_;
 };
 
 
@@ -0,0 +1,291 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file im_cr_task_list.cpp
+//! \brief function implementation for the task lists of the implicit cosmic rays
+
+// C headers
+
+// C++ headers
+#include <iostream>   // endl
+#include <sstream>    // sstream
+#include <stdexcept>  // runtime_error
+#include <string>     // c_str()
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../bvals/bvals.hpp"
+#include "../cr/cr.hpp"
+#include "../cr/implicit/cr_implicit.hpp"
+#include "../cr/integrators/cr_integrators.hpp"
+#include "../eos/eos.hpp"
+#include "../field/field.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../scalars/scalars.hpp"
+#include "../utils/perf_counters.hpp"
+#include "im_cr_task_list.hpp"
+
+//----------------------------------------------------------------------------------------
+//! IMCRITTaskList constructor
+
+IMCRITTaskList::IMCRITTaskList(Mesh *pm) {
+  pmy_mesh = pm;
+  {using namespace IMCRITTaskNames; // NOLINT (build/namespace)
+    AddTask(FLX_AND_SRC,NONE);
+    AddTask(SEND_CR_BND,FLX_AND_SRC);
+    AddTask(RECV_CR_BND,FLX_AND_SRC);
+    AddTask(SETB_CR_BND,(RECV_CR_BND|SEND_CR_BND));
+    if (pm->multilevel) {
+      AddTask(PRLN_CR_BND,SETB_CR_BND);
+      AddTask(CR_PHYS_BND,PRLN_CR_BND);
+    } else {
+      AddTask(CR_PHYS_BND,SETB_CR_BND);
+    }
+    AddTask(CLEAR_CR, CR_PHYS_BND);
+    // check residual does not need ghost zones
+    AddTask(CHK_CR_RES,FLX_AND_SRC);
+  } // end of using namespace block
+}
+
+void IMCRITTaskList::AddTask(const TaskID& id, const TaskID& dep) {
+  task_list_[ntasks].task_id=id;
+  task_list_[ntasks].dependency=dep;
+
+  using namespace IMCRITTaskNames; // NOLINT (build/namespace)
+  if (id == CLEAR_CR) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::ClearCRBoundary);
+  } else if (id == SEND_CR_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::SendCRBoundary);
+  } else if (id == RECV_CR_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::ReceiveCRBoundary);
+  } else if (id == SETB_CR_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::SetCRBoundary);
+  } else if (id == CR_PHYS_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::CRPhysicalBoundary);
+  } else if (id == PRLN_CR_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::ProlongateBoundary);
+  } else if (id == CHK_CR_RES) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::CheckResidual);
+  } else if (id == FLX_AND_SRC) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRITTaskList::AddFluxAndSourceTerms);
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in IMCRITTaskList::AddTask" << std::endl
+        << "Invalid Task is specified" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  ntasks++;
+  return;
+}
+
+TaskStatus IMCRITTaskList::AddFluxAndSourceTerms(MeshBlock *pmb) {
+  CosmicRay *pcr = pmb->pcr;
+  pcr->pcrintegrator->ImplicitFluxAndSource(dt, pmb->phydro->u, pcr->u_cr2,
+                                            pcr->u_cr_old, pcr->u_cr);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::ClearCRBoundary(MeshBlock *pmb) {
+  pmb->pcr->cr_bvar.ClearBoundary(BoundaryCommSubset::radiation);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::SendCRBoundary(MeshBlock *pmb) {
+  pmb->pcr->cr_bvar.SendBoundaryBuffers();
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::ReceiveCRBoundary(MeshBlock *pmb) {
+  bool ret = pmb->pcr->cr_bvar.ReceiveBoundaryBuffers();
+  if (!ret) {
+    return TaskStatus::fail;
+  }
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::SetCRBoundary(MeshBlock *pmb) {
+  pmb->pcr->cr_bvar.SetBoundaries();
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::CRPhysicalBoundary(MeshBlock *pmb) {
+  pmb->pbval->ApplyPhysicalBoundaries(time, dt, pmb->pbval->bvars_main_int);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRITTaskList::CheckResidual(MeshBlock *pmb) {
+  pmy_mesh->pimcr->CheckResidual(pmb, pmb->pcr->u_cr_old, pmb->pcr->u_cr);
+  return TaskStatus::success;
+}
+
+void IMCRITTaskList::StartupTaskList(MeshBlock *pmb) {
+  // the cosmic rays are not part of bvars_main_int in the implicit case,
+  // and the radiation subset exchanges the ghost zones without flux correction
+  pmb->pcr->cr_bvar.StartReceiving(BoundaryCommSubset::radiation);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! IMCRHydroTaskList constructor
+
+IMCRHydroTaskList::IMCRHydroTaskList(Mesh *pm) {
+  pmy_mesh = pm;
+  {using namespace IMCRHydroTaskNames; // NOLINT (build/namespace)
+    AddTask(ADD_CR_SRC,NONE);
+    AddTask(SEND_HYD_BND,ADD_CR_SRC);
+    AddTask(RECV_HYD_BND,NONE);
+    AddTask(SETB_HYD_BND,(RECV_HYD_BND|SEND_HYD_BND));
+    if (pm->multilevel) {
+      AddTask(PRLN_HYD_BND,SETB_HYD_BND);
+      AddTask(CONS_TO_PRIM,PRLN_HYD_BND);
+    } else {
+      AddTask(CONS_TO_PRIM,SETB_HYD_BND);
+    }
+    AddTask(HYD_PHYS_BND,CONS_TO_PRIM);
+    AddTask(CLEAR_HYD, HYD_PHYS_BND);
+    AddTask(UPD_OPA,HYD_PHYS_BND);
+  } // end of using namespace block
+}
+
+void IMCRHydroTaskList::AddTask(const TaskID& id, const TaskID& dep) {
+  task_list_[ntasks].task_id=id;
+  task_list_[ntasks].dependency=dep;
+
+  using namespace IMCRHydroTaskNames; // NOLINT (build/namespace)
+  if (id == CLEAR_HYD) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::ClearHydroBoundary);
+  } else if (id == SEND_HYD_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::SendHydroBoundary);
+  } else if (id == RECV_HYD_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::ReceiveHydroBoundary);
+  } else if (id == SETB_HYD_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::SetHydroBoundary);
+  } else if (id == HYD_PHYS_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::HydroPhysicalBoundary);
+  } else if (id == PRLN_HYD_BND) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::ProlongateBoundary);
+  } else if (id == UPD_OPA) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::UpdateOpacity);
+  } else if (id == ADD_CR_SRC) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::AddCRSource);
+  } else if (id == CONS_TO_PRIM) {
+    task_list_[ntasks].TaskFunc=
+        static_cast<TaskStatus (IMRadTaskList::*)(MeshBlock*)>
+        (&IMCRHydroTaskList::Primitive);
+  } else {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in IMCRHydroTaskList::AddTask" << std::endl
+        << "Invalid Task is specified" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  ntasks++;
+  return;
+}
+
+TaskStatus IMCRHydroTaskList::ClearHydroBoundary(MeshBlock *pmb) {
+  pmb->phydro->hbvar.ClearBoundary(BoundaryCommSubset::radhydro);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::SendHydroBoundary(MeshBlock *pmb) {
+  pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u, HydroBoundaryQuantity::cons);
+  pmb->phydro->hbvar.SendBoundaryBuffers();
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::ReceiveHydroBoundary(MeshBlock *pmb) {
+  bool ret = pmb->phydro->hbvar.ReceiveBoundaryBuffers();
+  if (!ret)
+    return TaskStatus::fail;
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::SetHydroBoundary(MeshBlock *pmb) {
+  pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u, HydroBoundaryQuantity::cons);
+  pmb->phydro->hbvar.SetBoundaries();
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::HydroPhysicalBoundary(MeshBlock *pmb) {
+  pmb->pbval->ApplyPhysicalBoundaries(time, dt, pmb->pbval->bvars_main_int);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::Primitive(MeshBlock *pmb) {
+  Hydro *ph = pmb->phydro;
+  Field *pf = pmb->pfield;
+  PassiveScalars *ps = pmb->pscalars;
+  BoundaryValues *pbval = pmb->pbval;
+  int il = pmb->is, iu = pmb->ie, jl = pmb->js, ju = pmb->je, kl = pmb->ks, ku = pmb->ke;
+  if (pbval->nblevel[1][1][0] != -1) il -= NGHOST;
+  if (pbval->nblevel[1][1][2] != -1) iu += NGHOST;
+  if (pbval->nblevel[1][0][1] != -1) jl -= NGHOST;
+  if (pbval->nblevel[1][2][1] != -1) ju += NGHOST;
+  if (pbval->nblevel[0][1][1] != -1) kl -= NGHOST;
+  if (pbval->nblevel[2][1][1] != -1) ku += NGHOST;
+  {
+    PerfCounters::Scope perf(PerfCounters::cons2prim, (iu-il+1)*(ju-jl+1)*(ku-kl+1));
+    pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
+                                    ph->w1, pf->bcc, pmb->pcoord,
+                                    il, iu, jl, ju, kl, ku);
+  }
+  if (NSCALARS > 0) {
+    pmb->peos->PassiveScalarConservedToPrimitive(ps->s, ph->u, ps->r, ps->r,
+                                                 pmb->pcoord, il, iu, jl, ju, kl, ku);
+  }
+  ph->w.SwapAthenaArray(ph->w1);
+
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::UpdateOpacity(MeshBlock *pmb) {
+  CosmicRay *pcr = pmb->pcr;
+  pcr->UpdateOpacity(pmb, pcr->u_cr, pmb->phydro->w, pmb->pfield->bcc);
+  return TaskStatus::success;
+}
+
+TaskStatus IMCRHydroTaskList::AddCRSource(MeshBlock *pmb) {
+  CosmicRay *pcr = pmb->pcr;
+  pcr->pcrintegrator->AddImplicitSourceTerms(pmb, dt, pmb->phydro->u, pcr->u_cr);
+  return TaskStatus::success;
+}
+
+void IMCRHydroTaskList::StartupTaskList(MeshBlock *pmb) {
+  pmb->phydro->hbvar.StartReceiving(BoundaryCommSubset::radhydro);
+  return;
+}
@@ -0,0 +1,97 @@
+#ifndef TASK_LIST_IM_CR_TASK_LIST_HPP_
+#define TASK_LIST_IM_CR_TASK_LIST_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file im_cr_task_list.hpp
+//! \brief task lists for the iterations of the implicit cosmic ray transport and the
+//! hydro update after them. They reuse the IMRadTaskList driver.
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "./im_rad_task_list.hpp"
+#include "./task_list.hpp"
+
+// forward declarations
+class Mesh;
+class MeshBlock;
+
+//----------------------------------------------------------------------------------------
+//! IMCRITTaskList
+//! Derived Class to handle one iteration of the cosmic ray transport
+
+class IMCRITTaskList : public IMRadTaskList {
+ public:
+  explicit IMCRITTaskList(Mesh *pm);
+
+  TaskStatus ClearCRBoundary(MeshBlock *pmb);
+  TaskStatus SendCRBoundary(MeshBlock *pmb);
+  TaskStatus ReceiveCRBoundary(MeshBlock *pmb);
+  TaskStatus SetCRBoundary(MeshBlock *pmb);
+  TaskStatus CRPhysicalBoundary(MeshBlock *pmb);
+  TaskStatus CheckResidual(MeshBlock *pmb);
+  TaskStatus AddFluxAndSourceTerms(MeshBlock *pmb);
+
+ private:
+  void StartupTaskList(MeshBlock *pmb) override;
+  void AddTask(const TaskID& id, const TaskID& dep) override;
+};
+
+//----------------------------------------------
+//! IMCRHydroTaskList
+//! Derived Class to add the cosmic ray source terms to the gas and update the gas
+//! boundary and the opacity afterwards
+
+class IMCRHydroTaskList : public IMRadTaskList {
+ public:
+  explicit IMCRHydroTaskList(Mesh *pm);
+
+  TaskStatus ClearHydroBoundary(MeshBlock *pmb);
+  TaskStatus SendHydroBoundary(MeshBlock *pmb);
+  TaskStatus ReceiveHydroBoundary(MeshBlock *pmb);
+  TaskStatus SetHydroBoundary(MeshBlock *pmb);
+  TaskStatus HydroPhysicalBoundary(MeshBlock *pmb);
+  TaskStatus UpdateOpacity(MeshBlock *pmb);
+  TaskStatus AddCRSource(MeshBlock *pmb);
+  TaskStatus Primitive(MeshBlock *pmb);
+
+ private:
+  void StartupTaskList(MeshBlock *pmb) override;
+  void AddTask(const TaskID& id, const TaskID& dep) override;
+};
+
+//----------------------------------------------------------------------------------------
+//! 64-bit integers with "1" in different bit positions used to ID each IMCRIT task.
+
+namespace IMCRITTaskNames {
+const TaskID NONE(0);
+const TaskID CLEAR_CR(1);     // clear cosmic ray boundary
+const TaskID SEND_CR_BND(2);  // send cosmic ray boundary
+const TaskID RECV_CR_BND(3);  // receive cosmic ray boundary
+const TaskID SETB_CR_BND(4);  // set cosmic ray boundary
+const TaskID CR_PHYS_BND(5);  // cosmic ray physical boundary
+const TaskID PRLN_CR_BND(6);  // prolongation
+const TaskID CHK_CR_RES(7);   // check residual
+const TaskID FLX_AND_SRC(8);  // one iteration of the flux and source terms
+} // namespace IMCRITTaskNames
+
+namespace IMCRHydroTaskNames {
+const TaskID NONE(0);
+const TaskID CLEAR_HYD(1);    // clear hydro boundary
+const TaskID SEND_HYD_BND(2); // send hydro boundary
+const TaskID RECV_HYD_BND(3); // receive hydro boundary
+const TaskID SETB_HYD_BND(4); // set hydro boundary
+const TaskID HYD_PHYS_BND(5); // hydro physical boundary
+const TaskID PRLN_HYD_BND(6); // prolongation
+const TaskID UPD_OPA(7);      // update the cosmic ray opacity
+const TaskID ADD_CR_SRC(8);   // add cosmic ray source term to the gas
+const TaskID CONS_TO_PRIM(9); // convert conservative to primitive variables
+} // namespace IMCRHydroTaskNames
+
+#endif // TASK_LIST_IM_CR_TASK_LIST_HPP_
@@ -25,6 +25,7 @@
 #include "../nr_radiation/integrators/rad_integrators.hpp"
 #include "../nr_radiation/radiation.hpp"
 #include "../scalars/scalars.hpp"
+#include "../utils/perf_counters.hpp"
 #include "./im_rad_task_list.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -175,9 +176,12 @@ TaskStatus IMRadHydroTaskList::Primitive(MeshBlock *pmb) {
   if (pbval->nblevel[1][2][1] != -1) ju += NGHOST;
   if (pbval->nblevel[0][1][1] != -1) kl -= NGHOST;
   if (pbval->nblevel[2][1][1] != -1) ku += NGHOST;
-  pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
-                                  ph->w1, pf->bcc, pmb->pcoord,
-                                  il, iu, jl, ju, kl, ku);
+  {
+    PerfCounters::Scope perf(PerfCounters::cons2prim, (iu-il+1)*(ju-jl+1)*(ku-kl+1));
+    pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
+                                    ph->w1, pf->bcc, pmb->pcoord,
+                                    il, iu, jl, ju, kl, ku);
+  }
   if (NSCALARS > 0) {
     // r1/r_old for GR is currently unused:
     pmb->peos->PassiveScalarConservedToPrimitive(ps->s, ph->u, ps->r, ps->r,
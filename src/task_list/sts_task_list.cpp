@@ -86,8 +86,9 @@ SuperTimeStepTaskList::SuperTimeStepTaskList(
         sts_idx_subset.push_back(IEN);
       }
     }
-    if (pmb->phydro->hdif.kappa_iso > 0.0
-        || pmb->phydro->hdif.kappa_aniso > 0.0) {
+    if ((pmb->phydro->hdif.kappa_iso > 0.0
+         || pmb->phydro->hdif.kappa_aniso > 0.0)
+        && !pmb->phydro->hdif.implicit_conduction) {
       if (!std::binary_search(sts_idx_subset.begin(), sts_idx_subset.end(), IEN)) {
         sts_idx_subset.push_back(IEN);
       }
@@ -16,6 +16,7 @@
 #include "../athena.hpp"
 #include "../globals.hpp"
 #include "../mesh/mesh.hpp"
+#include "../utils/task_trace.hpp"
 #include "task_list.hpp"
 
 #ifdef OPENMP_PARALLEL
@@ -38,7 +39,11 @@ TaskListStatus TaskList::DoAllAvailableTasks(MeshBlock *pmb, int stage, TaskStat
       // check if dependency clear
       if (ts.finished_tasks.CheckDependencies(taski.dependency)) {
         if (taski.lb_time) pmb->StartTimeMeasurement();
+        double tt0 = TaskTrace::enabled ? TaskTrace::Now() : 0.0;
         ret = (this->*task_list_[i].TaskFunc)(pmb, stage);
+        if (TaskTrace::enabled)
+          TaskTrace::Record(taski.name ? taski.name : TaskTrace::DefaultName(i), pmb->gid,
+                            stage, tt0, TaskTrace::Now(), ret == TaskStatus::fail);
         if (taski.lb_time) pmb->StopTimeMeasurement();
         if (ret != TaskStatus::fail) { // success
           ts.num_tasks_left--;
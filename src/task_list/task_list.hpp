@@ -74,6 +74,7 @@ struct Task { // aggregate and POD
                      //!> HydroIntegratorTaskNames
   TaskStatus (TaskList::*TaskFunc)(MeshBlock*, int);  //!> ptr to member function
   bool lb_time; //!> flag for automatic load balancing based on timing
+  const char *name; //!> label of the task in TaskTrace output, may be nullptr
 };
 
 //---------------------------------------------------------------------------------------
@@ -123,6 +124,7 @@ class TaskList {
 
 class TimeIntegratorTaskList : public TaskList {
   friend class IMRadiation;
+  friend class IMCosmicRay;
  public:
   TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm);
 
@@ -236,6 +238,8 @@ class TimeIntegratorTaskList : public TaskList {
   TaskStatus CRTCOpacity(MeshBlock *pmb, int stage);
 
   bool CheckNextMainStage(int stage) const {return stage_wghts[stage%nstages].main_stage;}
+  //! fraction of dt at which the given stage ends
+  Real StageEndTime(int stage) const {return stage_wghts[stage-1].ebeta;}
 
  private:
   bool ORBITAL_ADVECTION; // flag for orbital advection (true w/ , false w/o)
@@ -294,98 +298,42 @@ class SuperTimeStepTaskList : public TaskList {
 //! \todo (felker):
 //! - uncomment the reserved TASK_NAMES once the features are merged to master
 namespace HydroIntegratorTaskNames {
-
-const TaskID NONE(0);
-const TaskID CLEAR_ALLBND(1);
-
-const TaskID CALC_HYDFLX(2);
-const TaskID CALC_FLDFLX(3);
-const TaskID CALC_RADFLX(4);
-
-const TaskID SEND_HYDFLX(5);
-const TaskID SEND_FLDFLX(6);
-const TaskID SEND_RADFLX(7);
-const TaskID SEND_CRTCFLX(8);
-
-const TaskID RECV_HYDFLX(9);
-const TaskID RECV_FLDFLX(10);
-const TaskID RECV_RADFLX(11);
-const TaskID RECV_CRTCFLX(12);
-
-const TaskID SRC_TERM(13);
-const TaskID SRCTERM_CRTC(14);
-const TaskID SRCTERM_RAD(15);
-
-const TaskID INT_CRTC(16);
-const TaskID INT_HYD(17);
-const TaskID INT_FLD(18);
-const TaskID INT_RAD(19);
-const TaskID INT_CHM(20);
-
-const TaskID SEND_CRTC(21);
-const TaskID SEND_HYD(22);
-const TaskID SEND_FLD(23);
-const TaskID SEND_RAD(24);
-
-const TaskID RECV_CRTC(25);
-const TaskID RECV_HYD(26);
-const TaskID RECV_FLD(27);
-const TaskID RECV_RAD(28);
-
-const TaskID SETB_CRTC(29);
-const TaskID SETB_HYD(30);
-const TaskID SETB_FLD(31);
-const TaskID SETB_RAD(32);
-const TaskID CALC_CRTCFLX(33);
-
-const TaskID PROLONG(34);
-const TaskID CONS2PRIM(35);
-const TaskID PHY_BVAL(36);
-const TaskID USERWORK(37);
-const TaskID NEW_DT(38);
-const TaskID FLAG_AMR(39);
-
-const TaskID SEND_HYDFLXSH(40);
-const TaskID SEND_HYDSH(41);
-const TaskID SEND_EMFSH(42);
-const TaskID SEND_FLDSH(43);
-const TaskID RECV_HYDFLXSH(44);
-const TaskID RECV_HYDSH(45);
-const TaskID RECV_EMFSH(46);
-const TaskID RECV_FLDSH(47);
-
-const TaskID DIFFUSE_HYD(48);
-const TaskID DIFFUSE_FLD(49);
-
-const TaskID CALC_SCLRFLX(50);
-const TaskID SEND_SCLRFLX(51);
-const TaskID RECV_SCLRFLX(52);
-const TaskID INT_SCLR(53);
-const TaskID SEND_SCLR(54);
-const TaskID RECV_SCLR(55);
-const TaskID SETB_SCLR(56);
-const TaskID DIFFUSE_SCLR(57);
-const TaskID SEND_SCLRFLXSH(58);
-const TaskID SEND_SCLRSH(59);
-const TaskID RECV_SCLRFLXSH(60);
-const TaskID RECV_SCLRSH(61);
-
-const TaskID SEND_HYDORB(62);
-const TaskID RECV_HYDORB(63);
-const TaskID CALC_HYDORB(64);
-const TaskID SEND_FLDORB(65);
-const TaskID RECV_FLDORB(66);
-const TaskID CALC_FLDORB(67);
-
-const TaskID CRTC_OPACITY(68);
-const TaskID RAD_MOMOPACITY(69);
-
-const TaskID SEND_RADFLXSH(70);
-const TaskID RECV_RADFLXSH(71);
-const TaskID SEND_RADSH(72);
-const TaskID RECV_RADSH(73);
-
-const TaskID SRCTERM_IMRAD(74);
+//! every task as TASK(name, bit position); both the TaskID constants below and the task
+//! labels of TaskTrace in TimeIntegratorTaskList::AddTask() are generated from this list
+#define HYDRO_INTEGRATOR_TASKS(TASK)                                                    \
+  TASK(NONE, 0) TASK(CLEAR_ALLBND, 1)                                                   \
+  TASK(CALC_HYDFLX, 2) TASK(CALC_FLDFLX, 3) TASK(CALC_RADFLX, 4)                        \
+  TASK(SEND_HYDFLX, 5) TASK(SEND_FLDFLX, 6) TASK(SEND_RADFLX, 7)                        \
+  TASK(SEND_CRTCFLX, 8)                                                                 \
+  TASK(RECV_HYDFLX, 9) TASK(RECV_FLDFLX, 10) TASK(RECV_RADFLX, 11)                      \
+  TASK(RECV_CRTCFLX, 12)                                                                \
+  TASK(SRC_TERM, 13) TASK(SRCTERM_CRTC, 14) TASK(SRCTERM_RAD, 15)                       \
+  TASK(INT_CRTC, 16) TASK(INT_HYD, 17) TASK(INT_FLD, 18) TASK(INT_RAD, 19)              \
+  TASK(INT_CHM, 20)                                                                     \
+  TASK(SEND_CRTC, 21) TASK(SEND_HYD, 22) TASK(SEND_FLD, 23) TASK(SEND_RAD, 24)          \
+  TASK(RECV_CRTC, 25) TASK(RECV_HYD, 26) TASK(RECV_FLD, 27) TASK(RECV_RAD, 28)          \
+  TASK(SETB_CRTC, 29) TASK(SETB_HYD, 30) TASK(SETB_FLD, 31) TASK(SETB_RAD, 32)          \
+  TASK(CALC_CRTCFLX, 33)                                                                \
+  TASK(PROLONG, 34) TASK(CONS2PRIM, 35) TASK(PHY_BVAL, 36) TASK(USERWORK, 37)           \
+  TASK(NEW_DT, 38) TASK(FLAG_AMR, 39)                                                   \
+  TASK(SEND_HYDFLXSH, 40) TASK(SEND_HYDSH, 41) TASK(SEND_EMFSH, 42)                     \
+  TASK(SEND_FLDSH, 43) TASK(RECV_HYDFLXSH, 44) TASK(RECV_HYDSH, 45)                     \
+  TASK(RECV_EMFSH, 46) TASK(RECV_FLDSH, 47)                                             \
+  TASK(DIFFUSE_HYD, 48) TASK(DIFFUSE_FLD, 49)                                           \
+  TASK(CALC_SCLRFLX, 50) TASK(SEND_SCLRFLX, 51) TASK(RECV_SCLRFLX, 52)                  \
+  TASK(INT_SCLR, 53) TASK(SEND_SCLR, 54) TASK(RECV_SCLR, 55) TASK(SETB_SCLR, 56)        \
+  TASK(DIFFUSE_SCLR, 57) TASK(SEND_SCLRFLXSH, 58) TASK(SEND_SCLRSH, 59)                 \
+  TASK(RECV_SCLRFLXSH, 60) TASK(RECV_SCLRSH, 61)                                        \
+  TASK(SEND_HYDORB, 62) TASK(RECV_HYDORB, 63) TASK(CALC_HYDORB, 64)                     \
+  TASK(SEND_FLDORB, 65) TASK(RECV_FLDORB, 66) TASK(CALC_FLDORB, 67)                     \
+  TASK(CRTC_OPACITY, 68) TASK(RAD_MOMOPACITY, 69)                                       \
+  TASK(SEND_RADFLXSH, 70) TASK(RECV_RADFLXSH, 71) TASK(SEND_RADSH, 72)                  \
+  TASK(RECV_RADSH, 73)                                                                  \
+  TASK(SRCTERM_IMRAD, 74)
+
+#define HYDRO_INTEGRATOR_TASK_ID(name, bit) const TaskID name(bit);
+HYDRO_INTEGRATOR_TASKS(HYDRO_INTEGRATOR_TASK_ID)
+#undef HYDRO_INTEGRATOR_TASK_ID
 
 }  // namespace HydroIntegratorTaskNames
 #endif  // TASK_LIST_TASK_LIST_HPP_
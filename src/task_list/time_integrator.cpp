@@ -28,12 +28,14 @@
 #include "../hydro/hydro_diffusion/hydro_diffusion.hpp"
 #include "../hydro/srcterms/hydro_srcterms.hpp"
 #include "../mesh/mesh.hpp"
+#include "../mesh/polar_coarsening.hpp"
 #include "../nr_radiation/integrators/rad_integrators.hpp"
 #include "../nr_radiation/radiation.hpp"
 #include "../orbital_advection/orbital_advection.hpp"
 #include "../parameter_input.hpp"
 #include "../reconstruct/reconstruction.hpp"
 #include "../scalars/scalars.hpp"
+#include "../utils/perf_counters.hpp"
 #include "task_list.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -81,6 +83,8 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
 
   // nr_radiation enabled but not implicit_radiation
   bool radiation_flag = (NR_RADIATION_ENABLED && (!IM_RADIATION_ENABLED));
+  // cosmic rays enabled but not the implicit transport
+  bool cr_flag = (CR_ENABLED && (pm->pimcr == nullptr));
 
   // Read a flag for orbital advection
   ORBITAL_ADVECTION = (pm->orbital_advection != 0)? true : false;
@@ -958,7 +962,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
       AddTask(SETB_RAD,(RECV_RAD|SRCTERM_RAD));
     }
 
-    if (CR_ENABLED) {
+    if (cr_flag) {
       AddTask(CALC_CRTCFLX,NONE);
       if (pm->multilevel) { // SMR or AMR
         AddTask(SEND_CRTCFLX,CALC_CRTCFLX);
@@ -984,7 +988,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
     if (radiation_flag)
       src_aterm = (src_aterm | SRCTERM_RAD);
 
-    if (CR_ENABLED)
+    if (cr_flag)
       src_aterm = (src_aterm | SRCTERM_CRTC);
 
     if (ORBITAL_ADVECTION) {
@@ -1098,7 +1102,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
             setb=(setb|RECV_RADSH);
         }
 
-        if (CR_ENABLED) {
+        if (cr_flag) {
           setb=(setb|SEND_CRTC|SETB_CRTC);
         }
 
@@ -1143,7 +1147,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
             setb=(setb|RECV_RADSH);
         }
 
-        if (CR_ENABLED)
+        if (cr_flag)
           setb=(setb|SEND_CRTC|SETB_CRTC);
 
         AddTask(PROLONG,setb);
@@ -1177,7 +1181,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
       before_userwork = (before_userwork|RAD_MOMOPACITY);
     }
 
-    if (CR_ENABLED) {
+    if (cr_flag) {
       before_bval = (before_bval|SETB_CRTC|SEND_CRTC);
       before_userwork = (before_userwork|CRTC_OPACITY);
     }
@@ -1187,7 +1191,7 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
     if (radiation_flag)
       AddTask(RAD_MOMOPACITY,PHY_BVAL);
 
-    if (CR_ENABLED)
+    if (cr_flag)
       AddTask(CRTC_OPACITY,PHY_BVAL);
 
     if (!STS_ENABLED || pm->sts_integrator == "rkl1") {
@@ -1210,8 +1214,24 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
 //!  ntask.
 
 void TimeIntegratorTaskList::AddTask(const TaskID& id, const TaskID& dep) {
+  // labels for TaskTrace, generated from the same list as the TaskID constants
+  static const struct {
+    TaskID id;
+    const char *name;
+  } task_names[] = {
+#define HYDRO_INTEGRATOR_TASK_NAME(name, bit) {TaskID(bit), #name},
+    HYDRO_INTEGRATOR_TASKS(HYDRO_INTEGRATOR_TASK_NAME)
+#undef HYDRO_INTEGRATOR_TASK_NAME
+  };
   task_list_[ntasks].task_id = id;
   task_list_[ntasks].dependency = dep;
+  task_list_[ntasks].name = nullptr;
+  for (const auto &task : task_names) {
+    if (id == task.id) {
+      task_list_[ntasks].name = task.name;
+      break;
+    }
+  }
   //! \todo (felker):
   //! - change naming convention of either/both of TASK_NAME and TaskFunc
   //! - There are some issues with the current names:
@@ -1605,6 +1625,7 @@ void TimeIntegratorTaskList::AddTask(const TaskID& id, const TaskID& dep) {
 
 void TimeIntegratorTaskList::StartupTaskList(MeshBlock *pmb, int stage) {
   bool radiation_flag = (NR_RADIATION_ENABLED && (!IM_RADIATION_ENABLED));
+  bool cr_flag = (CR_ENABLED && (pmb->pmy_mesh->pimcr == nullptr));
   if (stage == 1) {
     // Initialize storage registers
     Hydro *ph = pmb->phydro;
@@ -1638,7 +1659,7 @@ void TimeIntegratorTaskList::StartupTaskList(MeshBlock *pmb, int stage) {
         pmb->pnrrad->ir2 = pmb->pnrrad->ir;
     }
 
-    if (CR_ENABLED) {
+    if (cr_flag) {
       pmb->pcr->u_cr1.ZeroClear();
       if (integrator == "ssprk5_4")
         pmb->pcr->u_cr2 = pmb->pcr->u_cr;
@@ -1824,6 +1845,8 @@ TaskStatus TimeIntegratorTaskList::IntegrateHydro(MeshBlock *pmb, int stage) {
       ph->AddFluxDivergence(wght, ph->u);
       // add coordinate (geometric) source terms
       pmb->pcoord->AddCoordTermsDivergence(wght, ph->flux, ph->w, pf->bcc, ph->u);
+      if (pmb->ppolar->polar_coarsening_defined)
+        pmb->ppolar->AverageCellCentered(ph->u, NHYDRO);
 
       // Hardcode an additional flux divergence weighted average for the penultimate
       // stage of SSPRK(5,4) since it cannot be expressed in a 3S* framework
@@ -1839,6 +1862,8 @@ TaskStatus TimeIntegratorTaskList::IntegrateHydro(MeshBlock *pmb, int stage) {
         ph->AddFluxDivergence(wght_ssp, ph->u2);
         // add coordinate (geometric) source terms
         pmb->pcoord->AddCoordTermsDivergence(wght_ssp, ph->flux, ph->w, pf->bcc, ph->u2);
+        if (pmb->ppolar->polar_coarsening_defined)
+          pmb->ppolar->AverageCellCentered(ph->u2, NHYDRO);
       }
     }
     return TaskStatus::next;
@@ -1877,6 +1902,7 @@ TaskStatus TimeIntegratorTaskList::IntegrateField(MeshBlock *pmb, int stage) {
         pmb->WeightedAve(pf->b, pf->b1, pf->b2, pf->b0, pf->ct_update, ave_wghts);
       }
 
+      if (pmb->ppolar->polar_coarsening_defined) pmb->ppolar->CoarsenEMF(pf->e);
       pf->CT(stage_wghts[stage-1].beta*pmb->pmy_mesh->dt, pf->b);
     }
     return TaskStatus::next;
@@ -2218,9 +2244,13 @@ TaskStatus TimeIntegratorTaskList::Primitives(MeshBlock *pmb, int stage) {
     // Newton-Raphson solver in GR EOS uses the following abscissae:
     // stage=1: W at t^n and
     // stage=2: W at t^{n+1/2} (VL2) or t^{n+1} (RK2)
-    pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
-                                    ph->w1, pf->bcc, pmb->pcoord,
-                                    il, iu, jl, ju, kl, ku);
+    {
+      PerfCounters::Scope perf(PerfCounters::cons2prim,
+                               (iu-il+1)*(ju-jl+1)*(ku-kl+1));
+      pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
+                                      ph->w1, pf->bcc, pmb->pcoord,
+                                      il, iu, jl, ju, kl, ku);
+    }
     if (pmb->porb->orbital_advection_defined) {
       pmb->porb->ResetOrbitalSystemConversionFlag();
     }
@@ -2401,6 +2431,8 @@ TaskStatus TimeIntegratorTaskList::IntegrateScalars(MeshBlock *pmb, int stage) {
 
       const Real wght = stage_wghts[stage-1].beta*pmb->pmy_mesh->dt;
       ps->AddFluxDivergence(wght, ps->s);
+      if (pmb->ppolar->polar_coarsening_defined)
+        pmb->ppolar->AverageCellCentered(ps->s, NSCALARS);
 
       // Hardcode an additional flux divergence weighted average for the penultimate
       // stage of SSPRK(5,4) since it cannot be expressed in a 3S* framework
@@ -2414,6 +2446,8 @@ TaskStatus TimeIntegratorTaskList::IntegrateScalars(MeshBlock *pmb, int stage) {
         // writing out to s2 register
         pmb->WeightedAve(ps->s2, ps->s1, ps->s2, ps->s0, ps->s_fl_div, ave_wghts);
         ps->AddFluxDivergence(wght_ssp, ps->s2);
+        if (pmb->ppolar->polar_coarsening_defined)
+          pmb->ppolar->AverageCellCentered(ps->s2, NSCALARS);
       }
     }
     return TaskStatus::next;
@@ -2426,6 +2460,8 @@ TaskStatus TimeIntegratorTaskList::IntegrateChemistry(MeshBlock *pmb, int stage)
   if (CHEMISTRY_ENABLED) {
     if (stage != nstages) return TaskStatus::success; // only do on last stage
 
+    PerfCounters::Scope perf(PerfCounters::ode_integrate,
+                             pmb->GetNumberOfMeshBlockCells());
     pmb->pscalars->odew.Integrate(pmb->pmy_mesh->time, pmb->pmy_mesh->dt);
   }
   return TaskStatus::next;
@@ -2757,6 +2793,9 @@ TaskStatus TimeIntegratorTaskList::AddSourceTermsRad(MeshBlock *pmb, int stage)
             prad->pradintegrator->CalSourceTerms(pmb, dt, k, j, i, ph->u,
                                                        prad->ir, prad->ir);
           }
+      // round to the storage format before the exchange with the gas, so that the gas
+      // absorbs the rounding error and the total energy is conserved
+      prad->QuantizeIntensity(prad->ir);
 
       if (prad->set_source_flag > 0) {
         prad->pradintegrator->GetHydroSourceTerms(pmb, prad->ir_old, prad->ir);
@@ -0,0 +1,320 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file autotune.cpp
+//! \brief implementation of the MeshBlock size and thread count autotuner
+//!
+//! Input parameters (block <autotune>):
+//!   enable     = true to tune new (not restarted) runs (default false)
+//!   sizes      = comma-separated candidate MeshBlock sizes, applied to every dimension
+//!                with more than one cell (default "8,16,32,64")
+//!   threads    = comma-separated candidate values of <mesh> num_threads (default: the
+//!                value in the input file)
+//!   nwarmup    = untimed cycles per candidate (default 1)
+//!   ncycle     = timed cycles per candidate (default 5)
+//!   cache_file = file storing the best candidate per problem (default autotune.cache)
+//!   use_cache  = false to repeat the trials although the cache has an entry
+//! The trials skip STS, chemistry radiation, regrids and outputs; with AMR the timed
+//! Mesh is the one left by the initial refinement in Mesh::Initialize. A candidate
+//! that fails on any rank is skipped on all of them. The number of ranks per node
+//! cannot be changed at run time and is part of the cache key instead.
+
+// C headers
+
+// C++ headers
+#include <cstdint>    // int64_t
+#include <ctime>      // clock_gettime()
+#include <exception>  // exception
+#include <fstream>    // ifstream, ofstream
+#include <iomanip>    // setw()
+#include <iostream>   // cout
+#include <memory>     // unique_ptr
+#include <sstream>    // stringstream
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../cr/implicit/cr_implicit.hpp"
+#include "../fft/turbulence.hpp"
+#include "../globals.hpp"
+#include "../gravity/fft_gravity.hpp"
+#include "../gravity/mg_gravity.hpp"
+#include "../mesh/mesh.hpp"
+#include "../nr_radiation/implicit/radiation_implicit.hpp"
+#include "../parameter_input.hpp"
+#include "../task_list/task_list.hpp"
+#include "autotune.hpp"
+
+// MPI/OpenMP headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace {
+//! one decomposition and its measured zone-cycles per second (negative: not run)
+struct Candidate {
+  int nx1, nx2, nx3, nthreads;
+  double rate;
+};
+
+double WallTime() {
+#ifdef OPENMP_PARALLEL
+  return omp_get_wtime();
+#elif defined(MPI_PARALLEL)
+  return MPI_Wtime();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec);
+#endif
+}
+
+std::vector<int> ParseList(const std::string &list) {
+  std::vector<int> values;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.find_first_not_of(" \t") != std::string::npos)
+      values.push_back(std::stoi(item));
+  }
+  return values;
+}
+
+//! problem, root grid, ranks and CPU model; spaces are replaced so that it is one word
+std::string CacheKey(ParameterInput *pin) {
+  std::string cpu = "unknown";
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  int ncpu = 0;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0) {
+      if (ncpu++ == 0) cpu = line.substr(line.find(':') + 2);
+    }
+  }
+  std::stringstream key;
+  key << pin->GetString("job", "problem_id") << "_" << pin->GetInteger("mesh", "nx1")
+      << "x" << pin->GetInteger("mesh", "nx2") << "x" << pin->GetInteger("mesh", "nx3")
+      << "_ranks" << Globals::nranks << "_" << cpu << "_" << ncpu << "cores";
+  std::string s = key.str();
+  for (char &c : s) {
+    if (c == ' ' || c == '\t') c = '_';
+  }
+  return s;
+}
+
+//! look up key in the cache file; returns false if there is no entry
+bool ReadCache(const std::string &fname, const std::string &key, Candidate &best) {
+  std::ifstream file(fname);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::stringstream ss(line);
+    std::string k;
+    Candidate c;
+    if ((ss >> k >> c.nx1 >> c.nx2 >> c.nx3 >> c.nthreads >> c.rate) && k == key) {
+      best = c;
+      return true;
+    }
+  }
+  return false;
+}
+
+//! replace or append the entry of key in the cache file
+void WriteCache(const std::string &fname, const std::string &key, const Candidate &best) {
+  std::vector<std::string> lines;
+  std::ifstream in(fname);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::stringstream ss(line);
+    std::string k;
+    if (!(ss >> k) || k != key) lines.push_back(line);
+  }
+  in.close();
+  std::stringstream entry;
+  entry << key << " " << best.nx1 << " " << best.nx2 << " " << best.nx3 << " "
+        << best.nthreads << " " << best.rate;
+  lines.push_back(entry.str());
+  std::ofstream out(fname);
+  if (!out) {
+    std::cout << "### Warning in Autotune::Run" << std::endl
+              << "Cache file '" << fname << "' could not be written" << std::endl;
+    return;
+  }
+  for (const std::string &l : lines) out << l << "\n";
+}
+
+//! one cycle of the main loop in main.cpp without STS, chemistry radiation and regrids
+void TrialCycle(Mesh *pm, TimeIntegratorTaskList *ptlist) {
+  if (pm->turb_flag > 1) pm->ptrbd->Driving();
+  for (int stage=1; stage<=ptlist->nstages; ++stage) {
+    ptlist->DoTaskListOneStage(pm, stage);
+    if (ptlist->CheckNextMainStage(stage)) {
+      if (SELF_GRAVITY_ENABLED == 1)
+        pm->pfgrd->Solve(stage, 0);
+      else if (SELF_GRAVITY_ENABLED == 2)
+        pm->pmgrd->Solve(stage);
+    }
+    if (IM_RADIATION_ENABLED)
+      pm->pimrad->Iteration(pm, ptlist, stage);
+    if (pm->pimcr != nullptr)
+      pm->pimcr->Iteration(pm, ptlist, stage);
+  }
+  pm->UserWorkInLoop();
+  pm->ncycle++;
+  pm->time += pm->dt;
+  pm->NewTimeStep();
+}
+
+//! build the Mesh for candidate c and return its zone-cycles per wall-clock second, or
+//! a negative value (and the reason in *error) if the trial failed on any rank
+double Trial(ParameterInput *pin, const Candidate &c, int nwarmup, int ncycle,
+             std::string *error) {
+  pin->SetInteger("meshblock", "nx1", c.nx1);
+  pin->SetInteger("meshblock", "nx2", c.nx2);
+  pin->SetInteger("meshblock", "nx3", c.nx3);
+  pin->SetInteger("mesh", "num_threads", c.nthreads);
+  double result[2] = {0.0, 0.0};  // elapsed time, failure flag
+  double ncells = 0.0;
+#ifdef ENABLE_EXCEPTIONS
+  try {
+#endif
+    std::unique_ptr<Mesh> pm(new Mesh(pin));
+    std::unique_ptr<TimeIntegratorTaskList> ptlist(
+        new TimeIntegratorTaskList(pin, pm.get()));
+    pm->Initialize(0, pin);
+    double t0 = 0.0;
+    for (int n=0; n<nwarmup+ncycle; ++n) {
+      if (n == nwarmup) {
+#ifdef MPI_PARALLEL
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+        t0 = WallTime();
+      }
+      TrialCycle(pm.get(), ptlist.get());
+    }
+    result[0] = WallTime() - t0;
+    ncells = static_cast<double>(pm->GetTotalCells());
+#ifdef ENABLE_EXCEPTIONS
+  }
+  catch(std::exception const& ex) {
+    // e.g. refinement regions that are not aligned with this MeshBlock size
+    result[1] = 1.0;
+    *error = ex.what();
+  }
+#endif
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, result, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  if (result[1] > 0.0) {
+    if (error->empty()) *error = "failed on another rank";
+    return -1.0;
+  }
+  return ncells*ncycle/(result[0] > 0.0 ? result[0] : 1.0e-30);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Autotune::Run(ParameterInput *pin)
+//! \brief choose <meshblock> nx1/nx2/nx3 and <mesh> num_threads from the cache or by
+//!        timing trial runs, and store them in pin
+
+void Autotune::Run(ParameterInput *pin) {
+  if (!pin->GetOrAddBoolean("autotune", "enable", false)) return;
+  std::vector<int> sizes = ParseList(pin->GetOrAddString("autotune", "sizes",
+                                                         "8,16,32,64"));
+  int nthreads0 = pin->GetOrAddInteger("mesh", "num_threads", 1);
+  std::vector<int> threads = ParseList(pin->GetOrAddString(
+      "autotune", "threads", std::to_string(nthreads0)));
+  int nwarmup = pin->GetOrAddInteger("autotune", "nwarmup", 1);
+  int ncycle = pin->GetOrAddInteger("autotune", "ncycle", 5);
+  std::string fname = pin->GetOrAddString("autotune", "cache_file", "autotune.cache");
+  bool use_cache = pin->GetOrAddBoolean("autotune", "use_cache", true);
+  std::string key = CacheKey(pin);
+
+  // rank 0 reads the cache and broadcasts the entry
+  Candidate best{0, 0, 0, 0, -1.0};
+  int found = 0;
+  if (Globals::my_rank == 0 && use_cache) found = ReadCache(fname, key, best) ? 1 : 0;
+#ifdef MPI_PARALLEL
+  int buf[5] = {found, best.nx1, best.nx2, best.nx3, best.nthreads};
+  MPI_Bcast(buf, 5, MPI_INT, 0, MPI_COMM_WORLD);
+  found = buf[0];
+  best.nx1 = buf[1], best.nx2 = buf[2], best.nx3 = buf[3], best.nthreads = buf[4];
+#endif
+
+  if (!found) {
+    int nx[3] = {pin->GetInteger("mesh", "nx1"), pin->GetOrAddInteger("mesh", "nx2", 1),
+                 pin->GetOrAddInteger("mesh", "nx3", 1)};
+    bool multilevel = (pin->GetOrAddString("mesh", "refinement", "none") != "none");
+    std::vector<Candidate> candidates;
+    for (int s : sizes) {
+      int bs[3];
+      std::int64_t nblocks = 1;
+      bool valid = true;
+      for (int d=0; d<3; ++d) {
+        bs[d] = (nx[d] > 1) ? s : 1;
+        if (nx[d] > 1 && (s < NGHOST || nx[d] % s != 0 || (multilevel && s % 2 != 0)))
+          valid = false;
+        if (valid) nblocks *= nx[d]/bs[d];
+      }
+      if (!valid || nblocks < Globals::nranks) continue;
+      for (int t : threads) {
+#ifndef OPENMP_PARALLEL
+        if (t != 1) continue;
+#endif
+        if (t >= 1) candidates.push_back({bs[0], bs[1], bs[2], t, -1.0});
+      }
+    }
+    if (candidates.empty()) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [Autotune::Run]" << std::endl
+          << "None of the MeshBlock sizes '" << pin->GetString("autotune", "sizes")
+          << "' divides the mesh into at least " << Globals::nranks << " MeshBlocks"
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+
+    if (Globals::my_rank == 0)
+      std::cout << "Autotune: timing " << candidates.size() << " candidates with "
+                << ncycle << " cycles each" << std::endl;
+    for (Candidate &c : candidates) {
+      std::string error;
+      c.rate = Trial(pin, c, nwarmup, ncycle, &error);
+      if (c.rate < 0.0) {
+        if (Globals::my_rank == 0)
+          std::cout << "Autotune: skipping " << c.nx1 << "x" << c.nx2 << "x" << c.nx3
+                    << ": " << error << std::endl;
+        continue;
+      }
+      if (Globals::my_rank == 0)
+        std::cout << "Autotune: meshblock " << std::setw(4) << c.nx1 << " x"
+                  << std::setw(4) << c.nx2 << " x" << std::setw(4) << c.nx3
+                  << ", threads " << std::setw(3) << c.nthreads << ": " << c.rate
+                  << " zone-cycles/second" << std::endl;
+      if (c.rate > best.rate) best = c;
+    }
+    if (best.rate < 0.0) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in function [Autotune::Run]" << std::endl
+          << "All candidates failed" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    if (Globals::my_rank == 0) WriteCache(fname, key, best);
+  }
+
+  if (Globals::my_rank == 0)
+    std::cout << "Autotune: using meshblock " << best.nx1 << " x " << best.nx2 << " x "
+              << best.nx3 << " and " << best.nthreads << " threads"
+              << (found ? " (from " + fname + ")" : "") << std::endl;
+  pin->SetInteger("meshblock", "nx1", best.nx1);
+  pin->SetInteger("meshblock", "nx2", best.nx2);
+  pin->SetInteger("meshblock", "nx3", best.nx3);
+  pin->SetInteger("mesh", "num_threads", best.nthreads);
+  return;
+}
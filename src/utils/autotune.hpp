@@ -0,0 +1,34 @@
+#ifndef UTILS_AUTOTUNE_HPP_
+#define UTILS_AUTOTUNE_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file autotune.hpp
+//! \brief selection of the MeshBlock size and number of threads by trial runs at startup
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+
+class ParameterInput;
+
+//----------------------------------------------------------------------------------------
+//! \namespace Autotune
+//! \brief opt-in tuning of <meshblock> nx1/nx2/nx3 and <mesh> num_threads
+//!
+//! Before the Mesh is constructed, Run() builds a temporary Mesh for every candidate
+//! decomposition, runs a few cycles of the full time integrator (including boundary
+//! communication and self-gravity) and measures the zone-cycles per wall-clock second.
+//! The fastest candidate is written into the ParameterInput, so that the Mesh of the
+//! simulation is constructed with it, and stored in a cache file keyed by problem, mesh
+//! size, number of ranks and CPU, which later runs read instead of repeating the trials.
+
+namespace Autotune {
+void Run(ParameterInput *pin);
+} // namespace Autotune
+
+#endif // UTILS_AUTOTUNE_HPP_
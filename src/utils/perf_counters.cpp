@@ -0,0 +1,308 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file perf_counters.cpp
+//! \brief implementation of the hardware counter functions in namespace PerfCounters
+//!
+//! Input parameters (block <perf_counters>):
+//!   enable       = true to read the counters (default false)
+//!   vector_event = raw event code of packed floating-point instructions, default
+//!                  0xfcc7 (Intel FP_ARITH_INST_RETIRED, all packed widths)
+//!   scalar_event = raw event code of scalar floating-point instructions, default
+//!                  0x03c7 (Intel FP_ARITH_INST_RETIRED, scalar single and double)
+//! The raw codes depend on the CPU family; set them to "none" where they do not exist.
+//! Counters that cannot be opened (e.g. inside virtual machines, or with
+//! kernel.perf_event_paranoid > 2) are reported as n/a. Only user-space events of the
+//! calling thread are counted.
+
+// C headers
+
+// C++ headers
+#include <cerrno>     // errno
+#include <cstdint>    // int64_t, uint64_t
+#include <cstdio>     // fopen(), fprintf()
+#include <cstring>    // memset(), strerror()
+#include <iomanip>    // setw()
+#include <iostream>   // cout
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../globals.hpp"
+#include "../parameter_input.hpp"
+#include "perf_counters.hpp"
+
+// Linux perf_event headers
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// MPI/OpenMP headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace PerfCounters {
+bool enabled = false;
+} // namespace PerfCounters
+
+namespace {
+//! counted events, in the order of the values following the two times
+enum Event {cycles=0, instructions, cache_misses, vector_ops, scalar_ops, nevents};
+constexpr int kNumEvents = nevents;
+//! accumulated values per region: calls, cells, then one per event
+constexpr int nstat = 2 + nevents;
+
+const char *region_names[PerfCounters::nregions] = {
+  "CalculateFluxes", "AddFluxDivergence", "ConservedToPrim", "BoundaryPack",
+  "BoundaryUnpack", "ODEIntegrate", "RadCalcFluxes", "RadFluxDivergence"};
+
+//! counter group of one thread; slot[e] is the position of event e in the group or -1
+struct ThreadCounters {
+  std::vector<int> fds;
+  int slot[kNumEvents];
+  int error;  // errno of the cycle counter if it could not be opened
+  std::vector<std::int64_t> stat;  // nregions x nstat
+};
+
+//! name of the output file of rank 0
+struct CounterFile {
+  std::string basename;
+};
+
+std::vector<ThreadCounters> threads;
+CounterFile file;
+
+int ThreadNumber() {
+#ifdef OPENMP_PARALLEL
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+//! open one counter of the calling thread; returns the file descriptor or -1
+int OpenCounter(std::uint32_t type, std::uint64_t config, int group_fd) {
+#ifdef __linux__
+  struct perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = (group_fd == -1) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+#else
+  return -1;
+#endif
+}
+
+//! open the group of the calling thread; events with config 0 of type raw are skipped
+void OpenGroup(ThreadCounters &tc, const std::uint64_t raw[2]) {
+  tc.fds.clear();
+  tc.error = ENOSYS;
+  for (int e=0; e<nevents; ++e) tc.slot[e] = -1;
+#ifdef __linux__
+  const std::uint32_t type[kNumEvents] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                       PERF_TYPE_HARDWARE, PERF_TYPE_RAW, PERF_TYPE_RAW};
+  const std::uint64_t config[kNumEvents] = {PERF_COUNT_HW_CPU_CYCLES,
+                                         PERF_COUNT_HW_INSTRUCTIONS,
+                                         PERF_COUNT_HW_CACHE_MISSES, raw[0], raw[1]};
+  for (int e=0; e<nevents; ++e) {
+    if (type[e] == PERF_TYPE_RAW && config[e] == 0) continue;
+    int fd = OpenCounter(type[e], config[e], tc.fds.empty() ? -1 : tc.fds[0]);
+    if (fd < 0) {
+      if (e == cycles) tc.error = errno;
+      continue;
+    }
+    tc.slot[e] = static_cast<int>(tc.fds.size());
+    tc.fds.push_back(fd);
+  }
+  if (!tc.fds.empty()) {
+    ioctl(tc.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(tc.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+}
+
+//! read the group of the calling thread into v[kNumValues]; zeros if it is not open
+void ReadGroup(const ThreadCounters &tc, std::int64_t *v) {
+  for (int n=0; n<PerfCounters::kNumValues; ++n) v[n] = 0;
+#ifdef __linux__
+  if (tc.fds.empty()) return;
+  std::uint64_t buf[3 + kNumEvents];
+  if (read(tc.fds[0], buf, sizeof(buf)) <= 0) return;
+  v[0] = static_cast<std::int64_t>(buf[1]);
+  v[1] = static_cast<std::int64_t>(buf[2]);
+  for (int e=0; e<nevents; ++e) {
+    if (tc.slot[e] >= 0) v[2+e] = static_cast<std::int64_t>(buf[3+tc.slot[e]]);
+  }
+#endif
+}
+
+//! print value, or n/a if not all events in mask were counted
+void Column(std::stringstream &out, int width, int avail, int mask, double value) {
+  if ((avail & mask) == mask)
+    out << std::setw(width) << value;
+  else
+    out << std::setw(width) << "n/a";
+}
+
+std::uint64_t ParseEvent(const std::string &code) {
+  if (code.empty() || code == "none") return 0;
+  return std::stoull(code, nullptr, 0);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void PerfCounters::Initialize(ParameterInput *pin, int nthreads)
+//! \brief read the <perf_counters> block and open the counter groups of all threads
+
+void PerfCounters::Initialize(ParameterInput *pin, int nthreads) {
+  enabled = pin->GetOrAddBoolean("perf_counters", "enable", false);
+  if (!enabled) return;
+  std::uint64_t raw[2];
+  raw[0] = ParseEvent(pin->GetOrAddString("perf_counters", "vector_event", "0xfcc7"));
+  raw[1] = ParseEvent(pin->GetOrAddString("perf_counters", "scalar_event", "0x03c7"));
+  file.basename = pin->GetString("job", "problem_id");
+  threads.assign(nthreads, ThreadCounters());
+  // every thread opens its own group, since perf_event counts only the calling thread
+#pragma omp parallel num_threads(nthreads)
+  {
+    ThreadCounters &tc = threads[ThreadNumber()];
+    tc.stat.assign(nregions*nstat, 0);
+    OpenGroup(tc, raw);
+  }
+  if (Globals::my_rank == 0 && threads[0].slot[cycles] < 0) {
+    std::cout << "### Warning in PerfCounters::Initialize" << std::endl
+              << "Hardware cycle counter could not be opened ("
+              << std::strerror(threads[0].error) << "); counts will be reported as n/a"
+              << std::endl;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PerfCounters::Start(std::int64_t *start)
+//! \brief read the counters of the calling thread at the beginning of a region
+
+void PerfCounters::Start(std::int64_t *start) {
+  ReadGroup(threads[ThreadNumber()], start);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PerfCounters::Stop(Region r, std::int64_t ncells, const std::int64_t *start)
+//! \brief add the counts since Start() to region r of the calling thread, scaled by the
+//!        fraction of time the group was scheduled if the kernel multiplexed it
+
+void PerfCounters::Stop(Region r, std::int64_t ncells, const std::int64_t *start) {
+  ThreadCounters &tc = threads[ThreadNumber()];
+  std::int64_t end[kNumValues];
+  ReadGroup(tc, end);
+  std::int64_t dt_enabled = end[0] - start[0], dt_running = end[1] - start[1];
+  double scale = (dt_running > 0) ? static_cast<double>(dt_enabled)/dt_running : 1.0;
+  std::int64_t *st = &tc.stat[r*nstat];
+  st[0]++;
+  st[1] += ncells;
+  for (int e=0; e<nevents; ++e)
+    st[2+e] += static_cast<std::int64_t>(scale*(end[2+e] - start[2+e]));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PerfCounters::Finalize()
+//! \brief close the counters, print the totals of all ranks from rank 0 and write the
+//!        values of every rank to a file
+
+void PerfCounters::Finalize() {
+  if (!enabled) return;
+  // sum the threads of this rank; the last value flags which events could be opened
+  std::vector<double> mine(nregions*nstat + 1, 0.0);
+  int avail = 0;
+  for (ThreadCounters &tc : threads) {
+    for (int n=0; n<nregions*nstat; ++n) mine[n] += static_cast<double>(tc.stat[n]);
+#ifdef __linux__
+    for (int fd : tc.fds) close(fd);
+#endif
+  }
+  for (int e=0; e<nevents; ++e)
+    if (threads[0].slot[e] >= 0) avail |= (1 << e);
+  mine[nregions*nstat] = avail;
+
+  std::size_t nrank_values = mine.size();
+  std::vector<double> all(nrank_values*Globals::nranks);
+#ifdef MPI_PARALLEL
+  MPI_Gather(mine.data(), static_cast<int>(nrank_values), MPI_DOUBLE, all.data(),
+             static_cast<int>(nrank_values), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+#else
+  all = mine;
+#endif
+  threads.clear();
+  if (Globals::my_rank != 0) return;
+
+  std::vector<double> total(nregions*nstat, 0.0);
+  for (int r=0; r<Globals::nranks; ++r) {
+    for (int n=0; n<nregions*nstat; ++n) total[n] += all[r*nrank_values + n];
+  }
+  std::stringstream out;
+  out << std::fixed << std::setprecision(3) << std::endl
+      << "Hardware counter summary (all ranks and threads, per cell)" << std::endl
+      << std::setw(18) << "region" << std::setw(12) << "calls" << std::setw(14)
+      << "cells" << std::setw(12) << "cycles" << std::setw(12) << "instr" << std::setw(8)
+      << "IPC" << std::setw(12) << "cache miss" << std::setw(10) << "vector"
+      << std::endl;
+  for (int n=0; n<nregions; ++n) {
+    const double *st = &total[n*nstat];
+    if (st[0] == 0.0) continue;
+    double cells = (st[1] > 0.0) ? st[1] : 1.0;
+    out << std::setw(18) << region_names[n] << std::setw(12)
+        << static_cast<std::int64_t>(st[0]) << std::setw(14)
+        << static_cast<std::int64_t>(st[1]);
+    Column(out, 12, avail, (1 << cycles), st[2+cycles]/cells);
+    Column(out, 12, avail, (1 << instructions), st[2+instructions]/cells);
+    Column(out, 8, (st[2+cycles] > 0.0) ? avail : 0, (1 << cycles) | (1 << instructions),
+           st[2+instructions]/st[2+cycles]);
+    Column(out, 12, avail, (1 << cache_misses), st[2+cache_misses]/cells);
+    // fraction of floating-point instructions that were packed (SIMD)
+    double fp = st[2+vector_ops] + st[2+scalar_ops];
+    Column(out, 10, (fp > 0.0) ? avail : 0, (1 << vector_ops) | (1 << scalar_ops),
+           st[2+vector_ops]/fp);
+    out << std::endl;
+  }
+  std::cout << out.str();
+
+  std::string fname = file.basename + ".perf_counters.txt";
+  FILE *pfile;
+  if ((pfile = std::fopen(fname.c_str(), "w")) == nullptr) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [PerfCounters::Finalize]" << std::endl
+        << "Output file '" << fname << "' could not be opened" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  std::fprintf(pfile, "# rank region calls cells cycles instructions cache_misses "
+               "vector_fp scalar_fp\n");
+  for (int r=0; r<Globals::nranks; ++r) {
+    for (int n=0; n<nregions; ++n) {
+      const double *st = &all[r*nrank_values + n*nstat];
+      if (st[0] == 0.0) continue;
+      std::fprintf(pfile, "%d %s", r, region_names[n]);
+      for (int s=0; s<nstat; ++s) std::fprintf(pfile, " %.0f", st[s]);
+      std::fprintf(pfile, "\n");
+    }
+  }
+  std::fclose(pfile);
+  return;
+}
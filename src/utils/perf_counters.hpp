@@ -0,0 +1,67 @@
+#ifndef UTILS_PERF_COUNTERS_HPP_
+#define UTILS_PERF_COUNTERS_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file perf_counters.hpp
+//! \brief hardware performance counters (Linux perf_event) around named kernels
+
+// C headers
+
+// C++ headers
+#include <cstdint>    // int64_t
+
+// Athena++ headers
+
+class ParameterInput;
+
+//----------------------------------------------------------------------------------------
+//! \namespace PerfCounters
+//! \brief per-thread counter groups read at the start and end of every Region scope,
+//!        enabled with <perf_counters> enable
+//!
+//! The counts of each region are accumulated per thread and summed per rank. At the end
+//! rank 0 prints the totals of all ranks per region, normalized by the number of cells
+//! passed to the Scope (the active cells of the MeshBlock, or the cells updated by the
+//! EOS), and writes the values of every rank to "problem_id.perf_counters.txt".
+
+namespace PerfCounters {
+//! instrumented kernels
+enum Region {calculate_fluxes=0, add_flux_divergence, cons2prim, bval_pack, bval_unpack,
+             ode_integrate, rad_fluxes, rad_divergence, nregions};
+
+extern bool enabled;
+void Initialize(ParameterInput *pin, int nthreads);
+void Finalize();
+void Start(std::int64_t *start);
+void Stop(Region r, std::int64_t ncells, const std::int64_t *start);
+
+//! number of values read per group: time enabled, time running, cycles, instructions,
+//! cache misses, vector and scalar floating-point instructions
+constexpr int kNumValues = 7;
+
+//----------------------------------------------------------------------------------------
+//! \class Scope
+//! \brief reads the counters of the calling thread when constructed and destroyed
+
+class Scope {
+ public:
+  Scope(Region r, std::int64_t ncells) : region_(r), ncells_(ncells) {
+    if (enabled) Start(start_);
+  }
+  ~Scope() {
+    if (enabled) Stop(region_, ncells_, start_);
+  }
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+ private:
+  Region region_;
+  std::int64_t ncells_;
+  std::int64_t start_[kNumValues];
+};
+} // namespace PerfCounters
+
+#endif // UTILS_PERF_COUNTERS_HPP_
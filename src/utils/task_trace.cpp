@@ -0,0 +1,290 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_trace.cpp
+//! \brief implementation of the task tracing functions in namespace TaskTrace
+//!
+//! Input parameters (block <trace>):
+//!   enable      = true to record tasks (default false)
+//!   ncycle_out  = cycles between trace files; 0 writes a single file at the end
+//!   buffer_size = events kept per thread between two files; older ones are overwritten
+//! Each rank writes "problem_id.rankNNNNN.XXXXX.trace.json" with pid = rank and
+//! tid = thread. Timestamps are in microseconds since TaskTrace::Initialize().
+
+// C headers
+
+// C++ headers
+#include <cstdint>    // int64_t
+#include <cstdio>     // fopen(), fprintf(), snprintf()
+#include <ctime>      // clock_gettime()
+#include <iomanip>    // setw()
+#include <iostream>   // cout
+#include <map>
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../globals.hpp"
+#include "../parameter_input.hpp"
+#include "task_trace.hpp"
+
+// MPI/OpenMP headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace TaskTrace {
+bool enabled = false;
+} // namespace TaskTrace
+
+namespace {
+//! one recorded task call; times relative to tbase
+struct TraceEvent {
+  double t0, t1;
+  const char *name;
+  int gid, stage;
+  bool wait;
+};
+
+//! accumulated time of one task on one thread
+struct TaskStat {
+  double busy, wait;
+  std::int64_t calls;
+};
+
+//! names and cadence of the trace files of this rank
+struct TraceFiles {
+  std::string basename;
+  int ncycle_out, file_number;
+};
+
+double tbase;
+int nthreads;
+std::size_t capacity;
+TraceFiles files;
+// ring buffers and their next write position and number of valid events per thread
+std::vector<std::vector<TraceEvent>> ring;
+std::vector<std::size_t> head, count;
+std::vector<std::unordered_map<const char *, TaskStat>> stats;
+std::vector<std::string> default_names;
+
+void WriteTraceFile() {
+  std::string fname;
+  char number[32];
+  std::snprintf(number, sizeof(number), ".rank%05d.%05d", Globals::my_rank,
+                files.file_number++);
+  fname = files.basename + number + ".trace.json";
+  FILE *pfile;
+  if ((pfile = std::fopen(fname.c_str(), "w")) == nullptr) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [TaskTrace::WriteTraceFile]" << std::endl
+        << "Output file '" << fname << "' could not be opened" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  std::fprintf(pfile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  std::fprintf(pfile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+               "\"args\":{\"name\":\"rank %d\"}}", Globals::my_rank, Globals::my_rank);
+  for (int t=0; t<nthreads; ++t) {
+    std::size_t first = (head[t] + capacity - count[t]) % capacity;
+    for (std::size_t n=0; n<count[t]; ++n) {
+      const TraceEvent &ev = ring[t][(first + n) % capacity];
+      std::fprintf(pfile, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                   "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,"
+                   "\"args\":{\"gid\":%d,\"stage\":%d}}", ev.name,
+                   ev.wait ? "wait" : "task", 1.0e6*ev.t0, 1.0e6*(ev.t1 - ev.t0),
+                   Globals::my_rank, t, ev.gid, ev.stage);
+    }
+    head[t] = count[t] = 0;
+  }
+  std::fprintf(pfile, "\n]}\n");
+  std::fclose(pfile);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void TaskTrace::Initialize(ParameterInput *pin, int nthreads)
+//! \brief read the <trace> block and allocate the ring buffers of all threads
+
+void TaskTrace::Initialize(ParameterInput *pin, int nthr) {
+  enabled = pin->GetOrAddBoolean("trace", "enable", false);
+  if (!enabled) return;
+  files.ncycle_out = pin->GetOrAddInteger("trace", "ncycle_out", 0);
+  int nbuf = pin->GetOrAddInteger("trace", "buffer_size", 100000);
+  capacity = nbuf > 1 ? nbuf : 1;
+  files.basename = pin->GetString("job", "problem_id");
+  nthreads = nthr;
+  files.file_number = 0;
+  ring.assign(nthreads, std::vector<TraceEvent>(capacity));
+  head.assign(nthreads, 0);
+  count.assign(nthreads, 0);
+  stats.assign(nthreads, std::unordered_map<const char *, TaskStat>());
+  // filled here since DefaultName() is called from inside OpenMP parallel regions
+  default_names.clear();
+  for (int n=0; n<128; ++n) default_names.push_back("task" + std::to_string(n));
+  tbase = 0.0;
+  tbase = Now();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double TaskTrace::Now()
+//! \brief wall-clock time in seconds since Initialize()
+
+double TaskTrace::Now() {
+#ifdef OPENMP_PARALLEL
+  return omp_get_wtime() - tbase;
+#elif defined(MPI_PARALLEL)
+  return MPI_Wtime() - tbase;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec) - tbase;
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TaskTrace::Record(const char *name, int gid, int stage, double t0,
+//!                            double t1, bool wait)
+//! \brief add one task call to the ring buffer and the summary of the calling thread
+
+void TaskTrace::Record(const char *name, int gid, int stage, double t0, double t1,
+                       bool wait) {
+  int t = 0;
+#ifdef OPENMP_PARALLEL
+  t = omp_get_thread_num();
+#endif
+  TaskStat &st = stats[t][name];
+  if (wait) {
+    st.wait += t1 - t0;
+  } else {
+    st.busy += t1 - t0;
+    st.calls++;
+  }
+  // merge repeated waits of the same task into the last event
+  if (wait && count[t] > 0) {
+    TraceEvent &last = ring[t][(head[t] + capacity - 1) % capacity];
+    if (last.wait && last.name == name && last.gid == gid && last.stage == stage) {
+      last.t1 = t1;
+      return;
+    }
+  }
+  ring[t][head[t]] = {t0, t1, name, gid, stage, wait};
+  head[t] = (head[t] + 1) % capacity;
+  if (count[t] < capacity) count[t]++;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn const char *TaskTrace::DefaultName(int id)
+//! \brief name of tasks that were not given one by their TaskList, "task<position>"
+
+const char *TaskTrace::DefaultName(int id) {
+  return default_names[id].c_str();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TaskTrace::Dump(int ncycle)
+//! \brief write the recorded events every ncycle_out cycles
+
+void TaskTrace::Dump(int ncycle) {
+  if (!enabled || files.ncycle_out <= 0 || ncycle % files.ncycle_out != 0) return;
+  WriteTraceFile();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TaskTrace::Finalize()
+//! \brief write the remaining events and print the summary of all ranks from rank 0
+
+void TaskTrace::Finalize() {
+  if (!enabled) return;
+  double elapsed = Now();
+  std::size_t nevents = 0;
+  for (int t=0; t<nthreads; ++t) nevents += count[t];
+  if (nevents > 0 || files.file_number == 0) WriteTraceFile();
+
+  // merge the threads of this rank
+  std::map<std::string, TaskStat> tasks;
+  double rank_time[3] = {0.0, 0.0, elapsed*nthreads}; // busy, wait, available
+  for (int t=0; t<nthreads; ++t) {
+    for (auto &entry : stats[t]) {
+      TaskStat &st = tasks[entry.first];
+      st.busy += entry.second.busy;
+      st.wait += entry.second.wait;
+      st.calls += entry.second.calls;
+      rank_time[0] += entry.second.busy;
+      rank_time[1] += entry.second.wait;
+    }
+  }
+  std::stringstream table;
+  table.precision(17);
+  for (auto &entry : tasks)
+    table << entry.first << " " << entry.second.busy << " " << entry.second.wait << " "
+          << entry.second.calls << "\n";
+  std::string mytable = table.str();
+
+  // collect the tables and times of all ranks on rank 0
+  std::vector<double> all_times(3*Globals::nranks);
+  std::string all_tables = mytable;
+#ifdef MPI_PARALLEL
+  MPI_Gather(rank_time, 3, MPI_DOUBLE, all_times.data(), 3, MPI_DOUBLE, 0,
+             MPI_COMM_WORLD);
+  int mylen = static_cast<int>(mytable.size());
+  std::vector<int> lens(Globals::nranks), disp(Globals::nranks);
+  MPI_Gather(&mylen, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  int total = 0;
+  for (int r=0; r<Globals::nranks; ++r) {
+    disp[r] = total;
+    total += lens[r];
+  }
+  std::vector<char> buf(total + 1);
+  MPI_Gatherv(mytable.data(), mylen, MPI_CHAR, buf.data(), lens.data(), disp.data(),
+              MPI_CHAR, 0, MPI_COMM_WORLD);
+  all_tables.assign(buf.data(), total);
+#else
+  for (int n=0; n<3; ++n) all_times[n] = rank_time[n];
+#endif
+  if (Globals::my_rank != 0) return;
+
+  tasks.clear();
+  std::stringstream input(all_tables);
+  std::string name;
+  TaskStat st;
+  double total_busy = 0.0;
+  while (input >> name >> st.busy >> st.wait >> st.calls) {
+    TaskStat &sum = tasks[name];
+    sum.busy += st.busy;
+    sum.wait += st.wait;
+    sum.calls += st.calls;
+    total_busy += st.busy;
+  }
+  std::stringstream out;
+  out << std::fixed << std::setprecision(4) << std::endl
+      << "Task trace summary (all ranks and threads)" << std::endl
+      << std::setw(16) << "task" << std::setw(12) << "calls" << std::setw(14)
+      << "time [s]" << std::setw(10) << "fraction" << std::setw(14) << "wait [s]"
+      << std::endl;
+  for (auto &entry : tasks) {
+    out << std::setw(16) << entry.first << std::setw(12) << entry.second.calls
+        << std::setw(14) << entry.second.busy << std::setw(10)
+        << (total_busy > 0.0 ? entry.second.busy/total_busy : 0.0)
+        << std::setw(14) << entry.second.wait << std::endl;
+  }
+  out << std::setw(16) << "rank" << std::setw(12) << "" << std::setw(14) << "busy [s]"
+      << std::setw(10) << "idle" << std::setw(14) << "wait [s]" << std::endl;
+  for (int r=0; r<Globals::nranks; ++r) {
+    double avail = all_times[3*r+2];
+    out << std::setw(16) << r << std::setw(12) << "" << std::setw(14) << all_times[3*r]
+        << std::setw(10) << (avail > 0.0 ? 1.0 - all_times[3*r]/avail : 0.0)
+        << std::setw(14) << all_times[3*r+1] << std::endl;
+  }
+  std::cout << out.str();
+  return;
+}
@@ -0,0 +1,41 @@
+#ifndef UTILS_TASK_TRACE_HPP_
+#define UTILS_TASK_TRACE_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file task_trace.hpp
+//! \brief tracing of individual tasks per MeshBlock, thread and rank, written in the
+//!        Chrome trace event format (chrome://tracing, ui.perfetto.dev)
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+
+class ParameterInput;
+
+//----------------------------------------------------------------------------------------
+//! \namespace TaskTrace
+//! \brief per-thread ring buffers of task begin/end times, enabled with <trace> enable
+//!
+//! Every call of a task function in TaskList::DoAllAvailableTasks() is recorded with
+//! the gid of the MeshBlock and the stage. Calls that return TaskStatus::fail (waiting
+//! for MPI messages) are recorded as waits, and consecutive waits of one task are merged
+//! into one event. The buffers are written every ncycle_out cycles and at the end, where
+//! a summary of the time per task, the wait time and the idle fraction of every rank is
+//! printed.
+
+namespace TaskTrace {
+extern bool enabled;
+void Initialize(ParameterInput *pin, int nthreads);
+double Now();
+void Record(const char *name, int gid, int stage, double t0, double t1, bool wait);
+const char *DefaultName(int id);
+void Dump(int ncycle);
+void Finalize();
+} // namespace TaskTrace
+
+#endif // UTILS_TASK_TRACE_HPP_
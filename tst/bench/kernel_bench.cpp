@@ -0,0 +1,558 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file kernel_bench.cpp
+//! \brief microbenchmarks of the numerical kernels compiled into this configuration
+//!
+//! Built with "make bench" from the same objects as bin/athena, except main.cpp and the
+//! problem generator, which are replaced by this file. A single MeshBlock is set up with
+//! smooth synthetic data and every available kernel is called repeatedly on it:
+//!   - DonorCell, PiecewiseLinear, PiecewiseParabolic reconstruction in each direction,
+//!     and their characteristic variants (Newtonian, non-general EOS only)
+//!   - the configured Riemann solver, in the x1 direction only and net of its
+//!     donor-cell input (reported as RiemannSolverX1)
+//!   - EquationOfState::ConservedToPrimitive
+//!   - MeshRefinement restriction/prolongation of the conserved variables and
+//!     prolongation of the shared faces of the magnetic field (-b)
+//!   - the multigrid gravity smoother (--grav=mg)
+//!   - ChemNetwork::RHS and, if <chemistry> user_jac = 1, Jacobian (--chemistry=...)
+//! Only one Riemann solver and EOS are compiled per configuration, so comparing them
+//! means building "make bench" once per configure.py --flux/--eos choice.
+//!
+//! For each kernel the throughput (cells/s), the nominal compulsory memory traffic
+//! (bytes/cell: arrays read and written once) and the resulting bandwidth are printed,
+//! together with the fraction of the STREAM triad bandwidth measured at startup. A
+//! fraction close to 1 marks a kernel limited by memory bandwidth, a small fraction a
+//! compute- or latency-bound one; fractions above 1 mean that the working set of the
+//! MeshBlock stays in cache. The same data is written to <bench> output as JSON.
+//!
+//! Usage: athena_bench [-i athinput] [block/par=value ...]
+//! Without -i the built-in input below is used (3D Cartesian, one 32^3 MeshBlock).
+//! MPI builds must be run on a single rank.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max()
+#include <cmath>      // sin(), cos()
+#include <cstdint>    // int64_t
+#include <cstdio>     // fopen(), fprintf()
+#include <cstring>    // strcmp()
+#include <ctime>      // clock_gettime()
+#include <exception>  // exception
+#include <iomanip>    // setw(), setprecision()
+#include <iostream>   // cout, endl
+#include <sstream>    // stringstream
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../../src/athena.hpp"
+#include "../../src/athena_arrays.hpp"
+#include "../../src/coordinates/coordinates.hpp"
+#include "../../src/eos/eos.hpp"
+#include "../../src/field/field.hpp"
+#include "../../src/globals.hpp"
+#include "../../src/gravity/gravity.hpp"
+#include "../../src/gravity/mg_gravity.hpp"
+#include "../../src/hydro/hydro.hpp"
+#include "../../src/mesh/mesh.hpp"
+#include "../../src/mesh/mesh_refinement.hpp"
+#include "../../src/outputs/io_wrapper.hpp"
+#include "../../src/parameter_input.hpp"
+#include "../../src/reconstruct/reconstruction.hpp"
+#include "../../src/scalars/scalars.hpp"
+
+// MPI/OpenMP headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace {
+const char *default_input = R"(
+<job>
+problem_id = Bench
+
+<bench>
+min_time    = 0.5        # minimum time spent in each kernel (s)
+stream_size = 4194304    # length of the arrays of the STREAM triad
+output      = kernel_bench.json
+
+<time>
+cfl_number = 0.3
+tlim       = 1.0
+
+<mesh>
+nx1    = 32
+x1min  = -0.5
+x1max  = 0.5
+ix1_bc = periodic
+ox1_bc = periodic
+nx2    = 32
+x2min  = -0.5
+x2max  = 0.5
+ix2_bc = periodic
+ox2_bc = periodic
+nx3    = 32
+x3min  = -0.5
+x3max  = 0.5
+ix3_bc = periodic
+ox3_bc = periodic
+refinement = static
+
+<meshblock>
+nx1 = 32
+nx2 = 32
+nx3 = 32
+
+<hydro>
+gamma           = 1.6666666666666667
+iso_sound_speed = 1.0
+
+<gravity>
+mgmode     = FMG
+niteration = 10
+ix1_bc = periodic
+ox1_bc = periodic
+ix2_bc = periodic
+ox2_bc = periodic
+ix3_bc = periodic
+ox3_bc = periodic
+
+<problem>
+four_pi_G = 1.0
+)";
+
+//! result of one kernel
+struct BenchResult {
+  std::string name;
+  double cells_per_sec, bytes_per_cell;
+  int nrep;
+};
+
+double WallTime() {
+#ifdef OPENMP_PARALLEL
+  return omp_get_wtime();
+#elif defined(MPI_PARALLEL)
+  return MPI_Wtime();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn BenchResult TimeKernel(const char *name, std::int64_t ncells, double bytes,
+//!                            double min_time, Kernel kernel)
+//! \brief call kernel() once to warm up, then repeatedly for at least min_time seconds
+
+template <typename Kernel>
+BenchResult TimeKernel(const std::string &name, std::int64_t ncells, double bytes,
+                       double min_time, Kernel kernel) {
+  kernel();
+  int nrep = 0;
+  double t0 = WallTime(), t1;
+  do {
+    kernel();
+    nrep++;
+    t1 = WallTime();
+  } while (t1 - t0 < min_time || nrep < 3);
+  return {name, static_cast<double>(ncells)*nrep/(t1 - t0), bytes, nrep};
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double StreamTriad(int n, double min_time)
+//! \brief sustainable memory bandwidth in bytes/s from a[i] = b[i] + s*c[i]
+
+double StreamTriad(int n, double min_time) {
+  std::vector<Real> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+  const Real s = 0.5;
+  Real *pa = a.data(), *pb = b.data(), *pc = c.data();
+  BenchResult res = TimeKernel("triad", n, 3.0*sizeof(Real), min_time, [=]() {
+#pragma omp simd
+    for (int i=0; i<n; ++i)
+      pa[i] = pb[i] + s*pc[i];
+  });
+  return res.cells_per_sec*res.bytes_per_cell;
+}
+} // namespace
+
+//========================================================================================
+//! \fn void Mesh::InitUserMeshData(ParameterInput *pin)
+//! \brief replaces the problem generator; only sets the gravitational constant
+
+void Mesh::InitUserMeshData(ParameterInput *pin) {
+  if (SELF_GRAVITY_ENABLED)
+    SetFourPiG(pin->GetReal("problem", "four_pi_G"));
+  return;
+}
+
+//========================================================================================
+//! \fn void MeshBlock::ProblemGenerator(ParameterInput *pin)
+//! \brief smooth, periodic synthetic state so that no kernel hits a floor or fallback
+
+void MeshBlock::ProblemGenerator(ParameterInput *pin) {
+  const Real two_pi = 2.0*PI;
+  Real x1len = pmy_mesh->mesh_size.x1max - pmy_mesh->mesh_size.x1min;
+  Real x2len = pmy_mesh->mesh_size.x2max - pmy_mesh->mesh_size.x2min;
+  Real x3len = pmy_mesh->mesh_size.x3max - pmy_mesh->mesh_size.x3min;
+  for (int k=ks; k<=ke; ++k) {
+    for (int j=js; j<=je; ++j) {
+      for (int i=is; i<=ie; ++i) {
+        Real s1 = std::sin(two_pi*pcoord->x1v(i)/x1len);
+        Real s2 = std::sin(two_pi*pcoord->x2v(j)/x2len);
+        Real c3 = std::cos(two_pi*pcoord->x3v(k)/x3len);
+        phydro->w(IDN,k,j,i) = 1.0 + 0.2*s1*s2 + 0.1*c3;
+        phydro->w(IVX,k,j,i) = 0.1*s2;
+        phydro->w(IVY,k,j,i) = 0.1*c3;
+        phydro->w(IVZ,k,j,i) = 0.1*s1;
+        if (NON_BAROTROPIC_EOS)
+          phydro->w(IPR,k,j,i) = 1.0 + 0.1*s1*c3;
+        if (NSCALARS > 0) {
+          for (int n=0; n<NSCALARS; ++n)
+            pscalars->r(n,k,j,i) = (1.0 + 0.1*s2)/(NSCALARS + 1.0);
+        }
+      }
+    }
+  }
+  if (MAGNETIC_FIELDS_ENABLED) {
+    // uniform field plus transverse components that depend only on x1: div(B) = 0
+    for (int k=ks; k<=ke; ++k) {
+      for (int j=js; j<=je; ++j) {
+        for (int i=is; i<=ie+1; ++i)
+          pfield->b.x1f(k,j,i) = 0.5;
+      }
+    }
+    for (int k=ks; k<=ke; ++k) {
+      for (int j=js; j<=je+1; ++j) {
+        for (int i=is; i<=ie; ++i)
+          pfield->b.x2f(k,j,i) = 0.3 + 0.1*std::sin(two_pi*pcoord->x1v(i)/x1len);
+      }
+    }
+    for (int k=ks; k<=ke+1; ++k) {
+      for (int j=js; j<=je; ++j) {
+        for (int i=is; i<=ie; ++i)
+          pfield->b.x3f(k,j,i) = 0.2 + 0.1*std::cos(two_pi*pcoord->x1v(i)/x1len);
+      }
+    }
+    pfield->CalculateCellCenteredField(pfield->b, pfield->bcc, pcoord, is, ie, js, je,
+                                       ks, ke);
+  }
+  peos->PrimitiveToConserved(phydro->w, pfield->bcc, phydro->u, pcoord,
+                             is, ie, js, je, ks, ke);
+  if (NSCALARS > 0)
+    peos->PassiveScalarPrimitiveToConserved(pscalars->r, phydro->u, pscalars->s, pcoord,
+                                            is, ie, js, je, ks, ke);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int main(int argc, char *argv[])
+//! \brief set up one MeshBlock, time all available kernels and report the results
+
+int main(int argc, char *argv[]) {
+#ifdef MPI_PARALLEL
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &(Globals::my_rank));
+  MPI_Comm_size(MPI_COMM_WORLD, &Globals::nranks);
+  if (Globals::nranks > 1) {
+    if (Globals::my_rank == 0)
+      std::cout << "### FATAL ERROR in main" << std::endl
+                << "The kernel benchmark sets up a single MeshBlock; run it on one "
+                << "MPI rank instead of " << Globals::nranks << std::endl;
+    MPI_Finalize();
+    return(0);
+  }
+#else
+  Globals::my_rank = 0;
+  Globals::nranks  = 1;
+#endif
+
+  ParameterInput *pinput = nullptr;
+  Mesh *pmesh = nullptr;
+  std::vector<BenchResult> results;
+  double triad_bw = 0.0;
+  std::string output_file;
+#ifdef ENABLE_EXCEPTIONS
+  try {
+#endif
+    pinput = new ParameterInput;
+    char *input_filename = nullptr;
+    for (int i=1; i<argc-1; ++i) {
+      if (std::strcmp(argv[i], "-i") == 0) input_filename = argv[i+1];
+    }
+    if (input_filename != nullptr) {
+      IOWrapper infile;
+      infile.Open(input_filename, IOWrapper::FileMode::read);
+      pinput->LoadFromFile(infile);
+      infile.Close();
+    } else {
+      std::istringstream is(default_input);
+      pinput->LoadFromStream(is);
+    }
+    // add the <bench> defaults first so that they can be changed on the command line
+    pinput->GetOrAddReal("bench", "min_time", 0.5);
+    pinput->GetOrAddInteger("bench", "stream_size", 4194304);
+    pinput->GetOrAddString("bench", "output", "kernel_bench.json");
+    // PPM scratch arrays are only allocated for xorder = 3
+    pinput->GetOrAddString("time", "xorder", NGHOST >= 3 ? "3" : "2");
+    pinput->ModifyFromCmdline(argc, argv);
+    double min_time = pinput->GetReal("bench", "min_time");
+    int stream_size = pinput->GetInteger("bench", "stream_size");
+    output_file = pinput->GetString("bench", "output");
+
+    pmesh = new Mesh(pinput);
+    pmesh->Initialize(0, pinput);
+    triad_bw = StreamTriad(stream_size, min_time);
+
+    MeshBlock *pmb = pmesh->my_blocks(0);
+    Hydro *ph = pmb->phydro;
+    Field *pf = pmb->pfield;
+    Reconstruction *pr = pmb->precon;
+    int is = pmb->is, ie = pmb->ie, js = pmb->js, je = pmb->je, ks = pmb->ks,
+        ke = pmb->ke;
+    const std::int64_t ncells = pmb->GetNumberOfMeshBlockCells();
+    const double rsize = sizeof(Real);
+    AthenaArray<Real> wl(NWAVE, pmb->ncells1), wr(NWAVE, pmb->ncells1);
+    AthenaArray<Real> dxw(pmb->ncells1);
+
+    // reconstruction: reads w (and bcc), writes wl and wr
+    const double recon_bytes = (NHYDRO + 2*NWAVE + (MAGNETIC_FIELDS_ENABLED ? NFIELD : 0))
+                               *rsize;
+    const char *method_names[3] = {"DonorCell", "PiecewiseLinear", "PiecewiseParabolic"};
+    bool characteristic = !GENERAL_EOS && !RELATIVISTIC_DYNAMICS;
+    bool saved_projection = pr->characteristic_projection;
+    for (int method=0; method<3; ++method) {
+      if (method == 2 && pr->xorder < 3) continue;
+      for (int proj=0; proj<=(method > 0 && characteristic ? 1 : 0); ++proj) {
+        pr->characteristic_projection = (proj == 1);
+        for (int dir=1; dir<=3; ++dir) {
+          if ((dir == 2 && pmb->block_size.nx2 == 1)
+              || (dir == 3 && pmb->block_size.nx3 == 1)) continue;
+          std::string name = method_names[method] + std::string("X")
+                             + std::to_string(dir) + (proj == 1 ? " (char)" : "");
+          results.push_back(TimeKernel(name, ncells, recon_bytes, min_time, [&]() {
+            for (int k=ks; k<=ke+(dir == 3); ++k) {
+              for (int j=js; j<=je+(dir == 2); ++j) {
+                if (dir == 1) {
+                  if (method == 0)
+                    pr->DonorCellX1(k, j, is-1, ie+1, ph->w, pf->bcc, wl, wr);
+                  if (method == 1)
+                    pr->PiecewiseLinearX1(k, j, is-1, ie+1, ph->w, pf->bcc, wl, wr);
+                  if (method == 2)
+                    pr->PiecewiseParabolicX1(k, j, is-1, ie+1, ph->w, pf->bcc, wl, wr);
+                } else if (dir == 2) {
+                  if (method == 0)
+                    pr->DonorCellX2(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                  if (method == 1)
+                    pr->PiecewiseLinearX2(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                  if (method == 2)
+                    pr->PiecewiseParabolicX2(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                } else {
+                  if (method == 0)
+                    pr->DonorCellX3(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                  if (method == 1)
+                    pr->PiecewiseLinearX3(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                  if (method == 2)
+                    pr->PiecewiseParabolicX3(k, j, is, ie, ph->w, pf->bcc, wl, wr);
+                }
+              }
+            }
+          }));
+        }
+      }
+    }
+    pr->characteristic_projection = saved_projection;
+
+    // Riemann solver along x1, fed by donor-cell states whose cost is subtracted
+    BenchResult donor = TimeKernel("", ncells, 0.0, min_time, [&]() {
+      for (int k=ks; k<=ke; ++k) {
+        for (int j=js; j<=je; ++j)
+          pr->DonorCellX1(k, j, is-1, ie+1, ph->w, pf->bcc, wl, wr);
+      }
+    });
+    BenchResult rsolver = TimeKernel("", ncells, 0.0, min_time, [&]() {
+      for (int k=ks; k<=ke; ++k) {
+        for (int j=js; j<=je; ++j) {
+          pr->DonorCellX1(k, j, is-1, ie+1, ph->w, pf->bcc, wl, wr);
+          pmb->pcoord->CenterWidth1(k, j, is, ie+1, dxw);
+#if !MAGNETIC_FIELDS_ENABLED
+          ph->RiemannSolver(k, j, is, ie+1, IVX, wl, wr, ph->flux[X1DIR], dxw);
+#else
+          ph->RiemannSolver(k, j, is, ie+1, IVX, pf->b.x1f, wl, wr, ph->flux[X1DIR],
+                            pf->e3_x1f, pf->e2_x1f, pf->wght.x1f, dxw);
+#endif
+        }
+      }
+    });
+    double t_net = 1.0/rsolver.cells_per_sec - 1.0/donor.cells_per_sec;
+    if (t_net > 0.0) {
+      results.push_back({std::string("RiemannSolverX1 ") + RIEMANN_SOLVER, 1.0/t_net,
+                         (2*NWAVE + NHYDRO + (MAGNETIC_FIELDS_ENABLED ? 4 : 0))*rsize,
+                         rsolver.nrep});
+    }
+
+    // conserved to primitive: reads u (and face fields), writes w (and bcc)
+    AthenaArray<Real> w_old(ph->w);
+    results.push_back(TimeKernel(std::string("ConservedToPrimitive ") + EQUATION_OF_STATE,
+                                 ncells, (2*NHYDRO + (MAGNETIC_FIELDS_ENABLED ? 6 : 0))
+                                 *rsize, min_time, [&]() {
+      pmb->peos->ConservedToPrimitive(ph->u, w_old, pf->b, ph->w, pf->bcc, pmb->pcoord,
+                                      is, ie, js, je, ks, ke);
+    }));
+
+    // restriction and prolongation, per fine cell: one fine and 1/8 coarse value
+    if (pmesh->multilevel) {
+      MeshRefinement *pmr = pmb->pmr;
+      AthenaArray<Real> fine(ph->u);
+      const double amr_bytes = NHYDRO*(1.0 + 1.0/8.0)*rsize;
+      results.push_back(TimeKernel("RestrictCellCenteredValues", ncells, amr_bytes,
+                                   min_time, [&]() {
+        pmr->RestrictCellCenteredValues(ph->u, ph->coarse_cons_, 0, NHYDRO-1,
+                                        pmb->cis, pmb->cie, pmb->cjs, pmb->cje,
+                                        pmb->cks, pmb->cke);
+      }));
+      results.push_back(TimeKernel("ProlongateCellCenteredValues", ncells, amr_bytes,
+                                   min_time, [&]() {
+        pmr->ProlongateCellCenteredValues(ph->coarse_cons_, fine, 0, NHYDRO-1,
+                                          pmb->cis, pmb->cie, pmb->cjs, pmb->cje,
+                                          pmb->cks, pmb->cke);
+      }));
+      // shared faces of the magnetic field, per fine cell and component: half a fine
+      // face (only every other one in the normal direction) and 1/8 coarse face
+      if (MAGNETIC_FIELDS_ENABLED) {
+        FaceField fine_b(pf->b);
+        results.push_back(TimeKernel("ProlongateSharedField", ncells,
+                                     3*(0.5 + 1.0/8.0)*rsize, min_time, [&]() {
+          pmr->ProlongateSharedFieldX1(pf->coarse_b_.x1f, fine_b.x1f, pmb->cis,
+                                       pmb->cie+1, pmb->cjs, pmb->cje, pmb->cks,
+                                       pmb->cke);
+          pmr->ProlongateSharedFieldX2(pf->coarse_b_.x2f, fine_b.x2f, pmb->cis,
+                                       pmb->cie, pmb->cjs, pmb->cje+1, pmb->cks,
+                                       pmb->cke);
+          pmr->ProlongateSharedFieldX3(pf->coarse_b_.x3f, fine_b.x3f, pmb->cis,
+                                       pmb->cie, pmb->cjs, pmb->cje, pmb->cks,
+                                       pmb->cke+1);
+        }));
+      }
+    }
+
+#if SELF_GRAVITY_ENABLED == 2
+    // red-black Gauss-Seidel sweep on the finest level: reads u and src, writes u.
+    // A separate MGGravity instance keeps the solver state of the MeshBlock untouched.
+    {
+      MGGravity mg(pmesh->pmgrd, pmb);
+      mg.LoadSource(ph->u, IDN, NGHOST, pinput->GetReal("problem", "four_pi_G"));
+      results.push_back(TimeKernel("MGGravity::Smooth", ncells, 3*rsize, min_time,
+                                   [&]() {
+        mg.SmoothBlock(0);
+        mg.SmoothBlock(1);
+      }));
+    }
+#endif
+
+#if CHEMISTRY_ENABLED
+    // chemical network: reads abundances and energy, writes their time derivatives
+    {
+      PassiveScalars *ps = pmb->pscalars;
+      Real y[NSPECIES], ydot[NSPECIES];
+      Real time = pmesh->time;
+      results.push_back(TimeKernel("ChemNetwork::RHS", ncells,
+                                   (2*NSPECIES + NHYDRO)*rsize, min_time, [&]() {
+        for (int k=ks; k<=ke; ++k) {
+          for (int j=js; j<=je; ++j) {
+            for (int i=is; i<=ie; ++i) {
+              ps->chemnet.InitializeNextStep(k, j, i);
+              for (int n=0; n<NSPECIES; ++n) y[n] = ps->r(n,k,j,i);
+              Real e = NON_BAROTROPIC_EOS ? ph->w(IPR,k,j,i) : 0.0;
+              ps->chemnet.RHS(time, y, e, ydot);
+              if (NON_BAROTROPIC_EOS) ps->chemnet.Edot(time, y, e);
+            }
+          }
+        }
+      }));
+      if (pinput->GetOrAddBoolean("chemistry", "user_jac", false)) {
+        int njac = NON_BAROTROPIC_EOS ? NSPECIES+1 : NSPECIES;
+        AthenaArray<Real> jac(njac, njac);
+        results.push_back(TimeKernel("ChemNetwork::Jacobian", ncells,
+                                     (NSPECIES + njac*njac)*rsize, min_time, [&]() {
+          for (int k=ks; k<=ke; ++k) {
+            for (int j=js; j<=je; ++j) {
+              for (int i=is; i<=ie; ++i) {
+                ps->chemnet.InitializeNextStep(k, j, i);
+                for (int n=0; n<NSPECIES; ++n) y[n] = ps->r(n,k,j,i);
+                if (NON_BAROTROPIC_EOS)
+                  ps->chemnet.Jacobian(time, y, ydot, jac);
+                else
+                  ps->chemnet.Jacobian_isothermal(time, y, ydot, jac);
+              }
+            }
+          }
+        }));
+      }
+    }
+#endif
+#ifdef ENABLE_EXCEPTIONS
+  }
+  catch(std::exception const& ex) {
+    std::cout << ex.what() << std::endl;
+#ifdef MPI_PARALLEL
+    MPI_Finalize();
+#endif
+    return(0);
+  }
+#endif // ENABLE_EXCEPTIONS
+
+  if (Globals::my_rank == 0) {
+    MeshBlock *pmb = pmesh->my_blocks(0);
+    std::cout << "Kernel benchmark: " << pmb->block_size.nx1 << "x"
+              << pmb->block_size.nx2 << "x" << pmb->block_size.nx3 << " MeshBlock, "
+              << "NGHOST=" << NGHOST << ", " << sizeof(Real) << "-byte Real" << std::endl
+              << "STREAM triad bandwidth = " << triad_bw*1.0e-9 << " GB/s" << std::endl
+              << std::endl << std::left << std::setw(44) << "kernel" << std::right
+              << std::setw(12) << "Mcells/s" << std::setw(12) << "bytes/cell"
+              << std::setw(10) << "GB/s" << std::setw(12) << "BW fraction" << std::endl;
+    for (const BenchResult &r : results) {
+      double bw = r.cells_per_sec*r.bytes_per_cell;
+      std::cout << std::left << std::setw(44) << r.name << std::right << std::fixed
+                << std::setprecision(2) << std::setw(12) << r.cells_per_sec*1.0e-6
+                << std::setw(12) << r.bytes_per_cell << std::setw(10) << bw*1.0e-9
+                << std::setw(12) << bw/triad_bw << std::endl;
+    }
+
+    FILE *pfile = std::fopen(output_file.c_str(), "w");
+    if (pfile != nullptr) {
+      std::fprintf(pfile, "{\n  \"coordinates\": \"%s\", \"eos\": \"%s\", "
+                   "\"riemann_solver\": \"%s\",\n  \"block\": [%d, %d, %d], "
+                   "\"nghost\": %d, \"real_bytes\": %d,\n  \"triad_bytes_per_sec\": %.6e,"
+                   "\n  \"kernels\": [", COORDINATE_SYSTEM, EQUATION_OF_STATE,
+                   RIEMANN_SOLVER, pmb->block_size.nx1, pmb->block_size.nx2,
+                   pmb->block_size.nx3, NGHOST, static_cast<int>(sizeof(Real)), triad_bw);
+      for (std::size_t n=0; n<results.size(); ++n) {
+        const BenchResult &r = results[n];
+        double bw = r.cells_per_sec*r.bytes_per_cell;
+        std::fprintf(pfile, "%s\n    {\"name\": \"%s\", \"cells_per_sec\": %.6e, "
+                     "\"bytes_per_cell\": %.1f, \"bytes_per_sec\": %.6e, "
+                     "\"bw_fraction\": %.4f, \"nrep\": %d}", n == 0 ? "" : ",",
+                     r.name.c_str(), r.cells_per_sec, r.bytes_per_cell, bw,
+                     bw/triad_bw, r.nrep);
+      }
+      std::fprintf(pfile, "\n  ]\n}\n");
+      std::fclose(pfile);
+    }
+  }
+
+  delete pmesh;
+  delete pinput;
+#ifdef MPI_PARALLEL
+  MPI_Finalize();
+#endif
+  return(0);
+}
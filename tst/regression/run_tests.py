@@ -12,6 +12,11 @@ Notes:
   - To add a new script, create a new .py file in scripts/tests/ subdirectory.
   - See scripts/tests/example.py for an example.
     - Example can be forced to run, but does not run by default in full test.
+  - Performance tests in scripts/tests/perf/ only run when selected, e.g.
+      python run_tests.py perf --perf_tolerance=0.05
+    and compare throughput with the baselines in data/perf_baselines.json; use
+    --perf_update to record new baselines for the current machine and --perf_phases
+    to also collect per-task times from a second, traced run.
   - For more information, check online regression test documentation.
 """
 
@@ -33,6 +38,7 @@ sys.dont_write_bytecode = True
 
 # Athena++ modules
 import scripts.utils.athena as athena  # noqa
+import scripts.utils.performance as performance  # noqa
 
 logger = logging.getLogger('athena')
 
@@ -54,10 +60,14 @@ def main(**kwargs):
     # Get args to pass to scripts.utils.athena as list of strings
     athena_config_args = kwargs.pop('config')
     athena_run_args = kwargs.pop('run')
+    # Settings of the performance tests
+    performance.tolerance = kwargs.pop('perf_tolerance')
+    performance.update_baselines = kwargs.pop('perf_update')
+    performance.trace_phases = kwargs.pop('perf_phases')
 
     if len(tests) == 0:  # run all tests
         for _, directory, ispkg in iter_modules(path=['scripts/tests']):
-            if ispkg:
+            if ispkg and directory != 'perf':  # timing tests only run on request
                 dir_test_names = [name for _, name, _ in
                                   iter_modules(path=['scripts/tests/'
                                                      + directory],
@@ -181,18 +191,26 @@ def main(**kwargs):
     logger.info('\nResults:')
     for name, result, error, time in zip(test_names, test_results, test_errors,
                                          test_times):
-        result_string = 'passed' if result else 'failed'
+        if isinstance(result, str):  # e.g. 'baseline recorded' by performance tests
+            result_string = result
+        else:
+            result_string = 'passed' if result else 'failed'
         error_string = ' -- unexpected failure in {0} stage'.format(error) \
                        if error is not None else '; time elapsed: {0:.3g} s'.format(time)
         logger.info('    {0}: {1}{2}'.format(name, result_string, error_string))
     logger.info('')
     num_tests = len(test_results)
     num_passed = test_results.count(True)
+    num_recorded = len([r for r in test_results if isinstance(r, str)])
     test_string = 'test' if num_tests == 1 else 'tests'
-    logger.info('Summary: {0} out of {1} {2} passed\n'.format(num_passed, num_tests,
-                                                              test_string))
+    if num_recorded > 0:
+        logger.info('Summary: {0} out of {1} {2} passed, {3} recorded a baseline\n'
+                    .format(num_passed, num_tests, test_string, num_recorded))
+    else:
+        logger.info('Summary: {0} out of {1} {2} passed\n'.format(num_passed, num_tests,
+                                                                  test_string))
     # For CI calling scripts, explicitly raise error if not all tests passed
-    if num_passed == num_tests:
+    if num_passed + num_recorded == num_tests:
         return 0
     else:
         raise TestError()
@@ -299,6 +317,19 @@ if __name__ == '__main__':
                               ' automatically passes -coverage to configure.py.'
                               ' Currently, assumes that Lcov is being used and appends '
                               ' -t and -o options w/ reformatted test name to COVERAGE.'))
+    parser.add_argument('--perf_tolerance',
+                        type=float,
+                        default=0.1,
+                        help='allowed relative loss of throughput in performance tests')
+    parser.add_argument('--perf_update',
+                        default=False,
+                        action='store_true',
+                        help='store measured throughput as new performance baselines')
+    parser.add_argument('--perf_phases',
+                        default=False,
+                        action='store_true',
+                        help='rerun performance tests with the task trace to report '
+                             'per-task times')
     parser.add_argument('-d', '--debug',
                         help="print debugging information",
                         action="store_const",
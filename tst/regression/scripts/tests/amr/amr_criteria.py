@@ -0,0 +1,50 @@
+# Regression test for the built-in refinement criteria (<amr_criterionN> blocks)
+#
+# Runs a 2D blast wave refined by the built-in relative pressure gradient criterion and
+# by the equivalent problem generator criterion, and checks that both give identical
+# histories. A third run only checks the refinement every 4 cycles with a one cell
+# buffer and must conserve mass.
+
+# Modules
+import logging
+import numpy as np
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='blast', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.test_amr_criteria', ['job/problem_id=Builtin'])
+    athena.run('hydro/athinput.test_amr_criteria',
+               ['job/problem_id=User', 'problem/thr=0.5',
+                'amr_criterion1/refine_tol=1e30', 'amr_criterion1/derefine_tol=1e30'])
+    athena.run('hydro/athinput.test_amr_criteria',
+               ['job/problem_id=Interval', 'mesh/refine_interval=4'])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    builtin = athena_read.hst('bin/Builtin.hst')
+    user = athena_read.hst('bin/User.hst')
+    for key in ['mass', 'tot-E', '1-KE', '2-KE']:
+        err = np.max(np.abs(builtin[key] - user[key]) / np.abs(user[key]).max())
+        if err > 1.0e-12:
+            logger.warning('built-in and user criteria differ in %s by %g', key, err)
+            analyze_status = False
+    interval = athena_read.hst('bin/Interval.hst')
+    err = abs(interval['mass'][-1] / interval['mass'][0] - 1.0)
+    if err > 1.0e-12:
+        logger.warning('mass not conserved with refine_interval=4: %g', err)
+        analyze_status = False
+    return analyze_status
@@ -0,0 +1,44 @@
+# Regression test for the user boundary functions enrolled per row of ghost cells
+#
+# Runs the double Mach reflection with AMR, where the refined shocks reach the user
+# boundaries, once with the whole-face user boundary functions and once with the
+# equivalent pencil functions, and checks that both give identical histories.
+
+# Modules
+import logging
+import numpy as np
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='dmr', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.test_user_bc_pencil', ['job/problem_id=Face'])
+    athena.run('hydro/athinput.test_user_bc_pencil',
+               ['job/problem_id=Pencil', 'problem/pencil_bc=true'])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    face = athena_read.hst('bin/Face.hst')
+    pencil = athena_read.hst('bin/Pencil.hst')
+    if len(face['time']) != len(pencil['time']):
+        logger.warning('the runs have different numbers of history outputs')
+        return False
+    for key in ['mass', 'tot-E', '1-mom', '2-mom', '1-KE', '2-KE']:
+        err = np.max(np.abs(face[key] - pencil[key]) / np.abs(face[key]).max())
+        if err > 1.0e-12:
+            logger.warning('face and pencil user boundaries differ in %s by %g', key, err)
+            analyze_status = False
+    return analyze_status
@@ -0,0 +1,70 @@
+# regression test for the prefix-scan column density solver of the six-ray integrator:
+# compares column_solver=scan against the block-to-block sweep on a multi-block mesh
+
+# Modules
+import os
+import logging
+import numpy as np                             # standard Python module for numerics
+import sys                                     # standard Python module to change path
+import scripts.utils.athena as athena          # utilities for running Athena++
+sys.path.insert(0, '../../vis/python')         # insert path to Python read scripts
+import athena_read                             # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_nblocks = 32  # 16x16x32 mesh in 8x8x8 blocks
+
+
+def prepare(**kwargs):
+    try:
+        if os.environ['CXX']:
+            cxx = os.environ['CXX']
+        else:
+            cxx = 'g++'
+    except KeyError:
+        cxx = 'g++'
+    athena.configure(
+        prob='read_vtk',
+        chemistry='gow17',
+        chem_ode_solver='cvode',
+        chem_radiation='six_ray',
+        cxx=cxx,
+        cvode_path=os.environ['CVODE_PATH']
+        )
+    athena.make()
+
+
+def run(**kwargs):
+    vtkfile = os.path.abspath("data/chem_cgk_input.vtk")
+    for solver in ['sweep', 'scan']:
+        arguments = ["problem/vtkfile="+vtkfile,
+                     'time/ncycle_out=100',
+                     'meshblock/nx1=8', 'meshblock/nx2=8', 'meshblock/nx3=8',
+                     'chem_radiation/column_solver='+solver,
+                     'job/problem_id=six_ray_'+solver]
+        athena.run('chemistry/athinput.six_ray', arguments)
+
+
+def analyze():
+    err_control = 1e-10
+    err_control_species = 1e-3
+    small_ = 1e-30
+    species = ["He+", "OHx", "CHx", "CO", "C+", "HCO+", "H2", "H+",
+               "H3+", "H2+", "O+", "Si+"]
+    err_max = 0.
+    for b in range(_nblocks):
+        _, _, _, data_ref = athena_read.vtk(
+            'bin/six_ray_sweep.block{0}.out1.00001.vtk'.format(b))
+        _, _, _, data_new = athena_read.vtk(
+            'bin/six_ray_scan.block{0}.out1.00001.vtk'.format(b))
+        err_rho = (abs(data_ref["rho"] - data_new["rho"])
+                   / (abs(data_ref["rho"]) + small_)).max()
+        if err_rho > err_control:
+            print("block", b, "rho", err_rho)
+            return False
+        for s in species:
+            xs_ref = data_ref["r"+s]
+            xs_new = data_new["r"+s]
+            err_s = (abs(xs_ref - xs_new) / (abs(xs_ref)+small_)).max()
+            err_max = max(err_max, err_s)
+    print("err_max", err_max)
+    return err_max < err_control_species
@@ -0,0 +1,78 @@
+# Regression test based on cosmic ray diffusion test problem with the implicit
+# cosmic ray transport
+
+# Modules
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+
+# Prepare Athena++
+
+
+def prepare(**kwargs):
+    athena.configure('cr',
+                     prob='cr_diffusion',
+                     coord='cartesian',
+                     flux='hllc')
+    athena.make()
+
+# Run Athena++
+
+
+def run(**kwargs):
+    # case 1: static diffusion along x direction
+    arguments = ['mesh/nx1=256', 'mesh/ix1_bc=outflow', 'mesh/ox1_bc=outflow',
+                 'mesh/nx2=4', 'mesh/ix2_bc=periodic', 'mesh/ox2_bc=periodic',
+                 'meshblock/nx1=32', 'meshblock/nx2=4', 'problem/direction=0',
+                 'problem/v0=0', 'time/ncycle_out=100', 'cr/integrator=implicit']
+    athena.run('cosmic_ray/athinput.cr_diffusion', arguments)
+
+    # case 2: dynamic diffusion along x direction
+    arguments = ['mesh/nx1=256', 'mesh/ix1_bc=outflow', 'mesh/ox1_bc=outflow',
+                 'mesh/nx2=4', 'mesh/ix2_bc=periodic', 'mesh/ox2_bc=periodic',
+                 'meshblock/nx1=32', 'meshblock/nx2=4', 'problem/direction=0',
+                 'problem/v0=1', 'time/ncycle_out=100', 'cr/integrator=implicit']
+    athena.run('cosmic_ray/athinput.cr_diffusion', arguments)
+
+    # case 3: the same diffusion coefficient with a ten times larger vmax, which
+    # does not change the time step of the implicit transport
+    arguments = ['mesh/nx1=256', 'mesh/ix1_bc=outflow', 'mesh/ox1_bc=outflow',
+                 'mesh/nx2=4', 'mesh/ix2_bc=periodic', 'mesh/ox2_bc=periodic',
+                 'meshblock/nx1=32', 'meshblock/nx2=4', 'problem/direction=0',
+                 'problem/v0=0', 'time/ncycle_out=100', 'cr/integrator=implicit',
+                 'cr/vmax=1000', 'problem/sigma=1.e4']
+    athena.run('cosmic_ray/athinput.cr_diffusion', arguments)
+
+    # case 4: static diffusion along y direction
+    arguments = ['mesh/nx1=4', 'mesh/ix1_bc=periodic', 'mesh/ox1_bc=periodic',
+                 'mesh/nx2=256', 'mesh/ix2_bc=outflow', 'mesh/ox2_bc=outflow',
+                 'meshblock/nx1=4', 'meshblock/nx2=32', 'problem/direction=1',
+                 'problem/v0=0', 'time/ncycle_out=100', 'cr/integrator=implicit']
+    athena.run('cosmic_ray/athinput.cr_diffusion', arguments)
+
+
+# Analyze outputs
+
+
+def analyze():
+    filename = 'bin/diffusion_error.dat'
+    data = []
+    with open(filename, 'r') as f:
+        raw_data = f.readlines()
+        for line in raw_data:
+            if line.split()[0][0] == '#':
+                continue
+            data.append([float(val) for val in line.split()])
+
+    labels = ['static diffusion along x', 'dynamic diffusion along x',
+              'static diffusion along x with vmax=1000',
+              'static diffusion along y']
+    # the implicit fluxes are first order, the errors are those of the explicit
+    # transport with cr_xorder=1
+    limits = [2.2e-2, 2.2e-2, 2.2e-2, 2.2e-2]
+    for n in range(len(labels)):
+        if data[n][8] > limits[n]:
+            print("error in implicit " + labels[n] + ": ", data[n][8])
+            return False
+
+    return True
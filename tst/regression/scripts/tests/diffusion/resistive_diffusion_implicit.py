@@ -0,0 +1,76 @@
+# Regression test based on the resistive decay of a sinusoidal magnetic field whose
+# wavevector lies along the diagonal of a periodic 3D box. The decay rate of the
+# magnetic energy is fit and compared with the analytic rate 2 eta k^2, using explicit
+# and implicit (Multigrid) Ohmic diffusion, and the total energy must be conserved.
+
+# Modules
+import logging
+import numpy as np
+from numpy.polynomial import Polynomial
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_eta = 0.05
+
+# (integrator, theta, upper bound on the relative error of the decay rate)
+cases = [('explicit', 1.0, 0.01),
+         ('implicit', 1.0, 0.04),
+         ('implicit', 0.5, 0.01)]
+# upper bound on the relative change of the total energy
+energy_tol = 1.0e-11
+
+
+def prepare(*args, **kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('b', *args,
+                     prob='resist',
+                     eos='adiabatic', **kwargs)
+    athena.make()
+
+
+def run(**kwargs):
+    for (integrator, theta, _) in cases:
+        arguments = ['time/ncycle_out=0',
+                     'resistivity/integrator={}'.format(integrator),
+                     'resistivity/theta={}'.format(theta),
+                     'problem/eta_ohm={}'.format(_eta),
+                     'job/problem_id=ResistiveDecay-{}-{}'.format(integrator, theta)]
+        athena.run('mhd/athinput.resist_implicit', arguments)
+
+
+def analyze():
+    # the wavevector 2 pi (1, 1, 1) of the unit box
+    ksqr = 3.0*(2.0*np.pi)**2
+    decay_rate = 2.0*_eta*ksqr
+    analyze_status = True
+
+    for (integrator, theta, err_tol) in cases:
+        label = '[Resistive Decay {} theta={}]'.format(integrator, theta)
+        hst_data = athena_read.hst('bin/ResistiveDecay-{}-{}.hst'
+                                   .format(integrator, theta))
+        tt = hst_data['time']
+        me = hst_data['1-ME'] + hst_data['2-ME'] + hst_data['3-ME']
+        tot_e = hst_data['tot-E']
+
+        p = Polynomial.fit(tt, np.log(me), 1)
+        fit_rate = -p.convert(domain=(-1, 1)).coef[-1]
+        error_rel = np.fabs(decay_rate/fit_rate - 1.0)
+        energy_err = np.amax(np.fabs(tot_e/tot_e[0] - 1.0))
+
+        logger.info('{}: Analytic decay rate = {}'.format(label, decay_rate))
+        logger.info('{}: Measured decay rate = {}'.format(label, fit_rate))
+        logger.info('{}: Decay rate relative error = {}'.format(label, error_rel))
+        logger.info('{}: Total energy relative change = {}'.format(label, energy_err))
+        if error_rel > err_tol:
+            logger.warning('{}: decay rate disagrees with prediction by >{}%'
+                           .format(label, err_tol*100.))
+            analyze_status = False
+        if energy_err > energy_tol:
+            logger.warning('{}: total energy is not conserved'.format(label))
+            analyze_status = False
+
+    return analyze_status
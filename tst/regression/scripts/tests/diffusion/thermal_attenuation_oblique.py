@@ -0,0 +1,100 @@
+# Regression test based on a sound wave damped by thermal conduction, propagating along
+# the diagonal of a periodic 3D box with the magnetic field parallel to the wavevector.
+# Isotropic and field-aligned conduction damp the wave at the same rate, so the fit
+# decay rate of every run, using the explicit and the implicit (Multigrid) conduction
+# solvers, is compared with the dispersion relation and with the first run.
+
+# Modules
+import logging
+import numpy as np
+from numpy.polynomial import Polynomial
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_kappa = 0.02
+_gamma = 5.0/3.0
+_nx = 32
+
+# (conduction, integrator); the first case is the reference of the others
+cases = [('iso', 'explicit'),
+         ('aniso', 'explicit'),
+         ('iso', 'implicit'),
+         ('aniso', 'implicit')]
+# Upper bound on relative error of the decay rate, dominated by numerical dissipation
+error_rel_tol = 0.15
+# Upper bound on relative difference of the decay rate from the reference case
+diff_rel_tol = 0.03
+
+
+def prepare(*args, **kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('b', *args,
+                     prob='conduction_wave',
+                     eos='adiabatic', **kwargs)
+    athena.make()
+
+
+def run(**kwargs):
+    for (cond, integrator) in cases:
+        kappa_iso = _kappa if cond == 'iso' else 0.0
+        kappa_aniso = _kappa if cond == 'aniso' else 0.0
+        arguments = ['time/ncycle_out=0',
+                     'mesh/nx1={}'.format(_nx),
+                     'mesh/nx2={}'.format(_nx),
+                     'mesh/nx3={}'.format(_nx),
+                     'meshblock/nx1={}'.format(_nx//2),
+                     'meshblock/nx2={}'.format(_nx//2),
+                     'meshblock/nx3={}'.format(_nx//2),
+                     'conduction/integrator={}'.format(integrator),
+                     'problem/kappa_iso={}'.format(kappa_iso),
+                     'problem/kappa_aniso={}'.format(kappa_aniso),
+                     'job/problem_id=CondWave-{}-{}'.format(cond, integrator)]
+        athena.run('mhd/athinput.conduction_wave', arguments)
+
+
+def analyze():
+    # the wavevector 2 pi (1, 1, 1) of the unit box; c_s = 1 and p = 1/gamma
+    ksqr = 3.0*(2.0*np.pi)**2
+    # perturbations exp(s t) of the conducting gas satisfy
+    #   s^3 + a s^2 + k^2 s + a k^2/gamma = 0,  a = (gamma-1) kappa k^2,
+    # and the sound waves are the complex pair of roots
+    a = (_gamma - 1.0)*_kappa*ksqr
+    roots = np.roots([1.0, a, ksqr, a*ksqr/_gamma])
+    decay_rate = -roots[np.argmax(np.abs(roots.imag))].real
+    analyze_status = True
+    ref_rate = None
+
+    for (cond, integrator) in cases:
+        label = '[Oblique Thermal Attenuation {} {}]'.format(cond, integrator)
+        hst_data = athena_read.hst('bin/CondWave-{}-{}.hst'.format(cond, integrator))
+        tt = hst_data['time']
+        max_v = hst_data['max-v']
+
+        # estimate the decay rate from simulation, using weighted least-squares (WLS)
+        yy = np.log(np.abs(max_v))
+        p = Polynomial.fit(tt, yy, 1, w=np.sqrt(max_v))
+        fit_rate = -p.convert(domain=(-1, 1)).coef[-1]
+        if ref_rate is None:
+            ref_rate = fit_rate
+        error_rel = np.fabs(decay_rate/fit_rate - 1.0)
+        diff_rel = np.fabs(fit_rate/ref_rate - 1.0)
+
+        logger.info('{}: Analytic decay rate = {}'.format(label, decay_rate))
+        logger.info('{}: Measured decay rate = {}'.format(label, fit_rate))
+        logger.info('{}: Decay rate relative error = {}'.format(label, error_rel))
+        logger.info('{}: Relative difference from {} {} = {}'.format(
+            label, cases[0][0], cases[0][1], diff_rel))
+        if error_rel > error_rel_tol:
+            logger.warning('{}: decay rate disagrees with prediction by >{}%'
+                           .format(label, error_rel_tol*100.))
+            analyze_status = False
+        if diff_rel > diff_rel_tol:
+            logger.warning('{}: decay rate differs from {} {} by >{}%'.format(
+                label, cases[0][0], cases[0][1], diff_rel_tol*100.))
+            analyze_status = False
+
+    return analyze_status
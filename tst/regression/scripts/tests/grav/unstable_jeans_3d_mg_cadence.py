@@ -0,0 +1,74 @@
+# Regression test for the self-gravity solve cadence control based on linear Jeans
+# instability with MG gravity + no MPI.
+# The Poisson equation is solved once per vl2 step (iterative multigrid warm-started
+# from the extrapolated potential) and phi is extrapolated to the half step. Checks the
+# L1 errors and their convergence as in unstable_jeans_3d_mg, and the number of solves
+# and the extrapolation error reported in the history file.
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='jeans',
+                     grav='mg',
+                     **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    def arg_res(res):
+        return ['mesh/nx1='+str(2*res), 'mesh/nx2='+str(res), 'mesh/nx3='+str(res),
+                'meshblock/nx1=16', 'meshblock/nx2=16', 'meshblock/nx3=16',
+                'problem/njeans=1.5', 'job/problem_id=Cadence'+str(res),
+                'output2/dt=-1', 'time/tlim=0.04', 'problem/compute_error=true',
+                'gravity/mgmode=MGI', 'gravity/solve_unit=step',
+                'time/ncycle_out=10']
+    athena.run('hydro/athinput.jeans_3d', arg_res(32))
+    athena.run('hydro/athinput.jeans_3d', arg_res(64))
+
+
+# Analyze outputs
+def analyze():
+    # read data from error file
+    filename = 'bin/jeans-errors.dat'
+    data = athena_read.error_dat(filename)
+    logger.warning(data)
+    result = True
+    # error
+    for i in range(len(data)):
+        if data[i][4] > 1.e-7:
+            logger.warning("MG Gravity Linear Jeans instability error is too large: %d",
+                           32*2**i)
+            result = False
+    # convergence to 2nd order, doubling resolution should decrease error by 4.0
+    for i in range(len(data)-1):
+        if data[i+1][4] > (1.5*data[i][4]/(4.0)):
+            slope = np.log(data[i+1][4]/data[i][4])/np.log(2.0)
+            logger.warning(
+                "Linear Jeans instability error is not converging at 2nd order")
+            logger.warning("Order estimate: %g", slope)
+            result = False
+
+    # one solve per step plus the initial solve, small extrapolation error
+    for i, res in enumerate([32, 64]):
+        hst = athena_read.hst('bin/Cadence{0}.hst'.format(res))
+        nsolve = hst['grav-nsolve'][-1]
+        if nsolve != data[i][3] + 1:
+            logger.warning("Unexpected number of gravity solves at %d: %g", res, nsolve)
+            result = False
+        if np.max(hst['grav-err']) > 2.e-2:
+            logger.warning("Potential extrapolation error is too large at %d: %g",
+                           res, np.max(hst['grav-err']))
+            result = False
+    return result
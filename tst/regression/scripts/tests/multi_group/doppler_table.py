@@ -0,0 +1,65 @@
+# Regression test of the tabulated frequency shifts, based on the thermal relaxation
+# problem in a uniformly moving medium, using the implicit multi-group radiation module
+
+# Modules
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+
+# Prepare Athena++
+
+
+def prepare(**kwargs):
+    athena.configure('implicit_radiation',
+                     prob='thermal_multigroup',
+                     coord='cartesian',
+                     flux='hllc')
+    athena.make()
+
+# Run Athena++
+
+
+def run(**kwargs):
+    # shifts calculated in every cell, then interpolated from the table
+    for table in (0, 256):
+        arguments = [
+            'problem/er_1=10.0',
+            'problem/tgas=1.0',
+            'problem/sigma_1=100.0',
+            'problem/sigma_2=200.0',
+            'problem/sigma_3=300.0',
+            'problem/black_body=1',
+            'problem/vx=0.5',
+            'radiation/prat=1.0',
+            'radiation/crat=10.0',
+            'radiation/error_limit=1.e-12',
+            'radiation/n_frequency=16',
+            'radiation/frequency_min=-0.5',
+            'radiation/frequency_max=-15',
+            'radiation/doppler_table=' + repr(table),
+            'mesh/nx1=4',
+            'meshblock/nx1=4',
+            'time/tlim=0.5',
+            'time/ncycle_out=100']
+        athena.run('radiation/athinput.thermal_multigroup', arguments)
+
+# Analyze outputs
+
+
+def analyze():
+    filename = 'bin/Averaged_quantity.dat'
+    data = []
+    with open(filename, 'r') as f:
+        raw_data = f.readlines()
+        for line in raw_data:
+            if line.split()[0][0] == '#':
+                continue
+            data.append([float(val) for val in line.split()])
+
+    # gas temperature and energy density of every group
+    for ref, val in zip(data[0], data[1]):
+        if abs(val - ref) > 1.e-4*abs(ref):
+            print("tabulated frequency shifts: T, Er_nu:", data[1], "exact:", data[0])
+            return False
+
+    return True
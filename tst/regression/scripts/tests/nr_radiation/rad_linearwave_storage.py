@@ -0,0 +1,91 @@
+# Regression test of the reduced-precision storage of the specific intensities,
+# based on the radiation linear wave problem split over several MeshBlocks, using the
+# explicit radiation hydro module
+
+# Modules
+import os
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+
+_storage = ('double', 'float', 'scaled16')
+
+# Prepare Athena++
+
+
+def prepare(**kwargs):
+    athena.configure('nr_radiation',
+                     prob='rad_linearwave',
+                     coord='cartesian',
+                     flux='hllc')
+    athena.make()
+
+# Run Athena++
+
+
+def run(**kwargs):
+    for storage in _storage:
+        for i in (32, 64):
+            arguments = ['problem/regime=1', 'radiation/prat=0.01',
+                         'radiation/crat=10.0',
+                         'radiation/intensity_storage=' + storage,
+                         'time/tlim=0.7745966144169111', 'problem/compute_error=true',
+                         'mesh/nx1=' + repr(i), 'mesh/nx2=8', 'mesh/nx3=1',
+                         'meshblock/nx1=' + repr(i//4),
+                         'meshblock/nx2=4',
+                         'meshblock/nx3=1',
+                         'time/ncycle_out=100']
+            athena.run('radiation/athinput.rad_linearwave', arguments)
+            # the boundaries are periodic, so gas plus radiation energy is conserved
+            os.system('mv bin/radwave.hst bin/radwave_{}_{}.hst'.format(storage, i))
+
+# Analyze outputs
+
+
+def total_energy(storage, nx1):
+    # total gas energy plus prat times the radiation energy, from the history file
+    data = []
+    with open('bin/radwave_{}_{}.hst'.format(storage, nx1), 'r') as f:
+        for line in f.readlines():
+            if line.split()[0][0] == '#':
+                continue
+            data.append([float(val) for val in line.split()])
+    prat = 0.01
+    return [d[9] + prat*d[10] for d in data]
+
+
+def analyze():
+    filename = 'bin/linearwave-errors.dat'
+    data = []
+    with open(filename, 'r') as f:
+        raw_data = f.readlines()
+        for line in raw_data:
+            if line.split()[0][0] == '#':
+                continue
+            data.append([float(val) for val in line.split()])
+
+    # errors of the double-precision runs, and upper bounds of the reduced-precision
+    # runs relative to them
+    ref = (data[0][4], data[1][4])
+    ratio = {'double': 1.0, 'float': 1.05, 'scaled16': 1.05}
+    for n, storage in enumerate(_storage):
+        err = (data[2*n][4], data[2*n+1][4])
+        if err[1] > ratio[storage]*ref[1] + 1.e-12:
+            print("error with intensity_storage=" + storage + ": ", err[1], ref[1])
+            return False
+        # rounding must be unbiased: Er may only lose the tiny radiation perturbation
+        if data[2*n+1][8] > 2.0e-9:
+            print("Er error with intensity_storage=" + storage + ": ", data[2*n+1][8])
+            return False
+        if err[1]/err[0] > 0.55:
+            print("not converging with intensity_storage=" + storage + ": ",
+                  err[1], err[0])
+            return False
+        for i in (32, 64):
+            etot = total_energy(storage, i)
+            if abs(etot[-1] - etot[0]) > 1.0e-12*etot[0]:
+                print("energy not conserved with intensity_storage=" + storage + ": ",
+                      etot[0], etot[-1])
+                return False
+
+    return True
@@ -0,0 +1,70 @@
+# Regression test for coarsened and region-of-interest HDF5 outputs
+#
+# Runs a 3D blast wave with a statically refined center and writes the same data at
+# native resolution, coarsened by 2, and restricted to the refined MeshBlocks of one
+# octant. Checks that the coarsened blocks are the 2x2x2 averages of the native ones
+# and that both reduced files can be read with athena_read.athdf().
+
+# Modules
+import logging
+import numpy as np
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('hdf5', prob='blast', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = ['time/ncycle_out=0']
+    athena.run('hydro/athinput.test_hdf5_coarsen', arguments)
+
+
+# Analyze outputs
+def analyze():
+    import h5py
+    analyze_status = True
+    basename = 'bin/TestHDF5Coarsen.out{0}.00002.athdf'
+    with h5py.File(basename.format(1), 'r') as f:
+        full = f['prim'][:]
+        size = f.attrs['RootGridSize']
+    with h5py.File(basename.format(2), 'r') as f:
+        coarse = f['prim'][:]
+        size_coarse = f.attrs['RootGridSize']
+    if np.any(size_coarse * 2 != size):
+        logger.warning('coarsened root grid size %s for native size %s',
+                       size_coarse, size)
+        analyze_status = False
+    nv, nb, nz, ny, nx = coarse.shape
+    average = full.reshape(nv, nb, nz, 2, ny, 2, nx, 2).mean(axis=(3, 5, 7))
+    err = np.max(np.abs(average - coarse) / np.abs(average))
+    if err > 1.0e-6:
+        logger.warning('coarsened data differs from block averages by %g', err)
+        analyze_status = False
+
+    with h5py.File(basename.format(3), 'r') as f:
+        levels = f['Levels'][:]
+        num_blocks = f.attrs['NumMeshBlocks']
+    if num_blocks != 8 or np.any(levels != 1):
+        logger.warning('region of interest contains %d blocks on levels %s',
+                       num_blocks, np.unique(levels))
+        analyze_status = False
+
+    # reduced files remain readable at the native level structure
+    data = athena_read.athdf(basename.format(2))
+    if data['rho'].shape != (32, 32, 32):
+        logger.warning('coarsened file read with shape %s', data['rho'].shape)
+        analyze_status = False
+    data = athena_read.athdf(basename.format(3))
+    if data['rho'].shape != (64, 64, 64) or np.max(data['rho']) <= 0.0:
+        logger.warning('region-of-interest file read incorrectly')
+        analyze_status = False
+    return analyze_status
@@ -0,0 +1,66 @@
+# Regression test for in-situ analysis outputs (file_type = hist, prof, spec)
+#
+# Runs decaying 3D turbulence on 8 MeshBlocks and checks the reductions against the
+# history file: the volume histogram must add up to the volume of the domain, the
+# mass-weighted joint histogram and radial profile to the total mass, and the
+# mass-weighted velocity spectrum to twice the kinetic energy (Parseval).
+
+# Modules
+import logging
+import numpy as np
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('fft', prob='turb', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = ['time/ncycle_out=0']
+    athena.run('hydro/athinput.test_insitu', arguments)
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    tol = 1.0e-10
+    hst = athena_read.hst('bin/TestInSitu.hst')
+    mass = hst['mass']
+    ke = hst['1-KE'] + hst['2-KE'] + hst['3-KE']
+    for n in range(3):
+        pdf = np.loadtxt('bin/TestInSitu.out2.{0:05d}.hist'.format(n))
+        if abs(np.sum(pdf[:, 2]) - 1.0) > tol:
+            logger.warning('volume histogram %d sums to %g instead of 1', n,
+                           np.sum(pdf[:, 2]))
+            analyze_status = False
+        if abs(np.sum(pdf[:, 3]) - 1.0) > tol:
+            logger.warning('histogram fractions %d do not sum to 1', n)
+            analyze_status = False
+        joint = np.loadtxt('bin/TestInSitu.out3.{0:05d}.hist'.format(n))
+        if abs(np.sum(joint[:, 4]) - mass[n]) > tol * mass[n]:
+            logger.warning('joint histogram %d mass %g differs from history mass %g', n,
+                           np.sum(joint[:, 4]), mass[n])
+            analyze_status = False
+        prof = np.loadtxt('bin/TestInSitu.out4.{0:05d}.prof'.format(n))
+        if abs(np.sum(prof[:, 2]) - mass[n]) > tol * mass[n]:
+            logger.warning('radial profile %d mass %g differs from history mass %g', n,
+                           np.sum(prof[:, 2]), mass[n])
+            analyze_status = False
+        spec = np.loadtxt('bin/TestInSitu.out5.{0:05d}.spec'.format(n))
+        if np.sum(spec[:, 1]) != 32**3:
+            logger.warning('spectrum %d covers %d modes instead of %d', n,
+                           np.sum(spec[:, 1]), 32**3)
+            analyze_status = False
+        if abs(0.5 * np.sum(spec[:, 2]) - ke[n]) > tol * ke[n]:
+            logger.warning('spectrum %d energy %g differs from history energy %g', n,
+                           0.5 * np.sum(spec[:, 2]), ke[n])
+            analyze_status = False
+    return analyze_status
@@ -0,0 +1,54 @@
+# Regression test for global projection outputs (file_type = proj)
+#
+# Runs a 3D blast wave with a statically refined center and checks that the
+# column-density image integrates to the total mass from the history file, which
+# requires correct deposition from both refinement levels.
+
+# Modules
+import logging
+import numpy as np
+import sys
+import scripts.utils.athena as athena
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('hdf5', prob='blast', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = ['time/ncycle_out=0']
+    athena.run('hydro/athinput.test_projection', arguments)
+
+
+# Analyze outputs
+def analyze():
+    import h5py
+    analyze_status = True
+    hst = athena_read.hst('bin/TestProjection.hst')
+    for n in range(3):
+        with h5py.File('bin/TestProjection.out2.{0:05d}.proj.h5'.format(n), 'r') as f:
+            time = f.attrs['Time']
+            dx = np.diff(f['xf'][:])
+            dy = np.diff(f['yf'][:])
+            mass = np.sum(f['rho'][:] * np.outer(dy, dx))
+        mass_ref = np.interp(time, hst['time'], hst['mass'])
+        if abs(mass - mass_ref) > 1.0e-10 * mass_ref:
+            logger.warning('column projection mass %g differs from history mass %g',
+                           mass, mass_ref)
+            analyze_status = False
+    # mass-weighted and slice images are averages, bounded by the extrema of rho
+    with h5py.File('bin/TestProjection.out3.00002.proj.h5', 'r') as f:
+        rho_mw = f['rho'][:]
+    with h5py.File('bin/TestProjection.out4.00002.proj.h5', 'r') as f:
+        rho_sl = f['rho'][:]
+    if rho_mw.min() <= 0.0 or rho_sl.min() <= 0.0:
+        logger.warning('non-positive density in mass-weighted or slice image')
+        analyze_status = False
+    return analyze_status
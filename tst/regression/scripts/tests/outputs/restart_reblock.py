@@ -0,0 +1,64 @@
+# Regression test for restarting with a different MeshBlock size
+#
+# Runs the 3D MHD linear wave for half a period writing a restart file, and restarts
+# from it three times to finish the period: with the same MeshBlocks, splitting them and
+# merging them. Checks that the errors at the end agree between the three restarts.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_mesh = ['mesh/nx1=32', 'mesh/nx2=16', 'mesh/nx3=16', 'mesh/refinement=none']
+_block = ['meshblock/nx1=16', 'meshblock/nx2=8', 'meshblock/nx3=8']
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('b',
+                     prob='linear_wave',
+                     coord='cartesian',
+                     flux='hlld', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = _mesh + _block + ['time/ncycle_out=0', 'time/tlim=0.5',
+                                  'output1/dt=-1', 'output2/file_type=rst',
+                                  'output2/dt=0.5', 'problem/compute_error=false']
+    athena.run('mhd/athinput.linear_wave3d', arguments)
+    arguments = ['time/tlim=1.0', 'output2/dt=-1', 'problem/compute_error=true']
+    # same MeshBlocks, each split into 2x2x2, and all merged into a single one
+    split = ['meshblock/nx1=8', 'meshblock/nx2=4', 'meshblock/nx3=4']
+    merge = ['meshblock/nx1=32', 'meshblock/nx2=16', 'meshblock/nx3=16']
+    athena.restart('LinWave.final.rst', arguments)
+    athena.restart('LinWave.final.rst', arguments + split)
+    athena.restart('LinWave.final.rst', arguments + merge)
+
+
+# Analyze outputs
+def analyze():
+    # read data from error file: the plain, split and merged restarts
+    filename = 'bin/linearwave-errors.dat'
+    data = athena_read.error_dat(filename)
+
+    analyze_status = True
+    if len(data) != 3:
+        logger.warning("expected 3 rows in the error file, found %d", len(data))
+        return False
+    for row, name in [(1, 'split'), (2, 'merged')]:
+        # columns 4 onward are the RMS and per-variable L1 errors
+        for col in range(4, len(data[0])):
+            diff = abs(data[row][col] - data[0][col])
+            if diff > 1.0e-6*abs(data[0][col]):
+                logger.warning("error %d of the %s restart differs: %g vs %g", col,
+                               name, data[row][col], data[0][col])
+                analyze_status = False
+
+    return analyze_status
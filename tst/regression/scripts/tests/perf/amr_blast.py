@@ -0,0 +1,55 @@
+# Performance test: 3D hydrodynamic blast wave with AMR
+#
+# Runs 20 cycles on a 32^3 root grid of 8^3 MeshBlocks with two levels of refinement, on
+# two ranks with one thread each, including regrids and load balancing. The zone-cycles
+# per second are compared with the baseline of this machine, see
+# scripts/utils/performance.py. Not part of the default test list; run with "python
+# run_tests.py perf".
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import scripts.utils.performance as performance
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('mpi', prob='blast', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    extra = """
+<time>
+nlim = 20
+tlim = 100.0
+<mesh>
+nx1 = 32
+nx2 = 32
+nx3 = 32
+x1min = -0.5
+x1max = 0.5
+x2min = -0.5
+x2max = 0.5
+x3min = -0.5
+x3max = 0.5
+refinement = adaptive
+numlevel = 3
+derefine_count = 5
+<meshblock>
+nx1 = 8
+nx2 = 8
+nx3 = 8
+<problem>
+thr = 0.8
+"""
+    performance.run(__name__[14:], 'hydro/athinput.blast', [], extra, nproc=2,
+                    threads=1, **kwargs)
+
+
+# Analyze outputs
+def analyze():
+    return performance.analyze(__name__[14:])
@@ -0,0 +1,45 @@
+# Performance test: H2 chemical network in a uniform medium
+#
+# Runs 50 cycles with the forward Euler solver on a 32^3 mesh of 16^3 MeshBlocks with one
+# rank and one thread. The zone-cycles per second are compared with the baseline of this
+# machine, see scripts/utils/performance.py. Not part of the default test list; run with
+# "python run_tests.py perf".
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import scripts.utils.performance as performance
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='chem_uniform', chemistry='H2', chem_ode_solver='forward_euler',
+                     eos='isothermal', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    extra = """
+<time>
+nlim = 50
+<chemistry>
+output_zone_sec = false
+<mesh>
+nx1 = 32
+nx2 = 32
+nx3 = 32
+<meshblock>
+nx1 = 16
+nx2 = 16
+nx3 = 16
+"""
+    performance.run(__name__[14:], 'chemistry/athinput.chem_H2', [], extra, nproc=1,
+                    threads=1, **kwargs)
+
+
+# Analyze outputs
+def analyze():
+    return performance.analyze(__name__[14:])
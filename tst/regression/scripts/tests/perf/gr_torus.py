@@ -0,0 +1,43 @@
+# Performance test: GRMHD Fishbone-Moncrief torus in Kerr-Schild coordinates
+#
+# Runs 10 cycles on a 32^3 mesh of 16^3 MeshBlocks with one rank and one thread. The
+# zone-cycles per second are compared with the baseline of this machine, see
+# scripts/utils/performance.py. Not part of the default test list; run with "python
+# run_tests.py perf".
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import scripts.utils.performance as performance
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('g', 'b', prob='gr_torus', coord='kerr-schild', flux='hlle',
+                     nghost=4, **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    extra = """
+<time>
+nlim = 10
+<mesh>
+nx1 = 32
+nx2 = 32
+nx3 = 32
+<meshblock>
+nx1 = 16
+nx2 = 16
+nx3 = 16
+"""
+    performance.run(__name__[14:], 'mhd_gr/athinput.fm_torus', [], extra, nproc=1,
+                    threads=1, **kwargs)
+
+
+# Analyze outputs
+def analyze():
+    return performance.analyze(__name__[14:])
@@ -0,0 +1,41 @@
+# Performance test: implicit radiation hydrodynamics linear wave
+#
+# Runs 20 cycles of the 2D radiation linear wave on a 128x64 mesh of 32x32 MeshBlocks
+# with one rank and one thread. The zone-cycles per second are compared with the baseline
+# of this machine, see scripts/utils/performance.py. Not part of the default test list;
+# run with "python run_tests.py perf".
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import scripts.utils.performance as performance
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('implicit_radiation', prob='rad_linearwave', coord='cartesian',
+                     flux='hllc', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    extra = """
+<time>
+nlim = 20
+<mesh>
+nx1 = 128
+nx2 = 64
+<meshblock>
+nx1 = 32
+nx2 = 32
+"""
+    performance.run(__name__[14:], 'radiation/athinput.rad_linearwave', [], extra,
+                    nproc=1, threads=1, **kwargs)
+
+
+# Analyze outputs
+def analyze():
+    return performance.analyze(__name__[14:])
@@ -0,0 +1,191 @@
+# Functions for the performance tests in scripts/tests/perf/
+#
+# Each performance test runs a fixed problem size with fixed rank and thread counts,
+# parses the throughput (zone-cycles per second) from the output of Athena++, and
+# compares it with a baseline stored in data/perf_baselines.json. Baselines are kept per
+# machine, identified by the CPU model and the number of cores, so that one file can
+# hold several node types. A missing baseline is recorded from the current run and the
+# test is reported as "baseline recorded" instead of passed; --perf_update on the
+# command line of run_tests.py overwrites existing ones. With --perf_phases, each
+# problem is run a second time with the task trace enabled to collect the per-task
+# timers; the throughput is always taken from the untraced run. All results are
+# collected in perf_report.json.
+
+# Modules
+import json
+import logging
+import multiprocessing
+import os
+import platform
+import re
+import subprocess
+from timeit import default_timer as timer
+from . import athena
+
+# Global variables, set by run_tests.py
+tolerance = 0.1            # allowed relative loss of throughput
+update_baselines = False   # overwrite stored baselines with the measured values
+trace_phases = False       # collect per-task timers in a second, traced run
+baseline_file = 'data/perf_baselines.json'
+report_file = 'perf_report.json'
+
+logger = logging.getLogger('athena.perf')
+results = {}
+
+
+# Identify the node type on which the baselines were measured
+def machine_id():
+    cpu = platform.processor() or platform.machine()
+    try:
+        with open('/proc/cpuinfo', 'r') as f:
+            for line in f:
+                if line.startswith('model name'):
+                    cpu = line.split(':', 1)[1].strip()
+                    break
+    except IOError:
+        pass
+    return '{0} ({1} cores)'.format(cpu, multiprocessing.cpu_count())
+
+
+# Copy an input file without its <output> blocks, appending the text in extra; blocks
+# given again in extra replace the values of the original ones
+def write_input(input_filename, extra, output_filename):
+    with open('../' + athena.athena_rel_path + 'inputs/' + input_filename, 'r') as f:
+        lines = f.readlines()
+    text, keep = [], True
+    for line in lines:
+        stripped = line.strip()
+        if stripped.startswith('<'):
+            keep = not stripped.startswith('<output')
+        if keep:
+            text.append(line)
+    text.append('\n' + extra + '\n')
+    with open(output_filename, 'w') as f:
+        f.writelines(text)
+
+
+# Run the command and return its standard output and wall time
+def execute(cmd, threads):
+    logging.getLogger('athena.run').debug('Executing: ' + ' '.join(cmd))
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    t0 = timer()
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, env=env,
+                            universal_newlines=True)
+    output = []
+    for line in iter(proc.stdout.readline, ''):
+        output.append(line)
+        logging.getLogger('athena.run').info(line.rstrip('\n'))
+    proc.wait()
+    wall_time = timer() - t0
+    if proc.returncode != 0:
+        raise athena.AthenaError('Return code {0} from command \'{1}\''
+                                 .format(proc.returncode, ' '.join(cmd)))
+    return output, wall_time
+
+
+# Run Athena++ and return the parsed timings; nproc > 1 uses mpirun
+def run(name, input_filename, arguments, extra='', nproc=1, threads=1,
+        mpirun_cmd='mpirun', mpirun_opts=None):
+    current_dir = os.getcwd()
+    os.chdir('bin')
+    try:
+        extra += '\n<mesh>\nnum_threads = {0}\n'.format(threads)
+        write_input(input_filename, extra, 'athinput.perf')
+        cmd = ['./athena', '-i', 'athinput.perf']
+        if nproc > 1:
+            cmd = [mpirun_cmd] + (mpirun_opts or []) + ['-n', str(nproc)] + cmd
+        cmd = list(filter(None, cmd)) + arguments + athena.global_run_args
+        output, wall_time = execute(cmd, threads)
+        timings = parse_output(output)
+        if trace_phases:
+            write_input(input_filename, extra + '\n<trace>\nenable = true\n',
+                        'athinput.perf')
+            output, _ = execute(cmd, threads)
+            timings['phases'] = parse_output(output)['phases']
+    finally:
+        os.chdir(current_dir)
+    timings['wall_time'] = wall_time
+    timings['nproc'] = nproc
+    timings['threads'] = threads
+    results[name] = timings
+    return timings
+
+
+# Extract throughput and per-task times from the standard output of Athena++
+def parse_output(lines):
+    timings = {'phases': {}}
+    in_summary = False
+    for line in lines:
+        match = re.match(r'\s*(zone-cycles(?:/\w+)?)\s*=\s*(\S+)', line)
+        if match:
+            timings[match.group(1).replace('-', '_').replace('/', '_per_')] = \
+                float(match.group(2))
+            continue
+        if line.startswith('Task trace summary'):
+            in_summary = True
+            continue
+        if in_summary:
+            fields = line.split()
+            if len(fields) == 0 or fields[0] == 'rank':
+                in_summary = False
+            elif len(fields) == 5 and fields[0] != 'task':
+                timings['phases'][fields[0]] = {'calls': int(fields[1]),
+                                                'time': float(fields[2]),
+                                                'wait': float(fields[4])}
+    rate = timings.get('zone_cycles_per_omp_wsecond',
+                       timings.get('zone_cycles_per_cpu_second', 0.0))
+    timings['zone_cycles_per_sec'] = rate
+    return timings
+
+
+# Compare the last run of test name with its baseline and record the result
+def analyze(name):
+    timings = results[name]
+    machine = machine_id()
+    baselines = {}
+    if os.path.isfile(baseline_file):
+        with open(baseline_file, 'r') as f:
+            baselines = json.load(f)
+    stored = baselines.setdefault(machine, {}).get(name)
+    measured = timings['zone_cycles_per_sec']
+    status = True
+    if measured <= 0.0:
+        logger.warning('%s: no zone-cycles/second found in the output', name)
+        status = False
+    elif stored is None or update_baselines:
+        logger.warning('%s: baseline recorded, %.4g zone-cycles/s for %s', name,
+                       measured, machine)
+        status = 'baseline recorded'
+        baselines[machine][name] = {'zone_cycles_per_sec': measured,
+                                    'phases': {k: v['time'] for k, v
+                                               in timings['phases'].items()}}
+        with open(baseline_file, 'w') as f:
+            json.dump(baselines, f, indent=2, sort_keys=True)
+            f.write('\n')
+    ratio = measured / stored['zone_cycles_per_sec'] if stored else 1.0
+    if stored is not None and not update_baselines:
+        logger.info('%s: %.4g zone-cycles/s, baseline %.4g, ratio %.3f', name, measured,
+                    stored['zone_cycles_per_sec'], ratio)
+        if ratio < 1.0 - tolerance:
+            logger.warning('%s: throughput dropped by %.1f%% (tolerance %.1f%%)', name,
+                           100.0 * (1.0 - ratio), 100.0 * tolerance)
+            status = False
+        # phases are reported, not checked: short ones are too noisy for a tolerance
+        for phase, base_time in sorted(stored.get('phases', {}).items()):
+            if phase in timings['phases'] and base_time > 0.0:
+                phase_ratio = timings['phases'][phase]['time'] / base_time
+                if phase_ratio > 1.0 + tolerance:
+                    logger.info('%s: %s takes %.2fx its baseline time', name, phase,
+                                phase_ratio)
+
+    report = {}
+    if os.path.isfile(report_file):
+        with open(report_file, 'r') as f:
+            report = json.load(f)
+    report[name] = dict(timings, machine=machine, ratio=ratio, passed=status is True,
+                        baseline_recorded=(status == 'baseline recorded'),
+                        baseline=stored['zone_cycles_per_sec'] if stored else None)
+    with open(report_file, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+        f.write('\n')
+    return status